@@ -62,6 +62,9 @@ class LivenessAnalysis;
 class FunctionPointerAnalysis;
 class PointerAnalysis;
 class FixpointParameters;
+class FixpointOrders;
+class FixpointTelemetry;
+class IncrementalAnalysis;
 
 /// \brief Global analysis context
 ///
@@ -95,6 +98,15 @@ public:
   /// \brief Fixpoint parameters
   FixpointParameters* fixpoint_parameters;
 
+  /// \brief Weak topological and partial orders
+  FixpointOrders* fixpoint_orders;
+
+  /// \brief Statistics on the fixpoints of the value analysis, or null
+  FixpointTelemetry* fixpoint_telemetry;
+
+  /// \brief Results reused from a previous run, or null
+  IncrementalAnalysis* incremental;
+
   /// \brief Liveness analysis, or null
   LivenessAnalysis* liveness;
 
@@ -114,7 +126,8 @@ public:
           VariableFactory& var_factory_,
           LiteralFactory& lit_factory_,
           CallContextFactory& call_context_factory_,
-          FixpointParameters& fixpoint_parameters_)
+          FixpointParameters& fixpoint_parameters_,
+          FixpointOrders& fixpoint_orders_)
       : bundle(bundle_),
         opts(std::move(opts_)),
         wd(std::move(wd_)),
@@ -124,6 +137,9 @@ public:
         lit_factory(&lit_factory_),
         call_context_factory(&call_context_factory_),
         fixpoint_parameters(&fixpoint_parameters_),
+        fixpoint_orders(&fixpoint_orders_),
+        fixpoint_telemetry(nullptr),
+        incremental(nullptr),
         liveness(nullptr),
         function_pointer(nullptr),
         pointer(nullptr) {}
@@ -59,6 +59,7 @@
 
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/fixpoint_memo.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
 
@@ -79,6 +80,7 @@ public:
       ConcurrentInlineCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
   using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
+  using FixpointMemoT = FixpointMemo< AbstractDomain >;
 
 private:
   /// \brief Analysis context
@@ -156,10 +158,15 @@ private:
     ar::Function* callee;
     std::unique_ptr< FunctionFixpoint > fixpoint;
 
+    /// \brief Fingerprint and projected entry invariant, for the memoized
+    /// fix-points
+    std::size_t fingerprint;
+    llvm::Optional< AbstractDomain > entry;
+
   public:
     /// \brief Constructor
     explicit CalleeAnalysis(ar::Function* callee_)
-        : callee(callee_), fixpoint(nullptr) {}
+        : callee(callee_), fixpoint(nullptr), fingerprint(0) {}
 
     /// \brief No copy constructor
     CalleeAnalysis(const CalleeAnalysis&) = delete;
@@ -199,6 +206,9 @@ private:
     /// \brief Analyses on callees
     std::vector< CalleeAnalysis >& _callee_analyses;
 
+    /// \brief True if the checks will be run on the callees
+    bool _check_callees;
+
     /// \brief Post invariant
     llvm::Optional< AbstractDomain > _post;
 
@@ -210,6 +220,7 @@ private:
                  FixpointCacheT& callees_cache,
                  ar::CallBase* call,
                  std::vector< CalleeAnalysis >& callee_analyses,
+                 bool check_callees,
                  AbstractDomain post)
         : _ctx(ctx),
           _engine(engine),
@@ -217,6 +228,7 @@ private:
           _callees_cache(callees_cache),
           _call(call),
           _callee_analyses(callee_analyses),
+          _check_callees(check_callees),
           _post(std::move(post)) {}
 
     /// \brief Split constructor
@@ -227,6 +239,7 @@ private:
           _callees_cache(parent._callees_cache),
           _call(parent._call),
           _callee_analyses(parent._callee_analyses),
+          _check_callees(parent._check_callees),
           _post(llvm::None) {}
 
     /// \brief No copy constructor
@@ -262,12 +275,45 @@ private:
 
       analysis.fixpoint = nullptr;
 
+      FixpointMemoT& memo = this->_caller.fixpoint_memo();
+
+      if (memo.enabled() && !this->_check_callees) {
+        analysis.entry = memo.project(_ctx,
+                                      this->_caller.function(),
+                                      this->_caller.call_context(),
+                                      engine.inv());
+        analysis.fingerprint =
+            FixpointMemoT::fingerprint(_ctx, analysis.callee, *analysis.entry);
+      }
+
       if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
         // Try to fetch the previously computed fix-point
         analysis.fixpoint =
             this->_callees_cache.try_fetch(this->_call, analysis.callee);
       }
 
+      if (analysis.fixpoint == nullptr && analysis.entry) {
+        // Try to fetch a fix-point computed for a larger entry invariant
+        auto memoized = memo.try_fetch(analysis.callee,
+                                       analysis.fingerprint,
+                                       *analysis.entry);
+
+        if (memoized) {
+          if (_ctx.opts.use_fixpoint_cache) {
+            // The fix-point for that call site is outdated
+            this->_callees_cache.erase(this->_call, analysis.callee);
+          }
+
+          engine.set_inv(
+              memo.combine(_ctx,
+                           analysis.callee,
+                           std::move(memoized->exit_invariant),
+                           engine.inv()));
+          this->join_callee_exit(engine, memoized->return_stmt);
+          return;
+        }
+      }
+
       if (analysis.fixpoint == nullptr) {
         if (_ctx.opts.use_fixpoint_cache) {
           // Erase the previous fix-point on the callee
@@ -283,13 +329,29 @@ private:
 
         // Run analysis on callee
         analysis.fixpoint->run(std::move(engine.inv()));
+
+        if (analysis.entry) {
+          memo.store(analysis.callee,
+                     analysis.fingerprint,
+                     std::move(*analysis.entry),
+                     memo.project(_ctx,
+                                  this->_caller.function(),
+                                  this->_caller.call_context(),
+                                  analysis.fixpoint->exit_invariant()),
+                     analysis.fixpoint->return_stmt());
+        }
       }
 
       // Return statement in the callee, or null
       ar::ReturnValue* return_stmt = analysis.fixpoint->return_stmt();
 
       engine.set_inv(analysis.fixpoint->exit_invariant());
+      this->join_callee_exit(engine, return_stmt);
+    }
 
+    /// \brief Propagate the exit invariant of a callee to the post invariant
+    void join_callee_exit(NumericalExecutionEngineT& engine,
+                          ar::ReturnValue* return_stmt) {
       // Merge exceptions in caught_exceptions, in case it's an invoke
       engine.inv().merge_propagated_in_caught_exceptions();
 
@@ -483,12 +545,18 @@ private:
                         this->_callees_cache,
                         call,
                         callee_analyses,
+                        this->_check_callees,
                         std::move(post));
     tbb::blocked_range< size_t > range(0, callee_analyses.size());
     tbb::parallel_reduce(range, worker);
 
     // Non-thread safe
     for (CalleeAnalysis& analysis : callee_analyses) {
+      if (analysis.fixpoint == nullptr) {
+        // Memoized fix-point
+        continue;
+      }
+
       if (this->_check_callees) {
         // Run the checks on the callee
         analysis.fixpoint->run_checks();
@@ -0,0 +1,447 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Memoization of callee fixpoints by entry state
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Memoization of callee fixpoints by entry state
+///
+/// Unlike FixpointCache, which stores a fixpoint per call site, this stores
+/// the exit invariant of a callee for a given entry invariant, whatever the
+/// call site.
+///
+/// Invariants are projected on the state visible to the callee before being
+/// memoized: the scalar variables of the functions in the call stack are
+/// forgotten, so that calls from different callers can share an entry. The
+/// memory is kept as a whole. If the callee is called again with a projected
+/// entry invariant that is included in a memoized one, the memoized exit
+/// invariant over-approximates the projected exit states for that entry. It is
+/// then combined with the scalar variables of the caller, which the callee
+/// cannot modify.
+///
+/// Checks are not memoized: a callee is always analyzed when its checks are
+/// run, so that they are reported for each calling context. The memoized
+/// fixpoints only save the analysis of callees before the fixpoint of the
+/// caller is reached.
+///
+/// Entries are bucketed by callee and by a coarse fingerprint of the entry
+/// invariant, the nullity of the pointer parameters. The fingerprint does not
+/// depend on numerical bounds, so that entries that are comparable usually
+/// fall in the same bucket, and `leq` decides within the bucket. The number of
+/// entries is bounded, and the least recently used entries are evicted first.
+/// The bound is a number of entries rather than a memory size, since the size
+/// of an invariant is not known by the abstract domains.
+template < typename AbstractDomain >
+class FixpointMemo {
+public:
+  /// \brief Result of a memoized fixpoint
+  struct Result {
+    /// \brief Projected exit invariant
+    AbstractDomain exit_invariant;
+
+    /// \brief Return statement in the callee, or null
+    ar::ReturnValue* return_stmt;
+  };
+
+private:
+  /// \brief Memoized entry
+  struct Entry {
+    ar::Function* callee;
+    std::size_t fingerprint;
+    AbstractDomain entry_invariant;
+    Result result;
+  };
+
+  /// \brief List of entries, from the most recently used to the least
+  using EntryList = std::list< Entry >;
+
+  /// \brief Key of a bucket
+  using Key = std::pair< ar::Function*, std::size_t >;
+
+  /// \brief Map from key to entries
+  using BucketMap =
+      llvm::DenseMap< Key,
+                      llvm::SmallVector< typename EntryList::iterator, 2 > >;
+
+  /// \brief Map from function to its scalar variables
+  ///
+  /// References on values are stable.
+  using FrameVariablesMap =
+      std::unordered_map< ar::Function*, std::vector< Variable* > >;
+
+  /// \brief Functions that might be called, directly or not, by a callee
+  using ReachableFunctions = llvm::DenseSet< ar::Function* >;
+
+  /// \brief Map from callee to the functions it might call
+  ///
+  /// References on values are stable.
+  using ReachableFunctionsMap =
+      std::unordered_map< ar::Function*, ReachableFunctions >;
+
+private:
+  /// \brief Maximum number of entries, or 0 if disabled
+  std::size_t _capacity;
+
+  /// \brief Entries
+  EntryList _entries;
+
+  /// \brief Buckets
+  BucketMap _buckets;
+
+  /// \brief Scalar variables of the functions in call stacks
+  FrameVariablesMap _frame_variables;
+
+  /// \brief Call graph, computed on the first combine
+  std::unique_ptr< CallGraph > _call_graph;
+
+  /// \brief Functions that might be called by the memoized callees
+  ReachableFunctionsMap _reachable_functions;
+
+  /// \brief Number of lookups that returned a memoized fixpoint
+  std::atomic< std::size_t > _hits{0};
+
+  /// \brief Number of lookups that did not return a memoized fixpoint
+  std::atomic< std::size_t > _misses{0};
+
+  /// \brief Number of evicted entries
+  std::atomic< std::size_t > _evictions{0};
+
+  std::mutex _mutex;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param capacity Maximum number of entries, or 0 to disable memoization
+  explicit FixpointMemo(std::size_t capacity) : _capacity(capacity) {}
+
+  /// \brief No copy constructor
+  FixpointMemo(const FixpointMemo&) = delete;
+
+  /// \brief No move constructor
+  FixpointMemo(FixpointMemo&&) = delete;
+
+  /// \brief No copy assignment operator
+  FixpointMemo& operator=(const FixpointMemo&) = delete;
+
+  /// \brief No move assignment operator
+  FixpointMemo& operator=(FixpointMemo&&) = delete;
+
+  /// \brief Destructor
+  ~FixpointMemo() = default;
+
+  /// \brief Return true if the memoization is enabled
+  bool enabled() const { return this->_capacity > 0; }
+
+  /// \brief Project an invariant on the state visible to a callee
+  ///
+  /// Forget the scalar variables of `caller` and of the functions in its
+  /// calling context `call_context`.
+  AbstractDomain project(Context& ctx,
+                         ar::Function* caller,
+                         CallContext* call_context,
+                         AbstractDomain inv) {
+    auto normal = std::move(inv.normal());
+    auto caught_exceptions = std::move(inv.caught_exceptions());
+    auto propagated_exceptions = inv.propagated_exceptions();
+
+    auto forget_frame = [&](ar::Function* fun) {
+      for (Variable* var : this->frame_variables(ctx, fun)) {
+        normal.scalar_forget(var);
+        caught_exceptions.scalar_forget(var);
+        propagated_exceptions.scalar_forget(var);
+      }
+    };
+
+    forget_frame(caller);
+    for (; !call_context->empty(); call_context = call_context->parent()) {
+      ar::Function* fun = call_context->call()->code()->function_or_null();
+      if (fun != nullptr) {
+        forget_frame(fun);
+      }
+    }
+
+    return AbstractDomain(std::move(normal),
+                          std::move(caught_exceptions),
+                          std::move(propagated_exceptions));
+  }
+
+  /// \brief Combine a memoized exit invariant with the entry invariant of the
+  /// current call to `callee`
+  ///
+  /// The scalar variables of the caller are not modified by the callee, hence
+  /// they are taken from `entry`. The memory and the lifetime of memory
+  /// locations are taken from `exit`.
+  ///
+  /// The scalar variables of `callee` and of the functions it might call,
+  /// including the allocation sizes of their dynamic memory locations, are
+  /// forgotten in `entry`: without the liveness analysis, `entry` might still
+  /// hold their values from a previous call, which do not hold at the exit
+  /// of this call.
+  AbstractDomain combine(Context& ctx,
+                         ar::Function* callee,
+                         AbstractDomain exit,
+                         const AbstractDomain& entry) {
+    auto frame = entry.normal();
+    frame.mem_forget_all();
+    frame.lifetime_forget_all();
+
+    const ReachableFunctions& functions =
+        this->reachable_functions(ctx, callee);
+    for (ar::Function* fun : functions) {
+      for (Variable* var : this->frame_variables(ctx, fun)) {
+        frame.scalar_forget(var);
+      }
+    }
+    for (DynAllocMemoryLocation* mem : ctx.mem_factory->dyn_allocs()) {
+      ar::Function* fun = mem->call()->code()->function_or_null();
+      if (fun != nullptr && functions.count(fun) > 0) {
+        frame.scalar_forget(ctx.var_factory->get_alloc_size(mem));
+      }
+    }
+
+    return exit.meet(AbstractDomain(frame, frame, frame));
+  }
+
+  /// \brief Compute the fingerprint of the entry invariant `inv` of `callee`
+  ///
+  /// The fingerprint only depends on the nullity of the pointer parameters.
+  /// Two invariants with different fingerprints can still be comparable, for
+  /// instance if a parameter is non-null in one and might be null in the
+  /// other. This is a trade-off to keep the buckets small.
+  static std::size_t fingerprint(Context& ctx,
+                                 ar::Function* callee,
+                                 const AbstractDomain& inv) {
+    std::size_t seed = 0;
+
+    if (inv.is_normal_flow_bottom()) {
+      return seed;
+    }
+
+    for (auto it = callee->param_begin(), et = callee->param_end(); it != et;
+         ++it) {
+      ar::InternalVariable* param = *it;
+
+      if (param->type()->is_pointer()) {
+        Variable* var = ctx.var_factory->get_internal(param);
+        auto nullity = inv.normal().nullity_to_nullity(var);
+        boost::hash_combine(seed, nullity.is_null());
+        boost::hash_combine(seed, nullity.is_non_null());
+      }
+    }
+
+    return seed;
+  }
+
+  /// \brief Try to fetch a memoized fixpoint for the given callee and
+  /// projected entry invariant
+  boost::optional< Result > try_fetch(ar::Function* callee,
+                                      std::size_t fingerprint,
+                                      const AbstractDomain& entry) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto bucket_it = this->_buckets.find(Key(callee, fingerprint));
+    if (bucket_it != this->_buckets.end()) {
+      for (auto entry_it : bucket_it->second) {
+        if (entry.leq(entry_it->entry_invariant)) {
+          // Mark as most recently used
+          this->_entries.splice(this->_entries.begin(),
+                                this->_entries,
+                                entry_it);
+          this->_hits++;
+          return entry_it->result;
+        }
+      }
+    }
+    this->_misses++;
+    return boost::none;
+  }
+
+  /// \brief Store the fixpoint of a callee for the given projected entry and
+  /// exit invariants
+  void store(ar::Function* callee,
+             std::size_t fingerprint,
+             AbstractDomain entry,
+             AbstractDomain exit,
+             ar::ReturnValue* return_stmt) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    if (this->_capacity == 0) {
+      return;
+    }
+
+    this->_entries.push_front(Entry{callee,
+                                    fingerprint,
+                                    std::move(entry),
+                                    Result{std::move(exit), return_stmt}});
+    this->_buckets[Key(callee, fingerprint)].push_back(this->_entries.begin());
+
+    while (this->_entries.size() > this->_capacity) {
+      this->evict();
+    }
+  }
+
+  /// \brief Return the number of lookups that returned a memoized fixpoint
+  std::size_t hits() const { return this->_hits.load(); }
+
+  /// \brief Return the number of lookups without a memoized fixpoint
+  std::size_t misses() const { return this->_misses.load(); }
+
+  /// \brief Return the number of evicted entries
+  std::size_t evictions() const { return this->_evictions.load(); }
+
+private:
+  /// \brief Return the scalar variables of the given function
+  ///
+  /// This includes the parameters, the internal variables and the addresses
+  /// of the local variables.
+  const std::vector< Variable* >& frame_variables(Context& ctx,
+                                                   ar::Function* fun) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto it = this->_frame_variables.find(fun);
+    if (it != this->_frame_variables.end()) {
+      return it->second;
+    }
+
+    std::vector< Variable* > vars;
+    for (auto p = fun->param_begin(), e = fun->param_end(); p != e; ++p) {
+      vars.push_back(ctx.var_factory->get_internal(*p));
+    }
+    if (ar::Code* body = fun->body_or_null()) {
+      for (auto v = body->internal_variable_begin(),
+                e = body->internal_variable_end();
+           v != e;
+           ++v) {
+        vars.push_back(ctx.var_factory->get_internal(*v));
+      }
+    }
+    for (auto v = fun->local_variable_begin(), e = fun->local_variable_end();
+         v != e;
+         ++v) {
+      vars.push_back(ctx.var_factory->get_local(*v));
+    }
+    return this->_frame_variables.emplace(fun, std::move(vars)).first->second;
+  }
+
+  /// \brief Return the functions that might be called by `callee`, including
+  /// `callee` itself
+  const ReachableFunctions& reachable_functions(Context& ctx,
+                                                ar::Function* callee) {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto it = this->_reachable_functions.find(callee);
+    if (it != this->_reachable_functions.end()) {
+      return it->second;
+    }
+
+    if (this->_call_graph == nullptr) {
+      this->_call_graph = std::make_unique< CallGraph >(build_call_graph(ctx));
+    }
+
+    ReachableFunctions functions;
+    std::vector< ar::Function* > worklist = {callee};
+    functions.insert(callee);
+    while (!worklist.empty()) {
+      ar::Function* fun = worklist.back();
+      worklist.pop_back();
+      auto callees_it = this->_call_graph->find(fun);
+      if (callees_it == this->_call_graph->end()) {
+        continue;
+      }
+      for (ar::Function* next : callees_it->second) {
+        if (functions.insert(next).second) {
+          worklist.push_back(next);
+        }
+      }
+    }
+    return this->_reachable_functions.emplace(callee, std::move(functions))
+        .first->second;
+  }
+
+  /// \brief Evict the least recently used entry
+  void evict() {
+    auto entry_it = std::prev(this->_entries.end());
+    auto bucket_it =
+        this->_buckets.find(Key(entry_it->callee, entry_it->fingerprint));
+    ikos_assert(bucket_it != this->_buckets.end());
+
+    auto& bucket = bucket_it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), entry_it));
+    if (bucket.empty()) {
+      this->_buckets.erase(bucket_it);
+    }
+
+    this->_entries.erase(entry_it);
+    this->_evictions++;
+  }
+
+}; // end class FixpointMemo
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -48,12 +48,15 @@
 
 #include <memory>
 
+#include <boost/optional.hpp>
+
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
 #include <ikos/ar/verify/type.hpp>
 
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/fixpoint_memo.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
@@ -76,6 +79,7 @@ public:
       InlineCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
   using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
+  using FixpointMemoT = FixpointMemo< AbstractDomain >;
 
 private:
   /// \brief Analysis context
@@ -290,6 +294,20 @@ private:
       // Analyze recursively the callee
       //
 
+      FixpointMemoT& memo = this->_caller.fixpoint_memo();
+      std::size_t fingerprint = 0;
+
+      // Projected entry invariant, for the memoized fix-points
+      boost::optional< AbstractDomain > entry;
+
+      if (memo.enabled() && !this->_check_callees) {
+        entry = memo.project(_ctx,
+                             this->_caller.function(),
+                             this->_caller.call_context(),
+                             engine.inv());
+        fingerprint = FixpointMemoT::fingerprint(_ctx, callee, *entry);
+      }
+
       std::unique_ptr< FunctionFixpoint > callee_fixpoint = nullptr;
 
       if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
@@ -297,6 +315,26 @@ private:
         callee_fixpoint = this->_callees_cache.try_fetch(call, callee);
       }
 
+      if (callee_fixpoint == nullptr && entry) {
+        // Try to fetch a fix-point computed for a larger entry invariant
+        auto memoized = memo.try_fetch(callee, fingerprint, *entry);
+
+        if (memoized) {
+          if (_ctx.opts.use_fixpoint_cache) {
+            // The fix-point for that call site is outdated
+            this->_callees_cache.erase(call, callee);
+          }
+
+          engine.set_inv(
+              memo.combine(_ctx,
+                           callee,
+                           std::move(memoized->exit_invariant),
+                           engine.inv()));
+          this->join_callee_exit(post, engine, call, memoized->return_stmt);
+          continue;
+        }
+      }
+
       if (callee_fixpoint == nullptr) {
         if (_ctx.opts.use_fixpoint_cache) {
           // Erase the previous fix-point on the callee
@@ -312,6 +350,17 @@ private:
         // Run analysis on callee
         log::debug("Analyzing function '" + demangle(callee->name()) + "'");
         callee_fixpoint->run(std::move(engine.inv()));
+
+        if (entry) {
+          memo.store(callee,
+                     fingerprint,
+                     std::move(*entry),
+                     memo.project(_ctx,
+                                  this->_caller.function(),
+                                  this->_caller.call_context(),
+                                  callee_fixpoint->exit_invariant()),
+                     callee_fixpoint->return_stmt());
+        }
       }
 
       if (this->_check_callees) {
@@ -332,20 +381,28 @@ private:
         callee_fixpoint.reset();
       }
 
-      // Merge exceptions in caught_exceptions, in case it's an invoke
-      engine.inv().merge_propagated_in_caught_exceptions();
+      this->join_callee_exit(post, engine, call, return_stmt);
+    }
 
-      if (engine.inv().is_normal_flow_bottom()) {
-        // Collect the exception states
-        post.join_with(std::move(engine.inv()));
-        continue;
-      }
+    this->_engine.set_inv(std::move(post));
+  }
+
+  /// \brief Propagate the exit invariant of a callee to the post invariant
+  void join_callee_exit(AbstractDomain& post,
+                        NumericalExecutionEngineT& engine,
+                        ar::CallBase* call,
+                        ar::ReturnValue* return_stmt) {
+    // Merge exceptions in caught_exceptions, in case it's an invoke
+    engine.inv().merge_propagated_in_caught_exceptions();
 
-      engine.match_up(call, return_stmt);
+    if (engine.inv().is_normal_flow_bottom()) {
+      // Collect the exception states
       post.join_with(std::move(engine.inv()));
+      return;
     }
 
-    this->_engine.set_inv(std::move(post));
+    engine.match_up(call, return_stmt);
+    post.join_with(std::move(engine.inv()));
   }
 
 }; // end class InlineCallExecutionEngine
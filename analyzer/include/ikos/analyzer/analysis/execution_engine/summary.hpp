@@ -0,0 +1,618 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Function summary call semantic
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/verify/type.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/literal.hpp>
+#include <ikos/analyzer/analysis/pointer/value.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Return the shadow variable holding the initial value of the given
+/// parameter of a function, or null if the parameter is not summarized
+///
+/// Only integer and pointer parameters are summarized. The shadow variable is
+/// assigned to the parameter on entry of the function, so that the exit
+/// invariant relates the return value with the parameters.
+inline Variable* summary_parameter_shadow(Context& ctx,
+                                          ar::Function* fun,
+                                          std::size_t i) {
+  ar::InternalVariable* param = fun->param(i);
+  ar::Type* type = param->type();
+
+  if (!type->is_integer() && !type->is_pointer()) {
+    return nullptr;
+  }
+
+  return ctx.var_factory->get_named_shadow(type,
+                                           "shadow.summary." + fun->name() +
+                                               ".param." + std::to_string(i));
+}
+
+/// \brief Input/output summary of a function
+///
+/// A summary is computed once per function, from the invariant at the exit
+/// node of the function analyzed with unknown parameters and unknown memory.
+/// It is then applied at every call site instead of analyzing the callee
+/// again.
+///
+/// Since the memory is unknown on entry, the memory contents at the exit node
+/// hold whatever the caller's memory was, and they are kept in the summary.
+template < typename AbstractDomain >
+class FunctionSummary {
+private:
+  /// \brief Invariant at the exit node, without exceptions
+  ///
+  /// The scalar variables of the function are forgotten, except the returned
+  /// variable and the shadow variables of the parameters.
+  AbstractDomain _exit_invariant;
+
+  /// \brief Return statement in the function, or null
+  ar::ReturnValue* _return_stmt;
+
+  /// \brief Shadow variables of the parameters, or null if not summarized
+  std::vector< Variable* > _parameters;
+
+  /// \brief Returned internal variable, or null
+  Variable* _return_var;
+
+  /// \brief Dynamic memory locations that the function might allocate
+  std::vector< MemoryLocation* > _allocated_memory;
+
+  /// \brief True if the function might write in the memory of the caller
+  bool _may_write_memory;
+
+  /// \brief True if the function might throw exceptions
+  bool _may_throw;
+
+public:
+  /// \brief Constructor
+  FunctionSummary(AbstractDomain exit_invariant,
+                  ar::ReturnValue* return_stmt,
+                  std::vector< Variable* > parameters,
+                  Variable* return_var,
+                  std::vector< MemoryLocation* > allocated_memory,
+                  bool may_write_memory,
+                  bool may_throw)
+      : _exit_invariant(std::move(exit_invariant)),
+        _return_stmt(return_stmt),
+        _parameters(std::move(parameters)),
+        _return_var(return_var),
+        _allocated_memory(std::move(allocated_memory)),
+        _may_write_memory(may_write_memory),
+        _may_throw(may_throw) {}
+
+  /// \brief Return the invariant at the exit node
+  const AbstractDomain& exit_invariant() const {
+    return this->_exit_invariant;
+  }
+
+  /// \brief Return the return statement, or null
+  ar::ReturnValue* return_stmt() const { return this->_return_stmt; }
+
+  /// \brief Return the number of parameters
+  std::size_t num_parameters() const { return this->_parameters.size(); }
+
+  /// \brief Return the shadow variable of the i-th parameter, or null
+  Variable* parameter(std::size_t i) const {
+    return i < this->_parameters.size() ? this->_parameters[i] : nullptr;
+  }
+
+  /// \brief Return the returned internal variable, or null
+  Variable* return_var() const { return this->_return_var; }
+
+  /// \brief Return the dynamic memory locations that the function might
+  /// allocate, including in its callees
+  const std::vector< MemoryLocation* >& allocated_memory() const {
+    return this->_allocated_memory;
+  }
+
+  /// \brief Return true if the function might write in the memory
+  bool may_write_memory() const { return this->_may_write_memory; }
+
+  /// \brief Return true if the function might throw exceptions
+  bool may_throw() const { return this->_may_throw; }
+
+}; // end class FunctionSummary
+
+/// \brief Cache of function summaries
+///
+/// Summaries are computed bottom-up on the call graph, so this is only
+/// accessed by one thread at a time.
+template < typename AbstractDomain >
+class SummaryCache {
+public:
+  using FunctionSummaryT = FunctionSummary< AbstractDomain >;
+
+private:
+  /// \brief Map from function to summary
+  using SummaryMap =
+      llvm::DenseMap< ar::Function*, std::unique_ptr< FunctionSummaryT > >;
+
+private:
+  SummaryMap _map;
+
+public:
+  /// \brief Constructor
+  SummaryCache() = default;
+
+  /// \brief No copy constructor
+  SummaryCache(const SummaryCache&) = delete;
+
+  /// \brief No move constructor
+  SummaryCache(SummaryCache&&) = delete;
+
+  /// \brief No copy assignment operator
+  SummaryCache& operator=(const SummaryCache&) = delete;
+
+  /// \brief No move assignment operator
+  SummaryCache& operator=(SummaryCache&&) = delete;
+
+  /// \brief Destructor
+  ~SummaryCache() = default;
+
+  /// \brief Try to fetch the summary of the given function, or null
+  const FunctionSummaryT* try_fetch(ar::Function* fun) const {
+    auto it = this->_map.find(fun);
+    if (it == this->_map.end()) {
+      return nullptr;
+    }
+    return it->second.get();
+  }
+
+  /// \brief Store the summary of the given function
+  void store(ar::Function* fun, std::unique_ptr< FunctionSummaryT > summary) {
+    this->_map[fun] = std::move(summary);
+  }
+
+}; // end class SummaryCache
+
+/// \brief Call semantic using function summaries
+///
+/// Calls to functions with a summary are executed by first applying the side
+/// effects of an unknown internal call (restricted to what the callee may
+/// actually do), and then refining the result with the exit invariant of the
+/// callee, in which the parameters are bound to the actual arguments. The
+/// memory contents of the exit invariant are met with the ones of the caller,
+/// which the unknown call forgot if the callee might write them.
+///
+/// Calls to functions without a summary (i.e, recursive calls) are treated as
+/// calls to unknown internal functions.
+template < typename FunctionFixpoint, typename AbstractDomain >
+class SummaryCallExecutionEngine final : public CallExecutionEngine {
+public:
+  using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+  using FunctionSummaryT = FunctionSummary< AbstractDomain >;
+  using SummaryCacheT = SummaryCache< AbstractDomain >;
+  using IntInterval = core::machine_int::Interval;
+  using IntLinearExpression = core::LinearExpression< MachineInt, Variable* >;
+  using Nullity = core::Nullity;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Numerical execution engine
+  NumericalExecutionEngineT& _engine;
+
+  /// \brief Function analyzer of the caller
+  FunctionFixpoint& _caller;
+
+  /// \brief Function summaries of the callees
+  const SummaryCacheT& _summaries;
+
+public:
+  /// \brief Constructor
+  SummaryCallExecutionEngine(Context& ctx,
+                             NumericalExecutionEngineT& engine,
+                             FunctionFixpoint& caller,
+                             const SummaryCacheT& summaries)
+      : _ctx(ctx), _engine(engine), _caller(caller), _summaries(summaries) {}
+
+  /// \brief Exit a function
+  ///
+  /// This is called whenever we reach the exit node (if there is one).
+  ///
+  /// Note that this is different from exec(ar::Returnvalue*) if there is
+  /// exceptions. This can be used to catch the invariant, including pending
+  /// exceptions.
+  void exec_exit(ar::Function* fun) override {
+    this->_engine.deallocate_local_variables(fun->local_variable_begin(),
+                                             fun->local_variable_end());
+    this->_caller.set_exit_invariant(this->_engine.inv());
+  }
+
+  /// \brief Execute a ReturnValue statement
+  void exec(ar::ReturnValue* s) override { this->_caller.set_return_stmt(s); }
+
+  /// \brief Execute a Call statement
+  void exec(ar::Call* s) override {
+    // Execute the call base statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // Exceptions aren't caught, propagate them
+    this->inv().merge_caught_in_propagated_exceptions();
+  }
+
+  /// \brief Execute an Invoke statement
+  void exec(ar::Invoke* s) override {
+    // Execute the call base statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // Exceptions are caught.
+    // Nothing to do here.
+    // see NumericalExecutionEngine::exec_edge()
+  }
+
+private:
+  /// \brief Return a non-const reference on the current invariant
+  AbstractDomain& inv() { return this->_engine.inv(); }
+
+  /// \brief Execute any call statement
+  void exec(ar::CallBase* call) {
+    this->inv().normal().normalize();
+
+    if (this->inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    //
+    // Collect potential callees
+    //
+    auto callees = PointsToSet::bottom();
+    ar::Value* called = call->called();
+
+    if (isa< ar::UndefinedConstant >(called)) {
+      // Call on undefined pointer: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (isa< ar::NullConstant >(called)) {
+      // Call on null pointer: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(called)) {
+      callees = {_ctx.mem_factory->get_function(cst->function())};
+    } else if (isa< ar::InlineAssemblyConstant >(called)) {
+      // Call to assembly
+      this->_engine.exec_unknown_extern_call(call);
+      return;
+    } else if (isa< ar::GlobalVariable >(called)) {
+      // Call to global variable: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (isa< ar::LocalVariable >(called)) {
+      // Call to local variable: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (auto ptr = dyn_cast< ar::InternalVariable >(called)) {
+      // Indirect call through a function pointer
+      Variable* ptr_var = _ctx.var_factory->get_internal(ptr);
+
+      // Assert `ptr != null`
+      this->inv().normal().nullity_assert_non_null(ptr_var);
+
+      // Reduction between value and pointer analysis
+      const PointerInfo* pointer_info = this->_engine.pointer_info();
+      if (pointer_info != nullptr) {
+        PointsToSet points_to = pointer_info->get(ptr_var).points_to();
+
+        // Pointer analysis and value analysis can be inconsistent
+        if (!points_to.is_bottom() && !points_to.is_top()) {
+          this->inv().normal().pointer_refine(ptr_var, points_to);
+        }
+      }
+
+      this->inv().normal().normalize();
+
+      if (this->inv().is_normal_flow_bottom()) {
+        return;
+      }
+
+      // Get the callees
+      callees = this->inv().normal().pointer_to_points_to(ptr_var);
+    } else {
+      ikos_unreachable("unexpected called operand");
+    }
+
+    //
+    // Check callees
+    //
+    ikos_assert(!callees.is_bottom());
+    if (callees.is_empty()) {
+      // Invalid pointer dereference
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (callees.is_top()) {
+      // No points-to information
+      // ASSUMPTION: the callee has no side effects.
+      // Just set lhs and all actual parameters of pointer type to TOP.
+      this->_engine.exec_unknown_extern_call(call);
+      return;
+    }
+
+    //
+    // Compute the post invariant
+    //
+
+    // By default, propagate the exception states
+    AbstractDomain post = this->inv();
+    post.set_normal_flow_to_bottom();
+
+    // For each callee
+    for (MemoryLocation* mem : callees) {
+      if (!isa< FunctionMemoryLocation >(mem)) {
+        // Not a call to a function memory location
+        continue;
+      }
+
+      ar::Function* callee = cast< FunctionMemoryLocation >(mem)->function();
+
+      if (!ar::TypeVerifier::is_valid_call(call, callee->type())) {
+        // Ill-formed function call
+        //
+        // This could be because of an imprecision of the pointer analysis.
+        continue;
+      }
+
+      NumericalExecutionEngineT engine = this->_engine.fork();
+
+      // Do not propagate exceptions from the caller to the callee
+      engine.inv().ignore_exceptions();
+
+      if (callee->is_declaration()) {
+        // Call to an extern function
+        //
+        // ASSUMPTION: if this is a call to an extern non-intrinsic function,
+        // treat it as a function call that has no side effects.
+        engine.exec_extern_call(call, callee);
+
+        // The call might allocate memory, e.g, malloc()
+        this->_caller.add_allocated_memory(
+            _ctx.mem_factory->get_dyn_alloc(call,
+                                            _ctx.call_context_factory
+                                                ->get_empty()));
+      } else if (const FunctionSummaryT* summary =
+                     this->_summaries.try_fetch(callee)) {
+        // Call to a summarized function
+        this->apply_summary(engine, call, callee, *summary);
+      } else {
+        // Recursive function call, the summary is not available yet
+        engine.exec_unknown_intern_call(call);
+      }
+
+      // Merge exceptions in caught_exceptions, in case it's an invoke
+      engine.inv().merge_propagated_in_caught_exceptions();
+      post.join_with(std::move(engine.inv()));
+    }
+
+    this->_engine.set_inv(std::move(post));
+  }
+
+  /// \brief Apply the summary of `callee` on the call statement
+  void apply_summary(NumericalExecutionEngineT& engine,
+                     ar::CallBase* call,
+                     ar::Function* callee,
+                     const FunctionSummaryT& summary) {
+    // Bind the parameters of the callee to the actual arguments
+    AbstractDomain exit = summary.exit_invariant();
+    for (std::size_t i = 0; i < callee->num_parameters(); i++) {
+      Variable* shadow = summary.parameter(i);
+      ar::Value* arg = call->argument(i);
+
+      if (shadow == nullptr || arg->type() != callee->param(i)->type()) {
+        continue;
+      }
+
+      const ScalarLit& actual = _ctx.lit_factory->get_scalar(arg);
+      if (actual.is_machine_int()) {
+        exit.normal().int_refine(shadow,
+                                 IntInterval(actual.machine_int(),
+                                             actual.machine_int()));
+      } else if (actual.is_machine_int_var()) {
+        exit.normal().int_refine(shadow,
+                                 engine.inv()
+                                     .normal()
+                                     .int_to_interval_congruence(actual.var()));
+      } else if (actual.is_null()) {
+        exit.normal().nullity_refine(shadow, Nullity::null());
+      } else if (actual.is_pointer_var() && isa< ar::InternalVariable >(arg)) {
+        exit.normal().pointer_refine(shadow,
+                                     engine.inv().normal().pointer_to_pointer(
+                                         actual.var()));
+      }
+    }
+    exit.normal().normalize();
+
+    // Side effects of the callee
+    bool may_write = summary.may_write_memory();
+    engine.exec_unknown_call(call,
+                             /* may_write_params = */ may_write,
+                             /* ignore_unknown_write = */ false,
+                             /* may_write_globals = */ may_write,
+                             /* may_throw_exc = */ summary.may_throw());
+
+    if (engine.inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    if (exit.is_normal_flow_bottom()) {
+      // The callee never returns with these arguments
+      engine.inv().set_normal_flow_to_bottom();
+      return;
+    }
+
+    this->apply_memory_effects(engine, summary, exit);
+
+    if (engine.inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    ar::ReturnValue* return_stmt = summary.return_stmt();
+    if (!call->has_result() || return_stmt == nullptr ||
+        !return_stmt->has_operand() ||
+        call->result()->type() != return_stmt->operand()->type()) {
+      return;
+    }
+
+    const Literal& lhs_lit = _ctx.lit_factory->get(call->result());
+    const Literal& ret_lit = _ctx.lit_factory->get(return_stmt->operand());
+    if (!lhs_lit.is_scalar() || !ret_lit.is_scalar()) {
+      return;
+    }
+
+    const ScalarLit& lhs = lhs_lit.scalar();
+    const ScalarLit& ret = ret_lit.scalar();
+    if (lhs.is_machine_int_var() && ret.is_machine_int()) {
+      engine.inv().normal().int_assign(lhs.var(), ret.machine_int());
+    } else if (lhs.is_machine_int_var() && ret.is_machine_int_var()) {
+      this->bind_int_result(engine, call, callee, summary, exit, lhs, ret);
+    } else if (lhs.is_pointer_var() && ret.is_null()) {
+      engine.inv().normal().pointer_assign_null(lhs.var());
+    } else if (lhs.is_pointer_var() && ret.is_pointer_var()) {
+      engine.inv().normal().pointer_refine(lhs.var(),
+                                           exit.normal().pointer_to_pointer(
+                                               ret.var()));
+    }
+  }
+
+  /// \brief Apply the memory contents of the exit invariant of a summarized
+  /// call on the caller
+  ///
+  /// `exit` is the exit invariant of the callee, with the parameters bound to
+  /// the actual arguments.
+  void apply_memory_effects(NumericalExecutionEngineT& engine,
+                            const FunctionSummaryT& summary,
+                            const AbstractDomain& exit) {
+    // Memory objects allocated by the callee replace the ones of the caller
+    for (MemoryLocation* addr : summary.allocated_memory()) {
+      this->_caller.add_allocated_memory(addr);
+      engine.inv().normal().mem_forget(addr);
+      engine.inv().normal().lifetime_set(addr,
+                                         exit.normal().lifetime_to_lifetime(
+                                             addr));
+      engine.inv().normal().int_forget(_ctx.var_factory->get_alloc_size(addr));
+    }
+
+    // Only keep the memory contents and allocation sizes. The lifetime of the
+    // other memory locations is left unchanged, as for an unknown call.
+    auto effects = exit.normal();
+    for (std::size_t i = 0; i < summary.num_parameters(); i++) {
+      if (Variable* shadow = summary.parameter(i)) {
+        effects.scalar_forget(shadow);
+      }
+    }
+    if (summary.return_var() != nullptr) {
+      effects.scalar_forget(summary.return_var());
+    }
+    effects.lifetime_forget_all();
+
+    engine.inv().normal().meet_with(effects);
+  }
+
+  /// \brief Bind the integer result of a summarized call
+  ///
+  /// If the exit invariant implies `ret = param + k` for a parameter, assign
+  /// `lhs = arg + k`, then refine `lhs` with the value of `ret`.
+  void bind_int_result(NumericalExecutionEngineT& engine,
+                       ar::CallBase* call,
+                       ar::Function* callee,
+                       const FunctionSummaryT& summary,
+                       const AbstractDomain& exit,
+                       const ScalarLit& lhs,
+                       const ScalarLit& ret) {
+    ar::Type* type = call->result()->type();
+    auto int_type = cast< ar::IntegerType >(type);
+    uint64_t bit_width = int_type->bit_width();
+    Signedness sign = int_type->sign();
+
+    for (std::size_t i = 0; i < callee->num_parameters(); i++) {
+      Variable* shadow = summary.parameter(i);
+      ar::Value* arg = call->argument(i);
+
+      if (shadow == nullptr || arg->type() != type ||
+          !isa< ar::InternalVariable >(arg)) {
+        continue;
+      }
+
+      IntLinearExpression diff(MachineInt::zero(bit_width, sign));
+      diff.add(MachineInt(1, bit_width, sign), ret.var());
+      diff.add(MachineInt(-1, bit_width, sign), shadow);
+      boost::optional< MachineInt > k =
+          exit.normal().int_to_interval(diff).singleton();
+
+      if (k) {
+        Variable* arg_var =
+            _ctx.var_factory->get_internal(cast< ar::InternalVariable >(arg));
+        IntLinearExpression e(*k);
+        e.add(MachineInt(1, bit_width, sign), arg_var);
+        engine.inv().normal().int_assign(lhs.var(), e);
+        break;
+      }
+    }
+
+    engine.inv().normal().int_refine(lhs.var(),
+                                     exit.normal().int_to_interval_congruence(
+                                         ret.var()));
+  }
+
+}; // end class SummaryCallExecutionEngine
+
+} // end namespace analyzer
+} // end namespace ikos
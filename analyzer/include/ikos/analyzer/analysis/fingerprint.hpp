@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fingerprints of the functions, for incremental analyses
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+// forward declaration
+class FingerprintsTable;
+
+/// \brief Fingerprints of the function definitions of a bundle
+///
+/// The fingerprint of a function is a hash of everything the value analysis
+/// of that function depends on:
+///   * The textual representation of its body and the source locations of its
+///     statements, since the checks refer to them;
+///   * The pointer information on its internal variables, if the pointer
+///     analysis was run;
+///   * The fingerprints of its callees, for the interprocedural and summary
+///     analyses. Indirect calls depend on all the functions whose address is
+///     taken;
+///   * The global variable definitions and the global constructors and
+///     destructors, for the interprocedural analysis.
+///
+/// The hash is stable across runs, but not across versions of the analyzer.
+class FunctionFingerprints {
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Map from function definition to fingerprint
+  llvm::DenseMap< ar::Function*, uint64_t > _fingerprints;
+
+public:
+  /// \brief Constructor
+  explicit FunctionFingerprints(Context& ctx);
+
+  /// \brief No copy constructor
+  FunctionFingerprints(const FunctionFingerprints&) = delete;
+
+  /// \brief No move constructor
+  FunctionFingerprints(FunctionFingerprints&&) = delete;
+
+  /// \brief No copy assignment operator
+  FunctionFingerprints& operator=(const FunctionFingerprints&) = delete;
+
+  /// \brief No move assignment operator
+  FunctionFingerprints& operator=(FunctionFingerprints&&) = delete;
+
+  /// \brief Destructor
+  ~FunctionFingerprints();
+
+  /// \brief Compute the fingerprints
+  ///
+  /// This must run after the pointer analysis.
+  void run();
+
+  /// \brief Return the fingerprint of the given function definition
+  uint64_t get(ar::Function* fun) const;
+
+  /// \brief Save the fingerprints in the given table
+  void save(FingerprintsTable& table) const;
+
+}; // end class FunctionFingerprints
+
+/// \brief Return the textual representation of a fingerprint
+std::string fingerprint_str(uint64_t fingerprint);
+
+} // end namespace analyzer
+} // end namespace ikos
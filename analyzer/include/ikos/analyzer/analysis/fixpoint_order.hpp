@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Weak topological and partial orders of control flow graphs
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/core/fixpoint/wpo.hpp>
+#include <ikos/core/fixpoint/wto.hpp>
+
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/code.hpp>
+
+#include <ikos/analyzer/analysis/option.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Weak topological and partial orders of the control flow graphs
+///
+/// Orders are computed once per ar::Code and shared by all the fixpoint
+/// iterators on that code. This class is thread-safe.
+class FixpointOrders {
+public:
+  /// \brief Weak topological order
+  using WtoT = core::Wto< ar::Code* >;
+
+  /// \brief Weak partial order
+  using WpoT = core::Wpo< ar::Code* >;
+
+private:
+  /// \brief Number of threads to build the orders
+  int _num_threads;
+
+  /// \brief Whether the weak partial orders are needed
+  bool _use_wpo;
+
+  /// \brief Protect the maps
+  std::mutex _mutex;
+
+  /// \brief Map from code to weak topological order
+  llvm::DenseMap< ar::Code*, std::shared_ptr< const WtoT > > _wto_map;
+
+  /// \brief Map from code to weak partial order
+  llvm::DenseMap< ar::Code*, std::shared_ptr< const WpoT > > _wpo_map;
+
+public:
+  /// \brief Constructor
+  explicit FixpointOrders(const AnalysisOptions& opts);
+
+  /// \brief No copy constructor
+  FixpointOrders(const FixpointOrders&) = delete;
+
+  /// \brief No move constructor
+  FixpointOrders(FixpointOrders&&) = delete;
+
+  /// \brief No copy assignment operator
+  FixpointOrders& operator=(const FixpointOrders&) = delete;
+
+  /// \brief No move assignment operator
+  FixpointOrders& operator=(FixpointOrders&&) = delete;
+
+  /// \brief Destructor
+  ~FixpointOrders();
+
+  /// \brief Compute the orders of all the function bodies of the bundle
+  ///
+  /// Functions are processed in parallel, unless the analysis is sequential.
+  /// The weak partial orders are only computed for concurrent analyses.
+  void build(ar::Bundle* bundle);
+
+  /// \brief Get or compute the weak topological order of the given code
+  std::shared_ptr< const WtoT > wto(ar::Code* code);
+
+  /// \brief Get or compute the weak partial order of the given code
+  std::shared_ptr< const WpoT > wpo(ar::Code* code);
+
+}; // end class FixpointOrders
+
+} // end namespace analyzer
+} // end namespace ikos
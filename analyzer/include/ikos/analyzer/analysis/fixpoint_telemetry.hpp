@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Statistics on the fixpoints of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/core/fixpoint/statistics.hpp>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+// forward declaration
+class FixpointStatsTable;
+
+/// \brief Statistics on the fixpoints of the value analysis
+///
+/// Fixpoint iterators record their iterations, widenings, narrowings, the time
+/// spent in transfer functions, joins, widenings and narrowings, and the size
+/// of the invariants at cycle heads. Statistics are aggregated per function
+/// and per cycle head. This class is thread-safe.
+///
+/// With the interprocedural analysis, the time spent analyzing a callee is
+/// included in the transfer time of the caller.
+class FixpointTelemetry {
+public:
+  /// \brief Statistics of a fixpoint iterator
+  class Statistics final
+      : public core::FixpointStatistics< ar::BasicBlock*,
+                                         value::AbstractDomain > {
+  public:
+    /// \brief Return the number of variables and memory cells of the
+    /// normal flow
+    std::pair< std::size_t, std::size_t > state_size(
+        const value::AbstractDomain& inv) const override;
+
+  }; // end class Statistics
+
+private:
+  /// \brief Statistics of a function
+  struct FunctionStatistics {
+    /// \brief Number of fixpoints computed on the function
+    std::size_t runs = 0;
+
+    /// \brief Statistics for the whole function
+    core::FixpointCounters total;
+
+    /// \brief Statistics for each cycle head
+    llvm::DenseMap< ar::BasicBlock*, core::FixpointCounters > cycles;
+  };
+
+private:
+  /// \brief Protect the map
+  std::mutex _mutex;
+
+  /// \brief Map from function to statistics
+  llvm::DenseMap< ar::Function*, FunctionStatistics > _functions;
+
+public:
+  /// \brief Constructor
+  FixpointTelemetry();
+
+  /// \brief No copy constructor
+  FixpointTelemetry(const FixpointTelemetry&) = delete;
+
+  /// \brief No move constructor
+  FixpointTelemetry(FixpointTelemetry&&) = delete;
+
+  /// \brief No copy assignment operator
+  FixpointTelemetry& operator=(const FixpointTelemetry&) = delete;
+
+  /// \brief No move assignment operator
+  FixpointTelemetry& operator=(FixpointTelemetry&&) = delete;
+
+  /// \brief Destructor
+  ~FixpointTelemetry();
+
+  /// \brief Add the statistics of a fixpoint computed on the given function
+  void add(ar::Function* fun, const Statistics& statistics);
+
+  /// \brief Save the statistics in the given table
+  void save(FixpointStatsTable& table);
+
+}; // end class FixpointTelemetry
+
+} // end namespace analyzer
+} // end namespace ikos
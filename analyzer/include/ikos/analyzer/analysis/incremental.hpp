@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Incremental analysis, reusing the results of a previous run
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/fingerprint.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Incremental analysis, reusing the results of a previous run
+///
+/// The output database of the previous run is attached to the current output
+/// database. Functions whose fingerprint did not change since the previous run
+/// are not analyzed again, and their checks are copied from the previous
+/// database.
+///
+/// A check belongs to the function at the root of its call context, or to the
+/// function of its statement if the call context is empty. With the
+/// interprocedural analysis, only entry points are reused. With the summary
+/// analysis, the fixpoint of a reused function is still computed to build its
+/// summary, but the checks are skipped.
+///
+/// Only the rows referenced by the reused checks are copied, with their ids.
+/// Files and functions keep the id they had in the previous run, and the other
+/// ids of the current run start after the ones of the previous run. This keeps
+/// the ids referenced by the check information valid, and the output database
+/// does not grow when the analysis is chained.
+///
+/// The results are only reused if the previous run used the same analysis
+/// settings, ignoring the ones that only affect performance.
+///
+/// Functions that changed are analyzed from scratch: the fixpoint on their
+/// loops is not seeded with the invariants of the previous run. Invariants are
+/// not stored in the output database, and they refer to variables and memory
+/// locations of the previous run, which have no stable identity across runs.
+class IncrementalAnalysis {
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Path to the previous output database
+  std::string _path;
+
+  /// \brief True if the previous results can be reused
+  bool _compatible = false;
+
+  /// \brief Fingerprints of the previous run, by function name
+  llvm::StringMap< std::string > _previous;
+
+  /// \brief Functions whose results are reused
+  llvm::DenseSet< ar::Function* > _reused;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx The analysis context
+  /// \param path The path to the previous output database
+  IncrementalAnalysis(Context& ctx, std::string path);
+
+  /// \brief No copy constructor
+  IncrementalAnalysis(const IncrementalAnalysis&) = delete;
+
+  /// \brief No move constructor
+  IncrementalAnalysis(IncrementalAnalysis&&) = delete;
+
+  /// \brief No copy assignment operator
+  IncrementalAnalysis& operator=(const IncrementalAnalysis&) = delete;
+
+  /// \brief No move assignment operator
+  IncrementalAnalysis& operator=(IncrementalAnalysis&&) = delete;
+
+  /// \brief Destructor
+  ~IncrementalAnalysis();
+
+  /// \brief Load the previous output database
+  ///
+  /// This must be called before any insertion of statements, functions or
+  /// checks in the output database.
+  void load();
+
+  /// \brief Select the functions whose results are reused
+  void run(const FunctionFingerprints& fingerprints);
+
+  /// \brief Return true if the results of the given function are reused
+  bool is_reused(ar::Function* fun) const {
+    return this->_reused.count(fun) != 0;
+  }
+
+  /// \brief Copy the reused results in the output database
+  void save();
+
+}; // end class IncrementalAnalysis
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -47,6 +47,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 
@@ -375,6 +376,9 @@ public:
   DynAllocMemoryLocation* get_dyn_alloc(ar::CallBase* call,
                                         CallContext* context);
 
+  /// \brief Return the DynAllocMemoryLocation created so far
+  std::vector< DynAllocMemoryLocation* > dyn_allocs();
+
 }; // end class MemoryFactory
 
 } // end namespace analyzer
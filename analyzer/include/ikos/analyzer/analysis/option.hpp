@@ -67,6 +67,7 @@ enum class MachineIntDomainOption {
   Congruence,
   IntervalCongruence,
   DBM,
+  SparseDBM,
   VarPackDBM,
   VarPackDBMCongruence,
   Gauge,
@@ -97,6 +98,8 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
       return "interval-congruence";
     case MachineIntDomainOption::DBM:
       return "dbm";
+    case MachineIntDomainOption::SparseDBM:
+      return "sparse-dbm";
     case MachineIntDomainOption::VarPackDBM:
       return "var-pack-dbm";
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -137,13 +140,16 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
   }
 }
 
-/// \brief Either Interprocedural or Intraprocedural
+/// \brief Either Interprocedural, Intraprocedural or Summary
 enum class Procedural {
   /// \brief Analyzes function by taking into account other functions
   Interprocedural,
 
   /// \brief Analyze function independently
   Intraprocedural,
+
+  /// \brief Analyze function once, bottom-up, using summaries of the callees
+  Summary,
 };
 
 /// \brief Return a string representing a Procedural
@@ -153,6 +159,8 @@ inline const char* procedural_str(Procedural proc) {
       return "interprocedural";
     case Procedural::Intraprocedural:
       return "intraprocedural";
+    case Procedural::Summary:
+      return "summary";
     default: {
       ikos_unreachable("unreachable");
     }
@@ -290,7 +298,7 @@ public:
   /// \brief Machine integer abstract domain
   MachineIntDomainOption machine_int_domain;
 
-  /// \brief Is the analysis interprocedural or intraprocedural
+  /// \brief Is the analysis interprocedural, intraprocedural or summary-based
   Procedural procedural;
 
   /// \brief Number of threads
@@ -329,9 +337,38 @@ public:
   /// \brief Wether we should use the partitioning abstract domain or not
   bool use_partitioning_domain;
 
+  /// \brief Wether we should instantiate the memory abstract domain on the
+  /// machine integer abstract domain or use virtual dispatch
+  bool use_static_dispatch;
+
+  /// \brief Wether we should hash-cons the nodes of patricia trees or not
+  bool use_hash_consing;
+
   /// \brief Wether we should save fixpoints on called functions or not
   bool use_fixpoint_cache;
 
+  /// \brief Maximum number of memoized fixpoints on called functions
+  ///
+  /// 0 to disable the memoization of fixpoints by entry invariant
+  unsigned fixpoint_memo_size;
+
+  /// \brief Wether we should only keep the invariants of cycle heads or not
+  ///
+  /// Other invariants are recomputed when running the checks.
+  bool use_sparse_invariants;
+
+  /// \brief Wether concurrent fixpoints should use the work stealing
+  /// scheduler or not
+  bool use_work_stealing;
+
+  /// \brief Wether concurrent intraprocedural fixpoints should run the checks
+  /// on basic blocks as soon as they are stable or not
+  bool use_pipelined_checks;
+
+  /// \brief Wether statistics on the fixpoint iterations should be saved in
+  /// the output database or not
+  bool use_fixpoint_telemetry;
+
   /// \brief Wether we should perform checks or not
   bool use_checks;
 
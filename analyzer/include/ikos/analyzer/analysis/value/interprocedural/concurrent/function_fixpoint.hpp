@@ -53,6 +53,7 @@
 #include <ikos/analyzer/analysis/call_context.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/fixpoint_memo.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
@@ -76,6 +77,10 @@ private:
   /// \brief Function fixpoint cache of callees
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
 
+public:
+  /// \brief Memoized fixpoints of callees
+  using FixpointMemoT = FixpointMemo< AbstractDomain >;
+
 private:
   /// \brief Analysis context
   Context& _ctx;
@@ -104,14 +109,19 @@ private:
   /// \brief Function fixpoint cache of callees
   FixpointCacheT _callees_cache;
 
+  /// \brief Memoized fixpoints of callees, shared by all fixpoints
+  FixpointMemoT& _fixpoint_memo;
+
 public:
   /// \brief Constructor for an entry point
   ///
   /// \param ctx Analysis context
   /// \param checkers List of checkers to run
+  /// \param fixpoint_memo Memoized fixpoints of callees
   /// \param entry_point Function to analyze
   FunctionFixpoint(Context& ctx,
                    const std::vector< std::unique_ptr< Checker > >& checkers,
+                   FixpointMemoT& fixpoint_memo,
                    ar::Function* entry_point);
 
   /// \brief Constructor for a callee
@@ -172,6 +182,9 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return the memoized fixpoints of callees
+  FixpointMemoT& fixpoint_memo() const { return this->_fixpoint_memo; }
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
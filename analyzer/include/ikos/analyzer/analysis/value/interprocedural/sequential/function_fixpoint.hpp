@@ -52,6 +52,7 @@
 #include <ikos/analyzer/analysis/call_context.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/fixpoint_memo.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/progress.hpp>
@@ -74,6 +75,10 @@ private:
   /// \brief Function fixpoint cache of callees
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
 
+public:
+  /// \brief Memoized fixpoints of callees
+  using FixpointMemoT = FixpointMemo< AbstractDomain >;
+
 private:
   /// \brief Analysis context
   Context& _ctx;
@@ -99,6 +104,9 @@ private:
   /// \brief Function fixpoint cache of callees
   FixpointCacheT _callees_cache;
 
+  /// \brief Memoized fixpoints of callees, shared by all fixpoints
+  FixpointMemoT& _fixpoint_memo;
+
   /// \brief Progress logger
   ProgressLogger& _logger;
 
@@ -109,9 +117,12 @@ public:
   ///
   /// \param ctx Analysis context
   /// \param checkers List of checkers to run
+  /// \param fixpoint_memo Memoized fixpoints of callees
+  /// \param logger Progress logger
   /// \param entry_point Function to analyze
   FunctionFixpoint(Context& ctx,
                    const std::vector< std::unique_ptr< Checker > >& checkers,
+                   FixpointMemoT& fixpoint_memo,
                    ProgressLogger& logger,
                    ar::Function* entry_point);
 
@@ -186,6 +197,9 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return the memoized fixpoints of callees
+  FixpointMemoT& fixpoint_memo() const { return this->_fixpoint_memo; }
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
@@ -207,6 +221,10 @@ public:
 
   /// @}
 
+private:
+  /// \brief Run the checks on a basic block, return the post invariant
+  AbstractDomain check_block(ar::BasicBlock* bb, const AbstractDomain& pre);
+
 }; // end class FunctionFixpoint
 
 } // end namespace sequential
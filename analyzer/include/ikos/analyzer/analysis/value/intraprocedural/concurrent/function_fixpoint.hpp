@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <ikos/ar/semantic/code.hpp>
 #include <ikos/ar/semantic/function.hpp>
 
@@ -82,9 +84,25 @@ private:
   /// \brief Fixpoint parameters
   const CodeFixpointParameters& _fixpoint_parameters;
 
+  /// \brief Checkers run on stable basic blocks during the fixpoint, or null
+  const std::vector< std::unique_ptr< Checker > >* _pipelined_checkers;
+
+  /// \brief Mutex for _pipelined_checkers
+  std::mutex _checkers_mutex;
+
 public:
   /// \brief Create a function fixpoint iterator
-  FunctionFixpoint(Context& ctx, ar::Function* function);
+  ///
+  /// \param ctx Analysis context
+  /// \param function Function to analyze
+  /// \param pipelined_checkers If not null, run these checkers on each basic
+  ///   block as soon as its invariant is stable, while the fixpoint is still
+  ///   computed on the rest of the function
+  FunctionFixpoint(
+      Context& ctx,
+      ar::Function* function,
+      const std::vector< std::unique_ptr< Checker > >* pipelined_checkers =
+          nullptr);
 
   /// \brief Compute the fixpoint
   void run(AbstractDomain inv) override;
@@ -124,6 +142,12 @@ public:
   /// \brief Run the checks with the previously computed fix-point
   void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers);
 
+private:
+  /// \brief Run the checks on a basic block with the given pre invariant
+  void check_block(ar::BasicBlock* bb,
+                   const AbstractDomain& pre,
+                   const std::vector< std::unique_ptr< Checker > >& checkers);
+
 }; // end class FunctionFixpoint
 
 } // end namespace concurrent
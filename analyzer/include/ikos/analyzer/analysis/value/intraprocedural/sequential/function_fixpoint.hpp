@@ -72,6 +72,9 @@ private:
   /// \brief Analysis context
   Context& _ctx;
 
+  /// \brief Analyzed function
+  ar::Function* _function;
+
   /// \brief Empty call context
   CallContext* _empty_call_context;
 
@@ -120,6 +123,13 @@ public:
   /// \brief Run the checks with the previously computed fix-point
   void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers);
 
+private:
+  /// \brief Run the checks on a basic block, return the post invariant
+  AbstractDomain check_block(
+      ar::BasicBlock* bb,
+      const AbstractDomain& pre,
+      const std::vector< std::unique_ptr< Checker > >& checkers);
+
 }; // end class FunctionFixpoint
 
 } // end namespace sequential
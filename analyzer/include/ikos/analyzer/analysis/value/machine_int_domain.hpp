@@ -71,6 +71,9 @@ MachineIntAbstractDomain make_bottom_machine_int_interval_congruence();
 MachineIntAbstractDomain make_top_machine_int_dbm();
 MachineIntAbstractDomain make_bottom_machine_int_dbm();
 
+MachineIntAbstractDomain make_top_machine_int_sparse_dbm();
+MachineIntAbstractDomain make_bottom_machine_int_sparse_dbm();
+
 MachineIntAbstractDomain make_top_machine_int_var_pack_dbm();
 MachineIntAbstractDomain make_bottom_machine_int_var_pack_dbm();
 
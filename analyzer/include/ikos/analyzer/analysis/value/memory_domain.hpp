@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Memory abstract domains over a concrete machine integer domain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/domain/lifetime/separate_domain.hpp>
+#include <ikos/core/domain/memory/partitioning.hpp>
+#include <ikos/core/domain/memory/value.hpp>
+#include <ikos/core/domain/nullity/separate_domain.hpp>
+#include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/option.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Memory abstract domain stack over the given machine integer domain
+///
+/// The whole stack (scalar, value and partitioning domains) is instantiated on
+/// `MachineIntDomain`. When `MachineIntDomain` is a concrete domain rather
+/// than `MachineIntAbstractDomain`, copies of the machine integer abstract
+/// value are plain value copies and its operations are statically dispatched.
+template < typename MachineIntDomain >
+struct MemoryDomainStack {
+  /// \brief Uninitialized abstract domain
+  using UninitializedAbstractDomain =
+      core::uninitialized::SeparateDomain< Variable* >;
+
+  /// \brief Nullity abstract domain
+  using NullityAbstractDomain = core::nullity::SeparateDomain< Variable* >;
+
+  /// \brief Scalar abstract domain
+  using ScalarAbstractDomain =
+      core::scalar::CompositeDomain< Variable*,
+                                     MemoryLocation*,
+                                     UninitializedAbstractDomain,
+                                     MachineIntDomain,
+                                     NullityAbstractDomain >;
+
+  /// \brief Lifetime abstract domain
+  using LifetimeAbstractDomain =
+      core::lifetime::SeparateDomain< MemoryLocation* >;
+
+  /// \brief Value abstract domain
+  using ValueAbstractDomain =
+      core::memory::ValueDomain< Variable*,
+                                 MemoryLocation*,
+                                 VariableFactory*,
+                                 ScalarAbstractDomain,
+                                 LifetimeAbstractDomain >;
+
+  /// \brief Partitioning abstract domain
+  using PartitioningAbstractDomain = core::memory::
+      PartitioningDomain< Variable*, MemoryLocation*, ValueAbstractDomain >;
+
+  /// \brief Create the bottom memory abstract value
+  static MemoryAbstractDomain bottom(Context& ctx,
+                                     MachineIntDomain machine_int) {
+    return make(ctx,
+                ValueAbstractDomain(ctx.var_factory,
+                                    ScalarAbstractDomain(
+                                        UninitializedAbstractDomain::bottom(),
+                                        std::move(machine_int),
+                                        NullityAbstractDomain::bottom()),
+                                    LifetimeAbstractDomain::bottom()));
+  }
+
+  /// \brief Create the top memory abstract value
+  static MemoryAbstractDomain top(Context& ctx, MachineIntDomain machine_int) {
+    return make(ctx,
+                ValueAbstractDomain(ctx.var_factory,
+                                    ScalarAbstractDomain(
+                                        UninitializedAbstractDomain::top(),
+                                        std::move(machine_int),
+                                        NullityAbstractDomain::top()),
+                                    LifetimeAbstractDomain::top()));
+  }
+
+private:
+  /// \brief Wrap the given value abstract value
+  static MemoryAbstractDomain make(Context& ctx, ValueAbstractDomain inv) {
+    if (ctx.opts.use_partitioning_domain) {
+      return MemoryAbstractDomain(PartitioningAbstractDomain(std::move(inv)));
+    } else {
+      return MemoryAbstractDomain(std::move(inv));
+    }
+  }
+};
+
+/// \name Constructors of statically dispatched memory abstract domains
+/// @{
+
+MemoryAbstractDomain make_top_memory_interval(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_interval(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_congruence(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_congruence(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_interval_congruence(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_interval_congruence(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_dbm(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_dbm(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_sparse_dbm(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_sparse_dbm(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_var_pack_dbm(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_var_pack_dbm(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_var_pack_dbm_congruence(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_var_pack_dbm_congruence(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_gauge(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_gauge(Context& ctx);
+
+MemoryAbstractDomain make_top_memory_gauge_interval_congruence(Context& ctx);
+MemoryAbstractDomain make_bottom_memory_gauge_interval_congruence(
+    Context& ctx);
+
+/// @}
+
+/// \brief Return true if the given machine integer abstract domain has a
+/// statically dispatched memory abstract domain
+bool has_static_memory_abstract_value(MachineIntDomainOption domain);
+
+/// \brief Create the top memory abstract value, statically dispatched on the
+/// machine integer abstract domain `ctx.opts.machine_int_domain`
+///
+/// Requires `has_static_memory_abstract_value(ctx.opts.machine_int_domain)`
+MemoryAbstractDomain make_top_static_memory_abstract_value(Context& ctx);
+
+/// \brief Create the bottom memory abstract value, statically dispatched on the
+/// machine integer abstract domain `ctx.opts.machine_int_domain`
+///
+/// Requires `has_static_memory_abstract_value(ctx.opts.machine_int_domain)`
+MemoryAbstractDomain make_bottom_static_memory_abstract_value(Context& ctx);
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
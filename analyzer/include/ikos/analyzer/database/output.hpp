@@ -47,11 +47,14 @@
 #include <ikos/analyzer/database/table/call_contexts.hpp>
 #include <ikos/analyzer/database/table/checks.hpp>
 #include <ikos/analyzer/database/table/files.hpp>
+#include <ikos/analyzer/database/table/fingerprints.hpp>
+#include <ikos/analyzer/database/table/fixpoint_stats.hpp>
 #include <ikos/analyzer/database/table/functions.hpp>
 #include <ikos/analyzer/database/table/memory_locations.hpp>
 #include <ikos/analyzer/database/table/operands.hpp>
 #include <ikos/analyzer/database/table/settings.hpp>
 #include <ikos/analyzer/database/table/statements.hpp>
+#include <ikos/analyzer/database/table/stats.hpp>
 #include <ikos/analyzer/database/table/times.hpp>
 
 namespace ikos {
@@ -63,6 +66,7 @@ public:
   sqlite::DbConnection& db;
   SettingsTable settings;
   TimesTable times;
+  StatsTable stats;
   FilesTable files;
   FunctionsTable functions;
   StatementsTable statements;
@@ -70,10 +74,18 @@ public:
   CallContextsTable call_contexts;
   MemoryLocationsTable memory_locations;
   ChecksTable checks;
+  FixpointStatsTable fixpoint_stats;
+  FingerprintsTable fingerprints;
 
 public:
   /// \brief Constructor
-  explicit OutputDatabase(sqlite::DbConnection& db_);
+  ///
+  /// \param db_ Database connection
+  /// \param commit_policy Commit policy used to insert rows, either
+  /// CommitPolicy::Background (thread-safe) or CommitPolicy::Auto
+  explicit OutputDatabase(
+      sqlite::DbConnection& db_,
+      sqlite::CommitPolicy commit_policy = sqlite::CommitPolicy::Background);
 
 }; // end class OutputDatabase
 
@@ -45,11 +45,19 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <sqlite3.h>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <llvm/ADT/ArrayRef.h>
 
 #include <ikos/analyzer/exception.hpp>
@@ -146,8 +154,78 @@ enum class CommitPolicy {
   /// \brief Automatically start new transactions every MaxRowsPerTransaction
   /// inserted rows
   Auto = 1,
+
+  /// \brief Buffer rows per thread and insert them from a single background
+  /// writer thread, in transactions of MaxRowsPerTransaction rows
+  ///
+  /// In this mode, DbOstream can be used concurrently from multiple threads.
+  Background = 2,
 };
 
+/// \brief Text column value serialized only when it is inserted
+///
+/// In CommitPolicy::Background, str() is called by the writer thread, which
+/// keeps the serialization cost off the threads inserting rows.
+class DbDeferredText {
+public:
+  /// \brief Return the text to insert
+  virtual std::string str() const = 0;
+
+  /// \brief Destructor
+  virtual ~DbDeferredText() = default;
+
+}; // end class DbDeferredText
+
+/// \brief Column value, buffered in memory before being inserted
+class DbValue {
+public:
+  /// \brief Kind of value
+  enum class Kind { Null, Integer, Real, Text, DeferredText };
+
+private:
+  Kind _kind;
+  DbInt64 _integer = 0;
+  DbDouble _real = 0.0;
+  std::string _text;
+  std::unique_ptr< const DbDeferredText > _deferred_text;
+
+public:
+  /// \brief Create a NULL value
+  DbValue() : _kind(Kind::Null) {}
+
+  /// \brief Create an integer value
+  explicit DbValue(DbInt64 n) : _kind(Kind::Integer), _integer(n) {}
+
+  /// \brief Create a double value
+  explicit DbValue(DbDouble d) : _kind(Kind::Real), _real(d) {}
+
+  /// \brief Create a string value
+  explicit DbValue(StringRef s) : _kind(Kind::Text), _text(s.to_string()) {}
+
+  /// \brief Create a deferred string value
+  explicit DbValue(std::unique_ptr< const DbDeferredText > t)
+      : _kind(Kind::DeferredText), _deferred_text(std::move(t)) {}
+
+  /// \brief Return the kind of value
+  Kind kind() const { return this->_kind; }
+
+  /// \brief Return the integer value
+  DbInt64 integer() const { return this->_integer; }
+
+  /// \brief Return the double value
+  DbDouble real() const { return this->_real; }
+
+  /// \brief Return the string value
+  const std::string& text() const { return this->_text; }
+
+  /// \brief Return the deferred string value
+  const DbDeferredText& deferred_text() const { return *this->_deferred_text; }
+
+}; // end class DbValue
+
+// forward declaration
+class DbOstream;
+
 /// \brief SQLite connection
 class DbConnection {
 public:
@@ -167,6 +245,39 @@ private:
   /// \brief Number of inserted rows, in CommitPolicy::Auto
   std::size_t _inserted_rows = 0;
 
+  /// \brief Batch of rows waiting for the writer thread
+  struct PendingBatch {
+    DbOstream* stream;
+    std::vector< DbValue > values;
+  };
+
+  /// \brief Output streams on this connection
+  std::vector< DbOstream* > _streams;
+
+  /// \brief Writer thread, in CommitPolicy::Background
+  std::thread _writer;
+
+  /// \brief Mutex for the writer state below
+  std::mutex _writer_mutex;
+
+  /// \brief Notified when a batch is submitted or the writer should stop
+  std::condition_variable _writer_wakeup;
+
+  /// \brief Notified when the writer thread has no more pending batches
+  std::condition_variable _writer_idle;
+
+  /// \brief Batches waiting to be inserted
+  std::deque< PendingBatch > _pending;
+
+  /// \brief True if the writer thread is inserting a batch
+  bool _writer_busy = false;
+
+  /// \brief True if the writer thread should stop
+  bool _writer_stop = false;
+
+  /// \brief First error raised in the writer thread
+  std::exception_ptr _writer_error;
+
 public:
   /// \brief No default constructor
   DbConnection() = delete;
@@ -213,10 +324,35 @@ public:
   /// \brief Return the current commit policy
   CommitPolicy commit_policy() const { return this->_commit_policy; }
 
+  /// \brief Insert all the rows buffered in CommitPolicy::Background
+  ///
+  /// This must not be called while other threads are inserting rows.
+  void flush();
+
 private:
   /// \brief Called upon a row insertion
   void row_inserted();
 
+  /// \brief Start the writer thread
+  void start_writer();
+
+  /// \brief Flush the buffered rows and stop the writer thread
+  void stop_writer();
+
+  /// \brief Main loop of the writer thread
+  void run_writer();
+
+  /// \brief Submit a batch of rows to the writer thread
+  void submit(DbOstream* stream, std::vector< DbValue > values);
+
+  /// \brief Wait until the writer thread inserted all submitted batches
+  void wait_writer();
+
+  /// \brief Rethrow the error raised in the writer thread, if any
+  ///
+  /// Precondition: the current thread owns the writer mutex
+  void check_writer_error();
+
 public:
   /// \brief Remove a table
   void drop_table(StringRef name);
@@ -247,7 +383,15 @@ public:
 }; // end class DbConnection
 
 /// \brief Stream-based interface for populating tables
+///
+/// In CommitPolicy::Background, rows are stored in a per-thread buffer and
+/// handed to the writer thread of the connection every MaxRowsPerBatch rows.
 class DbOstream {
+public:
+  /// \brief Maximum number of rows buffered per thread, in
+  /// CommitPolicy::Background
+  static const int MaxRowsPerBatch = 1024;
+
 private:
   /// \brief Database connection
   DbConnection& _db;
@@ -261,6 +405,9 @@ private:
   /// \brief Current number of column entered
   int _current_column = 1;
 
+  /// \brief Buffered values of each thread, in CommitPolicy::Background
+  tbb::enumerable_thread_specific< std::vector< DbValue > > _buffers;
+
 public:
   /// \brief No default constructor
   DbOstream() = delete;
@@ -291,6 +438,9 @@ public:
   /// \brief Insert a string
   void add(StringRef s);
 
+  /// \brief Insert a string serialized only when the row is written
+  void add(std::unique_ptr< const DbDeferredText > t);
+
   /// \brief Insert NULL
   void add_null();
 
@@ -303,7 +453,28 @@ public:
   /// \brief Flush the row
   void flush();
 
+private:
+  /// \brief Return true if rows are buffered for the writer thread
+  bool is_buffered() const {
+    return this->_db._commit_policy == CommitPolicy::Background;
+  }
+
+  /// \brief Bind a value to the given column of the prepared statement
+  void bind(int column, const DbValue& value);
+
+  /// \brief Execute the prepared statement, inserting one row
+  void step();
+
+  /// \brief Insert the given rows, called by the writer thread
+  void write(const std::vector< DbValue >& values);
+
+  /// \brief Submit all the per-thread buffers to the writer thread
+  ///
+  /// This must not be called while other threads are inserting rows.
+  void submit_buffers();
+
   // friends
+  friend class DbConnection;
   friend DbOstream& end_row(DbOstream&);
 
 }; // end class DbOstream
@@ -314,6 +485,13 @@ inline DbOstream& operator<<(DbOstream& o, StringRef s) {
   return o;
 }
 
+/// \brief Insert a string serialized only when the row is written
+inline DbOstream& operator<<(DbOstream& o,
+                             std::unique_ptr< const DbDeferredText > t) {
+  o.add(std::move(t));
+  return o;
+}
+
 /// \brief Mark the end of a row
 inline DbOstream& end_row(DbOstream& o) {
   o.flush();
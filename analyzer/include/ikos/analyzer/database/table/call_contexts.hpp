@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/analyzer/analysis/call_context.hpp>
@@ -71,6 +73,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _map and _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit CallContextsTable(sqlite::DbConnection& db,
@@ -80,6 +85,11 @@ public:
   /// \brief Insert the given call context in the database and return the id
   sqlite::DbInt64 insert(CallContext* call_context);
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
 }; // end class CallContextsTable
 
 } // end namespace analyzer
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/checker/kind.hpp>
 #include <ikos/analyzer/checker/name.hpp>
@@ -71,7 +73,7 @@ private:
   sqlite::DbOstream _row;
 
   /// \brief Last inserted id
-  sqlite::DbInt64 _last_insert_id = 0;
+  std::atomic< sqlite::DbInt64 > _last_insert_id{0};
 
 public:
   /// \brief Constructor
@@ -81,6 +83,8 @@ public:
                        CallContextsTable& call_contexts);
 
   /// \brief Insert a check in the database
+  ///
+  /// This is thread-safe if the database is in CommitPolicy::Background.
   void insert(CheckKind kind,
               CheckerName checker,
               Result status,
@@ -89,6 +93,11 @@ public:
               llvm::ArrayRef< ar::Value* > operands = {},
               const JsonDict& info = {});
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
 }; // end class ChecksTable
 
 } // end namespace analyzer
@@ -43,11 +43,14 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/IR/DebugInfoMetadata.h>
 
 #include <ikos/analyzer/database/table.hpp>
+#include <ikos/analyzer/util/source_location.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -64,9 +67,16 @@ private:
   /// \brief Map from full path to id
   llvm::StringMap< sqlite::DbInt64 > _path_map;
 
+  /// \brief Map from full path to the id of a previous analysis
+  llvm::StringMap< sqlite::DbInt64 > _previous_ids;
+
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _di_file_map, _path_map, _previous_ids and
+  /// _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit FilesTable(sqlite::DbConnection& db);
@@ -74,6 +84,30 @@ public:
   /// \brief Insert the given file in the database and return the id
   sqlite::DbInt64 insert(llvm::DIFile* file);
 
+  /// \brief Insert the file with the given absolute path in the database and
+  /// return the id
+  sqlite::DbInt64 insert(const boost::filesystem::path& path);
+
+  /// \brief Insert the file of the given source location in the database and
+  /// return the id
+  sqlite::DbInt64 insert(const SourceLocation& loc);
+
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
+  /// \brief Use the given id if the file with the given path is inserted
+  ///
+  /// This is used to keep the ids of a previous analysis.
+  void reuse_id(const std::string& path, sqlite::DbInt64 id);
+
+private:
+  /// \brief Insert the given path in the database and return the id
+  ///
+  /// Precondition: _mutex is locked
+  sqlite::DbInt64 insert_path(const std::string& path);
+
 }; // end class FilesTable
 
 } // end namespace analyzer
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Function.h>
 
@@ -67,9 +69,15 @@ private:
   /// \brief Map from ar::Function* to id
   llvm::DenseMap< ar::Function*, sqlite::DbInt64 > _map;
 
+  /// \brief Map from function name to the id of a previous analysis
+  llvm::StringMap< sqlite::DbInt64 > _previous_ids;
+
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _map, _previous_ids and _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   FunctionsTable(sqlite::DbConnection& db, FilesTable& files);
@@ -77,6 +85,16 @@ public:
   /// \brief Insert the given function in the database and return the id
   sqlite::DbInt64 insert(ar::Function* fun);
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
+  /// \brief Use the given id if the function with the given name is inserted
+  ///
+  /// This is used to keep the ids of a previous analysis.
+  void reuse_id(const std::string& name, sqlite::DbInt64 id);
+
   /// \brief Return the name of the ar::Function used in the database
   ///
   /// The returned function name might be mangled
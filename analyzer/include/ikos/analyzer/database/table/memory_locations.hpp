@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/analyzer/analysis/memory_location.hpp>
@@ -76,6 +78,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _map and _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit MemoryLocationsTable(sqlite::DbConnection& db,
@@ -86,6 +91,11 @@ public:
   /// \brief Insert the given memory location in the database and return the id
   sqlite::DbInt64 insert(MemoryLocation* mem_loc);
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
   /// \brief Return the json info for the given memory location
   JsonDict info(MemoryLocation* mem_loc);
 
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Constant.h>
 #include <llvm/IR/Type.h>
@@ -67,6 +69,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _map and _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit OperandsTable(sqlite::DbConnection& db);
@@ -74,6 +79,11 @@ public:
   /// \brief Insert the given operand in the database and return the id
   sqlite::DbInt64 insert(ar::Value* value);
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
   /// \brief Return a textual representation of a llvm::Type
   static std::string repr(llvm::Type* type);
 
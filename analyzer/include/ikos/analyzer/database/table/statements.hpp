@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/ar/semantic/statement.hpp>
@@ -72,6 +74,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex for _map and _last_insert_id
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   StatementsTable(sqlite::DbConnection& db,
@@ -81,6 +86,11 @@ public:
   /// \brief Insert the given statement in the database and return the id
   sqlite::DbInt64 insert(ar::Statement* stmt);
 
+  /// \brief Start the ids of the rows inserted from now on at the given value
+  ///
+  /// This is used to append rows to the ones of a previous analysis.
+  void set_first_id(sqlite::DbInt64 id);
+
 }; // end class StatementsTable
 
 } // end namespace analyzer
@@ -149,11 +149,61 @@ def parse_arguments(argv):
                           help='Disable the widening hint analysis',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--no-static-dispatch',
+                          dest='no_static_dispatch',
+                          help='Use virtual dispatch for the machine integer'
+                               ' abstract domain',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--hash-consing',
+                          dest='hash_consing',
+                          help='Share structurally equal subtrees of abstract'
+                               ' states and memoize binary operations',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--no-fixpoint-cache',
                           dest='no_fixpoint_cache',
                           help='Disable the cache of fixpoints',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--fixpoint-memo-size',
+                          dest='fixpoint_memo_size',
+                          metavar='',
+                          help='Maximum number of fixpoints on called functions'
+                               ' memoized by entry invariant (default: 0,'
+                               ' disabled)',
+                          default=0,
+                          type=int)
+    analysis.add_argument('--sparse-invariants',
+                          dest='sparse_invariants',
+                          help='Only keep the invariants of cycle heads,'
+                               ' recompute the others when running the checks',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--work-stealing',
+                          dest='work_stealing',
+                          help='Schedule basic blocks with work stealing in'
+                               ' concurrent analyses',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--pipelined-checks',
+                          dest='pipelined_checks',
+                          help='Check basic blocks as soon as their invariants'
+                               ' are stable in the concurrent intraprocedural'
+                               ' analysis',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--fixpoint-telemetry',
+                          dest='fixpoint_telemetry',
+                          help='Save statistics on the fixpoint iterations of'
+                               ' each function and loop',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--incremental-db',
+                          dest='incremental_db',
+                          metavar='<file>',
+                          help='Reuse the results of the unchanged functions'
+                               ' from the output database of a previous run')
     analysis.add_argument('--no-checks',
                           dest='no_checks',
                           help='Disable all the checks',
@@ -313,6 +363,12 @@ def parse_arguments(argv):
                               '(__ikos_assert, etc.)',
                          action='store_true',
                          default=False)
+    imports.add_argument('--no-prune-unreachable',
+                         dest='no_prune_unreachable',
+                         help='Import the functions unreachable from the '
+                              'entry points',
+                         action='store_true',
+                         default=False)
 
     # AR passes options
     passes = parser.add_argument_group('AR Passes Options')
@@ -509,6 +565,13 @@ def parse_arguments(argv):
                                        default=args.default_analyses,
                                        value=opt.analyses)
 
+    # the output database is removed before the analysis
+    if (opt.incremental_db and
+            os.path.abspath(opt.incremental_db) ==
+            os.path.abspath(opt.output_db)):
+        parser.error('--incremental-db must be different from the output'
+                     ' database')
+
     # by default, the entry point is main
     if not opt.entry_points:
         opt.entry_points = ('main',)
@@ -628,6 +691,12 @@ def is_apron_domain(domain):
     return 'apron-' in domain
 
 
+def is_apron_ppl_domain(domain):
+    ''' Return True if the given domain is an APRON domain relying on PPL '''
+    return (is_apron_domain(domain) and
+            ('ppl-' in domain or 'pkgrid-' in domain))
+
+
 domains_without_narrowing = (
     'apron-polka-polyhedra',
     'apron-polka-linear-equalities',
@@ -754,9 +823,13 @@ class AnalyzerError(Exception):
 def ikos_analyzer(db_path, pp_path, opt):
     if settings.BUILD_MODE == 'Debug':
         log.warning('ikos was built in debug mode, the analysis might be slow')
-    if is_apron_domain(opt.domain) and opt.jobs != 1:
-        log.warning('apron abstract domains are not thread-safe, '
+    if is_apron_ppl_domain(opt.domain) and opt.jobs != 1:
+        log.warning('apron abstract domains based on PPL are not thread-safe, '
                     'the analysis might crash')
+    if (opt.fixpoint_telemetry and opt.jobs != 1 and
+            opt.procedural != 'summary'):
+        log.warning('--fixpoint-telemetry is ignored by the concurrent '
+                    'analyses, use --jobs=1 to record fixpoint statistics')
 
     # Fix huge slow down when ikos-analyzer uses DROP TABLE on an existing db
     if os.path.isfile(db_path):
@@ -804,8 +877,24 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-no-widening-hints')
     if opt.partitioning != 'no':
         cmd.append('-enable-partitioning-domain')
+    if opt.no_static_dispatch:
+        cmd.append('-no-static-dispatch')
+    if opt.hash_consing:
+        cmd.append('-hash-consing')
     if opt.no_fixpoint_cache:
         cmd.append('-no-fixpoint-cache')
+    if opt.fixpoint_memo_size > 0:
+        cmd.append('-fixpoint-memo-size=%d' % opt.fixpoint_memo_size)
+    if opt.sparse_invariants:
+        cmd.append('-sparse-invariants')
+    if opt.work_stealing:
+        cmd.append('-work-stealing')
+    if opt.pipelined_checks:
+        cmd.append('-pipelined-checks')
+    if opt.fixpoint_telemetry:
+        cmd.append('-fixpoint-telemetry')
+    if opt.incremental_db:
+        cmd.append('-incremental-db=%s' % opt.incremental_db)
     if opt.no_checks:
         cmd.append('-no-checks')
     if opt.hardware_addresses:
@@ -825,6 +914,8 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-no-libcpp')
     if opt.no_libikos:
         cmd.append('-no-libikos')
+    if opt.no_prune_unreachable:
+        cmd.append('-no-prune-unreachable')
 
     # AR passes options
     if opt.no_type_check:
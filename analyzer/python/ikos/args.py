@@ -206,6 +206,8 @@ domains = (
      'Reduced product of Interval and Congruence'),
     ('dbm',
      'Difference-Bound Matrices domain'),
+    ('sparse-dbm',
+     'Difference-Bound Matrices domain in sparse representation'),
     ('var-pack-dbm',
      'Difference-Bound Matrices domain with variable packing'),
     ('var-pack-dbm-congruence',
@@ -257,6 +259,7 @@ default_globals_init_policy = 'skip-big-arrays'
 proceduralities = (
     ('inter', 'Interprocedural analysis'),
     ('intra', 'Intraprocedural analysis'),
+    ('summary', 'Bottom-up function summary analysis'),
 )
 
 default_procedurality = 'inter'
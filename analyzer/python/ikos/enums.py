@@ -379,3 +379,19 @@ class ChecksTable:
     OPERANDS = auto()
     CALL_CONTEXT_ID = auto()
     INFO = auto()
+
+
+class FixpointStatsTable:
+    FUNCTION_ID = auto(reset=0)
+    STATEMENT_ID = auto()
+    RUNS = auto()
+    INCREASING_ITERATIONS = auto()
+    DECREASING_ITERATIONS = auto()
+    WIDENINGS = auto()
+    NARROWINGS = auto()
+    TRANSFER_TIME = auto()
+    JOIN_TIME = auto()
+    WIDENING_TIME = auto()
+    NARROWING_TIME = auto()
+    MAX_VARIABLES = auto()
+    MAX_CELLS = auto()
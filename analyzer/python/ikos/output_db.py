@@ -44,7 +44,8 @@ import json
 import sqlite3
 
 from ikos.enums import FilesTable, FunctionsTable, StatementsTable, \
-    CallContextsTable, OperandsTable, MemoryLocationsTable, ChecksTable
+    CallContextsTable, OperandsTable, MemoryLocationsTable, ChecksTable, \
+    FixpointStatsTable
 
 
 class CachedProperty(object):
@@ -111,6 +112,22 @@ class OutputDatabase(object):
         c.executemany('INSERT INTO times VALUES (?, ?)', rows)
         self.con.commit()
 
+    def load_fixpoint_stats(self):
+        '''
+        Load the fixpoint statistics from the database,
+        as a list of FixpointStats sorted by decreasing time
+        '''
+        c = self.con.cursor()
+        c.execute("SELECT name FROM sqlite_master "
+                  "WHERE type = 'table' AND name = 'fixpoint_stats'")
+        if c.fetchone() is None:
+            return []
+
+        c.execute('SELECT * FROM fixpoint_stats')
+        stats = [FixpointStats(row, self) for row in c]
+        stats.sort(key=lambda s: s.time(), reverse=True)
+        return stats
+
     @CachedProperty
     def files(self):
         return self._fetch_table('files', File)
@@ -388,3 +405,62 @@ class Check(object):
         operands = json.loads(self.operands)
         return [NumOperandPair(num, self.db.operands[id])
                 for num, id in operands]
+
+
+class FixpointStats(object):
+    ''' Represents the fixpoint statistics of a function, or of a loop '''
+
+    __slots__ = (
+        'function_id',
+        'statement_id',
+        'runs',
+        'increasing_iterations',
+        'decreasing_iterations',
+        'widenings',
+        'narrowings',
+        'transfer_time',
+        'join_time',
+        'widening_time',
+        'narrowing_time',
+        'max_variables',
+        'max_cells',
+        'db'
+    )
+
+    def __init__(self, row, db):
+        self.function_id = row[FixpointStatsTable.FUNCTION_ID]
+        self.statement_id = row[FixpointStatsTable.STATEMENT_ID]  # or None
+        self.runs = row[FixpointStatsTable.RUNS]
+        self.increasing_iterations = \
+            row[FixpointStatsTable.INCREASING_ITERATIONS]
+        self.decreasing_iterations = \
+            row[FixpointStatsTable.DECREASING_ITERATIONS]
+        self.widenings = row[FixpointStatsTable.WIDENINGS]
+        self.narrowings = row[FixpointStatsTable.NARROWINGS]
+        self.transfer_time = row[FixpointStatsTable.TRANSFER_TIME]
+        self.join_time = row[FixpointStatsTable.JOIN_TIME]
+        self.widening_time = row[FixpointStatsTable.WIDENING_TIME]
+        self.narrowing_time = row[FixpointStatsTable.NARROWING_TIME]
+        self.max_variables = row[FixpointStatsTable.MAX_VARIABLES]
+        self.max_cells = row[FixpointStatsTable.MAX_CELLS]
+        self.db = db
+
+    def is_loop(self):
+        ''' Return True if these are the statistics of a loop '''
+        return self.statement_id is not None
+
+    def function(self):
+        ''' Return the function '''
+        return self.db.functions[self.function_id]
+
+    def statement(self):
+        ''' Return the first statement of the loop head, or None '''
+        if self.statement_id is None:
+            return None
+
+        return self.db.statements[self.statement_id]
+
+    def time(self):
+        ''' Return the total time, in seconds '''
+        return (self.transfer_time + self.join_time + self.widening_time +
+                self.narrowing_time)
@@ -110,6 +110,67 @@ def print_timing_results(db, full=True, sort=True):
         printf('%s: %s\n', name.ljust(name_width), format_time(elapsed))
 
 
+##################
+# fixpoint stats #
+##################
+
+
+def fixpoint_stats_location(stats):
+    ''' Return the location of a function or a loop, as a string '''
+    if stats.is_loop():
+        statement = stats.statement()
+        path = format_path(statement.file_path()) or '<unknown>'
+        if statement.line is not None:
+            return '%s:%d' % (path, statement.line)
+        return path
+
+    function = stats.function()
+    path = format_path(function.file_path()) or '<unknown>'
+    if function.line is not None:
+        return '%s:%d' % (path, function.line)
+    return path
+
+
+def print_fixpoint_stats_rows(title, rows):
+    ''' Print a list of fixpoint statistics '''
+    printf(bold(title) + '\n')
+
+    if not rows:
+        printf('No fixpoint statistics, run ikos with --fixpoint-telemetry\n')
+
+    for s in rows:
+        printf('%s: %s in %s\n',
+               fixpoint_stats_location(s),
+               bold(format_time(s.time())),
+               s.function().pretty_name())
+        printf('  runs: %d, iterations: %d increasing, %d decreasing, '
+               'widenings: %d, narrowings: %d\n',
+               s.runs,
+               s.increasing_iterations,
+               s.decreasing_iterations,
+               s.widenings,
+               s.narrowings)
+        printf('  transfer: %s, join: %s, widening: %s, narrowing: %s\n',
+               format_time(s.transfer_time),
+               format_time(s.join_time),
+               format_time(s.widening_time),
+               format_time(s.narrowing_time))
+        printf('  max state size: %d variables, %d memory cells\n',
+               s.max_variables,
+               s.max_cells)
+
+
+def print_fixpoint_stats(db, limit):
+    ''' Print the most expensive functions and loops from the database '''
+    stats = db.load_fixpoint_stats()
+    functions = [s for s in stats if not s.is_loop()]
+    loops = [s for s in stats if s.is_loop()]
+
+    print_fixpoint_stats_rows('# Hottest functions:', functions[:limit])
+    printf('\n')
+    print_fixpoint_stats_rows('# Hottest loops:', loops[:limit])
+
+
 ###########
 # summary #
 ###########
@@ -2130,6 +2191,14 @@ def parse_arguments(argv):
                         help='Display analysis raw checks',
                         action='store_true',
                         default=False)
+    parser.add_argument('--fixpoint-stats',
+                        dest='fixpoint_stats',
+                        metavar='N',
+                        help='Display the N functions and loops with the most'
+                             ' expensive fixpoints (see ikos'
+                             ' --fixpoint-telemetry)',
+                        default=0,
+                        type=int)
     parser.add_argument('-f', '--format',
                         dest='format',
                         metavar='',
@@ -2253,6 +2322,13 @@ def main(argv):
             print_raw_checks(db, settings['procedural'] == 'interprocedural')
             first = False
 
+        # display fixpoint statistics
+        if opt.fixpoint_stats > 0:
+            if not first:
+                printf('\n')
+            print_fixpoint_stats(db, opt.fixpoint_stats)
+            first = False
+
         # start ikos-view
         if opt.format == 'web':
             ikos_view(opt, db)
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Call graph of a bundle
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/pointer/function.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief Compute the strongly connected components of the call graph
+class StronglyConnectedComponents {
+private:
+  /// \brief Call graph
+  const CallGraph& _graph;
+
+  /// \brief Depth-first search index of each visited function
+  llvm::DenseMap< ar::Function*, unsigned > _index;
+
+  /// \brief Lowest index reachable from each function
+  llvm::DenseMap< ar::Function*, unsigned > _low_link;
+
+  /// \brief Stack of functions of the components in progress
+  llvm::SetVector< ar::Function* > _stack;
+
+  /// \brief Resulting components
+  std::vector< std::vector< ar::Function* > > _components;
+
+public:
+  /// \brief Constructor
+  explicit StronglyConnectedComponents(const CallGraph& graph)
+      : _graph(graph) {}
+
+  /// \brief Compute the strongly connected components
+  std::vector< std::vector< ar::Function* > > run(
+      const std::vector< ar::Function* >& functions) {
+    for (ar::Function* function : functions) {
+      if (this->_index.count(function) == 0) {
+        this->visit(function);
+      }
+    }
+    return std::move(this->_components);
+  }
+
+private:
+  /// \brief Visit a function
+  ///
+  /// The traversal is iterative to avoid stack overflows on deep call graphs.
+  void visit(ar::Function* root) {
+    using Frame = std::pair< ar::Function*, unsigned >;
+    std::vector< Frame > frames;
+
+    auto push = [&](ar::Function* function) {
+      unsigned index = this->_index.size();
+      this->_index[function] = index;
+      this->_low_link[function] = index;
+      this->_stack.insert(function);
+      frames.emplace_back(function, 0);
+    };
+
+    push(root);
+
+    while (!frames.empty()) {
+      ar::Function* function = frames.back().first;
+      const auto& callees = this->_graph.find(function)->second;
+
+      if (frames.back().second < callees.size()) {
+        ar::Function* callee = callees[frames.back().second++];
+
+        if (this->_index.count(callee) == 0) {
+          push(callee);
+        } else if (this->_stack.count(callee) != 0) {
+          this->_low_link[function] =
+              std::min(this->_low_link[function], this->_index[callee]);
+        }
+        continue;
+      }
+
+      frames.pop_back();
+
+      if (!frames.empty()) {
+        ar::Function* caller = frames.back().first;
+        this->_low_link[caller] =
+            std::min(this->_low_link[caller], this->_low_link[function]);
+      }
+
+      if (this->_low_link[function] == this->_index[function]) {
+        std::vector< ar::Function* > component;
+        ar::Function* member = nullptr;
+        do {
+          member = this->_stack.pop_back_val();
+          component.push_back(member);
+        } while (member != function);
+        this->_components.push_back(std::move(component));
+      }
+    }
+  }
+
+}; // end class StronglyConnectedComponents
+
+} // end anonymous namespace
+
+std::vector< std::vector< ar::Function* > > strongly_connected_components(
+    const CallGraph& graph, const std::vector< ar::Function* >& functions) {
+  return StronglyConnectedComponents(graph).run(functions);
+}
+
+CallGraph build_call_graph(Context& ctx) {
+  CallGraph graph;
+
+  for (auto it = ctx.bundle->function_begin(),
+            et = ctx.bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* function = *it;
+
+    if (!function->is_definition()) {
+      continue;
+    }
+
+    auto& callees = graph[function];
+
+    for (ar::BasicBlock* bb : *function->body()) {
+      for (ar::Statement* stmt : *bb) {
+        auto call = dyn_cast< ar::CallBase >(stmt);
+        if (call == nullptr) {
+          continue;
+        }
+
+        ar::Value* called = call->called();
+        if (auto cst = dyn_cast< ar::FunctionPointerConstant >(called)) {
+          if (cst->function()->is_definition()) {
+            callees.insert(cst->function());
+          }
+        } else if (auto ptr = dyn_cast< ar::InternalVariable >(called)) {
+          if (ctx.function_pointer == nullptr) {
+            continue;
+          }
+
+          PointsToSet points_to =
+              ctx.function_pointer->results()
+                  .get(ctx.var_factory->get_internal(ptr))
+                  .points_to();
+
+          if (points_to.is_top() || points_to.is_bottom()) {
+            continue;
+          }
+
+          for (MemoryLocation* mem : points_to) {
+            if (auto fun_mem = dyn_cast< FunctionMemoryLocation >(mem)) {
+              if (fun_mem->function()->is_definition()) {
+                callees.insert(fun_mem->function());
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return graph;
+}
+
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,403 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fingerprints of the functions, for incremental analyses
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+
+#include <ikos/ar/format/text.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/fingerprint.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/global_variable.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/database/table/fingerprints.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/source_location.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief 64-bit FNV-1a hash
+///
+/// Unlike std::hash, the result does not depend on the standard library.
+class StableHash {
+private:
+  uint64_t _value = 14695981039346656037ULL;
+
+public:
+  /// \brief Add a byte
+  void add_byte(uint8_t byte) {
+    this->_value ^= byte;
+    this->_value *= 1099511628211ULL;
+  }
+
+  /// \brief Add an integer
+  void add(uint64_t n) {
+    for (unsigned i = 0; i < 8; i++) {
+      this->add_byte(static_cast< uint8_t >(n >> (8 * i)));
+    }
+  }
+
+  /// \brief Add a string
+  void add(StringRef s) {
+    this->add(static_cast< uint64_t >(s.size()));
+    for (char c : s) {
+      this->add_byte(static_cast< uint8_t >(c));
+    }
+  }
+
+  /// \brief Return the hash
+  uint64_t value() const { return this->_value; }
+
+}; // end class StableHash
+
+/// \brief Add a source location to the hash
+void add_location(StableHash& hash, const SourceLocation& loc) {
+  if (loc) {
+    hash.add(loc.path().string());
+    hash.add(static_cast< uint64_t >(loc.line()));
+    hash.add(static_cast< uint64_t >(loc.column()));
+  } else {
+    hash.add(static_cast< uint64_t >(0));
+  }
+}
+
+/// \brief Add the source locations of a function to the hash
+///
+/// source_location() looks for the location of a statement without debug
+/// information in the following instructions, which is quadratic in the size
+/// of a basic block. Instead, hash the debug locations of all the llvm
+/// instructions, which determine the locations of the statements.
+void add_locations(StableHash& hash, ar::Function* fun) {
+  if (!fun->has_frontend()) {
+    return;
+  }
+
+  if (fun->frontend_isa< ar::SourceInfo >()) {
+    // Loaded from the AR binary format, the locations were resolved on export
+    for (ar::BasicBlock* bb : *fun->body()) {
+      for (ar::Statement* stmt : *bb) {
+        if (stmt->frontend_isa< ar::SourceInfo >()) {
+          add_location(hash, source_location(stmt));
+        }
+      }
+    }
+    return;
+  }
+
+  for (llvm::Instruction& inst :
+       llvm::instructions(fun->frontend< llvm::Function >())) {
+    if (llvm::DILocation* loc = inst.getDebugLoc().get()) {
+      add_location(hash, SourceLocation(loc));
+    }
+  }
+}
+
+/// \brief Add the functions referenced by the given value to the set
+void add_referenced_functions(ar::Value* value,
+                              llvm::DenseSet< ar::Function* >& functions) {
+  if (auto cst = dyn_cast< ar::FunctionPointerConstant >(value)) {
+    functions.insert(cst->function());
+  } else if (auto cst = dyn_cast< ar::StructConstant >(value)) {
+    for (auto it = cst->field_begin(), et = cst->field_end(); it != et; ++it) {
+      add_referenced_functions(it->value, functions);
+    }
+  } else if (auto cst = dyn_cast< ar::SequentialConstant >(value)) {
+    for (auto it = cst->element_begin(), et = cst->element_end(); it != et;
+         ++it) {
+      add_referenced_functions(*it, functions);
+    }
+  }
+}
+
+/// \brief Add the functions whose address is taken in the given code
+void add_address_taken(ar::Code* code,
+                       llvm::DenseSet< ar::Function* >& functions) {
+  for (ar::BasicBlock* bb : *code) {
+    for (ar::Statement* stmt : *bb) {
+      auto call = dyn_cast< ar::CallBase >(stmt);
+      for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+        if (call != nullptr && *it == call->called()) {
+          continue;
+        }
+        add_referenced_functions(*it, functions);
+      }
+    }
+  }
+}
+
+/// \brief Add a pointer abstract value to the hash
+///
+/// Memory locations are sorted by name, since the points-to sets are ordered
+/// by address.
+void add_pointer(StableHash& hash, const PointerAbsValue& value) {
+  if (value.is_bottom()) {
+    hash.add("_|_");
+    return;
+  } else if (value.is_top()) {
+    hash.add("T");
+    return;
+  }
+
+  std::ostringstream buf;
+  value.uninitialized().dump(buf);
+  value.nullity().dump(buf);
+  value.offset().dump(buf);
+  hash.add(buf.str());
+
+  const PointsToSet& points_to = value.points_to();
+  if (points_to.is_top()) {
+    hash.add("T");
+    return;
+  }
+
+  std::vector< std::string > names;
+  for (MemoryLocation* mem : points_to) {
+    std::ostringstream name;
+    mem->dump(name);
+    names.push_back(name.str());
+  }
+  std::sort(names.begin(), names.end());
+  for (const auto& name : names) {
+    hash.add(name);
+  }
+}
+
+} // end anonymous namespace
+
+FunctionFingerprints::FunctionFingerprints(Context& ctx) : _ctx(ctx) {}
+
+FunctionFingerprints::~FunctionFingerprints() = default;
+
+void FunctionFingerprints::run() {
+  ar::Bundle* bundle = _ctx.bundle;
+  bool with_callees = _ctx.opts.procedural != Procedural::Intraprocedural;
+
+  std::vector< ar::Function* > definitions;
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    if ((*it)->is_definition()) {
+      definitions.push_back(*it);
+    }
+  }
+
+  // Hash of the function bodies
+  llvm::DenseMap< ar::Function*, uint64_t > bodies;
+  ar::TextFormatter formatter;
+  for (ar::Function* fun : definitions) {
+    StableHash hash;
+
+    std::ostringstream text;
+    formatter.format(text, fun);
+    hash.add(text.str());
+    add_locations(hash, fun);
+
+    if (_ctx.pointer != nullptr) {
+      for (ar::BasicBlock* bb : *fun->body()) {
+        for (ar::Statement* stmt : *bb) {
+          for (auto op = stmt->op_begin(), et = stmt->op_end(); op != et;
+               ++op) {
+            if (auto iv = dyn_cast< ar::InternalVariable >(*op)) {
+              add_pointer(hash,
+                          _ctx.pointer->results().get(
+                              _ctx.var_factory->get_internal(iv)));
+            }
+          }
+        }
+      }
+    }
+
+    bodies[fun] = hash.value();
+  }
+
+  // Call graph, on function definitions
+  CallGraph graph;
+  llvm::DenseSet< ar::Function* > address_taken;
+  if (with_callees) {
+    for (ar::Function* fun : definitions) {
+      add_address_taken(fun->body(), address_taken);
+    }
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      if ((*it)->is_definition()) {
+        add_address_taken((*it)->initializer(), address_taken);
+      }
+    }
+  }
+  for (ar::Function* fun : definitions) {
+    auto& callees = graph[fun];
+    if (!with_callees) {
+      continue;
+    }
+
+    bool indirect = false;
+    for (ar::BasicBlock* bb : *fun->body()) {
+      for (ar::Statement* stmt : *bb) {
+        if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+          if (auto cst = dyn_cast< ar::FunctionPointerConstant >(
+                  call->called())) {
+            if (cst->function()->is_definition()) {
+              callees.insert(cst->function());
+            }
+          } else {
+            indirect = true;
+          }
+        }
+      }
+    }
+
+    if (indirect) {
+      for (ar::Function* callee : definitions) {
+        if (address_taken.count(callee) != 0) {
+          callees.insert(callee);
+        }
+      }
+    }
+  }
+
+  // Combine the hashes bottom-up on the strongly connected components
+  llvm::DenseMap< ar::Function*, uint64_t > components;
+  for (const auto& component :
+       strongly_connected_components(graph, definitions)) {
+    std::vector< uint64_t > members;
+    std::vector< uint64_t > callees;
+    for (ar::Function* fun : component) {
+      members.push_back(bodies[fun]);
+      for (ar::Function* callee : graph[fun]) {
+        if (std::find(component.begin(), component.end(), callee) ==
+            component.end()) {
+          callees.push_back(components[callee]);
+        }
+      }
+    }
+    std::sort(members.begin(), members.end());
+    std::sort(callees.begin(), callees.end());
+    callees.erase(std::unique(callees.begin(), callees.end()), callees.end());
+
+    StableHash hash;
+    for (uint64_t h : members) {
+      hash.add(h);
+    }
+    for (uint64_t h : callees) {
+      hash.add(h);
+    }
+    for (ar::Function* fun : component) {
+      components[fun] = hash.value();
+    }
+  }
+
+  // The interprocedural analysis starts from the initialized global variables
+  StableHash globals;
+  if (_ctx.opts.procedural == Procedural::Interprocedural) {
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      std::ostringstream text;
+      formatter.format(text, *it);
+      globals.add(text.str());
+    }
+
+    // Global constructors and destructors
+    std::vector< std::pair< ar::Function*, MachineInt > > entries;
+    if (ar::GlobalVariable* gv = bundle->global_or_null("ar.global_ctors")) {
+      entries = value::global_ctors(gv);
+    }
+    if (ar::GlobalVariable* gv = bundle->global_or_null("ar.global_dtors")) {
+      auto dtors = value::global_dtors(gv);
+      entries.insert(entries.end(), dtors.begin(), dtors.end());
+    }
+    for (const auto& entry : entries) {
+      if (entry.first->is_definition()) {
+        globals.add(components[entry.first]);
+      }
+    }
+  }
+
+  for (ar::Function* fun : definitions) {
+    StableHash hash;
+    hash.add(bodies[fun]);
+    hash.add(components[fun]);
+    hash.add(globals.value());
+    this->_fingerprints[fun] = hash.value();
+  }
+}
+
+uint64_t FunctionFingerprints::get(ar::Function* fun) const {
+  auto it = this->_fingerprints.find(fun);
+  ikos_assert_msg(it != this->_fingerprints.end(),
+                  "no fingerprint for function");
+  return it->second;
+}
+
+void FunctionFingerprints::save(FingerprintsTable& table) const {
+  for (auto it = _ctx.bundle->function_begin(),
+            et = _ctx.bundle->function_end();
+       it != et;
+       ++it) {
+    if ((*it)->is_definition()) {
+      table.insert(*it, this->get(*it));
+    }
+  }
+}
+
+std::string fingerprint_str(uint64_t fingerprint) {
+  std::ostringstream buf;
+  buf << std::hex << std::setw(16) << std::setfill('0') << fingerprint;
+  return buf.str();
+}
+
+} // end namespace analyzer
+} // end namespace ikos
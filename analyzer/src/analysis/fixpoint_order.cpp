@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Weak topological and partial orders of control flow graphs
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#include <memory>
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for_each.h>
+
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+FixpointOrders::FixpointOrders(const AnalysisOptions& opts)
+    : _num_threads(opts.num_threads),
+      _use_wpo(opts.num_threads != 1 &&
+               opts.procedural != Procedural::Summary) {}
+
+FixpointOrders::~FixpointOrders() = default;
+
+void FixpointOrders::build(ar::Bundle* bundle) {
+  std::vector< ar::Code* > codes;
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    if (fun->is_definition()) {
+      codes.push_back(fun->body());
+    }
+  }
+
+  auto build_orders = [this](ar::Code* code) {
+    this->wto(code);
+    if (this->_use_wpo) {
+      this->wpo(code);
+    }
+  };
+
+  if (this->_num_threads == 1) {
+    for (ar::Code* code : codes) {
+      build_orders(code);
+    }
+    return;
+  }
+
+  // Initialize the task scheduler
+  std::unique_ptr< tbb::global_control > scheduler;
+  if (this->_num_threads > 0) {
+    scheduler = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(this->_num_threads));
+  }
+
+  tbb::parallel_for_each(codes.begin(), codes.end(), build_orders);
+}
+
+std::shared_ptr< const FixpointOrders::WtoT > FixpointOrders::wto(
+    ar::Code* code) {
+  {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto it = this->_wto_map.find(code);
+    if (it != this->_wto_map.end()) {
+      return it->second;
+    }
+  }
+
+  // Compute the order without holding the lock
+  auto wto = std::make_shared< const WtoT >(code);
+
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  auto res = this->_wto_map.try_emplace(code, std::move(wto));
+  return res.first->second;
+}
+
+std::shared_ptr< const FixpointOrders::WpoT > FixpointOrders::wpo(
+    ar::Code* code) {
+  {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto it = this->_wpo_map.find(code);
+    if (it != this->_wpo_map.end()) {
+      return it->second;
+    }
+  }
+
+  // Compute the order without holding the lock
+  auto wpo = std::make_shared< const WpoT >(code);
+
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  auto res = this->_wpo_map.try_emplace(code, std::move(wpo));
+  return res.first->second;
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Statistics on the fixpoints of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/analyzer/analysis/fixpoint_telemetry.hpp>
+#include <ikos/analyzer/database/table/fixpoint_stats.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+std::pair< std::size_t, std::size_t > FixpointTelemetry::Statistics::
+    state_size(const value::AbstractDomain& inv) const {
+  if (inv.is_normal_flow_bottom()) {
+    return {0, 0};
+  }
+
+  return {inv.normal().num_variables(), inv.normal().num_cells()};
+}
+
+FixpointTelemetry::FixpointTelemetry() = default;
+
+FixpointTelemetry::~FixpointTelemetry() = default;
+
+void FixpointTelemetry::add(ar::Function* fun, const Statistics& statistics) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  FunctionStatistics& fun_stats = this->_functions[fun];
+  fun_stats.runs++;
+  fun_stats.total.merge(statistics.total());
+  for (const auto& entry : statistics.cycles()) {
+    fun_stats.cycles[entry.first].merge(entry.second);
+  }
+}
+
+void FixpointTelemetry::save(FixpointStatsTable& table) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  for (const auto& fun_entry : this->_functions) {
+    const FunctionStatistics& fun_stats = fun_entry.second;
+    auto runs = static_cast< sqlite::DbInt64 >(fun_stats.runs);
+    table.insert(fun_entry.first, nullptr, runs, fun_stats.total);
+    for (const auto& cycle_entry : fun_stats.cycles) {
+      table.insert(fun_entry.first,
+                   cycle_entry.first,
+                   runs,
+                   cycle_entry.second);
+    }
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,402 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Incremental analysis, reusing the results of a previous run
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/StringSet.h>
+
+#include <ikos/analyzer/analysis/incremental.hpp>
+#include <ikos/analyzer/analysis/value/global_variable.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief Settings that do not affect the results of the analysis
+const char* const IgnoredSettings = "'num-threads', "
+                                    "'use-static-dispatch', "
+                                    "'use-hash-consing', "
+                                    "'use-fixpoint-cache', "
+                                    "'fixpoint-memo-size', "
+                                    "'use-sparse-invariants', "
+                                    "'use-work-stealing', "
+                                    "'use-pipelined-checks', "
+                                    "'use-fixpoint-telemetry', "
+                                    "'trace-ar-statements'";
+
+/// \brief Return the given string as a SQL literal
+std::string sql_string(StringRef s) {
+  std::string result("'");
+  for (char c : s) {
+    if (c == '\'') {
+      result += '\'';
+    }
+    result += c;
+  }
+  result += '\'';
+  return result;
+}
+
+/// \brief Return the result of a query returning a single integer
+sqlite::DbInt64 query_int(sqlite::DbConnection& db, std::string query) {
+  sqlite::DbIstream in(db, std::move(query));
+  sqlite::DbInt64 n = 0;
+  in >> n;
+  return n;
+}
+
+/// \brief Return true if the sqlite library supports the JSON functions
+///
+/// They are used to find the rows referenced by the information of a check.
+bool has_json_support(sqlite::DbConnection& db) {
+  try {
+    db.exec_command("SELECT json_valid('[]')");
+    return true;
+  } catch (const sqlite::DbError&) {
+    return false;
+  }
+}
+
+} // end anonymous namespace
+
+IncrementalAnalysis::IncrementalAnalysis(Context& ctx, std::string path)
+    : _ctx(ctx), _path(std::move(path)) {}
+
+IncrementalAnalysis::~IncrementalAnalysis() = default;
+
+void IncrementalAnalysis::load() {
+  OutputDatabase& output_db = *_ctx.output_db;
+  sqlite::DbConnection& db = output_db.db;
+
+  // ATTACH is not allowed within a transaction
+  sqlite::CommitPolicy commit_policy = db.commit_policy();
+  db.set_commit_policy(sqlite::CommitPolicy::Manual);
+  db.exec_command("ATTACH DATABASE " + sql_string(this->_path) +
+                  " AS previous");
+
+  // Settings that affect the results
+  std::string current =
+      std::string("SELECT name, value FROM main.settings WHERE name NOT IN (") +
+      IgnoredSettings + ")";
+  std::string previous =
+      std::string(
+          "SELECT name, value FROM previous.settings WHERE name NOT IN (") +
+      IgnoredSettings + ")";
+
+  if (!has_json_support(db)) {
+    log::warning("sqlite3 was built without JSON support, analyzing all "
+                 "functions");
+  } else if (query_int(db,
+                       "SELECT COUNT(*) FROM previous.sqlite_master "
+                       "WHERE type = 'table' AND name = 'fingerprints'") == 0) {
+    log::warning("previous database '" + this->_path +
+                 "' has no function fingerprints, analyzing all functions");
+  } else if (query_int(db,
+                       "SELECT (SELECT COUNT(*) FROM (" + current + " EXCEPT " +
+                           previous + ")) + (SELECT COUNT(*) FROM (" +
+                           previous + " EXCEPT " + current + "))") != 0) {
+    log::warning("previous database '" + this->_path +
+                 "' was produced with different settings, analyzing all "
+                 "functions");
+  } else {
+    this->_compatible = true;
+  }
+
+  if (!this->_compatible) {
+    db.exec_command("DETACH DATABASE previous");
+    db.set_commit_policy(commit_policy);
+    return;
+  }
+
+  // Load the fingerprints
+  {
+    sqlite::DbIstream in(db,
+                         "SELECT f.name, p.fingerprint "
+                         "FROM previous.fingerprints p "
+                         "JOIN previous.functions f ON f.id = p.function_id");
+    while (!in.empty()) {
+      std::string name;
+      std::string fingerprint;
+      in >> name >> fingerprint;
+      this->_previous[name] = fingerprint;
+    }
+  }
+
+  // The ids of the current run start after the ones of the previous run
+  auto first_id = [&](const std::string& table) {
+    return query_int(db,
+                     "SELECT IFNULL(MAX(id) + 1, 0) FROM previous." + table);
+  };
+  output_db.files.set_first_id(first_id("files"));
+  output_db.functions.set_first_id(first_id("functions"));
+  output_db.statements.set_first_id(first_id("statements"));
+  output_db.operands.set_first_id(first_id("operands"));
+  output_db.call_contexts.set_first_id(first_id("call_contexts"));
+  output_db.memory_locations.set_first_id(first_id("memory_locations"));
+  output_db.checks.set_first_id(first_id("checks"));
+
+  // Files and functions keep their previous ids, so that the ids referenced by
+  // the copied checks remain valid
+  {
+    sqlite::DbIstream in(db, "SELECT id, path FROM previous.files");
+    while (!in.empty()) {
+      sqlite::DbInt64 id = 0;
+      std::string path;
+      in >> id >> path;
+      output_db.files.reuse_id(path, id);
+    }
+  }
+  {
+    sqlite::DbIstream in(db, "SELECT id, name FROM previous.functions");
+    while (!in.empty()) {
+      sqlite::DbInt64 id = 0;
+      std::string name;
+      in >> id >> name;
+      output_db.functions.reuse_id(name, id);
+    }
+  }
+
+  db.set_commit_policy(commit_policy);
+}
+
+void IncrementalAnalysis::run(const FunctionFingerprints& fingerprints) {
+  if (!this->_compatible) {
+    return;
+  }
+
+  ar::Bundle* bundle = _ctx.bundle;
+
+  // Candidates for reuse
+  std::vector< ar::Function* > candidates;
+  if (_ctx.opts.procedural == Procedural::Interprocedural) {
+    // Global constructors and destructors are always analyzed, to compute the
+    // invariants of the entry points
+    std::vector< std::pair< ar::Function*, MachineInt > > init;
+    if (ar::GlobalVariable* gv = bundle->global_or_null("ar.global_ctors")) {
+      init = value::global_ctors(gv);
+    }
+    if (ar::GlobalVariable* gv = bundle->global_or_null("ar.global_dtors")) {
+      auto dtors = value::global_dtors(gv);
+      init.insert(init.end(), dtors.begin(), dtors.end());
+    }
+    auto is_init = [&](ar::Function* fun) {
+      return std::any_of(init.begin(),
+                         init.end(),
+                         [=](const std::pair< ar::Function*, MachineInt >& e) {
+                           return e.first == fun;
+                         });
+    };
+
+    for (ar::Function* fun : _ctx.opts.entry_points) {
+      if (fun->is_definition() && !is_init(fun)) {
+        candidates.push_back(fun);
+      }
+    }
+  } else {
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      if ((*it)->is_definition()) {
+        candidates.push_back(*it);
+      }
+    }
+  }
+
+  for (ar::Function* fun : candidates) {
+    auto it = this->_previous.find(FunctionsTable::name(fun).to_string());
+    if (it != this->_previous.end() &&
+        it->second == fingerprint_str(fingerprints.get(fun))) {
+      this->_reused.insert(fun);
+    }
+  }
+
+  log::info("Reusing the results of " + std::to_string(this->_reused.size()) +
+            " out of " + std::to_string(candidates.size()) + " functions");
+  _ctx.output_db->stats.insert("ikos-analyzer.incremental.reused-functions",
+                               static_cast< sqlite::DbInt64 >(
+                                   this->_reused.size()));
+}
+
+void IncrementalAnalysis::save() {
+  if (!this->_compatible) {
+    return;
+  }
+
+  OutputDatabase& output_db = *_ctx.output_db;
+  sqlite::DbConnection& db = output_db.db;
+
+  // The reused functions get their previous ids
+  for (ar::Function* fun : this->_reused) {
+    output_db.functions.insert(fun);
+  }
+
+  // Flush the rows of the current run
+  sqlite::CommitPolicy commit_policy = db.commit_policy();
+  db.set_commit_policy(sqlite::CommitPolicy::Manual);
+
+  // Names of the reused functions
+  llvm::StringSet<> reused_names;
+  for (ar::Function* fun : this->_reused) {
+    reused_names.insert(FunctionsTable::name(fun).to_string());
+  }
+
+  // Ids of the reused functions in the previous database
+  std::string reused_ids;
+  {
+    sqlite::DbIstream in(db, "SELECT id, name FROM previous.functions");
+    while (!in.empty()) {
+      sqlite::DbInt64 id = 0;
+      std::string name;
+      in >> id >> name;
+
+      if (reused_names.count(name) != 0) {
+        if (!reused_ids.empty()) {
+          reused_ids += ", ";
+        }
+        reused_ids += std::to_string(id);
+      }
+    }
+  }
+
+  if (reused_ids.empty()) {
+    db.exec_command("DETACH DATABASE previous");
+    db.set_commit_policy(commit_policy);
+    return;
+  }
+
+  db.begin_transaction();
+
+  // Checks owned by the reused functions
+  db.exec_command(
+      "CREATE TEMP TABLE reused_checks AS "
+      "WITH RECURSIVE owners(id, function_id) AS ("
+      "SELECT c.id, c.function_id FROM previous.call_contexts c "
+      "JOIN previous.call_contexts p ON p.id = c.parent_id "
+      "WHERE p.call_id IS NULL "
+      "UNION ALL "
+      "SELECT c.id, o.function_id FROM previous.call_contexts c "
+      "JOIN owners o ON o.id = c.parent_id) "
+      "SELECT k.* FROM previous.checks k "
+      "JOIN previous.statements s ON s.id = k.statement_id "
+      "LEFT JOIN owners o ON o.id = k.call_context_id "
+      "WHERE IFNULL(o.function_id, s.function_id) IN (" +
+      reused_ids + ")");
+
+  // Memory locations referenced by the information of the checks
+  db.exec_command(
+      "CREATE TEMP TABLE reused_memory_locations AS "
+      "SELECT m.* FROM previous.memory_locations m WHERE m.id IN ("
+      "SELECT json_extract(p.value, '$.id') FROM temp.reused_checks k, "
+      "json_each(k.info, '$.points_to') p "
+      "UNION SELECT p.value FROM temp.reused_checks k, "
+      "json_each(k.info, '$.left_points_to') p "
+      "UNION SELECT p.value FROM temp.reused_checks k, "
+      "json_each(k.info, '$.right_points_to') p)");
+
+  // Call contexts of the checks and the dynamic allocations, with their parents
+  db.exec_command(
+      "CREATE TEMP TABLE reused_call_contexts AS "
+      "WITH RECURSIVE contexts(id) AS ("
+      "SELECT call_context_id FROM temp.reused_checks "
+      "UNION SELECT json_extract(info, '$.context_id') "
+      "FROM temp.reused_memory_locations "
+      "UNION SELECT c.parent_id FROM previous.call_contexts c "
+      "JOIN contexts ON contexts.id = c.id) "
+      "SELECT c.* FROM previous.call_contexts c "
+      "WHERE c.id IN (SELECT id FROM contexts)");
+
+  db.exec_command("INSERT INTO main.checks SELECT * FROM temp.reused_checks");
+  db.exec_command(
+      "INSERT INTO main.memory_locations "
+      "SELECT * FROM temp.reused_memory_locations");
+  db.exec_command(
+      "INSERT INTO main.call_contexts SELECT * FROM temp.reused_call_contexts");
+  db.exec_command(
+      "INSERT INTO main.statements "
+      "SELECT * FROM previous.statements WHERE id IN ("
+      "SELECT statement_id FROM temp.reused_checks "
+      "UNION SELECT call_id FROM temp.reused_call_contexts "
+      "UNION SELECT json_extract(info, '$.call_id') "
+      "FROM temp.reused_memory_locations)");
+  db.exec_command(
+      "INSERT INTO main.operands "
+      "SELECT * FROM previous.operands WHERE id IN ("
+      "SELECT json_extract(o.value, '$[1]') FROM temp.reused_checks k, "
+      "json_each(k.operands) o)");
+
+  // Functions and files that are referenced but were not inserted by the
+  // current run. Their ids are not used by the current run.
+  db.exec_command(
+      "INSERT INTO main.functions "
+      "SELECT * FROM previous.functions WHERE id IN ("
+      "SELECT function_id FROM main.statements "
+      "UNION SELECT function_id FROM main.call_contexts "
+      "UNION SELECT json_extract(p.value, '$.fun_id') "
+      "FROM temp.reused_checks k, json_each(k.info, '$.points_to') p "
+      "UNION SELECT json_extract(info, '$.fun_id') FROM temp.reused_checks "
+      "UNION SELECT json_extract(info, '$.id') "
+      "FROM temp.reused_memory_locations) "
+      "AND id NOT IN (SELECT id FROM main.functions)");
+  db.exec_command(
+      "INSERT INTO main.files "
+      "SELECT * FROM previous.files WHERE id IN ("
+      "SELECT file_id FROM main.statements "
+      "UNION SELECT file_id FROM main.functions) "
+      "AND id NOT IN (SELECT id FROM main.files)");
+
+  db.exec_command("DROP TABLE temp.reused_checks");
+  db.exec_command("DROP TABLE temp.reused_memory_locations");
+  db.exec_command("DROP TABLE temp.reused_call_contexts");
+
+  db.commit_transaction();
+  db.exec_command("DETACH DATABASE previous");
+  db.set_commit_policy(commit_policy);
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -281,5 +281,15 @@ DynAllocMemoryLocation* MemoryFactory::get_dyn_alloc(ar::CallBase* call,
   }
 }
 
+std::vector< DynAllocMemoryLocation* > MemoryFactory::dyn_allocs() {
+  boost::shared_lock< boost::shared_mutex > lock(this->_dyn_alloc_mutex);
+  std::vector< DynAllocMemoryLocation* > mls;
+  mls.reserve(this->_dyn_alloc_map.size());
+  for (const auto& entry : this->_dyn_alloc_map) {
+    mls.push_back(entry.second.get());
+  }
+  return mls;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -109,8 +109,22 @@ void AnalysisOptions::save(SettingsTable& table) {
 
   table.insert("use-partitioning-domain", this->use_partitioning_domain);
 
+  table.insert("use-static-dispatch", this->use_static_dispatch);
+
+  table.insert("use-hash-consing", this->use_hash_consing);
+
   table.insert("use-fixpoint-cache", this->use_fixpoint_cache);
 
+  table.insert("fixpoint-memo-size", std::to_string(this->fixpoint_memo_size));
+
+  table.insert("use-sparse-invariants", this->use_sparse_invariants);
+
+  table.insert("use-work-stealing", this->use_work_stealing);
+
+  table.insert("use-pipelined-checks", this->use_pipelined_checks);
+
+  table.insert("use-fixpoint-telemetry", this->use_fixpoint_telemetry);
+
   table.insert("use-checks", this->use_checks);
 
   table.insert("trace-ar-statements", this->trace_ar_statements);
@@ -54,6 +54,7 @@
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/pointer/constraint.hpp>
 #include <ikos/analyzer/analysis/pointer/function.hpp>
@@ -150,7 +151,9 @@ public:
   NumericalCodeInvariants(Context& ctx,
                           const FunctionPointerAnalysis& function_pointer,
                           ar::Code* code)
-      : FwdFixpointIterator(code, make_bottom_abstract_value()),
+      : FwdFixpointIterator(code,
+                            ctx.fixpoint_orders->wto(code),
+                            make_bottom_abstract_value()),
         _ctx(ctx),
         _empty_call_context(ctx.call_context_factory->get_empty()),
         _fixpoint_parameters(
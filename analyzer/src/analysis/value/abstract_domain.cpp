@@ -41,15 +41,9 @@
  *
  ******************************************************************************/
 
-#include <ikos/core/domain/lifetime/separate_domain.hpp>
-#include <ikos/core/domain/memory/partitioning.hpp>
-#include <ikos/core/domain/memory/value.hpp>
-#include <ikos/core/domain/nullity/separate_domain.hpp>
-#include <ikos/core/domain/scalar/composite.hpp>
-#include <ikos/core/domain/uninitialized/separate_domain.hpp>
-
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
+#include <ikos/analyzer/analysis/value/memory_domain.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -57,68 +51,35 @@ namespace value {
 
 namespace {
 
-/// \brief Uninitialized abstract domain
-using UninitializedAbstractDomain =
-    core::uninitialized::SeparateDomain< Variable* >;
-
-/// \brief Nullity abstract domain
-using NullityAbstractDomain = core::nullity::SeparateDomain< Variable* >;
-
-/// \brief Scalar abstract domain
-using ScalarAbstractDomain =
-    core::scalar::CompositeDomain< Variable*,
-                                   MemoryLocation*,
-                                   UninitializedAbstractDomain,
-                                   MachineIntAbstractDomain,
-                                   NullityAbstractDomain >;
-
-/// \brief Lifetime abstract domain
-using LifetimeAbstractDomain =
-    core::lifetime::SeparateDomain< MemoryLocation* >;
-
-/// \brief Value abstract domain
-using ValueAbstractDomain = core::memory::ValueDomain< Variable*,
-                                                       MemoryLocation*,
-                                                       VariableFactory*,
-                                                       ScalarAbstractDomain,
-                                                       LifetimeAbstractDomain >;
+/// \brief Memory abstract domain over the polymorphic machine integer domain
+using PolymorphicMemoryDomainStack =
+    MemoryDomainStack< MachineIntAbstractDomain >;
 
-/// \brief Partitioning abstract domain
-using PartitioningAbstractDomain = core::memory::
-    PartitioningDomain< Variable*, MemoryLocation*, ValueAbstractDomain >;
+/// \brief Return true if the memory abstract value should be statically
+/// dispatched on the machine integer abstract domain
+bool use_static_dispatch(Context& ctx) {
+  return ctx.opts.use_static_dispatch &&
+         has_static_memory_abstract_value(ctx.opts.machine_int_domain);
+}
 
 /// \brief Create the bottom memory abstract value
 MemoryAbstractDomain make_bottom_memory_abstract_value(Context& ctx) {
-  auto inv = ValueAbstractDomain(
-      ctx.var_factory,
-      ScalarAbstractDomain(UninitializedAbstractDomain::bottom(),
-                           make_bottom_machine_int_abstract_value(
-                               ctx.opts.machine_int_domain),
-                           NullityAbstractDomain::bottom()),
-      LifetimeAbstractDomain::bottom());
-
-  if (ctx.opts.use_partitioning_domain) {
-    return MemoryAbstractDomain(PartitioningAbstractDomain(inv));
-  } else {
-    return MemoryAbstractDomain(inv);
+  if (use_static_dispatch(ctx)) {
+    return make_bottom_static_memory_abstract_value(ctx);
   }
+
+  return PolymorphicMemoryDomainStack::bottom(
+      ctx, make_bottom_machine_int_abstract_value(ctx.opts.machine_int_domain));
 }
 
 /// \brief Create the top memory abstract value
 MemoryAbstractDomain make_top_memory_abstract_value(Context& ctx) {
-  auto inv = ValueAbstractDomain(
-      ctx.var_factory,
-      ScalarAbstractDomain(UninitializedAbstractDomain::top(),
-                           make_top_machine_int_abstract_value(
-                               ctx.opts.machine_int_domain),
-                           NullityAbstractDomain::top()),
-      LifetimeAbstractDomain::top());
-
-  if (ctx.opts.use_partitioning_domain) {
-    return MemoryAbstractDomain(PartitioningAbstractDomain(inv));
-  } else {
-    return MemoryAbstractDomain(inv);
+  if (use_static_dispatch(ctx)) {
+    return make_top_static_memory_abstract_value(ctx);
   }
+
+  return PolymorphicMemoryDomainStack::top(
+      ctx, make_top_machine_int_abstract_value(ctx.opts.machine_int_domain));
 }
 
 } // end anonymous namespace
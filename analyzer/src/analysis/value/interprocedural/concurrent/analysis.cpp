@@ -46,6 +46,7 @@
 #include <memory>
 #include <vector>
 
+#include <ikos/analyzer/analysis/incremental.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
@@ -82,6 +83,9 @@ void Analysis::run() {
     }
   }
 
+  // Memoized fixpoints of callees, shared by all entry points
+  FunctionFixpoint::FixpointMemoT fixpoint_memo(_ctx.opts.fixpoint_memo_size);
+
   // Initialize the task scheduler
   if (_ctx.opts.num_threads > 0) {
     tbb::global_control init(tbb::global_control::max_allowed_parallelism,
@@ -147,7 +151,7 @@ void Analysis::run() {
       }
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, ctor);
+      FunctionFixpoint fixpoint(_ctx, checkers, fixpoint_memo, ctor);
 
       {
         log::info("Analyzing global constructor '" + demangle(ctor->name()) +
@@ -184,6 +188,14 @@ void Analysis::run() {
       continue;
     }
 
+    // Entry points reused from a previous run are not analyzed again
+    if (_ctx.incremental != nullptr &&
+        _ctx.incremental->is_reused(entry_point)) {
+      log::info("Reusing the results of entry point '" +
+                demangle(entry_point->name()) + "'");
+      continue;
+    }
+
     // Entry point initial invariant
     AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
 
@@ -202,7 +214,7 @@ void Analysis::run() {
     }
 
     // Create a function fixpoint
-    FunctionFixpoint fixpoint(_ctx, checkers, entry_point);
+    FunctionFixpoint fixpoint(_ctx, checkers, fixpoint_memo, entry_point);
 
     {
       log::info("Analyzing entry point '" + demangle(entry_point->name()) +
@@ -238,7 +250,7 @@ void Analysis::run() {
       }
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, dtor);
+      FunctionFixpoint fixpoint(_ctx, checkers, fixpoint_memo, dtor);
 
       {
         log::info("Analyzing global destructor '" + demangle(dtor->name()) +
@@ -267,6 +279,16 @@ void Analysis::run() {
        ++it) {
     _ctx.output_db->functions.insert(*it);
   }
+
+  // Save statistics on the memoized fixpoints
+  if (fixpoint_memo.enabled()) {
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.hits",
+                                 fixpoint_memo.hits());
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.misses",
+                                 fixpoint_memo.misses());
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.evictions",
+                                 fixpoint_memo.evictions());
+  }
 }
 
 } // end namespace concurrent
@@ -45,6 +45,7 @@
 
 #include <ikos/analyzer/analysis/execution_engine/concurrent_inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/function_fixpoint.hpp>
 
@@ -68,21 +69,33 @@ using ConcurrentInlineCallExecutionEngineT =
 FunctionFixpoint::FunctionFixpoint(
     Context& ctx,
     const std::vector< std::unique_ptr< Checker > >& checkers,
+    FixpointMemoT& fixpoint_memo,
     ar::Function* entry_point)
-    : FwdFixpointIterator(entry_point->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(entry_point->body(),
+                          ctx.fixpoint_orders->wpo(entry_point->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_work_stealing
+                              ? core::ConcurrentScheduling::WorkStealing
+                              : core::ConcurrentScheduling::ParallelForEach),
       _ctx(ctx),
       _function(entry_point),
       _call_context(ctx.call_context_factory->get_empty()),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(entry_point)),
       _checkers(checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _fixpoint_memo(fixpoint_memo) {}
 
 FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
                                    ar::CallBase* call,
                                    ar::Function* callee)
-    : FwdFixpointIterator(callee->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(callee->body(),
+                          ctx.fixpoint_orders->wpo(callee->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_work_stealing
+                              ? core::ConcurrentScheduling::WorkStealing
+                              : core::ConcurrentScheduling::ParallelForEach),
       _ctx(ctx),
       _function(callee),
       _call_context(
@@ -90,7 +103,8 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
       _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
       _checkers(caller._checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _fixpoint_memo(caller._fixpoint_memo) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
   FwdFixpointIterator::run(std::move(inv));
@@ -44,6 +44,7 @@
 #include <memory>
 #include <vector>
 
+#include <ikos/analyzer/analysis/incremental.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/init_invariant.hpp>
@@ -79,6 +80,9 @@ void Analysis::run() {
     }
   }
 
+  // Memoized fixpoints of callees, shared by all entry points
+  FunctionFixpoint::FixpointMemoT fixpoint_memo(_ctx.opts.fixpoint_memo_size);
+
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
@@ -143,7 +147,7 @@ void Analysis::run() {
       ScopeLogger scope(*logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, ctor);
+      FunctionFixpoint fixpoint(_ctx, checkers, fixpoint_memo, *logger, ctor);
 
       {
         log::info("Analyzing global constructor '" + demangle(ctor->name()) +
@@ -180,6 +184,14 @@ void Analysis::run() {
       continue;
     }
 
+    // Entry points reused from a previous run are not analyzed again
+    if (_ctx.incremental != nullptr &&
+        _ctx.incremental->is_reused(entry_point)) {
+      log::info("Reusing the results of entry point '" +
+                demangle(entry_point->name()) + "'");
+      continue;
+    }
+
     // Entry point initial invariant
     AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
 
@@ -203,7 +215,11 @@ void Analysis::run() {
     ScopeLogger scope(*logger);
 
     // Create a function fixpoint
-    FunctionFixpoint fixpoint(_ctx, checkers, *logger, entry_point);
+    FunctionFixpoint fixpoint(_ctx,
+                              checkers,
+                              fixpoint_memo,
+                              *logger,
+                              entry_point);
 
     {
       log::info("Analyzing entry point '" + demangle(entry_point->name()) +
@@ -244,7 +260,7 @@ void Analysis::run() {
       ScopeLogger scope(*logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, dtor);
+      FunctionFixpoint fixpoint(_ctx, checkers, fixpoint_memo, *logger, dtor);
 
       {
         log::info("Analyzing global destructor '" + demangle(dtor->name()) +
@@ -273,6 +289,16 @@ void Analysis::run() {
        ++it) {
     _ctx.output_db->functions.insert(*it);
   }
+
+  // Save statistics on the memoized fixpoints
+  if (fixpoint_memo.enabled()) {
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.hits",
+                                 fixpoint_memo.hits());
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.misses",
+                                 fixpoint_memo.misses());
+    _ctx.output_db->stats.insert("ikos-analyzer.fixpoint-memo.evictions",
+                                 fixpoint_memo.evictions());
+  }
 }
 
 } // end namespace sequential
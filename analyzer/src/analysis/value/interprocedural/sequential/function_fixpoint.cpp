@@ -43,6 +43,8 @@
 
 #include <ikos/analyzer/analysis/execution_engine/inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
+#include <ikos/analyzer/analysis/fixpoint_telemetry.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/function_fixpoint.hpp>
 #include <ikos/ar/format/text.hpp>
@@ -67,9 +69,15 @@ using InlineCallExecutionEngineT =
 FunctionFixpoint::FunctionFixpoint(
     Context& ctx,
     const std::vector< std::unique_ptr< Checker > >& checkers,
+    FixpointMemoT& fixpoint_memo,
     ProgressLogger& logger,
     ar::Function* entry_point)
-    : FwdFixpointIterator(entry_point->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(entry_point->body(),
+                          ctx.fixpoint_orders->wto(entry_point->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants
+                              ? core::InvariantStorage::Sparse
+                              : core::InvariantStorage::Full),
       _ctx(ctx),
       _function(entry_point),
       _call_context(ctx.call_context_factory->get_empty()),
@@ -77,6 +85,7 @@ FunctionFixpoint::FunctionFixpoint(
       _checkers(checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
+      _fixpoint_memo(fixpoint_memo),
       _logger(logger),
       _namer() {
   if (_ctx.opts.trace_ar_statements) {
@@ -94,7 +103,12 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
                                    ar::CallBase* call,
                                    ar::Function* callee)
-    : FwdFixpointIterator(callee->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(callee->body(),
+                          ctx.fixpoint_orders->wto(callee->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants
+                              ? core::InvariantStorage::Sparse
+                              : core::InvariantStorage::Full),
       _ctx(ctx),
       _function(callee),
       _call_context(
@@ -103,6 +117,7 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
       _checkers(caller._checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
+      _fixpoint_memo(caller._fixpoint_memo),
       _logger(caller._logger),
       _namer() {
   if (_ctx.opts.trace_ar_statements) {
@@ -138,7 +153,15 @@ void FunctionFixpoint::run(AbstractDomain inv) {
   }
 
   // Compute the fixpoint
-  FwdFixpointIterator::run(std::move(inv));
+  if (this->_ctx.fixpoint_telemetry != nullptr) {
+    FixpointTelemetry::Statistics statistics;
+    this->set_statistics(&statistics);
+    FwdFixpointIterator::run(std::move(inv));
+    this->set_statistics(nullptr);
+    this->_ctx.fixpoint_telemetry->add(this->_function, statistics);
+  } else {
+    FwdFixpointIterator::run(std::move(inv));
+  }
 
   // Clear post invariants, save a lot of memory
   this->clear_post();
@@ -334,73 +357,93 @@ void FunctionFixpoint::run_checks() {
     this->_logger.start_callee(this->_call_context, this->_function);
   }
 
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    InlineCallExecutionEngineT call_exec_engine(this->_ctx,
-                                                exec_engine,
-                                                *this,
-                                                this->_callees_cache);
+  if (this->storage() == core::InvariantStorage::Full) {
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->check_block(bb, this->pre(bb));
+    }
+  } else {
+    // Recompute the pre invariants that are not stored
+    this->replay([this](ar::BasicBlock* bb, const AbstractDomain& pre) {
+      return this->check_block(bb, pre);
+    });
+
+    // Basic blocks unreachable from the entry
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      if (!this->wto().contains(bb)) {
+        this->check_block(bb, this->bottom());
+      }
+    }
+  }
 
-    // Check called functions during the transfer function
-    call_exec_engine.mark_check_callees();
+  if (!this->_call_context->empty()) {
+    this->_logger.end_callee(this->_call_context, this->_function);
+  }
+}
 
-    exec_engine.exec_enter(bb);
+AbstractDomain FunctionFixpoint::check_block(ar::BasicBlock* bb,
+                                             const AbstractDomain& pre) {
+  NumericalExecutionEngineT
+      exec_engine(pre,
+                  this->_ctx,
+                  this->_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  InlineCallExecutionEngineT call_exec_engine(this->_ctx,
+                                              exec_engine,
+                                              *this,
+                                              this->_callees_cache);
 
+  // Check called functions during the transfer function
+  call_exec_engine.mark_check_callees();
+
+  exec_engine.exec_enter(bb);
+
+  if (_ctx.opts.trace_ar_statements) {
+    auto msg = analyzer::log::msg();
+    auto& stream = msg.stream();
+    msg << "Entering basic block in run_checks: ";
+    bb->dump(stream);
+    stream << std::endl;
+    msg << "  Invariant on entry to basic block:";
+    stream << std::endl;
+    exec_engine.inv().dump(stream);
+    stream << std::endl;
+  }
+
+  for (ar::Statement* stmt : *bb) {
     if (_ctx.opts.trace_ar_statements) {
       auto msg = analyzer::log::msg();
       auto& stream = msg.stream();
-      msg << "Entering basic block in run_checks: ";
-      bb->dump(stream);
-      stream << std::endl;
-      msg << "  Invariant on entry to basic block:";
-      stream << std::endl;
-      exec_engine.inv().dump(stream);
+      msg << "Checking: ";
+      stmt->dump(stream);
       stream << std::endl;
     }
 
-    for (ar::Statement* stmt : *bb) {
-      if (_ctx.opts.trace_ar_statements) {
-        auto msg = analyzer::log::msg();
-        auto& stream = msg.stream();
-        msg << "Checking: ";
-        stmt->dump(stream);
-        stream << std::endl;
-      }
-
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : this->_checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_call_context);
-        }
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      exec_engine.inv().normalize();
+      for (const auto& checker : this->_checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_call_context);
       }
+    }
 
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
 
-      if (_ctx.opts.trace_ar_statements) {
-        auto msg = analyzer::log::msg();
-        auto& stream = msg.stream();
-        msg << "  In run_checks, invariant after: ";
-        exec_engine.inv().dump(stream);
-        stream << std::endl;
-      }
+    if (_ctx.opts.trace_ar_statements) {
+      auto msg = analyzer::log::msg();
+      auto& stream = msg.stream();
+      msg << "  In run_checks, invariant after: ";
+      exec_engine.inv().dump(stream);
+      stream << std::endl;
     }
-
-    exec_engine.exec_leave(bb);
   }
 
-  if (!this->_call_context->empty()) {
-    this->_logger.end_callee(this->_call_context, this->_function);
-  }
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
 }
 
 } // end namespace sequential
@@ -41,6 +41,7 @@
  *
  ******************************************************************************/
 
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/global_init_fixpoint.hpp>
@@ -53,7 +54,9 @@ namespace sequential {
 
 GlobalVarInitializerFixpoint::GlobalVarInitializerFixpoint(
     Context& ctx, ar::GlobalVariable* gv)
-    : FwdFixpointIterator(gv->initializer(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(gv->initializer(),
+                          ctx.fixpoint_orders->wto(gv->initializer()),
+                          make_bottom_abstract_value(ctx)),
       _gv(gv),
       _ctx(ctx),
       _empty_call_context(ctx.call_context_factory->get_empty()) {}
@@ -0,0 +1,409 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fixpoint on a function body for the bottom-up summary analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/execution_engine/summary.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
+#include <ikos/analyzer/analysis/fixpoint_telemetry.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/function_fixpoint.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+namespace {
+
+/// \brief Numerical execution engine
+using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+
+/// \brief Call execution engine
+using SummaryCallExecutionEngineT =
+    SummaryCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
+
+} // end anonymous namespace
+
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   ar::Function* function,
+                                   const SummaryCacheT& summaries)
+    : FwdFixpointIterator(function->body(),
+                          ctx.fixpoint_orders->wto(function->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants
+                              ? core::InvariantStorage::Sparse
+                              : core::InvariantStorage::Full),
+      _ctx(ctx),
+      _function(function),
+      _empty_call_context(ctx.call_context_factory->get_empty()),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)),
+      _summaries(summaries),
+      _exit_invariant(make_bottom_abstract_value(ctx)),
+      _return_stmt(nullptr) {}
+
+void FunctionFixpoint::run(AbstractDomain inv) {
+  // Save the initial value of the parameters in shadow variables
+  for (std::size_t i = 0; i < this->_function->num_parameters(); i++) {
+    Variable* shadow =
+        summary_parameter_shadow(this->_ctx, this->_function, i);
+
+    if (shadow == nullptr) {
+      continue;
+    }
+
+    Variable* param =
+        this->_ctx.var_factory->get_internal(this->_function->param(i));
+    if (param->type()->is_integer()) {
+      inv.normal().int_assign(shadow, param);
+    } else {
+      inv.normal().pointer_assign(shadow, param);
+    }
+  }
+
+  if (this->_ctx.fixpoint_telemetry != nullptr) {
+    FixpointTelemetry::Statistics statistics;
+    this->set_statistics(&statistics);
+    FwdFixpointIterator::run(std::move(inv));
+    this->set_statistics(nullptr);
+    this->_ctx.fixpoint_telemetry->add(this->_function, statistics);
+  } else {
+    FwdFixpointIterator::run(std::move(inv));
+  }
+}
+
+AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
+                                             unsigned iteration,
+                                             const AbstractDomain& before,
+                                             const AbstractDomain& after) {
+  if (iteration <= this->_fixpoint_parameters.widening_delay) {
+    // Fixed number of iterations using join
+    return before.join_iter(after);
+  }
+
+  iteration -= this->_fixpoint_parameters.widening_delay;
+  iteration--;
+
+  if (iteration % this->_fixpoint_parameters.widening_period != 0) {
+    // Not the period, iteration using join
+    return before.join_iter(after);
+  }
+
+  switch (this->_fixpoint_parameters.widening_strategy) {
+    case WideningStrategy::Widen: {
+      if (iteration == 0) {
+        if (auto threshold =
+                this->_fixpoint_parameters.widening_hints.get(head)) {
+          // One iteration using widening with threshold
+          return before.widening_threshold(after, *threshold);
+        }
+      }
+
+      // Iterations using widening until convergence
+      return before.widening(after);
+    }
+    case WideningStrategy::Join: {
+      // Iterations using join until convergence
+      return before.join_iter(after);
+    }
+    default: {
+      ikos_unreachable("unexpected strategy");
+    }
+  }
+}
+
+AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
+                                        unsigned iteration,
+                                        const AbstractDomain& before,
+                                        const AbstractDomain& after) {
+  switch (this->_fixpoint_parameters.narrowing_strategy) {
+    case NarrowingStrategy::Narrow: {
+      if (iteration == 1) {
+        if (auto threshold =
+                this->_fixpoint_parameters.widening_hints.get(head)) {
+          // First iteration using narrowing with threshold
+          return before.narrowing_threshold(after, *threshold);
+        }
+      }
+
+      // Iterations using narrowing
+      return before.narrowing(after);
+    }
+    case NarrowingStrategy::Meet: {
+      // Iterations using meet
+      return before.meet(after);
+    }
+    default: {
+      ikos_unreachable("unexpected strategy");
+    }
+  }
+}
+
+bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
+    ar::BasicBlock* /*head*/,
+    unsigned iteration,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  // Check if we reached the number of requested iterations, or convergence
+  return (this->_fixpoint_parameters.narrowing_iterations &&
+          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
+         before.leq(after);
+}
+
+AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
+                                              AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  SummaryCallExecutionEngineT call_exec_engine(this->_ctx,
+                                               exec_engine,
+                                               *this,
+                                               this->_summaries);
+  exec_engine.exec_enter(bb);
+  for (ar::Statement* stmt : *bb) {
+    transfer_function(exec_engine, call_exec_engine, stmt);
+  }
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
+}
+
+AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
+                                              ar::BasicBlock* dest,
+                                              AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  exec_engine.exec_edge(src, dest);
+  return std::move(exec_engine.inv());
+}
+
+void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
+                                   const AbstractDomain& /*pre*/) {}
+
+void FunctionFixpoint::process_post(ar::BasicBlock* bb,
+                                    const AbstractDomain& post) {
+  if (this->_function->body()->exit_block_or_null() == bb) {
+    NumericalExecutionEngineT
+        exec_engine(post,
+                    this->_ctx,
+                    this->_empty_call_context,
+                    ExecutionEngine::UpdateAllocSizeVar,
+                    /* liveness = */ this->_ctx.liveness,
+                    /* pointer_info = */ this->_ctx.pointer == nullptr
+                        ? nullptr
+                        : &this->_ctx.pointer->results());
+    SummaryCallExecutionEngineT call_exec_engine(this->_ctx,
+                                                 exec_engine,
+                                                 *this,
+                                                 this->_summaries);
+    call_exec_engine.exec_exit(this->_function);
+  }
+}
+
+void FunctionFixpoint::run_checks(
+    const std::vector< std::unique_ptr< Checker > >& checkers) {
+  if (this->storage() == core::InvariantStorage::Full) {
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->check_block(bb, this->pre(bb), checkers);
+    }
+  } else {
+    // Recompute the pre invariants that are not stored
+    this->replay([&](ar::BasicBlock* bb, const AbstractDomain& pre) {
+      return this->check_block(bb, pre, checkers);
+    });
+
+    // Basic blocks unreachable from the entry
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      if (!this->wto().contains(bb)) {
+        this->check_block(bb, this->bottom(), checkers);
+      }
+    }
+  }
+}
+
+AbstractDomain FunctionFixpoint::check_block(
+    ar::BasicBlock* bb,
+    const AbstractDomain& pre,
+    const std::vector< std::unique_ptr< Checker > >& checkers) {
+  NumericalExecutionEngineT
+      exec_engine(pre,
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  SummaryCallExecutionEngineT call_exec_engine(this->_ctx,
+                                               exec_engine,
+                                               *this,
+                                               this->_summaries);
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      exec_engine.inv().normalize();
+      for (const auto& checker : checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
+    }
+
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
+  }
+
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
+}
+
+std::unique_ptr< FunctionSummaryT > FunctionFixpoint::summary() const {
+  AbstractDomain exit = this->_exit_invariant;
+  exit.normalize();
+
+  // The caller only sees exceptions through the `may_throw` flag
+  bool may_throw = !exit.is_caught_exceptions_bottom() ||
+                   !exit.is_propagated_exceptions_bottom();
+  exit.ignore_exceptions();
+
+  std::vector< Variable* > parameters;
+  parameters.reserve(this->_function->num_parameters());
+  for (std::size_t i = 0; i < this->_function->num_parameters(); i++) {
+    parameters.push_back(
+        summary_parameter_shadow(this->_ctx, this->_function, i));
+  }
+
+  Variable* return_var = nullptr;
+  if (this->_return_stmt != nullptr && this->_return_stmt->has_operand()) {
+    if (auto iv =
+            dyn_cast< ar::InternalVariable >(this->_return_stmt->operand())) {
+      return_var = this->_ctx.var_factory->get_internal(iv);
+    }
+  }
+
+  // The memory is kept, since the function was analyzed with an unknown
+  // memory. The other scalar variables of the function are not visible to the
+  // callers.
+  if (!exit.is_normal_flow_bottom()) {
+    auto forget = [&](Variable* var) {
+      if (var != return_var) {
+        exit.normal().scalar_forget(var);
+      }
+    };
+    for (auto it = this->_function->param_begin(),
+              et = this->_function->param_end();
+         it != et;
+         ++it) {
+      forget(this->_ctx.var_factory->get_internal(*it));
+    }
+    for (auto it = this->_function->body()->internal_variable_begin(),
+              et = this->_function->body()->internal_variable_end();
+         it != et;
+         ++it) {
+      forget(this->_ctx.var_factory->get_internal(*it));
+    }
+    for (auto it = this->_function->local_variable_begin(),
+              et = this->_function->local_variable_end();
+         it != et;
+         ++it) {
+      forget(this->_ctx.var_factory->get_local(*it));
+    }
+  }
+
+  std::vector< MemoryLocation* >
+      allocated_memory(this->_allocated_memory.begin(),
+                       this->_allocated_memory.end());
+
+  return std::make_unique< FunctionSummaryT >(std::move(exit),
+                                              this->_return_stmt,
+                                              std::move(parameters),
+                                              return_var,
+                                              std::move(allocated_memory),
+                                              this->may_write_memory(),
+                                              may_throw);
+}
+
+bool FunctionFixpoint::may_write_memory() const {
+  for (ar::BasicBlock* bb : *this->_function->body()) {
+    for (ar::Statement* stmt : *bb) {
+      if (auto store = dyn_cast< ar::Store >(stmt)) {
+        // Writes on local variables of the function are not visible
+        if (!isa< ar::LocalVariable >(store->pointer())) {
+          return true;
+        }
+      } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+        auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called());
+        if (cst == nullptr) {
+          return true;
+        }
+
+        const FunctionSummaryT* callee_summary =
+            this->_summaries.try_fetch(cst->function());
+        if (callee_summary == nullptr || callee_summary->may_write_memory()) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,9 +43,17 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_for_each.h>
+
+#include <ikos/analyzer/analysis/incremental.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/function_fixpoint.hpp>
@@ -61,6 +69,59 @@ namespace value {
 namespace intraprocedural {
 namespace concurrent {
 
+namespace {
+
+/// \brief Checkers of a worker thread, reused by all its tasks
+struct WorkerCheckers {
+  std::vector< std::unique_ptr< Checker > > checkers;
+
+  /// \brief True if a task of the worker is using the checkers
+  bool in_use = false;
+};
+
+/// \brief Checkers borrowed by a task from its worker thread
+///
+/// A worker waiting for nested parallel work can start another task while
+/// its checkers are in use. That task creates its own checkers.
+class TaskCheckers {
+private:
+  WorkerCheckers& _worker;
+  std::vector< std::unique_ptr< Checker > > _own;
+  bool _borrowed;
+
+public:
+  TaskCheckers(Context& ctx, WorkerCheckers& worker)
+      : _worker(worker), _borrowed(!worker.in_use) {
+    std::vector< std::unique_ptr< Checker > >& checkers =
+        this->_borrowed ? worker.checkers : this->_own;
+    if (checkers.empty()) {
+      for (CheckerName name : ctx.opts.analyses) {
+        checkers.emplace_back(make_checker(ctx, name));
+      }
+    }
+    if (this->_borrowed) {
+      worker.in_use = true;
+    }
+  }
+
+  TaskCheckers(const TaskCheckers&) = delete;
+  TaskCheckers(TaskCheckers&&) = delete;
+  TaskCheckers& operator=(const TaskCheckers&) = delete;
+  TaskCheckers& operator=(TaskCheckers&&) = delete;
+
+  ~TaskCheckers() {
+    if (this->_borrowed) {
+      this->_worker.in_use = false;
+    }
+  }
+
+  const std::vector< std::unique_ptr< Checker > >& get() const {
+    return this->_borrowed ? this->_worker.checkers : this->_own;
+  }
+};
+
+} // end anonymous namespace
+
 Analysis::Analysis(Context& ctx) : _ctx(ctx) {}
 
 Analysis::~Analysis() = default;
@@ -69,30 +130,19 @@ void Analysis::run() {
   // Bundle
   ar::Bundle* bundle = _ctx.bundle;
 
-  // Create checkers
-  std::vector< std::unique_ptr< Checker > > checkers;
-  if (_ctx.opts.use_checks) {
-    for (CheckerName name : _ctx.opts.analyses) {
-      checkers.emplace_back(make_checker(_ctx, name));
-    }
+  // Initialize the task scheduler
+  std::unique_ptr< tbb::global_control > scheduler;
+  if (_ctx.opts.num_threads > 0) {
+    scheduler = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(_ctx.opts.num_threads));
   }
 
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
-  // Setup a progress logger
-  std::unique_ptr< ProgressLogger > progress =
-      make_progress_logger(_ctx.opts.progress,
-                           LogLevel::Info,
-                           /* num_tasks = */
-                           2 * std::count_if(bundle->function_begin(),
-                                             bundle->function_end(),
-                                             [](ar::Function* fun) {
-                                               return fun->is_definition();
-                                             }));
-  ScopeLogger scope(*progress);
-
-  // Analyze every function in the bundle
+  // Collect the functions to analyze, with their number of statements
+  std::vector< std::pair< std::size_t, ar::Function* > > functions;
   for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
        ++it) {
@@ -105,24 +155,98 @@ void Analysis::run() {
       continue;
     }
 
-    FunctionFixpoint fixpoint(_ctx, function);
-
-    {
-      progress->start_task("Analyzing function '" + demangle(function->name()) +
-                           "'");
-      ScopeTimerDatabase t(_ctx.output_db->times,
-                           "ikos-analyzer.value." + function->name());
-      fixpoint.run(init_inv);
+    // Functions reused from a previous run are not analyzed again
+    if (_ctx.incremental != nullptr && _ctx.incremental->is_reused(function)) {
+      continue;
     }
 
-    if (!checkers.empty()) {
-      progress->start_task("Checking properties for function '" +
-                           demangle(function->name()) + "'");
-      ScopeTimerDatabase t(_ctx.output_db->times,
-                           "ikos-analyzer.check." + function->name());
-      fixpoint.run_checks(checkers);
+    // Create the fixpoint parameters now, FixpointParameters::get() is not
+    // thread-safe
+    _ctx.fixpoint_parameters->get(function);
+
+    std::size_t size = 0;
+    for (ar::BasicBlock* bb : *function->body()) {
+      size += bb->num_statements();
     }
+    functions.emplace_back(size, function);
   }
+
+  // Schedule the largest functions first, to avoid a long tail of work at the
+  // end of the analysis
+  std::stable_sort(functions.begin(),
+                   functions.end(),
+                   [](const std::pair< std::size_t, ar::Function* >& a,
+                      const std::pair< std::size_t, ar::Function* >& b) {
+                     return a.first > b.first;
+                   });
+
+  // Check the basic blocks while the fixpoint is still running
+  bool pipelined_checks = _ctx.opts.use_checks && !_ctx.opts.analyses.empty() &&
+                          _ctx.opts.use_pipelined_checks;
+
+  // Setup a progress logger
+  std::unique_ptr< ProgressLogger > progress =
+      make_progress_logger(_ctx.opts.progress,
+                           LogLevel::Info,
+                           /* num_tasks = */ (pipelined_checks ? 1 : 2) *
+                               functions.size());
+  ScopeLogger scope(*progress);
+
+  // Mutex for the progress logger
+  std::mutex progress_mutex;
+
+  // Checkers are created once per worker thread, on its first task
+  tbb::enumerable_thread_specific< WorkerCheckers > worker_checkers;
+
+  // Analyze all functions in parallel
+  //
+  // Each function fixpoint also spreads its basic blocks across the workers,
+  // so large functions still benefit from nested parallelism.
+  tbb::parallel_for_each(
+      functions.begin(),
+      functions.end(),
+      [&](const std::pair< std::size_t, ar::Function* >& entry) {
+        ar::Function* function = entry.second;
+
+        if (pipelined_checks) {
+          TaskCheckers checkers(_ctx, worker_checkers.local());
+          FunctionFixpoint fixpoint(_ctx, function, &checkers.get());
+          {
+            std::lock_guard< std::mutex > lock(progress_mutex);
+            progress->start_task("Analyzing and checking function '" +
+                                 demangle(function->name()) + "'");
+          }
+          ScopeTimerDatabase t(_ctx.output_db->times,
+                               "ikos-analyzer.value." + function->name());
+          fixpoint.run(init_inv);
+          return;
+        }
+
+        FunctionFixpoint fixpoint(_ctx, function);
+
+        {
+          {
+            std::lock_guard< std::mutex > lock(progress_mutex);
+            progress->start_task("Analyzing function '" +
+                                 demangle(function->name()) + "'");
+          }
+          ScopeTimerDatabase t(_ctx.output_db->times,
+                               "ikos-analyzer.value." + function->name());
+          fixpoint.run(init_inv);
+        }
+
+        if (_ctx.opts.use_checks && !_ctx.opts.analyses.empty()) {
+          TaskCheckers checkers(_ctx, worker_checkers.local());
+          {
+            std::lock_guard< std::mutex > lock(progress_mutex);
+            progress->start_task("Checking properties for function '" +
+                                 demangle(function->name()) + "'");
+          }
+          ScopeTimerDatabase t(_ctx.output_db->times,
+                               "ikos-analyzer.check." + function->name());
+          fixpoint.run_checks(checkers.get());
+        }
+      });
 }
 
 } // end namespace concurrent
@@ -46,6 +46,7 @@
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/function_fixpoint.hpp>
 
@@ -66,11 +67,23 @@ using ContextInsensitiveCallExecutionEngineT =
 
 } // end anonymous namespace
 
-FunctionFixpoint::FunctionFixpoint(Context& ctx, ar::Function* function)
-    : FwdFixpointIterator(function->body(), make_bottom_abstract_value(ctx)),
+FunctionFixpoint::FunctionFixpoint(
+    Context& ctx,
+    ar::Function* function,
+    const std::vector< std::unique_ptr< Checker > >* pipelined_checkers)
+    : FwdFixpointIterator(function->body(),
+                          ctx.fixpoint_orders->wpo(function->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_work_stealing
+                              ? core::ConcurrentScheduling::WorkStealing
+                              : core::ConcurrentScheduling::ParallelForEach,
+                          pipelined_checkers != nullptr
+                              ? core::ConcurrentProcessing::Pipelined
+                              : core::ConcurrentProcessing::AfterFixpoint),
       _ctx(ctx),
       _empty_call_context(ctx.call_context_factory->get_empty()),
-      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)) {}
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)),
+      _pipelined_checkers(pipelined_checkers) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
   FwdFixpointIterator::run(std::move(inv));
@@ -190,8 +203,12 @@ AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
   return std::move(exec_engine.inv());
 }
 
-void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
-                                   const AbstractDomain& /*pre*/) {}
+void FunctionFixpoint::process_pre(ar::BasicBlock* bb,
+                                   const AbstractDomain& pre) {
+  if (this->_pipelined_checkers != nullptr) {
+    this->check_block(bb, pre, *this->_pipelined_checkers);
+  }
+}
 
 void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
                                     const AbstractDomain& /*post*/) {}
@@ -199,34 +216,45 @@ void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
 void FunctionFixpoint::run_checks(
     const std::vector< std::unique_ptr< Checker > >& checkers) {
   for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_empty_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
-
-    exec_engine.exec_enter(bb);
-
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
-      }
+    this->check_block(bb, this->pre(bb), checkers);
+  }
+}
 
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+void FunctionFixpoint::check_block(
+    ar::BasicBlock* bb,
+    const AbstractDomain& pre,
+    const std::vector< std::unique_ptr< Checker > >& checkers) {
+  NumericalExecutionEngineT
+      exec_engine(pre,
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      exec_engine.inv().normalize();
+
+      // Checkers are not thread-safe, and blocks might be checked
+      // concurrently in pipelined mode
+      std::lock_guard< std::mutex > lock(this->_checkers_mutex);
+      for (const auto& checker : checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
 }
 
 } // end namespace concurrent
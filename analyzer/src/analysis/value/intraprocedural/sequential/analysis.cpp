@@ -44,6 +44,7 @@
 #include <memory>
 #include <vector>
 
+#include <ikos/analyzer/analysis/incremental.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/function_fixpoint.hpp>
@@ -78,6 +79,12 @@ void Analysis::run() {
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
+  // Functions reused from a previous run are not analyzed again
+  auto is_analyzed = [this](ar::Function* fun) {
+    return fun->is_definition() && (_ctx.incremental == nullptr ||
+                                    !_ctx.incremental->is_reused(fun));
+  };
+
   // Setup a progress logger
   std::unique_ptr< ProgressLogger > progress =
       make_progress_logger(_ctx.opts.progress,
@@ -85,9 +92,7 @@ void Analysis::run() {
                            /* num_tasks = */
                            2 * std::count_if(bundle->function_begin(),
                                              bundle->function_end(),
-                                             [](ar::Function* fun) {
-                                               return fun->is_definition();
-                                             }));
+                                             is_analyzed));
   ScopeLogger scope(*progress);
 
   // Analyze every function in the bundle
@@ -99,7 +104,7 @@ void Analysis::run() {
     // Insert the function in the database
     _ctx.output_db->functions.insert(function);
 
-    if (!function->is_definition()) {
+    if (!is_analyzed(function)) {
       continue;
     }
 
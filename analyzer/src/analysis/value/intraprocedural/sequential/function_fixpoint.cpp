@@ -44,6 +44,8 @@
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
+#include <ikos/analyzer/analysis/fixpoint_telemetry.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/function_fixpoint.hpp>
 
@@ -65,13 +67,27 @@ using ContextInsensitiveCallExecutionEngineT =
 } // end anonymous namespace
 
 FunctionFixpoint::FunctionFixpoint(Context& ctx, ar::Function* function)
-    : FwdFixpointIterator(function->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(function->body(),
+                          ctx.fixpoint_orders->wto(function->body()),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants
+                              ? core::InvariantStorage::Sparse
+                              : core::InvariantStorage::Full),
       _ctx(ctx),
+      _function(function),
       _empty_call_context(ctx.call_context_factory->get_empty()),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(function)) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
-  FwdFixpointIterator::run(std::move(inv));
+  if (this->_ctx.fixpoint_telemetry != nullptr) {
+    FixpointTelemetry::Statistics statistics;
+    this->set_statistics(&statistics);
+    FwdFixpointIterator::run(std::move(inv));
+    this->set_statistics(nullptr);
+    this->_ctx.fixpoint_telemetry->add(this->_function, statistics);
+  } else {
+    FwdFixpointIterator::run(std::move(inv));
+  }
 }
 
 AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
@@ -196,35 +212,57 @@ void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
 
 void FunctionFixpoint::run_checks(
     const std::vector< std::unique_ptr< Checker > >& checkers) {
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_empty_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
-
-    exec_engine.exec_enter(bb);
-
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
+  if (this->storage() == core::InvariantStorage::Full) {
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->check_block(bb, this->pre(bb), checkers);
+    }
+  } else {
+    // Recompute the pre invariants that are not stored
+    this->replay([&](ar::BasicBlock* bb, const AbstractDomain& pre) {
+      return this->check_block(bb, pre, checkers);
+    });
+
+    // Basic blocks unreachable from the entry
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      if (!this->wto().contains(bb)) {
+        this->check_block(bb, this->bottom(), checkers);
       }
+    }
+  }
+}
+
+AbstractDomain FunctionFixpoint::check_block(
+    ar::BasicBlock* bb,
+    const AbstractDomain& pre,
+    const std::vector< std::unique_ptr< Checker > >& checkers) {
+  NumericalExecutionEngineT
+      exec_engine(pre,
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
+
+  exec_engine.exec_enter(bb);
 
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      exec_engine.inv().normalize();
+      for (const auto& checker : checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
 }
 
 } // end namespace sequential
@@ -58,6 +58,8 @@ MachineIntAbstractDomain make_top_machine_int_abstract_value(
       return make_top_machine_int_interval_congruence();
     case MachineIntDomainOption::DBM:
       return make_top_machine_int_dbm();
+    case MachineIntDomainOption::SparseDBM:
+      return make_top_machine_int_sparse_dbm();
     case MachineIntDomainOption::VarPackDBM:
       return make_top_machine_int_var_pack_dbm();
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -109,6 +111,8 @@ MachineIntAbstractDomain make_bottom_machine_int_abstract_value(
       return make_bottom_machine_int_interval_congruence();
     case MachineIntDomainOption::DBM:
       return make_bottom_machine_int_dbm();
+    case MachineIntDomainOption::SparseDBM:
+      return make_bottom_machine_int_sparse_dbm();
     case MachineIntDomainOption::VarPackDBM:
       return make_bottom_machine_int_var_pack_dbm();
     case MachineIntDomainOption::VarPackDBMCongruence:
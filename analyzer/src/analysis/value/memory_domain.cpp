@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Implement make_(top|bottom)_static_memory_abstract_value
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/analyzer/analysis/value/memory_domain.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+bool has_static_memory_abstract_value(MachineIntDomainOption domain) {
+  switch (domain) {
+    case MachineIntDomainOption::Interval:
+    case MachineIntDomainOption::Congruence:
+    case MachineIntDomainOption::IntervalCongruence:
+    case MachineIntDomainOption::DBM:
+    case MachineIntDomainOption::SparseDBM:
+    case MachineIntDomainOption::VarPackDBM:
+    case MachineIntDomainOption::VarPackDBMCongruence:
+    case MachineIntDomainOption::Gauge:
+    case MachineIntDomainOption::GaugeIntervalCongruence:
+      return true;
+    default:
+      return false;
+  }
+}
+
+MemoryAbstractDomain make_top_static_memory_abstract_value(Context& ctx) {
+  switch (ctx.opts.machine_int_domain) {
+    case MachineIntDomainOption::Interval:
+      return make_top_memory_interval(ctx);
+    case MachineIntDomainOption::Congruence:
+      return make_top_memory_congruence(ctx);
+    case MachineIntDomainOption::IntervalCongruence:
+      return make_top_memory_interval_congruence(ctx);
+    case MachineIntDomainOption::DBM:
+      return make_top_memory_dbm(ctx);
+    case MachineIntDomainOption::SparseDBM:
+      return make_top_memory_sparse_dbm(ctx);
+    case MachineIntDomainOption::VarPackDBM:
+      return make_top_memory_var_pack_dbm(ctx);
+    case MachineIntDomainOption::VarPackDBMCongruence:
+      return make_top_memory_var_pack_dbm_congruence(ctx);
+    case MachineIntDomainOption::Gauge:
+      return make_top_memory_gauge(ctx);
+    case MachineIntDomainOption::GaugeIntervalCongruence:
+      return make_top_memory_gauge_interval_congruence(ctx);
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+MemoryAbstractDomain make_bottom_static_memory_abstract_value(Context& ctx) {
+  switch (ctx.opts.machine_int_domain) {
+    case MachineIntDomainOption::Interval:
+      return make_bottom_memory_interval(ctx);
+    case MachineIntDomainOption::Congruence:
+      return make_bottom_memory_congruence(ctx);
+    case MachineIntDomainOption::IntervalCongruence:
+      return make_bottom_memory_interval_congruence(ctx);
+    case MachineIntDomainOption::DBM:
+      return make_bottom_memory_dbm(ctx);
+    case MachineIntDomainOption::SparseDBM:
+      return make_bottom_memory_sparse_dbm(ctx);
+    case MachineIntDomainOption::VarPackDBM:
+      return make_bottom_memory_var_pack_dbm(ctx);
+    case MachineIntDomainOption::VarPackDBMCongruence:
+      return make_bottom_memory_var_pack_dbm_congruence(ctx);
+    case MachineIntDomainOption::Gauge:
+      return make_bottom_memory_gauge(ctx);
+    case MachineIntDomainOption::GaugeIntervalCongruence:
+      return make_bottom_memory_gauge_interval_congruence(ctx);
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
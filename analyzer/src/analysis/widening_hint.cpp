@@ -47,6 +47,7 @@
 
 #include <ikos/ar/semantic/statement.hpp>
 
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/widening_hint.hpp>
 #include <ikos/analyzer/support/cast.hpp>
@@ -198,8 +199,7 @@ void WideningHintAnalysis::run(ar::Function* fun) {
 
   CodeFixpointParameters& parameters = this->_ctx.fixpoint_parameters->get(fun);
   WideningHintWtoVisitor visitor(parameters.widening_hints);
-  core::Wto< ar::Code* > wto(fun->body());
-  wto.accept(visitor);
+  this->_ctx.fixpoint_orders->wto(fun->body())->accept(visitor);
 }
 
 } // end namespace analyzer
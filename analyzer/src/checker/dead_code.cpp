@@ -118,6 +118,11 @@ bool DeadCodeChecker::skip_check(ar::Statement* stmt) {
   }
 
   if (ar::isa< ar::Assignment >(stmt) || ar::isa< ar::UnaryOperation >(stmt)) {
+    if (stmt->frontend_isa< ar::SourceInfo >()) {
+      // Phi nodes and comparisons are marked as synthetic on export
+      return stmt->frontend< ar::SourceInfo >()->is_synthetic();
+    }
+
     auto value = stmt->frontend< llvm::Value >();
 
     if (llvm::isa< llvm::PHINode >(value) ||
@@ -46,18 +46,22 @@
 namespace ikos {
 namespace analyzer {
 
-OutputDatabase::OutputDatabase(sqlite::DbConnection& db_)
+OutputDatabase::OutputDatabase(sqlite::DbConnection& db_,
+                               sqlite::CommitPolicy commit_policy)
     : db(db_),
       settings(db_),
       times(db_),
+      stats(db_),
       files(db_),
       functions(db_, files),
       statements(db_, files, functions),
       operands(db_),
       call_contexts(db_, functions, statements),
       memory_locations(db_, functions, statements, call_contexts),
-      checks(db_, statements, operands, call_contexts) {
-  this->db.set_commit_policy(sqlite::CommitPolicy::Auto);
+      checks(db_, statements, operands, call_contexts),
+      fixpoint_stats(db_, functions, statements),
+      fingerprints(db_, functions) {
+  this->db.set_commit_policy(commit_policy);
 }
 
 } // end namespace analyzer
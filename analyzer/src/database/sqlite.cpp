@@ -43,6 +43,7 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <sstream>
 
 #include <ikos/core/support/compiler.hpp>
@@ -177,7 +178,15 @@ DbConnection::DbConnection(std::string filename)
 
 DbConnection::~DbConnection() {
   // The destructor shall not throw an exception. No error check.
-  if (this->_commit_policy == CommitPolicy::Auto) {
+  if (this->_commit_policy == CommitPolicy::Background) {
+    try {
+      this->stop_writer();
+    } catch (...) {
+    }
+  }
+
+  if (this->_commit_policy == CommitPolicy::Auto ||
+      this->_commit_policy == CommitPolicy::Background) {
     sqlite3_exec(this->_handle, "COMMIT", nullptr, nullptr, nullptr);
   }
 
@@ -213,21 +222,43 @@ void DbConnection::rollback_transaction() {
 }
 
 void DbConnection::set_commit_policy(CommitPolicy policy) {
-  if (this->_commit_policy == CommitPolicy::Auto) {
+  if (this->_commit_policy == CommitPolicy::Background) {
+    this->stop_writer();
+  }
+
+  if (this->_commit_policy == CommitPolicy::Auto ||
+      this->_commit_policy == CommitPolicy::Background) {
     this->exec_command("COMMIT");
     this->_inserted_rows = 0;
   }
 
   this->_commit_policy = policy;
 
-  if (this->_commit_policy == CommitPolicy::Auto) {
+  if (this->_commit_policy == CommitPolicy::Auto ||
+      this->_commit_policy == CommitPolicy::Background) {
     this->exec_command("BEGIN");
     this->_inserted_rows = 0;
   }
+
+  if (this->_commit_policy == CommitPolicy::Background) {
+    this->start_writer();
+  }
+}
+
+void DbConnection::flush() {
+  if (this->_commit_policy != CommitPolicy::Background) {
+    return;
+  }
+
+  for (DbOstream* stream : this->_streams) {
+    stream->submit_buffers();
+  }
+  this->wait_writer();
 }
 
 void DbConnection::row_inserted() {
-  if (this->_commit_policy == CommitPolicy::Auto) {
+  if (this->_commit_policy == CommitPolicy::Auto ||
+      this->_commit_policy == CommitPolicy::Background) {
     this->_inserted_rows++;
 
     if (this->_inserted_rows >= MaxRowsPerTransaction) {
@@ -238,6 +269,89 @@ void DbConnection::row_inserted() {
   }
 }
 
+void DbConnection::start_writer() {
+  this->_writer_stop = false;
+  this->_writer_busy = false;
+  this->_writer_error = nullptr;
+  this->_writer = std::thread([this] { this->run_writer(); });
+}
+
+void DbConnection::stop_writer() {
+  // Insert the rows still buffered in the output streams
+  for (DbOstream* stream : this->_streams) {
+    stream->submit_buffers();
+  }
+
+  {
+    std::lock_guard< std::mutex > lock(this->_writer_mutex);
+    this->_writer_stop = true;
+  }
+  this->_writer_wakeup.notify_one();
+  this->_writer.join();
+
+  std::lock_guard< std::mutex > lock(this->_writer_mutex);
+  this->check_writer_error();
+}
+
+void DbConnection::run_writer() {
+  std::unique_lock< std::mutex > lock(this->_writer_mutex);
+
+  while (true) {
+    this->_writer_wakeup.wait(lock, [this] {
+      return !this->_pending.empty() || this->_writer_stop;
+    });
+
+    if (this->_pending.empty()) {
+      // Stop requested and nothing left to insert
+      return;
+    }
+
+    PendingBatch batch = std::move(this->_pending.front());
+    this->_pending.pop_front();
+    this->_writer_busy = true;
+    lock.unlock();
+
+    try {
+      batch.stream->write(batch.values);
+    } catch (...) {
+      lock.lock();
+      if (!this->_writer_error) {
+        this->_writer_error = std::current_exception();
+      }
+      lock.unlock();
+    }
+
+    lock.lock();
+    this->_writer_busy = false;
+    if (this->_pending.empty()) {
+      this->_writer_idle.notify_all();
+    }
+  }
+}
+
+void DbConnection::submit(DbOstream* stream, std::vector< DbValue > values) {
+  {
+    std::lock_guard< std::mutex > lock(this->_writer_mutex);
+    this->check_writer_error();
+    this->_pending.push_back(PendingBatch{stream, std::move(values)});
+  }
+  this->_writer_wakeup.notify_one();
+}
+
+void DbConnection::wait_writer() {
+  std::unique_lock< std::mutex > lock(this->_writer_mutex);
+  this->_writer_idle.wait(lock, [this] {
+    return this->_pending.empty() && !this->_writer_busy;
+  });
+  this->check_writer_error();
+}
+
+void DbConnection::check_writer_error() {
+  if (this->_writer_error) {
+    std::rethrow_exception(this->_writer_error);
+  }
+}
+
 void DbConnection::drop_table(StringRef name) {
   std::string cmd("DROP TABLE IF EXISTS ");
   cmd += name;
@@ -350,10 +464,24 @@ DbOstream::DbOstream(DbConnection& db, StringRef table_name, int columns)
                   "DbOstream: cannot populate " + table_name.to_string() +
                       " in database " + this->_db.filename());
   }
+
+  this->_db._streams.push_back(this);
 }
 
 DbOstream::~DbOstream() {
   // The destructor shall not throw an exception. No error check is performed.
+  if (this->is_buffered()) {
+    try {
+      this->submit_buffers();
+      this->_db.wait_writer();
+    } catch (...) {
+    }
+  }
+
+  auto& streams = this->_db._streams;
+  streams.erase(std::remove(streams.begin(), streams.end(), this),
+                streams.end());
+
   sqlite3_finalize(_stmt);
 }
 
@@ -361,42 +489,106 @@ void DbOstream::add(StringRef s) {
   ikos_assert(s.size() <=
               static_cast< std::size_t >(std::numeric_limits< int >::max()));
 
-  int status = sqlite3_bind_text(this->_stmt,
-                                 this->_current_column++,
-                                 s.data(),
-                                 static_cast< int >(s.size()),
-                                 SQLITE_TRANSIENT);
-  if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::add(StringRef)");
+  if (this->is_buffered()) {
+    this->_buffers.local().emplace_back(s);
+  } else {
+    this->bind(this->_current_column++, DbValue(s));
+  }
+}
+
+void DbOstream::add(std::unique_ptr< const DbDeferredText > t) {
+  if (this->is_buffered()) {
+    this->_buffers.local().emplace_back(std::move(t));
+  } else {
+    this->bind(this->_current_column++, DbValue(std::move(t)));
   }
 }
 
 void DbOstream::add_null() {
-  int status = sqlite3_bind_null(this->_stmt, this->_current_column++);
-  if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::add_null()");
+  if (this->is_buffered()) {
+    this->_buffers.local().emplace_back();
+  } else {
+    this->bind(this->_current_column++, DbValue());
   }
 }
 
 void DbOstream::add(DbInt64 n) {
-  int status = sqlite3_bind_int64(this->_stmt, this->_current_column++, n);
-  if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::add(DbInt64)");
+  if (this->is_buffered()) {
+    this->_buffers.local().emplace_back(n);
+  } else {
+    this->bind(this->_current_column++, DbValue(n));
   }
 }
 
 void DbOstream::add(DbDouble d) {
-  int status = sqlite3_bind_double(this->_stmt, this->_current_column++, d);
-  if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::add(DbDouble)");
+  if (this->is_buffered()) {
+    this->_buffers.local().emplace_back(d);
+  } else {
+    this->bind(this->_current_column++, DbValue(d));
   }
 }
 
 void DbOstream::flush() {
+  if (this->is_buffered()) {
+    std::vector< DbValue >& buffer = this->_buffers.local();
+    ikos_assert_msg(buffer.size() % static_cast< std::size_t >(
+                                        this->_columns) ==
+                        0,
+                    "incomplete row");
+
+    if (buffer.size() >= static_cast< std::size_t >(this->_columns) *
+                             MaxRowsPerBatch) {
+      std::vector< DbValue > values;
+      values.swap(buffer);
+      this->_db.submit(this, std::move(values));
+    }
+    return;
+  }
+
   ikos_assert_msg(this->_current_column == this->_columns + 1,
                   "incomplete row");
   ikos_ignore(this->_columns);
 
+  this->step();
+  this->_current_column = 1;
+}
+
+void DbOstream::bind(int column, const DbValue& value) {
+  int status = SQLITE_OK;
+  switch (value.kind()) {
+    case DbValue::Kind::Null: {
+      status = sqlite3_bind_null(this->_stmt, column);
+    } break;
+    case DbValue::Kind::Integer: {
+      status = sqlite3_bind_int64(this->_stmt, column, value.integer());
+    } break;
+    case DbValue::Kind::Real: {
+      status = sqlite3_bind_double(this->_stmt, column, value.real());
+    } break;
+    case DbValue::Kind::Text: {
+      status = sqlite3_bind_text(this->_stmt,
+                                 column,
+                                 value.text().data(),
+                                 static_cast< int >(value.text().size()),
+                                 SQLITE_TRANSIENT);
+    } break;
+    case DbValue::Kind::DeferredText: {
+      std::string text = value.deferred_text().str();
+      ikos_assert(text.size() <= static_cast< std::size_t >(
+                                     std::numeric_limits< int >::max()));
+      status = sqlite3_bind_text(this->_stmt,
+                                 column,
+                                 text.data(),
+                                 static_cast< int >(text.size()),
+                                 SQLITE_TRANSIENT);
+    } break;
+  }
+  if (status != SQLITE_OK) {
+    throw DbError(status, "DbOstream::bind()");
+  }
+}
+
+void DbOstream::step() {
   int status = sqlite3_step(this->_stmt);
   if (status != SQLITE_DONE) {
     throw DbError(status, "DbOstream::flush(): step failed");
@@ -412,10 +604,31 @@ void DbOstream::flush() {
     throw DbError(status, "DbOstream::flush(): reset failed");
   }
 
-  this->_current_column = 1;
   this->_db.row_inserted();
 }
 
+void DbOstream::write(const std::vector< DbValue >& values) {
+  auto columns = static_cast< std::size_t >(this->_columns);
+  ikos_assert(values.size() % columns == 0);
+
+  for (std::size_t i = 0; i < values.size(); i += columns) {
+    for (std::size_t j = 0; j < columns; j++) {
+      this->bind(static_cast< int >(j + 1), values[i + j]);
+    }
+    this->step();
+  }
+}
+
+void DbOstream::submit_buffers() {
+  for (std::vector< DbValue >& buffer : this->_buffers) {
+    if (!buffer.empty()) {
+      std::vector< DbValue > values;
+      values.swap(buffer);
+      this->_db.submit(this, std::move(values));
+    }
+  }
+}
+
 // DbIstream
 
 DbIstream::DbIstream(DbConnection& db, std::string query)
@@ -63,9 +63,12 @@ CallContextsTable::CallContextsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
   ikos_assert(call_context != nullptr);
 
-  auto it = this->_map.find(call_context);
-  if (it != this->_map.end()) {
-    return it->second;
+  {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    auto it = this->_map.find(call_context);
+    if (it != this->_map.end()) {
+      return it->second;
+    }
   }
 
   // Insert the parent first
@@ -74,6 +77,14 @@ sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
     parent_id = this->insert(call_context->parent());
   }
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
+  // Another thread might have inserted it in the meantime
+  auto it = this->_map.find(call_context);
+  if (it != this->_map.end()) {
+    return it->second;
+  }
+
   // Insert row
   sqlite::DbInt64 id = this->_last_insert_id++;
 
@@ -101,5 +112,11 @@ sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
   return id;
 }
 
+void CallContextsTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
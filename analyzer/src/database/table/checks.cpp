@@ -46,6 +46,38 @@
 namespace ikos {
 namespace analyzer {
 
+namespace {
+
+/// \brief List of (operand number, operand id) pairs of a check
+///
+/// The JSON string is only built when the row is written, on the writer
+/// thread of the output database.
+class OperandsText final : public sqlite::DbDeferredText {
+private:
+  std::vector< std::pair< sqlite::DbInt64, sqlite::DbInt64 > > _operands;
+
+public:
+  /// \brief Reserve space for the given number of operands
+  void reserve(std::size_t n) { this->_operands.reserve(n); }
+
+  /// \brief Add an operand
+  void add(sqlite::DbInt64 operand_no, sqlite::DbInt64 operand_id) {
+    this->_operands.emplace_back(operand_no, operand_id);
+  }
+
+  /// \brief Return the JSON representation
+  std::string str() const override {
+    JsonList json_operands;
+    for (const auto& operand : this->_operands) {
+      json_operands.add(JsonList{operand.first, operand.second});
+    }
+    return json_operands.str();
+  }
+
+}; // end class OperandsText
+
+} // end anonymous namespace
+
 ChecksTable::ChecksTable(sqlite::DbConnection& db,
                          StatementsTable& statements,
                          OperandsTable& operands,
@@ -82,7 +114,8 @@ void ChecksTable::insert(CheckKind kind,
   this->_row << this->_statements.insert(stmt);
   if (!operands.empty() &&
       (status == Result::Warning || status == Result::Error)) {
-    JsonList json_operands;
+    auto operands_text = std::make_unique< OperandsText >();
+    operands_text->reserve(operands.size());
     for (auto operand : operands) {
       // Find operand number
       auto it = std::find(stmt->op_begin(), stmt->op_end(), operand);
@@ -90,9 +123,10 @@ void ChecksTable::insert(CheckKind kind,
       if (it != stmt->op_end()) {
         operand_no = static_cast< sqlite::DbInt64 >(it - stmt->op_begin());
       }
-      json_operands.add(JsonList{operand_no, this->_operands.insert(operand)});
+      operands_text->add(operand_no, this->_operands.insert(operand));
     }
-    this->_row << json_operands.str();
+    this->_row << std::unique_ptr< const sqlite::DbDeferredText >(
+        std::move(operands_text));
   } else {
     this->_row << sqlite::null;
   }
@@ -105,5 +139,10 @@ void ChecksTable::insert(CheckKind kind,
   this->_row << sqlite::end_row;
 }
 
+void ChecksTable::set_first_id(sqlite::DbInt64 id) {
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -58,6 +58,8 @@ FilesTable::FilesTable(sqlite::DbConnection& db)
 sqlite::DbInt64 FilesTable::insert(llvm::DIFile* file) {
   ikos_assert(file != nullptr);
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   // Check in _di_file_map
   {
     auto it = this->_di_file_map.find(file);
@@ -67,26 +69,63 @@ sqlite::DbInt64 FilesTable::insert(llvm::DIFile* file) {
   }
 
   // llvm::DIFile* are not unique, use _path_map
-  boost::filesystem::path path = source_path(file);
+  sqlite::DbInt64 id = this->insert_path(source_path(file).string());
+  this->_di_file_map.try_emplace(file, id);
+  return id;
+}
+
+sqlite::DbInt64 FilesTable::insert(const SourceLocation& loc) {
+  ikos_assert(loc);
+
+  if (llvm::DIFile* file = loc.file()) {
+    return this->insert(file);
+  }
+
+  return this->insert(loc.path());
+}
 
+sqlite::DbInt64 FilesTable::insert(const boost::filesystem::path& path) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  return this->insert_path(path.string());
+}
+
+sqlite::DbInt64 FilesTable::insert_path(const std::string& path) {
   // Check in _path_map
   {
-    auto it = this->_path_map.find(path.string());
+    auto it = this->_path_map.find(path);
     if (it != this->_path_map.end()) {
-      this->_di_file_map.try_emplace(file, it->second);
       return it->second;
     }
   }
 
-  sqlite::DbInt64 id = this->_last_insert_id++;
+  sqlite::DbInt64 id;
+  auto it = this->_previous_ids.find(path);
+  if (it != this->_previous_ids.end()) {
+    id = it->second;
+    this->_previous_ids.erase(it);
+  } else {
+    id = this->_last_insert_id++;
+  }
+
   this->_row << id;
-  this->_row << path.string();
+  this->_row << path;
   this->_row << sqlite::end_row;
 
-  this->_di_file_map.try_emplace(file, id);
-  this->_path_map.try_emplace(path.string(), id);
+  this->_path_map.try_emplace(path, id);
   return id;
 }
 
+void FilesTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
+void FilesTable::reuse_id(const std::string& path, sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(id < this->_last_insert_id);
+  this->_previous_ids.try_emplace(path, id);
+}
+
 } // end namespace analyzer
 } // end namespace ikos
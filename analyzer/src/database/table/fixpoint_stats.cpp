@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief FixpointStatsTable implementation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2011-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/analyzer/database/table/fixpoint_stats.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+FixpointStatsTable::FixpointStatsTable(sqlite::DbConnection& db,
+                                       FunctionsTable& functions,
+                                       StatementsTable& statements)
+    : DatabaseTable(db,
+                    "fixpoint_stats",
+                    {{"function_id", sqlite::DbColumnType::Integer},
+                     {"statement_id", sqlite::DbColumnType::Integer},
+                     {"runs", sqlite::DbColumnType::Integer},
+                     {"increasing_iterations", sqlite::DbColumnType::Integer},
+                     {"decreasing_iterations", sqlite::DbColumnType::Integer},
+                     {"widenings", sqlite::DbColumnType::Integer},
+                     {"narrowings", sqlite::DbColumnType::Integer},
+                     {"transfer_time", sqlite::DbColumnType::Real},
+                     {"join_time", sqlite::DbColumnType::Real},
+                     {"widening_time", sqlite::DbColumnType::Real},
+                     {"narrowing_time", sqlite::DbColumnType::Real},
+                     {"max_variables", sqlite::DbColumnType::Integer},
+                     {"max_cells", sqlite::DbColumnType::Integer}},
+                    {"function_id"}),
+      _functions(functions),
+      _statements(statements),
+      _row(db, "fixpoint_stats", 13) {}
+
+void FixpointStatsTable::insert(ar::Function* fun,
+                                ar::BasicBlock* head,
+                                sqlite::DbInt64 runs,
+                                const core::FixpointCounters& counters) {
+  // Locate the cycle with the first statement of the head
+  ar::Statement* stmt = nullptr;
+  if (head != nullptr) {
+    for (ar::Statement* s : *head) {
+      if (s->has_frontend()) {
+        stmt = s;
+        break;
+      }
+    }
+    if (stmt == nullptr) {
+      return;
+    }
+  }
+
+  this->_row << this->_functions.insert(fun);
+  if (stmt != nullptr) {
+    this->_row << this->_statements.insert(stmt);
+  } else {
+    this->_row << sqlite::null;
+  }
+  this->_row << runs;
+  this->_row << static_cast< sqlite::DbInt64 >(counters.increasing_iterations);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.decreasing_iterations);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.widenings);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.narrowings);
+  this->_row << counters.transfer_time;
+  this->_row << counters.join_time;
+  this->_row << counters.widening_time;
+  this->_row << counters.narrowing_time;
+  this->_row << static_cast< sqlite::DbInt64 >(counters.max_variables);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.max_cells);
+  this->_row << sqlite::end_row;
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -66,14 +66,25 @@ FunctionsTable::FunctionsTable(sqlite::DbConnection& db, FilesTable& files)
 sqlite::DbInt64 FunctionsTable::insert(ar::Function* fun) {
   ikos_assert(fun != nullptr);
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   auto it = this->_map.find(fun);
   if (it != this->_map.end()) {
     return it->second;
   }
 
-  sqlite::DbInt64 id = this->_last_insert_id++;
   StringRef fun_name = name(fun);
 
+  sqlite::DbInt64 id;
+  auto prev = this->_previous_ids.find(
+      llvm::StringRef(fun_name.data(), fun_name.size()));
+  if (prev != this->_previous_ids.end()) {
+    id = prev->second;
+    this->_previous_ids.erase(prev);
+  } else {
+    id = this->_last_insert_id++;
+  }
+
   this->_row << id;
   this->_row << fun_name;
   if (is_mangled(fun_name)) {
@@ -83,7 +94,17 @@ sqlite::DbInt64 FunctionsTable::insert(ar::Function* fun) {
   }
   this->_row << (fun->is_definition() ? sqlite::DbInt64(1)
                                       : sqlite::DbInt64(0));
-  if (fun->has_frontend()) {
+  if (fun->frontend_isa< ar::SourceInfo >()) {
+    auto info = fun->frontend< ar::SourceInfo >();
+    if (info->has_location()) {
+      this->_row << this->_files.insert(
+          boost::filesystem::path(info->file.to_string()));
+      this->_row << static_cast< sqlite::DbInt64 >(info->line);
+    } else {
+      this->_row << sqlite::null;
+      this->_row << sqlite::null;
+    }
+  } else if (fun->has_frontend()) {
     auto llvm_fun = fun->frontend< llvm::Function >();
     llvm::DISubprogram* dbg = llvm_fun->getSubprogram();
     if (dbg != nullptr) {
@@ -109,6 +130,11 @@ StringRef FunctionsTable::name(ar::Function* fun) {
     return fun->name();
   }
 
+  if (fun->frontend_isa< ar::SourceInfo >()) {
+    auto info = fun->frontend< ar::SourceInfo >();
+    return info->has_name() ? info->name : fun->name();
+  }
+
   return name(fun->frontend< llvm::Function >());
 }
 
@@ -117,5 +143,17 @@ StringRef FunctionsTable::name(llvm::Function* fun) {
   return to_string_ref(fun->getName());
 }
 
+void FunctionsTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
+void FunctionsTable::reuse_id(const std::string& name, sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(id < this->_last_insert_id);
+  this->_previous_ids.try_emplace(name, id);
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -73,6 +73,8 @@ MemoryLocationsTable::MemoryLocationsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 MemoryLocationsTable::insert(MemoryLocation* mem_loc) {
   ikos_assert(mem_loc != nullptr);
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   auto it = this->_map.find(mem_loc);
   if (it != this->_map.end()) {
     return it->second;
@@ -98,6 +100,15 @@ JsonDict MemoryLocationsTable::info(MemoryLocation* mem_loc) {
   if (auto local_mem_loc = dyn_cast< LocalMemoryLocation >(mem_loc)) {
     ar::LocalVariable* lv = local_mem_loc->local_var();
     ikos_assert(lv->has_frontend());
+
+    if (lv->frontend_isa< ar::SourceInfo >()) {
+      auto src_info = lv->frontend< ar::SourceInfo >();
+      if (src_info->has_name()) {
+        return {{"name", src_info->name.to_string()}};
+      }
+      return {};
+    }
+
     auto value = lv->frontend< llvm::Value >();
     auto alloca = llvm::cast< llvm::AllocaInst >(value);
 
@@ -148,6 +159,18 @@ JsonDict MemoryLocationsTable::info(MemoryLocation* mem_loc) {
   } else if (auto global_mem_loc = dyn_cast< GlobalMemoryLocation >(mem_loc)) {
     ar::GlobalVariable* gv = global_mem_loc->global_var();
     ikos_assert(gv->has_frontend());
+
+    if (gv->frontend_isa< ar::SourceInfo >()) {
+      auto src_info = gv->frontend< ar::SourceInfo >();
+      std::string name = src_info->has_name() ? src_info->name.to_string()
+                                              : gv->name();
+      if (is_mangled(name)) {
+        return {{"name", name}, {"demangle", demangle(name)}};
+      } else {
+        return {{"name", name}};
+      }
+    }
+
     auto llvm_gv = gv->frontend< llvm::GlobalVariable >();
 
     // Check for debug info
@@ -201,5 +224,11 @@ JsonDict MemoryLocationsTable::info(MemoryLocation* mem_loc) {
   }
 }
 
+void MemoryLocationsTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -77,6 +77,8 @@ OperandsTable::OperandsTable(sqlite::DbConnection& db)
 sqlite::DbInt64 OperandsTable::insert(ar::Value* value) {
   ikos_assert(value != nullptr);
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   auto it = this->_map.find(value);
   if (it != this->_map.end()) {
     return it->second;
@@ -1022,6 +1024,11 @@ struct OperandReprVisitor {
 
   std::string operator()(ar::GlobalVariable* gv) const {
     ikos_assert(gv->has_frontend());
+
+    if (gv->frontend_isa< ar::SourceInfo >()) {
+      return "&" + source_info_repr(gv, "__unnamed_global_var");
+    }
+
     auto llvm_gv = gv->frontend< llvm::GlobalVariable >();
 
     // Check for debug info
@@ -1052,6 +1059,11 @@ struct OperandReprVisitor {
 
   std::string operator()(ar::LocalVariable* lv) const {
     ikos_assert(lv->has_frontend());
+
+    if (lv->frontend_isa< ar::SourceInfo >()) {
+      return "&" + source_info_repr(lv, "__unnamed_local_var");
+    }
+
     auto value = lv->frontend< llvm::Value >();
     ikos_assert(llvm::isa< llvm::AllocaInst >(value));
     auto alloca = llvm::cast< llvm::AllocaInst >(value);
@@ -1104,10 +1116,32 @@ struct OperandReprVisitor {
 
   std::string operator()(ar::InternalVariable* iv) const {
     ikos_assert(iv->has_frontend());
+
+    if (iv->frontend_isa< ar::SourceInfo >()) {
+      return source_info_repr(iv, "__unnamed_var");
+    }
+
     auto value = iv->frontend< llvm::Value >();
     return OperandsTable::repr(value);
   }
 
+  /// \brief Return the representation of a variable loaded from the AR binary
+  /// format
+  ///
+  /// Only the source name is available, since there is no llvm::Module.
+  static std::string source_info_repr(ar::Variable* var,
+                                      const char* unnamed) {
+    auto info = var->frontend< ar::SourceInfo >();
+
+    if (info->has_name()) {
+      return demangle(info->name);
+    } else if (var->has_name()) {
+      return var->name();
+    } else {
+      return unnamed;
+    }
+  }
+
 }; // end struct OperandReprVisitor
 
 } // end anonymous namespace
@@ -1129,5 +1163,11 @@ std::string OperandsTable::repr(ar::Value* value) {
   return ar::apply_visitor(detail::OperandReprVisitor{}, value);
 }
 
+void OperandsTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -66,6 +66,8 @@ StatementsTable::StatementsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
   ikos_assert(stmt != nullptr);
 
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   auto it = this->_map.find(stmt);
   if (it != this->_map.end()) {
     return it->second;
@@ -83,7 +85,7 @@ sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
   ikos_assert(stmt->has_frontend());
   SourceLocation loc = source_location(stmt);
   if (loc) {
-    this->_row << this->_files.insert(loc.file());
+    this->_row << this->_files.insert(loc);
     this->_row << static_cast< sqlite::DbInt64 >(loc.line());
     this->_row << static_cast< sqlite::DbInt64 >(loc.column());
   } else {
@@ -98,5 +100,11 @@ sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
   return id;
 }
 
+void StatementsTable::set_first_id(sqlite::DbInt64 id) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ikos_assert(this->_last_insert_id == 0);
+  this->_last_insert_id = id;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
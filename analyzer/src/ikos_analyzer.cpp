@@ -53,11 +53,16 @@
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/Debug.h>
 #include <llvm/Support/InitLLVM.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Process.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/WithColor.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <ikos/core/adt/patricia_tree/hash_consing.hpp>
+#include <ikos/core/adt/patricia_tree/node.hpp>
+
+#include <ikos/ar/format/binary.hpp>
 #include <ikos/ar/format/dot.hpp>
 #include <ikos/ar/format/formatter.hpp>
 #include <ikos/ar/format/text.hpp>
@@ -73,8 +78,12 @@
 
 #include <ikos/analyzer/analysis/call_context.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/fingerprint.hpp>
+#include <ikos/analyzer/analysis/fixpoint_order.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
+#include <ikos/analyzer/analysis/fixpoint_telemetry.hpp>
 #include <ikos/analyzer/analysis/hardware_addresses.hpp>
+#include <ikos/analyzer/analysis/incremental.hpp>
 #include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/analysis/liveness.hpp>
 #include <ikos/analyzer/analysis/memory_location.hpp>
@@ -84,6 +93,7 @@
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/analysis.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/analysis.hpp>
 #include <ikos/analyzer/analysis/variable.hpp>
@@ -95,6 +105,7 @@
 #include <ikos/analyzer/util/timer.hpp>
 
 namespace ar = ikos::ar;
+namespace core = ikos::core;
 namespace llvm_to_ar = ikos::frontend::import;
 namespace analyzer = ikos::analyzer;
 
@@ -109,6 +120,12 @@ static llvm::cl::opt< std::string > InputFilename(
     llvm::cl::Required,
     llvm::cl::value_desc("file"));
 
+static llvm::cl::opt< bool > InputAR(
+    "input-ar",
+    llvm::cl::desc("The input file is an AR bundle written by "
+                   "ikos-import -emit-ar-bin, instead of LLVM bitcode"),
+    llvm::cl::cat(MainCategory));
+
 static llvm::cl::opt< std::string > OutputFilename(
     "o",
     llvm::cl::desc("Output database filename (default: output.db)"),
@@ -237,6 +254,10 @@ static llvm::cl::opt< analyzer::MachineIntDomainOption > Domain(
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::DBM),
                    "Difference-Bound Matrices domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::SparseDBM,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::SparseDBM),
+                   "Difference-Bound Matrices domain in sparse representation"),
         clEnumValN(analyzer::MachineIntDomainOption::VarPackDBM,
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::VarPackDBM),
@@ -346,7 +367,10 @@ static llvm::cl::opt< analyzer::Procedural > Procedural(
                                 "Interprocedural analysis (default)"),
                      clEnumValN(analyzer::Procedural::Intraprocedural,
                                 "intra",
-                                "Intraprocedural analysis")),
+                                "Intraprocedural analysis"),
+                     clEnumValN(analyzer::Procedural::Summary,
+                                "summary",
+                                "Bottom-up function summary analysis")),
     llvm::cl::init(analyzer::Procedural::Interprocedural),
     llvm::cl::cat(AnalysisCategory));
 
@@ -429,11 +453,61 @@ static llvm::cl::opt< bool > EnablePartitioningDomain(
     llvm::cl::desc("Enable the partitioning abstract domain"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > NoStaticDispatch(
+    "no-static-dispatch",
+    llvm::cl::desc("Use virtual dispatch for the machine integer abstract "
+                   "domain"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > HashConsing(
+    "hash-consing",
+    llvm::cl::desc("Share structurally equal subtrees of abstract states and "
+                   "memoize binary operations"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoFixpointCache(
     "no-fixpoint-cache",
     llvm::cl::desc("Disable the cache of fixpoints"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< unsigned > FixpointMemoSize(
+    "fixpoint-memo-size",
+    llvm::cl::desc("Maximum number of fixpoints on called functions memoized "
+                   "by entry invariant (0 to disable)"),
+    llvm::cl::init(0),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > SparseInvariants(
+    "sparse-invariants",
+    llvm::cl::desc("Only keep the invariants of cycle heads, recompute the "
+                   "others when running the checks"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > WorkStealing(
+    "work-stealing",
+    llvm::cl::desc("Schedule basic blocks with work stealing in concurrent "
+                   "analyses"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > PipelinedChecks(
+    "pipelined-checks",
+    llvm::cl::desc("Check basic blocks as soon as their invariants are stable "
+                   "in the concurrent intraprocedural analysis"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > FixpointTelemetry(
+    "fixpoint-telemetry",
+    llvm::cl::desc("Save statistics on the fixpoint iterations of each "
+                   "function and loop"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< std::string > IncrementalDb(
+    "incremental-db",
+    llvm::cl::desc("Reuse the results of the unchanged functions from the "
+                   "output database of a previous run"),
+    llvm::cl::value_desc("file"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoChecks("no-checks",
                                       llvm::cl::desc("Disable all the checks"),
                                       llvm::cl::cat(AnalysisCategory));
@@ -508,6 +582,12 @@ static llvm::cl::opt< bool > AllowDebugInfoMismatch(
     llvm::cl::desc("Allow incorrect debug information in the module"),
     llvm::cl::cat(ImportCategory));
 
+static llvm::cl::opt< bool > NoPruneUnreachable(
+    "no-prune-unreachable",
+    llvm::cl::desc("Import the functions unreachable from the entry points "
+                   "(only for interprocedural analysis)"),
+    llvm::cl::cat(ImportCategory));
+
 /// @}
 /// \name Passes options
 /// @{
@@ -627,6 +707,12 @@ static llvm::cl::opt< analyzer::DisplayOption > DisplayChecks(
     llvm::cl::init(analyzer::DisplayOption::None),
     llvm::cl::cat(DebugCategory));
 
+static llvm::cl::opt< bool > NoBackgroundDbWriter(
+    "no-background-db-writer",
+    llvm::cl::desc("Insert the rows of the output database from the analysis "
+                   "thread instead of a writer thread (requires -j=1)"),
+    llvm::cl::cat(DebugCategory));
+
 /// @}
 /// \name Formatting options
 /// @{
@@ -787,6 +873,29 @@ parse_function_names_to_unsigned(const llvm::cl::list< std::string >& opt,
   return map;
 }
 
+/// \brief Return true if the functions unreachable from the entry points
+/// should be removed before the translation
+static bool prune_unreachable() {
+  // Other analyses also analyze functions that are not reachable
+  return Procedural == analyzer::Procedural::Interprocedural &&
+         !NoPruneUnreachable &&
+         std::find(EntryPoints.begin(), EntryPoints.end(), "*") ==
+             EntryPoints.end();
+}
+
+/// \brief Return the names of the functions the reachability starts from
+///
+/// Functions given to -no-init-globals must also be defined.
+static std::vector< std::string > entry_point_names() {
+  std::vector< std::string > names;
+  names.insert(names.end(), EntryPoints.begin(), EntryPoints.end());
+  names.insert(names.end(), NoInitGlobals.begin(), NoInitGlobals.end());
+  for (std::string& name : names) {
+    boost::trim(name);
+  }
+  return names;
+}
+
 /// \brief Build analysis options from command line arguments
 static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
   return analyzer::AnalysisOptions{
@@ -810,7 +919,14 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .use_pointer = !NoPointer,
       .use_widening_hints = !NoWideningHints,
       .use_partitioning_domain = EnablePartitioningDomain,
+      .use_static_dispatch = !NoStaticDispatch,
+      .use_hash_consing = HashConsing,
       .use_fixpoint_cache = !NoFixpointCache,
+      .fixpoint_memo_size = FixpointMemoSize,
+      .use_sparse_invariants = SparseInvariants,
+      .use_work_stealing = WorkStealing,
+      .use_pipelined_checks = PipelinedChecks,
+      .use_fixpoint_telemetry = FixpointTelemetry,
       .use_checks = !NoChecks,
       .trace_ar_statements = TraceARStmts,
       .globals_init_policy = GlobalsInitPolicy,
@@ -890,6 +1006,30 @@ int main(int argc, char** argv) {
   // Enable colors, if asked
   analyzer::color::Enable = colors_enabled();
 
+  // The previous output database must exist, and must not be overwritten
+  if (!IncrementalDb.empty()) {
+    boost::system::error_code ec;
+    if (!boost::filesystem::exists(IncrementalDb.getValue())) {
+      llvm::errs() << progname << ": " << IncrementalDb
+                   << ": error: no such file\n";
+      return 1;
+    }
+    if (boost::filesystem::equivalent(IncrementalDb.getValue(),
+                                      OutputFilename.getValue(),
+                                      ec)) {
+      llvm::errs() << progname << ": " << IncrementalDb
+                   << ": error: same file as the output database\n";
+      return 1;
+    }
+  }
+
+  // Without the writer thread, the tables are not thread-safe
+  if (NoBackgroundDbWriter && Jobs != 1) {
+    llvm::errs() << progname
+                 << ": error: -no-background-db-writer requires -j=1\n";
+    return 1;
+  }
+
   try {
     // Initialize output database
     // This might throw DbError, see catch()
@@ -897,66 +1037,115 @@ int main(int argc, char** argv) {
     analyzer::sqlite::DbConnection db(OutputFilename);
     db.set_journal_mode(analyzer::sqlite::JournalMode::Off);
     db.set_synchronous_flag(analyzer::sqlite::SynchronousFlag::Off);
-    analyzer::OutputDatabase output_db(db);
+    analyzer::OutputDatabase output_db(
+        db,
+        NoBackgroundDbWriter ? analyzer::sqlite::CommitPolicy::Auto
+                             : analyzer::sqlite::CommitPolicy::Background);
 
-    // Load the input module
+    // Input module or binary AR, the front-end objects of the AR point into it
     std::unique_ptr< llvm::Module > module = nullptr;
-    {
-      analyzer::log::debug("Loading LLVM bitcode");
-      analyzer::ScopeTimerDatabase t(output_db.times, "ikos-analyzer.load-bc");
-      llvm::SMDiagnostic err; // Error diagnostic
-      module = llvm::parseIRFile(InputFilename, err, llvm_context);
-      if (!module) {
-        err.print(progname.c_str(), llvm::errs());
+    std::unique_ptr< llvm::MemoryBuffer > ar_buffer = nullptr;
+    ar::BinaryReader ar_reader;
+
+    // AR context
+    ar::Context ar_context;
+
+    ar::Bundle* bundle = nullptr;
+    if (InputAR) {
+      // Load the AR written by ikos-import, which already ran the type
+      // checker and the simplify-cfg pass.
+      // This might throw FormatError, see catch()
+      analyzer::log::info("Loading AR");
+      analyzer::ScopeTimerDatabase t(output_db.times, "ikos-analyzer.load-ar");
+      // Memory map the file, strings of the source information point into it
+      llvm::ErrorOr< std::unique_ptr< llvm::MemoryBuffer > > buffer =
+          llvm::MemoryBuffer::getFile(InputFilename,
+                                      /*IsText = */ false,
+                                      /*RequiresNullTerminator = */ false);
+      if (!buffer) {
+        llvm::errs() << progname << ": " << InputFilename
+                     << ": error: " << buffer.getError().message() << "\n";
         return 2;
       }
-    }
+      ar_buffer = std::move(*buffer);
+      bundle = ar_reader.read(ar_context,
+                              ar_buffer->getBufferStart(),
+                              ar_buffer->getBufferSize());
+    } else {
+      // Load the input module
+      {
+        analyzer::log::debug("Loading LLVM bitcode");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.load-bc");
+        llvm::SMDiagnostic err; // Error diagnostic
+        if (prune_unreachable()) {
+          // Function bodies are only parsed if they are reachable
+          module = llvm::getLazyIRFileModule(InputFilename, err, llvm_context);
+        } else {
+          module = llvm::parseIRFile(InputFilename, err, llvm_context);
+        }
+        if (!module) {
+          err.print(progname.c_str(), llvm::errs());
+          return 2;
+        }
+      }
 
-    // Immediately run the verifier to catch any problems
-    if (!NoVerify) {
-      analyzer::log::debug("Verifying integrity of LLVM bitcode");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.verify-bc");
-      if (verifyModule(*module, &llvm::errs())) {
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": error: input module is broken!\n";
-        return 3;
+      // Remove the functions unreachable from the entry points
+      // This might throw ImportError, see catch()
+      if (prune_unreachable()) {
+        analyzer::log::debug("Removing functions unreachable from the entry "
+                             "points");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.prune-unreachable");
+        std::size_t num_removed =
+            llvm_to_ar::prune_unreachable_functions(*module,
+                                                    entry_point_names());
+        analyzer::log::debug("Removed " + std::to_string(num_removed) +
+                             " unreachable functions");
       }
-    }
 
-    // Check for debug information in LLVM
-    {
-      analyzer::log::debug("Checking for debug information");
-      if (!llvm_to_ar::has_debug_info(*module)) {
-        // We warn but allow analysis to proceed.
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": warning: llvm bitcode has no debug information\n";
+      // Immediately run the verifier to catch any problems
+      if (!NoVerify) {
+        analyzer::log::debug("Verifying integrity of LLVM bitcode");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.verify-bc");
+        if (verifyModule(*module, &llvm::errs())) {
+          llvm::errs() << progname << ": " << InputFilename
+                       << ": error: input module is broken!\n";
+          return 3;
+        }
       }
-    }
 
-    // AR context
-    ar::Context ar_context;
+      // Check for debug information in LLVM
+      {
+        analyzer::log::debug("Checking for debug information");
+        if (!llvm_to_ar::has_debug_info(*module)) {
+          // We warn but allow analysis to proceed.
+          llvm::errs() << progname << ": " << InputFilename
+                       << ": warning: llvm bitcode has no debug information\n";
+        }
+      }
 
-    // Translate LLVM bitcode into AR
-    // This might throw ImportError, see catch()
-    ar::Bundle* bundle = nullptr;
-    {
-      analyzer::log::info("Translating LLVM bitcode to AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.llvm-to-ar");
-      llvm_to_ar::Importer importer(ar_context);
-      bundle = importer.import(*module, make_import_options());
-    }
+      // Translate LLVM bitcode into AR
+      // This might throw ImportError, see catch()
+      {
+        analyzer::log::info("Translating LLVM bitcode to AR");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.llvm-to-ar");
+        llvm_to_ar::Importer importer(ar_context);
+        bundle = importer.import(*module, make_import_options(), Jobs);
+      }
 
-    // Run type checker
-    if (!NoTypeCheck) {
-      analyzer::log::debug("Running type verifier on AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.type-checker");
-      if (!ar::TypeVerifier(/*all = */ true).verify(bundle, std::cerr)) {
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": error: type checker\n";
-        return 7;
+      // Run type checker
+      if (!NoTypeCheck) {
+        analyzer::log::debug("Running type verifier on AR");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.type-checker");
+        if (!ar::TypeVerifier(/*all = */ true).verify(bundle, std::cerr)) {
+          llvm::errs() << progname << ": " << InputFilename
+                       << ": error: type checker\n";
+          return 7;
+        }
       }
     }
 
@@ -966,7 +1155,7 @@ int main(int argc, char** argv) {
     }
 
     // Simplify the control flow graph
-    if (!NoSimplifyCFG) {
+    if (!InputAR && !NoSimplifyCFG) {
       analyzer::log::debug("Running simplify-cfg pass on AR");
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.simplify-cfg");
@@ -1026,6 +1215,11 @@ int main(int argc, char** argv) {
     analyzer::AnalysisOptions opts = make_analysis_options(bundle);
     opts.save(output_db.settings);
 
+    // Patricia trees are only shared between threads by concurrent analyses
+    core::patricia_tree_utils::set_thread_safe_reference_count(
+        opts.num_threads != 1);
+    core::patricia_tree_utils::set_hash_consing(opts.use_hash_consing);
+
     // Initialize factories
     analyzer::MemoryFactory mem_factory;
     analyzer::VariableFactory var_factory(bundle);
@@ -1035,6 +1229,15 @@ int main(int argc, char** argv) {
     // Fixpoint parameters
     analyzer::FixpointParameters fixpoint_parameters(opts);
 
+    // Weak topological and partial orders, shared by all the fixpoints
+    analyzer::FixpointOrders fixpoint_orders(opts);
+    {
+      analyzer::log::info("Computing weak topological orders");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.fixpoint-orders");
+      fixpoint_orders.build(bundle);
+    }
+
     // Analysis context
     analyzer::Context ctx(bundle,
                           opts,
@@ -1044,7 +1247,29 @@ int main(int argc, char** argv) {
                           var_factory,
                           lit_factory,
                           call_context_factory,
-                          fixpoint_parameters);
+                          fixpoint_parameters,
+                          fixpoint_orders);
+
+    // Statistics on the fixpoints of the value analysis
+    analyzer::FixpointTelemetry fixpoint_telemetry;
+    if (FixpointTelemetry) {
+      ctx.fixpoint_telemetry = &fixpoint_telemetry;
+      if (Jobs != 1 && Procedural != analyzer::Procedural::Summary) {
+        analyzer::log::warning(
+            "-fixpoint-telemetry is ignored by the concurrent analyses, use "
+            "-j=1 to record fixpoint statistics");
+      }
+    }
+
+    // Results of a previous run
+    analyzer::IncrementalAnalysis incremental(ctx, IncrementalDb);
+    if (!IncrementalDb.empty()) {
+      analyzer::log::info("Loading previous analysis results");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.incremental-load");
+      incremental.load();
+      ctx.incremental = &incremental;
+    }
 
     // Run a liveness analysis
     //
@@ -1081,7 +1306,7 @@ int main(int argc, char** argv) {
     // The goal here is to get all function pointers so that we can analyse
     // precisely indirect calls in the following analyses
     analyzer::FunctionPointerAnalysis function_pointer(ctx);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    if (Procedural != analyzer::Procedural::Interprocedural && !NoPointer) {
       analyzer::log::info("Running function pointer analysis");
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.function-pointer-analysis");
@@ -1096,7 +1321,7 @@ int main(int argc, char** argv) {
     //
     // That step uses the result of the previous function pointer analysis.
     analyzer::PointerAnalysis pointer(ctx, function_pointer);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    if (Procedural != analyzer::Procedural::Interprocedural && !NoPointer) {
       analyzer::log::info("Running pointer analysis");
       analyzer::ScopeTimerDatabase t(output_db.times,
                                      "ikos-analyzer.pointer-analysis");
@@ -1107,6 +1332,19 @@ int main(int argc, char** argv) {
       pointer.dump(analyzer::log::msg().stream());
     }
 
+    // Compute the fingerprints of the functions
+    //
+    // They are saved for the next incremental analysis, and used to find the
+    // functions that did not change since the previous run
+    analyzer::FunctionFingerprints fingerprints(ctx);
+    {
+      analyzer::log::info("Computing function fingerprints");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.fingerprints");
+      fingerprints.run();
+      incremental.run(fingerprints);
+    }
+
     // Final step, run a value analysis, and check properties on the results
     if (Procedural == analyzer::Procedural::Interprocedural) {
       analyzer::log::info("Running interprocedural value analysis");
@@ -1126,9 +1364,28 @@ int main(int argc, char** argv) {
       } else {
         analyzer::value::intraprocedural::concurrent::Analysis(ctx).run();
       }
+    } else if (Procedural == analyzer::Procedural::Summary) {
+      analyzer::log::info("Running bottom-up summary value analysis");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.value-analysis");
+      analyzer::value::interprocedural::summary::Analysis(ctx).run();
     } else {
       ikos_unreachable("unreachable");
     }
+
+    if (FixpointTelemetry) {
+      analyzer::log::info("Saving fixpoint statistics");
+      fixpoint_telemetry.save(output_db.fixpoint_stats);
+    }
+
+    fingerprints.save(output_db.fingerprints);
+
+    if (ctx.incremental != nullptr) {
+      analyzer::log::info("Copying previous analysis results");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.incremental-save");
+      incremental.save();
+    }
     return 0;
   } catch (analyzer::sqlite::DbError& err) {
     llvm::errs() << progname << ": " << OutputFilename
@@ -1138,6 +1395,10 @@ int main(int argc, char** argv) {
     llvm::errs() << progname << ": " << InputFilename
                  << ": error: " << err.what() << "\n";
     return 5;
+  } catch (ar::FormatError& err) {
+    llvm::errs() << progname << ": " << InputFilename
+                 << ": error: " << err.what() << "\n";
+    return 5;
   } catch (std::exception& err) {
     // catch any std::exception, core::Exception or analyzer::Exception
     llvm::errs() << progname << ": " << InputFilename
@@ -43,6 +43,8 @@
 
 #include <iostream>
 
+#include <mutex>
+
 #include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
@@ -50,12 +52,20 @@ namespace analyzer {
 
 // LoggerOutputStream
 
+/// \brief Mutex held while a log message is being written
+///
+/// This prevents messages from different threads to be interleaved.
+static std::recursive_mutex MessageMutex;
+
 void LogMessage::start() {
+  // Lock the mutex, unlock in end()
+  MessageMutex.lock();
   this->_logger->start_message();
 }
 
 void LogMessage::end() {
   this->_logger->end_message();
+  MessageMutex.unlock();
 }
 
 // TerminalLogger
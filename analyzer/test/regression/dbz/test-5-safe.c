@@ -0,0 +1,20 @@
+// SAFE
+
+extern int __ikos_nondet_int(void);
+
+int f(int y) {
+  return 100 / (y + 1);
+}
+
+int main() {
+  int n = __ikos_nondet_int();
+  if (n < 0 || n > 10) {
+    return 0;
+  }
+
+  // The entry invariants of the last calls are included in the first one
+  int a = f(n);
+  int b = f(3);
+  int c = f(5);
+  return a + b + c;
+}
@@ -0,0 +1,19 @@
+// DEFINITE UNSAFE
+
+extern int __ikos_nondet_int(void);
+
+int f(int y) {
+  return 100 / (y + 1);
+}
+
+int main() {
+  int n = __ikos_nondet_int();
+  if (n < 0 || n > 10) {
+    return 0;
+  }
+
+  // The entry invariant of the second call is not included in the first one
+  int a = f(n);
+  int b = f(-1);
+  return a + b;
+}
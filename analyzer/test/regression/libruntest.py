@@ -53,6 +53,7 @@ INTERACTIVE = True
 VERBOSE = False
 CLANG = 'clang'
 IKOS_PP = 'ikos-pp'
+IKOS_IMPORT = 'ikos-import'
 IKOS_ANALYZER = 'ikos-analyzer'
 
 # available ikos analyses
@@ -170,6 +171,12 @@ def find_ikos_pp():
     return path
 
 
+def find_ikos_import():
+    path = which(IKOS_IMPORT)
+    assert is_executable(path), 'could not find ikos-import'
+    return path
+
+
 def find_ikos_analyzer():
     path = which(IKOS_ANALYZER)
     assert is_executable(path), 'could not find ikos-analyzer'
@@ -227,6 +234,28 @@ class Database:
         self.cursor.execute('SELECT COUNT(*) FROM checks %s' % where)
         return self.cursor.fetchone()[0]
 
+    def get_table_sizes(self, tables):
+        sizes = {}
+        for table in tables:
+            self.cursor.execute('SELECT COUNT(*) FROM %s' % table)
+            sizes[table] = self.cursor.fetchone()[0]
+        return sizes
+
+    def get_rows(self, table):
+        ''' Return the rows of the given table, ignoring their order '''
+        self.cursor.execute('SELECT * FROM %s' % table)
+        return sorted(self.cursor.fetchall(), key=repr)
+
+    def get_stat(self, name):
+        self.cursor.execute('SELECT value FROM stats WHERE name=?', (name,))
+        row = self.cursor.fetchone()
+        return row[0] if row else None
+
+    def get_checks(self):
+        ''' Return the sorted list of checks, without identifiers '''
+        self.cursor.execute('SELECT checks.kind, checks.checker, checks.status, statements.kind, functions.name, statements.line, statements.column FROM checks INNER JOIN statements ON checks.statement_id = statements.id INNER JOIN functions ON statements.function_id = functions.id')
+        return sorted(self.cursor.fetchall())
+
     def get_line_status(self, line):
         self.cursor.execute('SELECT checks.status FROM checks INNER JOIN statements ON checks.statement_id = statements.id WHERE statements.line=%d' % line)
         return [row[0] for row in self.cursor.fetchall()]
@@ -254,7 +283,10 @@ class Test:
                  entry_points=None,
                  procedural=None,
                  options=None,
-                 line_checks=None):
+                 line_checks=None,
+                 incremental=False,
+                 input_ar=False,
+                 db_writer=False):
         if not isinstance(analyses, list):
             analyses = [analyses]
 
@@ -273,6 +305,9 @@ class Test:
         self.procedural = procedural or 'inter'
         self.options = options or []
         self.line_checks = line_checks or []
+        self.incremental = incremental
+        self.input_ar = input_ar
+        self.db_writer = db_writer
 
     def run(self, root, output_db):
         fullpath = os.path.join(root, self.filename)
@@ -321,6 +356,116 @@ class Test:
                               stdout=subprocess.PIPE,
                               stderr=subprocess.PIPE)
 
+        incremental_comments = []
+        if self.incremental:
+            # Chain the analysis on its own output: the results are checked on
+            # the last output, and the tables must not grow between the runs
+            tables = ('files', 'functions', 'statements', 'operands',
+                      'call_contexts', 'memory_locations', 'checks')
+            sizes = None
+            for i in range(2):
+                previous_db = os.path.join(wd, 'previous-%d.db' % i)
+                shutil.copyfile(output_db, previous_db)
+                incremental_cmd = (cmd[:-3] +
+                                   ['-incremental-db=%s' % previous_db] +
+                                   cmd[-3:])
+                subprocess.check_call(incremental_cmd,
+                                      stdout=subprocess.PIPE,
+                                      stderr=subprocess.PIPE)
+
+                with Database(output_db) as db:
+                    if not db.get_stat('ikos-analyzer.incremental.reused-functions'):
+                        incremental_comments.append(
+                            'Run %d did not reuse any function.' % (i + 2))
+                    new_sizes = db.get_table_sizes(tables)
+                    if sizes is not None and new_sizes != sizes:
+                        incremental_comments.append(
+                            'Tables changed from %r to %r with run %d.'
+                            % (sizes, new_sizes, i + 2))
+                    sizes = new_sizes
+
+        input_ar_comments = []
+        if self.input_ar:
+            # Import the bitcode into a binary AR file, analyze it and check
+            # that the results are the same as with the bitcode
+            ar_path = os.path.join(wd, '%s.ar' % self.filename)
+            import_cmd = [find_ikos_import(), '-emit-ar-bin']
+            if self.opt_level == 'aggressive':
+                import_cmd.append('-allow-dbg-mismatch')
+            import_cmd += [pp_path, '-o', ar_path]
+            subprocess.check_call(import_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            ar_db = os.path.join(wd, 'input-ar.db')
+            ar_cmd = cmd[:-3] + ['-input-ar', ar_path, '-o', ar_db]
+            subprocess.check_call(ar_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            with Database(output_db) as db, Database(ar_db) as db_ar:
+                checks, checks_ar = db.get_checks(), db_ar.get_checks()
+                if checks != checks_ar:
+                    input_ar_comments.append(
+                        'Got different checks with %r: %r instead of %r.'
+                        % (ar_cmd, checks_ar, checks))
+
+            # A truncated file is rejected with a format error
+            truncated_path = os.path.join(wd, '%s.truncated.ar' % self.filename)
+            with open(ar_path, 'rb') as f:
+                data = f.read()
+            with open(truncated_path, 'wb') as f:
+                f.write(data[:len(data) // 2])
+            truncated_cmd = cmd[:-3] + ['-input-ar', truncated_path,
+                                        '-o', os.path.join(wd, 'truncated.db')]
+            proc = subprocess.Popen(truncated_cmd,
+                                    stdout=subprocess.PIPE,
+                                    stderr=subprocess.PIPE)
+            _, stderr = proc.communicate()
+            if proc.returncode != 5 or b'error:' not in stderr:
+                input_ar_comments.append(
+                    'Running %r did not fail with a format error.'
+                    % truncated_cmd)
+
+        db_writer_comments = []
+        if self.db_writer:
+            # Insert the rows from the analysis thread, as a reference, and
+            # compare it with the rows inserted by the writer thread. Ids
+            # depend on the scheduling with several threads, in which case
+            # only the checks and the table sizes are compared.
+            tables = ('files', 'functions', 'statements', 'operands',
+                      'call_contexts', 'memory_locations', 'checks',
+                      'fingerprints')
+            auto_db = os.path.join(wd, 'no-background-db-writer.db')
+            auto_cmd = (cmd[:-3] + ['-no-background-db-writer'] +
+                        [pp_path, '-o', auto_db])
+            subprocess.check_call(auto_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            jobs_db = os.path.join(wd, 'jobs.db')
+            jobs_cmd = cmd[:-3] + ['-j=4', pp_path, '-o', jobs_db]
+            subprocess.check_call(jobs_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            with Database(auto_db) as db_auto, \
+                    Database(output_db) as db, \
+                    Database(jobs_db) as db_jobs:
+                for table in tables:
+                    if db.get_rows(table) != db_auto.get_rows(table):
+                        db_writer_comments.append(
+                            'Table %s differs with %r.' % (table, auto_cmd))
+                sizes = db_auto.get_table_sizes(tables)
+                jobs_sizes = db_jobs.get_table_sizes(tables)
+                if jobs_sizes != sizes:
+                    db_writer_comments.append(
+                        'Got tables of sizes %r with %r instead of %r.'
+                        % (jobs_sizes, jobs_cmd, sizes))
+                if db_jobs.get_checks() != db_auto.get_checks():
+                    db_writer_comments.append(
+                        'Got different checks with %r.' % jobs_cmd)
+
         with Database(output_db) as db:
             # Get the global result
             errors = db.get_num_checks(Result.ERROR)
@@ -383,6 +528,18 @@ class Test:
                                     '(%s) for line %d and not the expected one (%s).'
                                     % (line_result, line_num, line_expected))
 
+            if incremental_comments:
+                ret.code = 'FAIL'
+                ret.comments.extend(incremental_comments)
+
+            if input_ar_comments:
+                ret.code = 'FAIL'
+                ret.comments.extend(input_ar_comments)
+
+            if db_writer_comments:
+                ret.code = 'FAIL'
+                ret.comments.extend(db_writer_comments)
+
             if ret.code == 'FAIL':
                 ret.comments.insert(0, 'Running %r' % cmd)
 
@@ -481,16 +638,21 @@ def parse_args(description=None):
     parser.add_argument('--ikos-pp', dest='ikos_pp',
                         help='Path to the ikos-pp binary',
                         default='ikos-pp')
+    parser.add_argument('--ikos-import', dest='ikos_import',
+                        help='Path to the ikos-import binary',
+                        default='ikos-import')
     parser.add_argument('--ikos-analyzer', dest='ikos_analyzer',
                         help='Path to the ikos-analyzer binary',
                         default='ikos-analyzer')
 
     args = parser.parse_args()
 
-    global VERBOSE, USE_COLORS, INTERACTIVE, CLANG, IKOS_PP, IKOS_ANALYZER
+    global VERBOSE, USE_COLORS, INTERACTIVE, CLANG, IKOS_PP, IKOS_IMPORT
+    global IKOS_ANALYZER
     VERBOSE = args.verbose
     USE_COLORS = False if args.no_colors else os.isatty(sys.stdout.fileno())
     INTERACTIVE = False if args.no_interactive else os.isatty(sys.stdout.fileno())
     CLANG = args.clang
     IKOS_PP = args.ikos_pp
+    IKOS_IMPORT = args.ikos_import
     IKOS_ANALYZER = args.ikos_analyzer
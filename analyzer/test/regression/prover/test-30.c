@@ -0,0 +1,19 @@
+extern void __ikos_assert(int);
+extern int __ikos_nondet_int(void);
+
+static int clamp(int a) {
+  if (a < 0) {
+    return 0;
+  }
+  if (a > 10) {
+    return 10;
+  }
+  return a;
+}
+
+int main() {
+  int n = __ikos_nondet_int();
+  int c = clamp(n);
+  __ikos_assert(c >= 0 && c <= 10);
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ *
+ * Tests for the SQLite3 wrapper
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_sqlite
+#define BOOST_TEST_DYN_LINK
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/analyzer/database/sqlite.hpp>
+
+namespace sqlite = ikos::analyzer::sqlite;
+
+namespace {
+
+/// \brief Temporary database file
+struct Fixture {
+  std::string path;
+
+  Fixture()
+      : path((boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("ikos-test-%%%%-%%%%.db"))
+                 .string()) {}
+
+  ~Fixture() { boost::filesystem::remove(this->path); }
+};
+
+void create_table(sqlite::DbConnection& db) {
+  db.create_table("rows",
+                  {{"id", sqlite::DbColumnType::Integer},
+                   {"name", sqlite::DbColumnType::Text},
+                   {"value", sqlite::DbColumnType::Real}});
+}
+
+/// \brief Insert the rows [first, first + n)
+void insert_rows(sqlite::DbOstream& out, int first, int n) {
+  for (int i = first; i < first + n; i++) {
+    out << sqlite::DbInt64(i) << "row-" + std::to_string(i);
+    if (i % 3 == 0) {
+      out << sqlite::null;
+    } else {
+      out << sqlite::DbDouble(i) / 2;
+    }
+    out << sqlite::end_row;
+  }
+}
+
+sqlite::DbInt64 count_rows(sqlite::DbConnection& db) {
+  sqlite::DbIstream in(db, "SELECT COUNT(*) FROM rows");
+  sqlite::DbInt64 n = 0;
+  in >> n;
+  return n;
+}
+
+/// \brief Return the rows as strings, ordered by id
+std::vector< std::string > get_rows(sqlite::DbConnection& db) {
+  std::vector< std::string > rows;
+  sqlite::DbIstream in(db,
+                       "SELECT id, name, IFNULL(value, 'null') FROM rows "
+                       "ORDER BY id");
+  while (!in.empty()) {
+    sqlite::DbInt64 id = 0;
+    std::string name;
+    std::string value;
+    in >> id >> name >> value;
+    rows.push_back(std::to_string(id) + "|" + name + "|" + value);
+  }
+  return rows;
+}
+
+/// \brief Insert the rows [0, n) with the given commit policy
+std::vector< std::string > insert_with_policy(const std::string& path,
+                                              sqlite::CommitPolicy policy,
+                                              int n) {
+  sqlite::DbConnection db(path);
+  create_table(db);
+  db.set_commit_policy(policy);
+  {
+    sqlite::DbOstream out(db, "rows", 3);
+    insert_rows(out, 0, n);
+  }
+  db.set_commit_policy(sqlite::CommitPolicy::Manual);
+  return get_rows(db);
+}
+
+/// \brief Deferred text recording the thread that serialized it
+class ThreadText final : public sqlite::DbDeferredText {
+private:
+  std::string _text;
+  std::thread::id* _serialized_by;
+
+public:
+  ThreadText(std::string text, std::thread::id* serialized_by)
+      : _text(std::move(text)), _serialized_by(serialized_by) {}
+
+  std::string str() const override {
+    *this->_serialized_by = std::this_thread::get_id();
+    return this->_text;
+  }
+};
+
+} // end anonymous namespace
+
+BOOST_FIXTURE_TEST_CASE(test_background_same_rows, Fixture) {
+  // More rows than in a batch and in a transaction
+  int n = sqlite::DbConnection::MaxRowsPerTransaction +
+          sqlite::DbOstream::MaxRowsPerBatch + 7;
+  std::vector< std::string > rows =
+      insert_with_policy(this->path, sqlite::CommitPolicy::Auto, n);
+  BOOST_CHECK(rows.size() == static_cast< std::size_t >(n));
+  boost::filesystem::remove(this->path);
+  BOOST_CHECK(insert_with_policy(this->path,
+                                 sqlite::CommitPolicy::Background,
+                                 n) == rows);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_background_threads, Fixture) {
+  const int num_threads = 4;
+  const int n = 3 * sqlite::DbOstream::MaxRowsPerBatch + 11;
+
+  sqlite::DbConnection db(this->path);
+  create_table(db);
+  db.set_commit_policy(sqlite::CommitPolicy::Background);
+  sqlite::DbOstream out(db, "rows", 3);
+
+  std::vector< std::thread > threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&out, t] { insert_rows(out, t * n, n); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  db.flush();
+
+  std::vector< std::string > rows = get_rows(db);
+  BOOST_CHECK(rows.size() == static_cast< std::size_t >(num_threads * n));
+
+  // Same rows as a single thread, ignoring the insertion order
+  sqlite::DbConnection expected_db(":memory:");
+  create_table(expected_db);
+  sqlite::DbOstream expected_out(expected_db, "rows", 3);
+  insert_rows(expected_out, 0, num_threads * n);
+  BOOST_CHECK(rows == get_rows(expected_db));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_flush, Fixture) {
+  sqlite::DbConnection db(this->path);
+  create_table(db);
+  db.set_commit_policy(sqlite::CommitPolicy::Background);
+  sqlite::DbOstream out(db, "rows", 3);
+
+  // Less than a batch, the rows stay in the buffer of the thread
+  insert_rows(out, 0, 10);
+  BOOST_CHECK(count_rows(db) == 0);
+  db.flush();
+  BOOST_CHECK(count_rows(db) == 10);
+
+  // Flushing again does nothing
+  db.flush();
+  BOOST_CHECK(count_rows(db) == 10);
+
+  insert_rows(out, 10, sqlite::DbOstream::MaxRowsPerBatch + 1);
+  db.flush();
+  BOOST_CHECK(count_rows(db) == sqlite::DbOstream::MaxRowsPerBatch + 11);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_stop_writer, Fixture) {
+  {
+    sqlite::DbConnection db(this->path);
+    create_table(db);
+    db.set_commit_policy(sqlite::CommitPolicy::Background);
+
+    // Destroying a stream inserts its buffered rows
+    {
+      sqlite::DbOstream out(db, "rows", 3);
+      insert_rows(out, 0, 10);
+    }
+    BOOST_CHECK(count_rows(db) == 10);
+
+    // Changing the commit policy stops the writer thread, after inserting the
+    // buffered rows, and commits the transaction
+    sqlite::DbOstream out(db, "rows", 3);
+    insert_rows(out, 10, 10);
+    db.set_commit_policy(sqlite::CommitPolicy::Manual);
+    BOOST_CHECK(count_rows(db) == 20);
+
+    // The writer thread can be started again
+    db.set_commit_policy(sqlite::CommitPolicy::Background);
+    insert_rows(out, 20, 10);
+  }
+
+  // Destroying the connection inserts the remaining rows and commits
+  sqlite::DbConnection db(this->path);
+  BOOST_CHECK(count_rows(db) == 30);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_writer_error, Fixture) {
+  sqlite::DbConnection db(this->path);
+  create_table(db);
+  db.set_commit_policy(sqlite::CommitPolicy::Background);
+  sqlite::DbOstream out(db, "rows", 3);
+
+  // Duplicate primary key, the insertion fails in the writer thread
+  insert_rows(out, 0, 10);
+  insert_rows(out, 5, 1);
+
+  // The error is rethrown in the calling thread, and on every later flush
+  for (int i = 0; i < 2; i++) {
+    try {
+      db.flush();
+      BOOST_ERROR("expected a DbError");
+    } catch (const sqlite::DbError& err) {
+      BOOST_CHECK(err.error_code() == SQLITE_CONSTRAINT);
+    }
+  }
+
+  // And when submitting a batch
+  BOOST_CHECK_THROW(insert_rows(out, 100, sqlite::DbOstream::MaxRowsPerBatch),
+                    sqlite::DbError);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_deferred_text, Fixture) {
+  for (auto policy :
+       {sqlite::CommitPolicy::Auto, sqlite::CommitPolicy::Background}) {
+    boost::filesystem::remove(this->path);
+    sqlite::DbConnection db(this->path);
+    create_table(db);
+    db.set_commit_policy(policy);
+    std::thread::id serialized_by;
+    {
+      sqlite::DbOstream out(db, "rows", 3);
+      out << sqlite::DbInt64(1)
+          << std::unique_ptr< const sqlite::DbDeferredText >(
+                 std::make_unique< ThreadText >("deferred", &serialized_by))
+          << sqlite::null << sqlite::end_row;
+    }
+    db.flush();
+    db.set_commit_policy(sqlite::CommitPolicy::Manual);
+    BOOST_CHECK(get_rows(db) == std::vector< std::string >{"1|deferred|null"});
+
+    // Only the writer thread serializes the text in CommitPolicy::Background
+    BOOST_CHECK((serialized_by == std::this_thread::get_id()) ==
+                (policy == sqlite::CommitPolicy::Auto));
+  }
+}
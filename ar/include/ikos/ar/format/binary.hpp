@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Binary format for the abstract representation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ikos/core/exception.hpp>
+
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/context.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/value.hpp>
+#include <ikos/ar/support/source_info.hpp>
+
+namespace ikos {
+namespace ar {
+
+/// \brief Version of the binary format
+///
+/// Increment it whenever the layout of the binary format changes.
+constexpr uint32_t BinaryFormatVersion = 1;
+
+/// \brief Exception for malformed binary files
+class FormatError : public core::Exception {
+private:
+  /// \brief Explanatory message
+  ///
+  /// See https://clang.llvm.org/extra/clang-tidy/checks/cert-err60-cpp.html
+  std::shared_ptr< const std::string > _msg;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param msg Explanatory message
+  explicit FormatError(const std::string& msg)
+      : _msg(std::make_shared< const std::string >(msg)) {}
+
+  /// \brief Constructor
+  ///
+  /// \param msg Explanatory message
+  explicit FormatError(const char* msg)
+      : _msg(std::make_shared< const std::string >(msg)) {}
+
+  /// \brief No default constructor
+  FormatError() = delete;
+
+  /// \brief Copy constructor
+  FormatError(const FormatError&) noexcept = default;
+
+  /// \brief Move constructor
+  FormatError(FormatError&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  FormatError& operator=(const FormatError&) noexcept = default;
+
+  /// \brief Move assignment operator
+  FormatError& operator=(FormatError&&) noexcept = default;
+
+  /// \brief Get the explanatory string
+  const char* what() const noexcept override;
+
+  /// \brief Destructor
+  ~FormatError() override;
+
+}; // end class FormatError
+
+/// \brief Binary writer
+///
+/// Serialize a bundle into a compact, versioned binary format that can be
+/// loaded back with BinaryReader without the front-end.
+///
+/// Front-end objects cannot be serialized. Instead, each object with a
+/// front-end object is written with its source information, given by a
+/// SourceInfoProvider.
+class BinaryWriter {
+public:
+  /// \brief Provide the source information of objects with a front-end object
+  ///
+  /// Returned strings must remain valid until the next call.
+  class SourceInfoProvider {
+  public:
+    /// \brief Return the source information of a function
+    virtual SourceInfo source_info(Function*) = 0;
+
+    /// \brief Return the source information of a global variable
+    virtual SourceInfo source_info(GlobalVariable*) = 0;
+
+    /// \brief Return the source information of a local variable
+    virtual SourceInfo source_info(LocalVariable*) = 0;
+
+    /// \brief Return the source information of an internal variable
+    virtual SourceInfo source_info(InternalVariable*) = 0;
+
+    /// \brief Return the source information of a statement
+    virtual SourceInfo source_info(Statement*) = 0;
+
+    /// \brief Destructor
+    virtual ~SourceInfoProvider();
+
+  }; // end class SourceInfoProvider
+
+private:
+  // Source information provider, or null
+  SourceInfoProvider* _provider;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param provider Source information provider, or null
+  ///
+  /// Without provider, objects with a front-end object are written with an
+  /// empty source information, unless they were themselves loaded from the
+  /// binary format.
+  explicit BinaryWriter(SourceInfoProvider* provider = nullptr)
+      : _provider(provider) {}
+
+  /// \brief No copy constructor
+  BinaryWriter(const BinaryWriter&) = delete;
+
+  /// \brief No move constructor
+  BinaryWriter(BinaryWriter&&) = delete;
+
+  /// \brief No copy assignment operator
+  BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+  /// \brief No move assignment operator
+  BinaryWriter& operator=(BinaryWriter&&) = delete;
+
+  /// \brief Destructor
+  ~BinaryWriter() = default;
+
+  /// \brief Write a bundle in binary format
+  void write(std::ostream&, Bundle*) const;
+
+}; // end class BinaryWriter
+
+/// \brief Binary reader
+///
+/// Load a bundle written by BinaryWriter.
+///
+/// Strings of the source information are not copied: they point into the
+/// given memory region, which can be a memory mapped file.
+class BinaryReader {
+private:
+  // Source information of the loaded objects
+  std::vector< SourceInfo > _source_infos;
+
+public:
+  /// \brief Constructor
+  BinaryReader() = default;
+
+  /// \brief No copy constructor
+  BinaryReader(const BinaryReader&) = delete;
+
+  /// \brief No move constructor
+  BinaryReader(BinaryReader&&) = delete;
+
+  /// \brief No copy assignment operator
+  BinaryReader& operator=(const BinaryReader&) = delete;
+
+  /// \brief No move assignment operator
+  BinaryReader& operator=(BinaryReader&&) = delete;
+
+  /// \brief Destructor
+  ~BinaryReader() = default;
+
+  /// \brief Read a bundle in binary format
+  ///
+  /// The front-end objects of the loaded objects point into the reader and
+  /// into the given memory region, which must both outlive the bundle.
+  ///
+  /// Throws a FormatError if the data is malformed.
+  Bundle* read(Context& ctx, const char* data, std::size_t size);
+
+  /// \brief Return true if the given memory region starts with the header of
+  /// the binary format
+  static bool has_header(const char* data, std::size_t size);
+
+}; // end class BinaryReader
+
+} // end namespace ar
+} // end namespace ikos
@@ -56,6 +56,7 @@
 #include <ikos/ar/semantic/context.hpp>
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/value.hpp>
+#include <ikos/ar/support/arena.hpp>
 #include <ikos/ar/support/assert.hpp>
 #include <ikos/ar/support/iterator.hpp>
 #include <ikos/ar/support/traceable.hpp>
@@ -300,13 +301,19 @@ public:
 ///
 /// A code represents the control flow graph of a function or global variable
 /// initializer
+///
+/// Basic blocks and internal variables are allocated in an arena owned by the
+/// code, and destroyed by the code. Statements are owned by their basic block.
 class Code : public Traceable {
 private:
+  // Arena of the basic blocks and internal variables
+  Arena _arena;
+
   // List of basic blocks
-  std::vector< std::unique_ptr< BasicBlock > > _blocks;
+  std::vector< BasicBlock* > _blocks;
 
   // List of internal variables
-  std::vector< std::unique_ptr< InternalVariable > > _internal_vars;
+  std::vector< InternalVariable* > _internal_vars;
 
   // Entry block
   BasicBlock* _entry_block;
@@ -325,14 +332,11 @@ private:
 
 public:
   /// \brief Iterator over a list of basic block
-  using BasicBlockIterator = boost::transform_iterator<
-      SeqExposeRawPtr< BasicBlock >,
-      std::vector< std::unique_ptr< BasicBlock > >::const_iterator >;
+  using BasicBlockIterator = std::vector< BasicBlock* >::const_iterator;
 
   /// \brief Iterator over a list of internal variables
-  using InternalVariableIterator = boost::transform_iterator<
-      SeqExposeRawPtr< InternalVariable >,
-      std::vector< std::unique_ptr< InternalVariable > >::const_iterator >;
+  using InternalVariableIterator =
+      std::vector< InternalVariable* >::const_iterator;
 
 private:
   /// \brief Private constructor
@@ -358,29 +362,19 @@ public:
   ~Code();
 
   /// \brief Begin iterator over the list of basic blocks
-  BasicBlockIterator begin() const {
-    return boost::make_transform_iterator(this->_blocks.cbegin(),
-                                          SeqExposeRawPtr< BasicBlock >());
-  }
+  BasicBlockIterator begin() const { return this->_blocks.cbegin(); }
 
   /// \brief End iterator over the list of basic blocks
-  BasicBlockIterator end() const {
-    return boost::make_transform_iterator(this->_blocks.cend(),
-                                          SeqExposeRawPtr< BasicBlock >());
-  }
+  BasicBlockIterator end() const { return this->_blocks.cend(); }
 
   /// \brief Begin iterator over the list of internal variables
   InternalVariableIterator internal_variable_begin() const {
-    return boost::make_transform_iterator(this->_internal_vars.cbegin(),
-                                          SeqExposeRawPtr<
-                                              InternalVariable >());
+    return this->_internal_vars.cbegin();
   }
 
   /// \brief End iterator over the list of internal variables
   InternalVariableIterator internal_variable_end() const {
-    return boost::make_transform_iterator(this->_internal_vars.cend(),
-                                          SeqExposeRawPtr<
-                                              InternalVariable >());
+    return this->_internal_vars.cend();
   }
 
   /// \brief Does it have an entry block?
@@ -448,8 +442,11 @@ public:
 private:
   /// \brief Add a basic block in the code
   ///
+  /// The basic block must be allocated in the arena of the code, it is
+  /// destroyed with the code.
+  ///
   /// \returns a pointer on the basic block
-  BasicBlock* add_basic_block(std::unique_ptr< BasicBlock >);
+  BasicBlock* add_basic_block(BasicBlock*);
 
 public:
   /// \brief Remove the given basic block
@@ -461,8 +458,11 @@ public:
 private:
   /// \brief Add an internal variable in the code
   ///
+  /// The internal variable must be allocated in the arena of the code, it is
+  /// destroyed with the code.
+  ///
   /// \returns a pointer on the interval variable
-  InternalVariable* add_internal_variable(std::unique_ptr< InternalVariable >);
+  InternalVariable* add_internal_variable(InternalVariable*);
 
   // friends
   friend class Function;
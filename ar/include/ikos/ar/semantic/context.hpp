@@ -58,6 +58,8 @@ class Value;
 ///
 /// It owns global data of the Abstract Representation,
 /// such as bundles and types.
+///
+/// Getting or creating types and constants is thread-safe.
 class Context {
 private:
   // Private implementation
@@ -360,6 +360,10 @@ public:
     bool operator<(const Field& o) const {
       return offset < o.offset || (offset == o.offset && value < o.value);
     }
+
+    bool operator==(const Field& o) const {
+      return offset == o.offset && value == o.value;
+    }
   };
 
   /// \brief Type of the value container
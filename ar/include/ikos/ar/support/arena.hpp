@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Arena allocator
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ikos/ar/support/assert.hpp>
+
+namespace ikos {
+namespace ar {
+
+/// \brief Arena allocator
+///
+/// Allocate objects contiguously in large chunks of memory. All the objects
+/// are destroyed at once, in the reverse order of creation, when the arena is
+/// destroyed.
+///
+/// This is used for objects that have the same lifetime as their owner, e.g,
+/// the types and constants of a context, or the basic blocks and internal
+/// variables of a code.
+///
+/// Chunks start small and double in size, so that small owners (e.g, the
+/// initializer of a global variable) do not waste memory.
+class Arena {
+private:
+  /// \brief Size of the first chunk, in bytes
+  static constexpr std::size_t MinChunkSize = 256;
+
+  /// \brief Maximum size of a chunk, in bytes
+  static constexpr std::size_t MaxChunkSize = 64 * 1024;
+
+  /// \brief Destructor of an object allocated in the arena
+  struct Destructor {
+    void* object;
+    void (*destroy)(void*);
+  };
+
+private:
+  // List of chunks
+  std::vector< std::unique_ptr< char[] > > _chunks;
+
+  // Next free byte in the current chunk
+  std::uintptr_t _cur = 0;
+
+  // End of the current chunk
+  std::uintptr_t _end = 0;
+
+  // Size of the next chunk
+  std::size_t _chunk_size = MinChunkSize;
+
+  // Destructors of the non-trivially destructible objects
+  std::vector< Destructor > _destructors;
+
+public:
+  /// \brief Default constructor
+  Arena() = default;
+
+  /// \brief No copy constructor
+  Arena(const Arena&) = delete;
+
+  /// \brief No move constructor
+  Arena(Arena&&) = delete;
+
+  /// \brief No copy assignment operator
+  Arena& operator=(const Arena&) = delete;
+
+  /// \brief No move assignment operator
+  Arena& operator=(Arena&&) = delete;
+
+  /// \brief Destructor
+  ~Arena() {
+    for (auto it = this->_destructors.rbegin(), et = this->_destructors.rend();
+         it != et;
+         ++it) {
+      it->destroy(it->object);
+    }
+  }
+
+  /// \brief Allocate uninitialized memory
+  void* allocate(std::size_t size, std::size_t alignment) {
+    ikos_assert_msg((alignment & (alignment - 1)) == 0, "invalid alignment");
+
+    std::uintptr_t p = align(this->_cur, alignment);
+    if (this->_cur == 0 || p + size > this->_end) {
+      std::size_t chunk_size = std::max(this->_chunk_size, size + alignment);
+      this->_chunk_size = std::min(this->_chunk_size * 2, MaxChunkSize);
+      this->_chunks.emplace_back(new char[chunk_size]);
+      char* chunk = this->_chunks.back().get();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      this->_cur = reinterpret_cast< std::uintptr_t >(chunk);
+      this->_end = this->_cur + chunk_size;
+      p = align(this->_cur, alignment);
+    }
+    this->_cur = p + size;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast< void* >(p);
+  }
+
+  /// \brief Register an object constructed in memory allocated by the arena
+  ///
+  /// The object is destroyed with the arena.
+  template < typename T >
+  T* track(T* object) {
+    if (!std::is_trivially_destructible< T >::value) {
+      this->_destructors.push_back(
+          {object, [](void* o) { static_cast< T* >(o)->~T(); }});
+    }
+    return object;
+  }
+
+  /// \brief Create an object in the arena
+  template < typename T, typename... Args >
+  T* create(Args&&... args) {
+    void* p = this->allocate(sizeof(T), alignof(T));
+    return this->track(new (p) T(std::forward< Args >(args)...));
+  }
+
+private:
+  /// \brief Round up the given address to the given alignment
+  static std::uintptr_t align(std::uintptr_t p, std::size_t alignment) {
+    auto mask = static_cast< std::uintptr_t >(alignment) - 1;
+    return (p + mask) & ~mask;
+  }
+
+}; // end class Arena
+
+} // end namespace ar
+} // end namespace ikos
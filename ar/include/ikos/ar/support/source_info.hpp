@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Source information of objects loaded without their front-end
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <ikos/ar/support/string_ref.hpp>
+
+namespace ikos {
+namespace ar {
+
+/// \brief Source information of an AR object
+///
+/// This is the front-end object of the AR objects loaded from the binary
+/// format (see BinaryReader). It holds what is needed to trace them back to
+/// the source code, without a front-end (e.g, an llvm::Module).
+///
+/// Strings point into the loaded file.
+struct SourceInfo {
+  /// \brief Flags
+  enum Flag : uint32_t {
+    NoFlag = 0x0,
+
+    /// \brief The front-end object has no source-level counterpart
+    ///
+    /// For instance, a statement translated from a phi node.
+    Synthetic = 0x1,
+  };
+
+  /// \brief Absolute path of the source file, or empty
+  StringRef file;
+
+  /// \brief Line, or 0
+  uint32_t line = 0;
+
+  /// \brief Column, or 0
+  uint32_t column = 0;
+
+  /// \brief Front-end name (e.g, a symbol or a debug information name), or
+  /// empty
+  StringRef name;
+
+  /// \brief Flags
+  uint32_t flags = NoFlag;
+
+  /// \brief Return true if the object has a source location
+  bool has_location() const { return !this->file.empty(); }
+
+  /// \brief Return true if the front-end object has a name
+  bool has_name() const { return !this->name.empty(); }
+
+  /// \brief Return true if the front-end object has no source-level
+  /// counterpart
+  bool is_synthetic() const { return (this->flags & Synthetic) != 0; }
+
+}; // end struct SourceInfo
+
+} // end namespace ar
+} // end namespace ikos
@@ -114,6 +114,13 @@ public:
   /// \brief Return true if this object has a pointer to a front-end object
   bool has_frontend() const { return this->_frontend != nullptr; }
 
+  /// \brief Return true if this object has a pointer to a front-end object of
+  /// type T
+  template < typename T >
+  bool frontend_isa() const {
+    return this->_frontend != nullptr && *this->_frontend_type_info == typeid(T);
+  }
+
   /// \brief Return the pointer to a front-end object
   ///
   /// Precondition: has_frontend() is true
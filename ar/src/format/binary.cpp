@@ -0,0 +1,1615 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Binary format for the abstract representation, implementation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2017-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <ikos/ar/format/binary.hpp>
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/data_layout.hpp>
+#include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/support/assert.hpp>
+#include <ikos/ar/support/cast.hpp>
+
+namespace ikos {
+namespace ar {
+
+const char* FormatError::what() const noexcept {
+  return this->_msg->c_str();
+}
+
+FormatError::~FormatError() = default;
+
+BinaryWriter::SourceInfoProvider::~SourceInfoProvider() = default;
+
+namespace {
+
+/// \brief Magic number at the beginning of a binary file
+constexpr char Magic[8] = {'I', 'K', 'O', 'S', '-', 'A', 'R', '\0'};
+
+/// \brief Byte order mark, to reject files written on another endianness
+constexpr uint32_t ByteOrderMark = 0x01020304;
+
+/// \brief Maximum bit-width of integers, same as LLVM
+constexpr uint64_t MaxBitWidth = 1 << 24;
+
+/// \brief Index of a missing object (e.g, no source information)
+constexpr uint32_t NoIndex = 0xFFFFFFFF;
+
+/// \brief Tag of a value reference
+enum ValueTag : uint8_t {
+  NullTag,
+  ConstantTag,
+  GlobalVariableTag,
+  LocalVariableTag,
+  InternalVariableTag,
+  InlineConstantTag,
+};
+
+/// \brief Tag of a number
+enum NumberTag : uint8_t {
+  SmallNumberTag,
+  LargeNumberTag,
+};
+
+/// \brief Source information record, with strings as indexes in the string
+/// table
+using SourceInfoRecord =
+    std::tuple< uint32_t, uint32_t, uint32_t, uint32_t, uint32_t >;
+
+/// \brief Encoder of the binary format
+///
+/// The body is encoded in memory first, since the string table and the source
+/// information table are only known once the whole bundle has been visited.
+class Encoder {
+private:
+  // Source information provider, or null
+  BinaryWriter::SourceInfoProvider* _provider;
+
+  // Context of the bundle
+  Context* _context = nullptr;
+
+  // Encoded body
+  std::string _body;
+
+  // String table
+  std::vector< const std::string* > _strings;
+
+  // Map from string to index in the string table
+  std::unordered_map< std::string, uint32_t > _string_ids;
+
+  // Source information table
+  std::vector< SourceInfoRecord > _source_infos;
+
+  // Map from source information to index in the source information table
+  std::map< SourceInfoRecord, uint32_t > _source_info_ids;
+
+  // Type table
+  std::vector< Type* > _types;
+
+  // Map from type to index in the type table
+  std::unordered_map< Type*, uint32_t > _type_ids;
+
+  // Constant table
+  std::vector< Constant* > _constants;
+
+  // Map from constant to index in the constant table
+  std::unordered_map< Constant*, uint32_t > _constant_ids;
+
+  // Constants holding local or internal variables, encoded inline
+  std::unordered_set< Constant* > _inline_constants;
+
+  // Map from global variable to index
+  std::unordered_map< GlobalVariable*, uint32_t > _global_ids;
+
+  // Map from function to index
+  std::unordered_map< Function*, uint32_t > _function_ids;
+
+  // Map from local variable to index, in the current function
+  std::unordered_map< LocalVariable*, uint32_t > _local_ids;
+
+  // Map from internal variable to index, in the current code
+  std::unordered_map< InternalVariable*, uint32_t > _internal_ids;
+
+  // Map from basic block to index, in the current code
+  std::unordered_map< BasicBlock*, uint32_t > _block_ids;
+
+public:
+  /// \brief Constructor
+  explicit Encoder(BinaryWriter::SourceInfoProvider* provider)
+      : _provider(provider) {
+    // The empty string is always at index 0
+    this->string_id("");
+  }
+
+  /// \brief Encode the bundle and write it on the given stream
+  void write(std::ostream& o, Bundle* bundle) {
+    this->_context = &bundle->context();
+    this->collect(bundle);
+    this->encode(bundle);
+
+    std::string header;
+    header.append(Magic, sizeof(Magic));
+    append(header, BinaryFormatVersion);
+    append(header, ByteOrderMark);
+
+    // String table
+    append(header, static_cast< uint32_t >(this->_strings.size()));
+    for (const std::string* s : this->_strings) {
+      append(header, static_cast< uint32_t >(s->size()));
+      header.append(*s);
+    }
+
+    // Source information table
+    append(header, static_cast< uint32_t >(this->_source_infos.size()));
+    for (const SourceInfoRecord& r : this->_source_infos) {
+      append(header, std::get< 0 >(r));
+      append(header, std::get< 1 >(r));
+      append(header, std::get< 2 >(r));
+      append(header, std::get< 3 >(r));
+      append(header, std::get< 4 >(r));
+    }
+
+    o.write(header.data(), static_cast< std::streamsize >(header.size()));
+    o.write(this->_body.data(),
+            static_cast< std::streamsize >(this->_body.size()));
+  }
+
+private:
+  /// \brief Append the native representation of an integer
+  template < typename T >
+  static void append(std::string& buffer, T n) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &n, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+  }
+
+  /// \name Collect the types and constants
+  /// @{
+
+  void collect(Bundle* bundle) {
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      GlobalVariable* gv = *it;
+      this->_global_ids.emplace(gv, this->_global_ids.size());
+      this->collect(gv->type());
+    }
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      Function* fun = *it;
+      this->_function_ids.emplace(fun, this->_function_ids.size());
+      this->collect(fun->type());
+    }
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      if ((*it)->is_definition()) {
+        this->collect((*it)->initializer());
+      }
+    }
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      Function* fun = *it;
+      if (fun->is_definition()) {
+        for (auto lv = fun->local_variable_begin(),
+                  le = fun->local_variable_end();
+             lv != le;
+             ++lv) {
+          this->collect((*lv)->type());
+        }
+        this->collect(fun->body());
+      }
+    }
+  }
+
+  void collect(Code* code) {
+    for (auto it = code->internal_variable_begin(),
+              et = code->internal_variable_end();
+         it != et;
+         ++it) {
+      this->collect((*it)->type());
+    }
+    for (BasicBlock* bb : *code) {
+      for (Statement* stmt : *bb) {
+        for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+          this->collect(*it);
+        }
+        if (auto alloca = dyn_cast< Allocate >(stmt)) {
+          this->collect(alloca->allocated_type());
+        }
+      }
+    }
+  }
+
+  /// \brief Collect a type and its sub-types
+  ///
+  /// Sub-types come first in the type table, except for the fields of
+  /// structures, which can be recursive. The layouts of structures are written
+  /// after the type table.
+  void collect(Type* type) {
+    if (this->_type_ids.count(type) != 0) {
+      return;
+    }
+
+    if (auto struct_type = dyn_cast< StructType >(type)) {
+      this->add_type(type);
+      for (auto it = struct_type->field_begin(), et = struct_type->field_end();
+           it != et;
+           ++it) {
+        this->collect(it->type);
+      }
+      return;
+    }
+
+    if (auto ptr_type = dyn_cast< PointerType >(type)) {
+      this->collect(ptr_type->pointee());
+    } else if (auto seq_type = dyn_cast< SequentialType >(type)) {
+      this->collect(seq_type->element_type());
+    } else if (auto fun_type = dyn_cast< FunctionType >(type)) {
+      this->collect(fun_type->return_type());
+      for (auto it = fun_type->param_begin(), et = fun_type->param_end();
+           it != et;
+           ++it) {
+        this->collect(*it);
+      }
+    }
+    this->add_type(type);
+  }
+
+  void add_type(Type* type) {
+    this->_type_ids.emplace(type, this->_types.size());
+    this->_types.push_back(type);
+  }
+
+  /// \brief Collect a constant and its operands
+  ///
+  /// Aggregate constants can hold local or internal variables (e.g, a pointer
+  /// cast from an integer). These are not in the constant table, they are
+  /// encoded inline in their code.
+  void collect(Value* value) {
+    auto cst = dyn_cast< Constant >(value);
+    if (cst == nullptr || this->_constant_ids.count(cst) != 0 ||
+        this->_inline_constants.count(cst) != 0) {
+      return;
+    }
+
+    this->collect(cst->type());
+    bool is_inline = false;
+    if (auto struct_cst = dyn_cast< StructConstant >(cst)) {
+      for (auto it = struct_cst->field_begin(), et = struct_cst->field_end();
+           it != et;
+           ++it) {
+        this->collect(it->value);
+        is_inline = is_inline || this->is_code_dependent(it->value);
+      }
+    } else if (auto seq_cst = dyn_cast< SequentialConstant >(cst)) {
+      for (auto it = seq_cst->element_begin(), et = seq_cst->element_end();
+           it != et;
+           ++it) {
+        this->collect(*it);
+        is_inline = is_inline || this->is_code_dependent(*it);
+      }
+    }
+
+    if (is_inline) {
+      this->_inline_constants.insert(cst);
+    } else {
+      this->_constant_ids.emplace(cst, this->_constants.size());
+      this->_constants.push_back(cst);
+    }
+  }
+
+  /// \brief Return true if the given value depends on a code
+  bool is_code_dependent(Value* value) const {
+    if (isa< LocalVariable >(value) || isa< InternalVariable >(value)) {
+      return true;
+    } else if (auto cst = dyn_cast< Constant >(value)) {
+      return this->_inline_constants.count(cst) != 0;
+    } else {
+      return false;
+    }
+  }
+
+  /// @}
+  /// \name Primitive encoders
+  /// @{
+
+  void write_u8(uint8_t n) { append(this->_body, n); }
+
+  void write_u32(uint32_t n) { append(this->_body, n); }
+
+  void write_u64(uint64_t n) { append(this->_body, n); }
+
+  void write_bool(bool b) { this->write_u8(b ? 1 : 0); }
+
+  uint32_t string_id(const std::string& s) {
+    auto res = this->_string_ids.emplace(s, this->_strings.size());
+    if (res.second) {
+      this->_strings.push_back(&res.first->first);
+    }
+    return res.first->second;
+  }
+
+  void write_string(const std::string& s) {
+    this->write_u32(this->string_id(s));
+  }
+
+  void write_number(const ZNumber& n) {
+    if (n.fits< int64_t >()) {
+      this->write_u8(SmallNumberTag);
+      this->write_u64(static_cast< uint64_t >(n.to< int64_t >()));
+    } else {
+      this->write_u8(LargeNumberTag);
+      this->write_string(n.str());
+    }
+  }
+
+  void write_machine_int(const MachineInt& n) {
+    this->write_u64(n.bit_width());
+    this->write_u8(static_cast< uint8_t >(n.sign()));
+    this->write_number(n.to_z_number());
+  }
+
+  void write_type(Type* type) {
+    auto it = this->_type_ids.find(type);
+    ikos_assert_msg(it != this->_type_ids.end(), "type was not collected");
+    this->write_u32(it->second);
+  }
+
+  /// \brief Write the index of the source information of the given object
+  template < typename T >
+  void write_source_info(T* obj) {
+    if (!obj->has_frontend()) {
+      this->write_u32(NoIndex);
+      return;
+    }
+
+    SourceInfo info;
+    if (obj->template frontend_isa< SourceInfo >()) {
+      info = *obj->template frontend< SourceInfo >();
+    } else if (this->_provider != nullptr) {
+      info = this->_provider->source_info(obj);
+    }
+
+    SourceInfoRecord r(this->string_id(info.file.to_string()),
+                       info.line,
+                       info.column,
+                       this->string_id(info.name.to_string()),
+                       info.flags);
+    auto res = this->_source_info_ids.emplace(r, this->_source_infos.size());
+    if (res.second) {
+      this->_source_infos.push_back(r);
+    }
+    this->write_u32(res.first->second);
+  }
+
+  void write_value(Value* value) {
+    if (value == nullptr) {
+      this->write_u8(NullTag);
+      this->write_u32(0);
+    } else if (auto cst = dyn_cast< Constant >(value)) {
+      if (this->_inline_constants.count(cst) != 0) {
+        this->write_u8(InlineConstantTag);
+        this->encode_constant(cst);
+      } else {
+        this->write_u8(ConstantTag);
+        this->write_u32(this->_constant_ids.at(cst));
+      }
+    } else if (auto gv = dyn_cast< GlobalVariable >(value)) {
+      this->write_u8(GlobalVariableTag);
+      this->write_u32(this->_global_ids.at(gv));
+    } else if (auto lv = dyn_cast< LocalVariable >(value)) {
+      this->write_u8(LocalVariableTag);
+      this->write_u32(this->_local_ids.at(lv));
+    } else if (auto iv = dyn_cast< InternalVariable >(value)) {
+      this->write_u8(InternalVariableTag);
+      this->write_u32(this->_internal_ids.at(iv));
+    } else {
+      ikos_unreachable("unexpected value");
+    }
+  }
+
+  void write_block(BasicBlock* bb) {
+    if (bb == nullptr) {
+      this->write_u32(NoIndex);
+    } else {
+      this->write_u32(this->_block_ids.at(bb));
+    }
+  }
+
+  /// @}
+  /// \name Bundle encoder
+  /// @{
+
+  void encode(Bundle* bundle) {
+    // Target
+    this->write_string(bundle->target_triple());
+    const DataLayout& dl = bundle->data_layout();
+    this->write_u8(static_cast< uint8_t >(dl.endianness));
+    this->write_data_layout_info(dl.pointers);
+    this->write_u32(static_cast< uint32_t >(dl.integers.size()));
+    for (const DataLayoutInfo& info : dl.integers) {
+      this->write_data_layout_info(info);
+    }
+    this->write_u32(static_cast< uint32_t >(dl.floats.size()));
+    for (const DataLayoutInfo& info : dl.floats) {
+      this->write_data_layout_info(info);
+    }
+
+    // Types
+    this->write_u32(static_cast< uint32_t >(this->_types.size()));
+    for (Type* type : this->_types) {
+      this->encode_type(type);
+    }
+
+    // Layouts of structures
+    for (Type* type : this->_types) {
+      if (auto struct_type = dyn_cast< StructType >(type)) {
+        this->write_u32(static_cast< uint32_t >(struct_type->num_fields()));
+        for (auto it = struct_type->field_begin(),
+                  et = struct_type->field_end();
+             it != et;
+             ++it) {
+          this->write_number(it->offset);
+          this->write_type(it->type);
+        }
+      }
+    }
+
+    // Global variable declarations
+    this->write_u32(static_cast< uint32_t >(bundle->num_globals()));
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      GlobalVariable* gv = *it;
+      this->write_string(gv->name_or_empty());
+      this->write_type(gv->type());
+      this->write_bool(gv->is_definition());
+      this->write_u64(gv->alignment());
+      this->write_source_info(gv);
+    }
+
+    // Function declarations
+    this->write_u32(static_cast< uint32_t >(bundle->num_functions()));
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      Function* fun = *it;
+      this->write_string(fun->name());
+      this->write_type(fun->type());
+      this->write_bool(fun->is_definition());
+      this->write_u32(static_cast< uint32_t >(fun->intrinsic_id()));
+      this->write_source_info(fun);
+    }
+
+    // Constants
+    this->write_u32(static_cast< uint32_t >(this->_constants.size()));
+    for (Constant* cst : this->_constants) {
+      this->encode_constant(cst);
+    }
+
+    // Global variable initializers
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      if ((*it)->is_definition()) {
+        this->encode_code((*it)->initializer());
+      }
+    }
+
+    // Function bodies
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      Function* fun = *it;
+      if (!fun->is_definition()) {
+        continue;
+      }
+
+      this->_local_ids.clear();
+      this->write_u32(static_cast< uint32_t >(
+          std::distance(fun->local_variable_begin(),
+                        fun->local_variable_end())));
+      for (auto lv = fun->local_variable_begin(),
+                le = fun->local_variable_end();
+           lv != le;
+           ++lv) {
+        this->_local_ids.emplace(*lv, this->_local_ids.size());
+        this->write_type((*lv)->type());
+        this->write_u64((*lv)->alignment());
+        this->write_string((*lv)->name_or_empty());
+        this->write_source_info(*lv);
+      }
+
+      this->encode_code(fun->body());
+    }
+  }
+
+  void write_data_layout_info(const DataLayoutInfo& info) {
+    this->write_u64(info.bit_width);
+    this->write_u64(info.abi_alignment);
+    this->write_u64(info.pref_alignment);
+  }
+
+  void encode_type(Type* type) {
+    this->write_u8(static_cast< uint8_t >(type->kind()));
+    switch (type->kind()) {
+      case Type::VoidKind: {
+      } break;
+      case Type::IntegerKind: {
+        auto int_type = cast< IntegerType >(type);
+        this->write_u64(int_type->bit_width());
+        this->write_u8(static_cast< uint8_t >(int_type->sign()));
+      } break;
+      case Type::FloatKind: {
+        auto float_type = cast< FloatType >(type);
+        this->write_u8(static_cast< uint8_t >(float_type->float_semantic()));
+      } break;
+      case Type::PointerKind: {
+        this->write_type(cast< PointerType >(type)->pointee());
+      } break;
+      case Type::StructKind: {
+        this->write_bool(cast< StructType >(type)->packed());
+      } break;
+      case Type::ArrayKind:
+      case Type::VectorKind: {
+        auto seq_type = cast< SequentialType >(type);
+        this->write_type(seq_type->element_type());
+        this->write_number(seq_type->num_elements());
+      } break;
+      case Type::OpaqueKind: {
+        this->write_bool(type == OpaqueType::libc_file_type(*this->_context));
+      } break;
+      case Type::FunctionKind: {
+        auto fun_type = cast< FunctionType >(type);
+        this->write_type(fun_type->return_type());
+        this->write_u32(static_cast< uint32_t >(fun_type->num_parameters()));
+        for (auto it = fun_type->param_begin(), et = fun_type->param_end();
+             it != et;
+             ++it) {
+          this->write_type(*it);
+        }
+        this->write_bool(fun_type->is_var_arg());
+      } break;
+      default: {
+        ikos_unreachable("unexpected type");
+      }
+    }
+  }
+
+  void encode_constant(Constant* cst) {
+    this->write_u8(static_cast< uint8_t >(cst->kind()));
+    switch (cst->kind()) {
+      case Value::UndefinedConstantKind:
+      case Value::NullConstantKind:
+      case Value::AggregateZeroConstantKind: {
+        this->write_type(cst->type());
+      } break;
+      case Value::IntegerConstantKind: {
+        this->write_type(cst->type());
+        this->write_number(cast< IntegerConstant >(cst)->value().to_z_number());
+      } break;
+      case Value::FloatConstantKind: {
+        this->write_type(cst->type());
+        this->write_string(cast< FloatConstant >(cst)->value());
+      } break;
+      case Value::StructConstantKind: {
+        auto struct_cst = cast< StructConstant >(cst);
+        this->write_type(cst->type());
+        this->write_u32(static_cast< uint32_t >(
+            std::distance(struct_cst->field_begin(), struct_cst->field_end())));
+        for (auto it = struct_cst->field_begin(), et = struct_cst->field_end();
+             it != et;
+             ++it) {
+          this->write_number(it->offset);
+          this->write_value(it->value);
+        }
+      } break;
+      case Value::ArrayConstantKind:
+      case Value::VectorConstantKind: {
+        auto seq_cst = cast< SequentialConstant >(cst);
+        this->write_type(cst->type());
+        this->write_u32(static_cast< uint32_t >(
+            std::distance(seq_cst->element_begin(), seq_cst->element_end())));
+        for (auto it = seq_cst->element_begin(), et = seq_cst->element_end();
+             it != et;
+             ++it) {
+          this->write_value(*it);
+        }
+      } break;
+      case Value::FunctionPointerConstantKind: {
+        this->write_u32(this->_function_ids.at(
+            cast< FunctionPointerConstant >(cst)->function()));
+      } break;
+      case Value::InlineAssemblyConstantKind: {
+        this->write_type(cst->type());
+        this->write_string(cast< InlineAssemblyConstant >(cst)->code());
+      } break;
+      default: {
+        ikos_unreachable("unexpected constant");
+      }
+    }
+  }
+
+  void encode_code(Code* code) {
+    this->_internal_ids.clear();
+    this->_block_ids.clear();
+
+    // Internal variables, starting with the parameters
+    this->write_u32(static_cast< uint32_t >(
+        std::distance(code->internal_variable_begin(),
+                      code->internal_variable_end())));
+    for (auto it = code->internal_variable_begin(),
+              et = code->internal_variable_end();
+         it != et;
+         ++it) {
+      InternalVariable* iv = *it;
+      this->_internal_ids.emplace(iv, this->_internal_ids.size());
+      this->write_type(iv->type());
+      this->write_string(iv->name_or_empty());
+      this->write_source_info(iv);
+    }
+
+    // Basic blocks
+    for (BasicBlock* bb : *code) {
+      this->_block_ids.emplace(bb, this->_block_ids.size());
+    }
+    this->write_u32(static_cast< uint32_t >(this->_block_ids.size()));
+    for (BasicBlock* bb : *code) {
+      this->write_string(bb->name_or_empty());
+      this->write_u32(static_cast< uint32_t >(bb->num_successors()));
+      for (auto it = bb->successor_begin(), et = bb->successor_end(); it != et;
+           ++it) {
+        this->write_block(*it);
+      }
+      this->write_u32(static_cast< uint32_t >(bb->num_statements()));
+      for (Statement* stmt : *bb) {
+        this->encode_statement(stmt);
+      }
+    }
+    this->write_block(code->has_entry_block() ? code->entry_block() : nullptr);
+    this->write_block(code->exit_block_or_null());
+  }
+
+  void encode_statement(Statement* stmt) {
+    this->write_u8(static_cast< uint8_t >(stmt->kind()));
+    this->write_source_info(stmt);
+    this->write_value(stmt->result_or_null());
+    this->write_u32(static_cast< uint32_t >(stmt->num_operands()));
+    for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+      this->write_value(*it);
+    }
+
+    switch (stmt->kind()) {
+      case Statement::UnaryOperationKind: {
+        auto s = cast< UnaryOperation >(stmt);
+        this->write_u8(static_cast< uint8_t >(s->op()));
+      } break;
+      case Statement::BinaryOperationKind: {
+        auto s = cast< BinaryOperation >(stmt);
+        this->write_u8(static_cast< uint8_t >(s->op()));
+        this->write_bool(s->has_no_wrap());
+        this->write_bool(s->is_exact());
+      } break;
+      case Statement::ComparisonKind: {
+        this->write_u8(
+            static_cast< uint8_t >(cast< Comparison >(stmt)->predicate()));
+      } break;
+      case Statement::AllocateKind: {
+        this->write_type(cast< Allocate >(stmt)->allocated_type());
+      } break;
+      case Statement::PointerShiftKind: {
+        auto s = cast< PointerShift >(stmt);
+        for (auto it = s->term_begin(), et = s->term_end(); it != et; ++it) {
+          this->write_machine_int((*it).first);
+        }
+      } break;
+      case Statement::LoadKind: {
+        auto s = cast< Load >(stmt);
+        this->write_u64(s->alignment());
+        this->write_bool(s->is_volatile());
+      } break;
+      case Statement::StoreKind: {
+        auto s = cast< Store >(stmt);
+        this->write_u64(s->alignment());
+        this->write_bool(s->is_volatile());
+      } break;
+      case Statement::InvokeKind: {
+        auto s = cast< Invoke >(stmt);
+        this->write_block(s->normal_dest());
+        this->write_block(s->exception_dest());
+      } break;
+      default: {
+      } break;
+    }
+  }
+
+  /// @}
+
+}; // end class Encoder
+
+/// \brief Decoder of the binary format
+///
+/// Every index is checked, so that a malformed file throws a FormatError.
+class Decoder {
+private:
+  // Context
+  Context& _ctx;
+
+  // Current position
+  const char* _it;
+
+  // End of the data
+  const char* _end;
+
+  // Source information table
+  std::vector< SourceInfo >& _source_infos;
+
+  // String table
+  std::vector< StringRef > _strings;
+
+  // Type table
+  std::vector< Type* > _types;
+
+  // Constant table
+  std::vector< Value* > _constants;
+
+  // Global variables
+  std::vector< GlobalVariable* > _globals;
+
+  // Functions
+  std::vector< Function* > _functions;
+
+  // Local variables of the current function
+  std::vector< LocalVariable* > _locals;
+
+  // Internal variables of the current code
+  std::vector< InternalVariable* > _internals;
+
+  // Basic blocks of the current code
+  std::vector< BasicBlock* > _blocks;
+
+  // Loaded bundle
+  Bundle* _bundle = nullptr;
+
+public:
+  /// \brief Constructor
+  Decoder(Context& ctx,
+          const char* data,
+          std::size_t size,
+          std::vector< SourceInfo >& source_infos)
+      : _ctx(ctx), _it(data), _end(data + size), _source_infos(source_infos) {}
+
+  /// \brief Decode the bundle
+  Bundle* read() {
+    this->read_header();
+    this->read_string_table();
+    this->read_source_info_table();
+    this->decode_bundle();
+    if (this->_it != this->_end) {
+      throw FormatError("unexpected data after the end of the bundle");
+    }
+    return this->_bundle;
+  }
+
+private:
+  /// \name Primitive decoders
+  /// @{
+
+  const char* consume(std::size_t n) {
+    if (static_cast< std::size_t >(this->_end - this->_it) < n) {
+      throw FormatError("unexpected end of file");
+    }
+    const char* p = this->_it;
+    this->_it += n;
+    return p;
+  }
+
+  template < typename T >
+  T read_integer() {
+    T n;
+    std::memcpy(&n, this->consume(sizeof(T)), sizeof(T));
+    return n;
+  }
+
+  uint8_t read_u8() { return this->read_integer< uint8_t >(); }
+
+  uint32_t read_u32() { return this->read_integer< uint32_t >(); }
+
+  uint64_t read_u64() { return this->read_integer< uint64_t >(); }
+
+  bool read_bool() { return this->read_u8() != 0; }
+
+  /// \brief Read a number of elements
+  ///
+  /// Every element takes at least one byte, this protects against huge
+  /// allocations on malformed files.
+  uint32_t read_count() {
+    uint32_t n = this->read_u32();
+    if (n > static_cast< std::size_t >(this->_end - this->_it)) {
+      throw FormatError("invalid number of elements");
+    }
+    return n;
+  }
+
+  /// \brief Read an index, and check it is lower than the given size
+  uint32_t read_index(std::size_t size, const char* what) {
+    uint32_t idx = this->read_u32();
+    if (idx >= size) {
+      throw FormatError(std::string("invalid ") + what + " index");
+    }
+    return idx;
+  }
+
+  StringRef read_string_ref() {
+    return this->_strings[this->read_index(this->_strings.size(), "string")];
+  }
+
+  std::string read_string() { return this->read_string_ref().to_string(); }
+
+  ZNumber read_number() {
+    uint8_t tag = this->read_u8();
+    if (tag == SmallNumberTag) {
+      return ZNumber(static_cast< int64_t >(this->read_u64()));
+    } else if (tag == LargeNumberTag) {
+      StringRef str = this->read_string_ref();
+      auto it = str.begin();
+      if (it != str.end() && *it == '-') {
+        ++it;
+      }
+      if (it == str.end() || !std::all_of(it, str.end(), [](char c) {
+            return c >= '0' && c <= '9';
+          })) {
+        throw FormatError("invalid number");
+      }
+      return ZNumber::from_string(str.to_string());
+    } else {
+      throw FormatError("invalid number");
+    }
+  }
+
+  /// \brief Read a number of elements of a sequential type
+  ZNumber read_num_elements() {
+    ZNumber n = this->read_number();
+    if (n < 0) {
+      throw FormatError("invalid number of elements");
+    }
+    return n;
+  }
+
+  /// \brief Read a bit-width, limited to the maximum bit-width of LLVM
+  uint64_t read_bit_width() {
+    uint64_t bit_width = this->read_u64();
+    if (bit_width == 0 || bit_width > MaxBitWidth) {
+      throw FormatError("invalid bit-width");
+    }
+    return bit_width;
+  }
+
+  Signedness read_sign() {
+    auto sign = static_cast< Signedness >(this->read_u8());
+    if (sign != Signed && sign != Unsigned) {
+      throw FormatError("invalid signedness");
+    }
+    return sign;
+  }
+
+  MachineInt read_machine_int() {
+    uint64_t bit_width = this->read_bit_width();
+    Signedness sign = this->read_sign();
+    return MachineInt(this->read_number(), bit_width, sign);
+  }
+
+  Type* read_type() {
+    return this->_types[this->read_index(this->_types.size(), "type")];
+  }
+
+  template < typename T >
+  T* read_type_as() {
+    Type* type = this->read_type();
+    if (!isa< T >(type)) {
+      throw FormatError("unexpected type");
+    }
+    return cast< T >(type);
+  }
+
+  Value* read_value() {
+    uint8_t tag = this->read_u8();
+    switch (tag) {
+      case NullTag: {
+        this->read_u32();
+        return nullptr;
+      }
+      case ConstantTag: {
+        return this->_constants[this->read_index(this->_constants.size(),
+                                                 "constant")];
+      }
+      case GlobalVariableTag: {
+        return this->_globals[this->read_index(this->_globals.size(),
+                                               "global variable")];
+      }
+      case LocalVariableTag: {
+        return this->_locals[this->read_index(this->_locals.size(),
+                                              "local variable")];
+      }
+      case InternalVariableTag: {
+        return this->_internals[this->read_index(this->_internals.size(),
+                                                 "internal variable")];
+      }
+      case InlineConstantTag: {
+        return this->decode_constant();
+      }
+      default: {
+        throw FormatError("invalid value");
+      }
+    }
+  }
+
+  template < typename T >
+  T* read_value_as() {
+    Value* value = this->read_value();
+    if (value == nullptr || !isa< T >(value)) {
+      throw FormatError("unexpected value");
+    }
+    return cast< T >(value);
+  }
+
+  template < typename T >
+  T* read_value_as_or_null() {
+    Value* value = this->read_value();
+    if (value != nullptr && !isa< T >(value)) {
+      throw FormatError("unexpected value");
+    }
+    return cast_or_null< T >(value);
+  }
+
+  BasicBlock* read_block_or_null() {
+    uint32_t idx = this->read_u32();
+    if (idx == NoIndex) {
+      return nullptr;
+    }
+    if (idx >= this->_blocks.size()) {
+      throw FormatError("invalid basic block index");
+    }
+    return this->_blocks[idx];
+  }
+
+  /// \brief Read the source information, and attach it to the given object
+  template < typename T >
+  void read_source_info(T* obj) {
+    uint32_t idx = this->read_u32();
+    if (idx == NoIndex) {
+      return;
+    }
+    if (idx >= this->_source_infos.size()) {
+      throw FormatError("invalid source information index");
+    }
+    obj->set_frontend(&this->_source_infos[idx]);
+  }
+
+  /// @}
+  /// \name Tables
+  /// @{
+
+  void read_header() {
+    if (std::memcmp(this->consume(sizeof(Magic)), Magic, sizeof(Magic)) != 0) {
+      throw FormatError("not an AR binary file");
+    }
+    if (this->read_u32() != BinaryFormatVersion) {
+      throw FormatError("unsupported version of the AR binary format");
+    }
+    if (this->read_u32() != ByteOrderMark) {
+      throw FormatError("AR binary file written with a different endianness");
+    }
+  }
+
+  void read_string_table() {
+    uint32_t n = this->read_count();
+    this->_strings.reserve(n);
+    for (uint32_t i = 0; i < n; i++) {
+      uint32_t size = this->read_u32();
+      this->_strings.emplace_back(this->consume(size), size);
+    }
+    if (this->_strings.empty() || !this->_strings[0].empty()) {
+      throw FormatError("invalid string table");
+    }
+  }
+
+  void read_source_info_table() {
+    // The vector is never resized afterwards, objects point into it
+    uint32_t n = this->read_count();
+    this->_source_infos.clear();
+    this->_source_infos.resize(n);
+    for (SourceInfo& info : this->_source_infos) {
+      info.file = this->read_string_ref();
+      info.line = this->read_u32();
+      info.column = this->read_u32();
+      info.name = this->read_string_ref();
+      info.flags = this->read_u32();
+    }
+  }
+
+  /// @}
+  /// \name Bundle decoder
+  /// @{
+
+  void decode_bundle() {
+    // Target
+    std::string triple = this->read_string();
+    auto endianness = static_cast< Endianness >(this->read_u8());
+    if (endianness != LittleEndian && endianness != BigEndian) {
+      throw FormatError("invalid endianness");
+    }
+    std::unique_ptr< DataLayout > dl =
+        DataLayout::create(endianness, this->read_data_layout_info());
+    for (uint32_t i = 0, n = this->read_count(); i < n; i++) {
+      dl->set_integer_alignment(this->read_data_layout_info());
+    }
+    for (uint32_t i = 0, n = this->read_count(); i < n; i++) {
+      dl->set_float_alignment(this->read_data_layout_info());
+    }
+    this->_bundle = Bundle::create(this->_ctx, std::move(dl), triple);
+
+    // Types
+    uint32_t num_types = this->read_count();
+    this->_types.reserve(num_types);
+    for (uint32_t i = 0; i < num_types; i++) {
+      this->_types.push_back(this->decode_type());
+    }
+
+    // Layouts of structures
+    for (Type* type : this->_types) {
+      if (auto struct_type = dyn_cast< StructType >(type)) {
+        StructType::Layout layout;
+        uint32_t n = this->read_count();
+        layout.reserve(n);
+        for (uint32_t i = 0; i < n; i++) {
+          ZNumber offset = this->read_number();
+          layout.push_back({std::move(offset), this->read_type()});
+        }
+        struct_type->set_layout(std::move(layout));
+      }
+    }
+
+    // Global variable declarations
+    uint32_t num_globals = this->read_count();
+    this->_globals.reserve(num_globals);
+    for (uint32_t i = 0; i < num_globals; i++) {
+      std::string name = this->read_string();
+      auto type = this->read_type_as< PointerType >();
+      bool is_definition = this->read_bool();
+      uint64_t alignment = this->read_u64();
+      if (name.empty() || !this->_bundle->is_name_available(name)) {
+        throw FormatError("invalid global variable name");
+      }
+      GlobalVariable* gv = GlobalVariable::create(this->_bundle,
+                                                  type,
+                                                  std::move(name),
+                                                  is_definition,
+                                                  alignment);
+      this->read_source_info(gv);
+      this->_globals.push_back(gv);
+    }
+
+    // Function declarations
+    uint32_t num_functions = this->read_count();
+    this->_functions.reserve(num_functions);
+    for (uint32_t i = 0; i < num_functions; i++) {
+      std::string name = this->read_string();
+      auto type = this->read_type_as< FunctionType >();
+      bool is_definition = this->read_bool();
+      uint32_t id = this->read_u32();
+      if (id >= Intrinsic::_EndLibcppIntrinsic ||
+          (id != Intrinsic::NotIntrinsic && is_definition)) {
+        throw FormatError("invalid intrinsic");
+      }
+      if (name.empty() || !this->_bundle->is_name_available(name)) {
+        throw FormatError("invalid function name");
+      }
+      Function* fun = Function::create(this->_bundle,
+                                       type,
+                                       std::move(name),
+                                       is_definition,
+                                       static_cast< Intrinsic::ID >(id));
+      this->read_source_info(fun);
+      this->_functions.push_back(fun);
+    }
+
+    // Constants
+    uint32_t num_constants = this->read_count();
+    this->_constants.reserve(num_constants);
+    for (uint32_t i = 0; i < num_constants; i++) {
+      this->_constants.push_back(this->decode_constant());
+    }
+
+    // Global variable initializers
+    for (GlobalVariable* gv : this->_globals) {
+      if (gv->is_definition()) {
+        this->_locals.clear();
+        this->decode_code(gv->initializer());
+      }
+    }
+
+    // Function bodies
+    for (Function* fun : this->_functions) {
+      if (!fun->is_definition()) {
+        continue;
+      }
+
+      this->_locals.clear();
+      uint32_t num_locals = this->read_count();
+      this->_locals.reserve(num_locals);
+      for (uint32_t i = 0; i < num_locals; i++) {
+        auto type = this->read_type_as< PointerType >();
+        uint64_t alignment = this->read_u64();
+        LocalVariable* lv = LocalVariable::create(fun, type, alignment);
+        std::string name = this->read_string();
+        if (!name.empty()) {
+          lv->set_name(std::move(name));
+        }
+        this->read_source_info(lv);
+        this->_locals.push_back(lv);
+      }
+
+      this->decode_code(fun->body());
+    }
+  }
+
+  DataLayoutInfo read_data_layout_info() {
+    uint64_t bit_width = this->read_u64();
+    uint64_t abi_alignment = this->read_u64();
+    uint64_t pref_alignment = this->read_u64();
+    return DataLayoutInfo(bit_width, abi_alignment, pref_alignment);
+  }
+
+  Type* decode_type() {
+    switch (this->read_u8()) {
+      case Type::VoidKind: {
+        return VoidType::get(this->_ctx);
+      }
+      case Type::IntegerKind: {
+        uint64_t bit_width = this->read_bit_width();
+        Signedness sign = this->read_sign();
+        return IntegerType::get(this->_ctx, bit_width, sign);
+      }
+      case Type::FloatKind: {
+        uint8_t sem = this->read_u8();
+        if (sem > PPC_FP128) {
+          throw FormatError("invalid floating point type");
+        }
+        return FloatType::get(this->_ctx, static_cast< FloatSemantic >(sem));
+      }
+      case Type::PointerKind: {
+        return PointerType::get(this->_ctx, this->read_type());
+      }
+      case Type::StructKind: {
+        return StructType::create(this->_ctx, this->read_bool());
+      }
+      case Type::ArrayKind: {
+        Type* element_type = this->read_type();
+        return ArrayType::get(this->_ctx,
+                              element_type,
+                              this->read_num_elements());
+      }
+      case Type::VectorKind: {
+        auto element_type = this->read_type_as< ScalarType >();
+        return VectorType::get(this->_ctx,
+                               element_type,
+                               this->read_num_elements());
+      }
+      case Type::OpaqueKind: {
+        if (this->read_bool()) {
+          return OpaqueType::libc_file_type(this->_ctx);
+        }
+        return OpaqueType::create(this->_ctx);
+      }
+      case Type::FunctionKind: {
+        Type* return_type = this->read_type();
+        FunctionType::ParamTypes params;
+        uint32_t n = this->read_count();
+        params.reserve(n);
+        for (uint32_t i = 0; i < n; i++) {
+          params.push_back(this->read_type());
+        }
+        bool is_var_arg = this->read_bool();
+        return FunctionType::get(this->_ctx, return_type, params, is_var_arg);
+      }
+      default: {
+        throw FormatError("invalid type");
+      }
+    }
+  }
+
+  Value* decode_constant() {
+    switch (this->read_u8()) {
+      case Value::UndefinedConstantKind: {
+        return UndefinedConstant::get(this->_ctx, this->read_type());
+      }
+      case Value::IntegerConstantKind: {
+        auto type = this->read_type_as< IntegerType >();
+        MachineInt value(this->read_number(), type->bit_width(), type->sign());
+        return IntegerConstant::get(this->_ctx, type, value);
+      }
+      case Value::FloatConstantKind: {
+        auto type = this->read_type_as< FloatType >();
+        return FloatConstant::get(this->_ctx, type, this->read_string());
+      }
+      case Value::NullConstantKind: {
+        return NullConstant::get(this->_ctx,
+                                 this->read_type_as< PointerType >());
+      }
+      case Value::StructConstantKind: {
+        auto type = this->read_type_as< StructType >();
+        StructConstant::Values values;
+        uint32_t n = this->read_count();
+        values.reserve(n);
+        for (uint32_t i = 0; i < n; i++) {
+          ZNumber offset = this->read_number();
+          values.push_back({std::move(offset), this->read_value_as< Value >()});
+        }
+        return StructConstant::get(this->_ctx, type, values);
+      }
+      case Value::ArrayConstantKind: {
+        auto type = this->read_type_as< ArrayType >();
+        return ArrayConstant::get(this->_ctx, type, this->read_values());
+      }
+      case Value::VectorConstantKind: {
+        auto type = this->read_type_as< VectorType >();
+        return VectorConstant::get(this->_ctx, type, this->read_values());
+      }
+      case Value::AggregateZeroConstantKind: {
+        auto type = this->read_type_as< AggregateType >();
+        return AggregateZeroConstant::get(this->_ctx, type);
+      }
+      case Value::FunctionPointerConstantKind: {
+        uint32_t idx = this->read_index(this->_functions.size(), "function");
+        return FunctionPointerConstant::get(this->_ctx, this->_functions[idx]);
+      }
+      case Value::InlineAssemblyConstantKind: {
+        auto type = this->read_type_as< PointerType >();
+        return InlineAssemblyConstant::get(this->_ctx,
+                                           type,
+                                           this->read_string());
+      }
+      default: {
+        throw FormatError("invalid constant");
+      }
+    }
+  }
+
+  std::vector< Value* > read_values() {
+    std::vector< Value* > values;
+    uint32_t n = this->read_count();
+    values.reserve(n);
+    for (uint32_t i = 0; i < n; i++) {
+      values.push_back(this->read_value_as< Value >());
+    }
+    return values;
+  }
+
+  void decode_code(Code* code) {
+    // Internal variables, starting with the parameters created with the code
+    this->_internals.assign(code->internal_variable_begin(),
+                            code->internal_variable_end());
+    this->_blocks.clear();
+
+    uint32_t num_internals = this->read_count();
+    if (num_internals < this->_internals.size()) {
+      throw FormatError("missing function parameters");
+    }
+    this->_internals.reserve(num_internals);
+    for (uint32_t i = 0; i < num_internals; i++) {
+      Type* type = this->read_type();
+      InternalVariable* iv = nullptr;
+      if (i < this->_internals.size()) {
+        iv = this->_internals[i];
+        if (iv->type() != type) {
+          throw FormatError("unexpected function parameter type");
+        }
+      } else {
+        iv = InternalVariable::create(code, type);
+        this->_internals.push_back(iv);
+      }
+      std::string name = this->read_string();
+      if (!name.empty()) {
+        iv->set_name(std::move(name));
+      }
+      this->read_source_info(iv);
+    }
+
+    // Basic blocks
+    uint32_t num_blocks = this->read_count();
+    this->_blocks.reserve(num_blocks);
+    for (uint32_t i = 0; i < num_blocks; i++) {
+      this->_blocks.push_back(BasicBlock::create(code));
+    }
+    for (BasicBlock* bb : this->_blocks) {
+      std::string name = this->read_string();
+      if (!name.empty()) {
+        bb->set_name(std::move(name));
+      }
+      for (uint32_t i = 0, n = this->read_count(); i < n; i++) {
+        BasicBlock* succ = this->read_block_or_null();
+        if (succ == nullptr) {
+          throw FormatError("invalid successor");
+        }
+        bb->add_successor(succ);
+      }
+      for (uint32_t i = 0, n = this->read_count(); i < n; i++) {
+        bb->push_back(this->decode_statement());
+      }
+    }
+
+    if (BasicBlock* entry = this->read_block_or_null()) {
+      code->set_entry_block(entry);
+    }
+    if (BasicBlock* exit = this->read_block_or_null()) {
+      code->set_exit_block(exit);
+    }
+  }
+
+  std::unique_ptr< Statement > decode_statement() {
+    uint8_t kind = this->read_u8();
+    uint32_t source_info = this->read_u32();
+    Value* result = this->read_value();
+    Statement::Operands ops;
+    uint32_t num_ops = this->read_count();
+    ops.reserve(num_ops);
+    for (uint32_t i = 0; i < num_ops; i++) {
+      ops.push_back(this->read_value_as< Value >());
+    }
+
+    std::unique_ptr< Statement > stmt = this->make_statement(kind, result, ops);
+
+    if (source_info != NoIndex) {
+      if (source_info >= this->_source_infos.size()) {
+        throw FormatError("invalid source information index");
+      }
+      stmt->set_frontend(&this->_source_infos[source_info]);
+    }
+    return stmt;
+  }
+
+  /// \brief Return the internal variable result of a statement
+  static InternalVariable* internal_result(Value* result) {
+    if (result == nullptr || !isa< InternalVariable >(result)) {
+      throw FormatError("unexpected statement result");
+    }
+    return cast< InternalVariable >(result);
+  }
+
+  /// \brief Return the optional internal variable result of a statement
+  static InternalVariable* internal_result_or_null(Value* result) {
+    return result == nullptr ? nullptr : internal_result(result);
+  }
+
+  /// \brief Return true if the given binary operator is valid
+  static bool is_valid(BinaryOperation::Operator op) {
+    using Op = BinaryOperation;
+    return (op > Op::_BeginUnsignedIntegerOp &&
+            op < Op::_EndUnsignedIntegerOp) ||
+           (op > Op::_BeginSignedIntegerOp && op < Op::_EndSignedIntegerOp) ||
+           (op > Op::_BeginFloatOp && op < Op::_EndFloatOp);
+  }
+
+  /// \brief Return true if the given comparison predicate is valid
+  static bool is_valid(Comparison::Predicate pred) {
+    using Pred = Comparison;
+    return (pred > Pred::_BeginUnsignedIntegerPred &&
+            pred < Pred::_EndUnsignedIntegerPred) ||
+           (pred > Pred::_BeginSignedIntegerPred &&
+            pred < Pred::_EndSignedIntegerPred) ||
+           (pred > Pred::_BeginFloatPred && pred < Pred::_EndFloatPred) ||
+           (pred > Pred::_BeginPointerPred && pred < Pred::_EndPointerPred);
+  }
+
+  /// \brief Check the number of operands of a statement
+  static void check_operands(const Statement::Operands& ops, std::size_t n) {
+    if (ops.size() != n) {
+      throw FormatError("unexpected number of operands");
+    }
+  }
+
+  std::unique_ptr< Statement > make_statement(uint8_t kind,
+                                              Value* result,
+                                              const Statement::Operands& ops) {
+    switch (kind) {
+      case Statement::AssignmentKind: {
+        check_operands(ops, 1);
+        return Assignment::create(internal_result(result), ops[0]);
+      }
+      case Statement::UnaryOperationKind: {
+        check_operands(ops, 1);
+        auto op = static_cast< UnaryOperation::Operator >(this->read_u8());
+        if (op > UnaryOperation::Bitcast) {
+          throw FormatError("invalid unary operator");
+        }
+        return UnaryOperation::create(op, internal_result(result), ops[0]);
+      }
+      case Statement::BinaryOperationKind: {
+        check_operands(ops, 2);
+        auto op = static_cast< BinaryOperation::Operator >(this->read_u8());
+        if (!is_valid(op)) {
+          throw FormatError("invalid binary operator");
+        }
+        bool no_wrap = this->read_bool();
+        bool exact = this->read_bool();
+        if ((no_wrap && !BinaryOperation::is_wrapping_operator(op)) ||
+            (exact && !BinaryOperation::is_exact_operator(op))) {
+          throw FormatError("invalid binary operation flags");
+        }
+        return BinaryOperation::create(op,
+                                       internal_result(result),
+                                       ops[0],
+                                       ops[1],
+                                       no_wrap,
+                                       exact);
+      }
+      case Statement::ComparisonKind: {
+        check_operands(ops, 2);
+        auto pred = static_cast< Comparison::Predicate >(this->read_u8());
+        if (!is_valid(pred)) {
+          throw FormatError("invalid comparison predicate");
+        }
+        return Comparison::create(pred, ops[0], ops[1]);
+      }
+      case Statement::ReturnValueKind: {
+        if (ops.size() > 1) {
+          throw FormatError("unexpected number of operands");
+        }
+        return ReturnValue::create(ops.empty() ? nullptr : ops[0]);
+      }
+      case Statement::UnreachableKind: {
+        check_operands(ops, 0);
+        return Unreachable::create();
+      }
+      case Statement::AllocateKind: {
+        check_operands(ops, 1);
+        if (result == nullptr || !isa< LocalVariable >(result)) {
+          throw FormatError("unexpected statement result");
+        }
+        Type* allocated_type = this->read_type();
+        return Allocate::create(cast< LocalVariable >(result),
+                                allocated_type,
+                                ops[0]);
+      }
+      case Statement::PointerShiftKind: {
+        if (ops.empty()) {
+          throw FormatError("unexpected number of operands");
+        }
+        std::vector< PointerShift::Term > terms;
+        terms.reserve(ops.size() - 1);
+        for (std::size_t i = 1; i < ops.size(); i++) {
+          terms.emplace_back(this->read_machine_int(), ops[i]);
+        }
+        return PointerShift::create(internal_result(result), ops[0], terms);
+      }
+      case Statement::LoadKind: {
+        check_operands(ops, 1);
+        uint64_t alignment = this->read_u64();
+        bool is_volatile = this->read_bool();
+        return Load::create(internal_result(result),
+                            ops[0],
+                            alignment,
+                            is_volatile);
+      }
+      case Statement::StoreKind: {
+        check_operands(ops, 2);
+        uint64_t alignment = this->read_u64();
+        bool is_volatile = this->read_bool();
+        return Store::create(ops[0], ops[1], alignment, is_volatile);
+      }
+      case Statement::ExtractElementKind: {
+        check_operands(ops, 2);
+        return ExtractElement::create(internal_result(result), ops[0], ops[1]);
+      }
+      case Statement::InsertElementKind: {
+        check_operands(ops, 3);
+        return InsertElement::create(internal_result(result),
+                                     ops[0],
+                                     ops[1],
+                                     ops[2]);
+      }
+      case Statement::ShuffleVectorKind: {
+        check_operands(ops, 2);
+        return ShuffleVector::create(internal_result(result), ops[0], ops[1]);
+      }
+      case Statement::CallKind: {
+        if (ops.empty()) {
+          throw FormatError("unexpected number of operands");
+        }
+        return Call::create(internal_result_or_null(result),
+                            ops[0],
+                            std::vector< Value* >(ops.begin() + 1, ops.end()));
+      }
+      case Statement::InvokeKind: {
+        if (ops.empty()) {
+          throw FormatError("unexpected number of operands");
+        }
+        BasicBlock* normal_dest = this->read_block_or_null();
+        BasicBlock* exception_dest = this->read_block_or_null();
+        return Invoke::create(internal_result_or_null(result),
+                              ops[0],
+                              std::vector< Value* >(ops.begin() + 1,
+                                                    ops.end()),
+                              normal_dest,
+                              exception_dest);
+      }
+      case Statement::LandingPadKind: {
+        check_operands(ops, 0);
+        return LandingPad::create(internal_result(result));
+      }
+      case Statement::ResumeKind: {
+        check_operands(ops, 1);
+        return Resume::create(internal_result(ops[0]));
+      }
+      default: {
+        throw FormatError("invalid statement");
+      }
+    }
+  }
+
+  /// @}
+
+}; // end class Decoder
+
+} // end anonymous namespace
+
+void BinaryWriter::write(std::ostream& o, Bundle* bundle) const {
+  Encoder(this->_provider).write(o, bundle);
+}
+
+Bundle* BinaryReader::read(Context& ctx, const char* data, std::size_t size) {
+  return Decoder(ctx, data, size, this->_source_infos).read();
+}
+
+bool BinaryReader::has_header(const char* data, std::size_t size) {
+  return size >= sizeof(Magic) && std::memcmp(data, Magic, sizeof(Magic)) == 0;
+}
+
+} // end namespace ar
+} // end namespace ikos
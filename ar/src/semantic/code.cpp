@@ -59,8 +59,8 @@ BasicBlock::BasicBlock(Code* code) : _parent(code) {
 BasicBlock::~BasicBlock() = default;
 
 BasicBlock* BasicBlock::create(Code* code) {
-  auto bb = std::unique_ptr< BasicBlock >(new BasicBlock(code));
-  return code->add_basic_block(std::move(bb));
+  void* p = code->_arena.allocate(sizeof(BasicBlock), alignof(BasicBlock));
+  return code->add_basic_block(new (p) BasicBlock(code));
 }
 
 Context& BasicBlock::context() const {
@@ -283,7 +283,14 @@ Code::Code(GlobalVariable* gv)
   ikos_assert_msg(gv, "gv is null");
 }
 
-Code::~Code() = default;
+Code::~Code() {
+  for (BasicBlock* bb : this->_blocks) {
+    bb->~BasicBlock();
+  }
+  for (InternalVariable* iv : this->_internal_vars) {
+    iv->~InternalVariable();
+  }
+}
 
 void Code::set_entry_block(BasicBlock* bb) {
   this->_entry_block = bb;
@@ -293,9 +300,9 @@ void Code::set_exit_block(BasicBlock* bb) {
   this->_exit_block = bb;
 }
 
-BasicBlock* Code::add_basic_block(std::unique_ptr< BasicBlock > bb) {
-  this->_blocks.emplace_back(std::move(bb));
-  return this->_blocks.back().get();
+BasicBlock* Code::add_basic_block(BasicBlock* bb) {
+  this->_blocks.push_back(bb);
+  return bb;
 }
 
 void Code::erase_basic_block(BasicBlock* bb) {
@@ -306,18 +313,18 @@ void Code::erase_basic_block(BasicBlock* bb) {
   bb->clear_predecessors();
   bb->clear_successors();
 
-  this->_blocks.erase(std::remove_if(this->_blocks.begin(),
-                                     this->_blocks.end(),
-                                     [=](const auto& bb_ptr) {
-                                       return bb_ptr.get() == bb;
-                                     }),
+  this->_blocks.erase(std::remove(this->_blocks.begin(),
+                                  this->_blocks.end(),
+                                  bb),
                       this->_blocks.end());
+
+  // The memory is released with the arena
+  bb->~BasicBlock();
 }
 
-InternalVariable* Code::add_internal_variable(
-    std::unique_ptr< InternalVariable > iv) {
-  this->_internal_vars.emplace_back(std::move(iv));
-  return this->_internal_vars.back().get();
+InternalVariable* Code::add_internal_variable(InternalVariable* iv) {
+  this->_internal_vars.push_back(iv);
+  return iv;
 }
 
 } // end namespace ar
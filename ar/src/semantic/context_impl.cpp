@@ -41,6 +41,10 @@
  *
  ******************************************************************************/
 
+#include <initializer_list>
+
+#include <boost/functional/hash.hpp>
+
 #include <ikos/ar/semantic/bundle.hpp>
 #include <ikos/ar/semantic/context.hpp>
 #include <ikos/ar/semantic/function.hpp>
@@ -51,6 +55,39 @@
 namespace ikos {
 namespace ar {
 
+namespace {
+
+/// \brief Combine the hash of a value
+template < typename T >
+void hash_combine(std::size_t& seed, const T& value) {
+  boost::hash_combine(seed, value);
+}
+
+/// \brief Combine the hash of a structure field
+void hash_combine(std::size_t& seed, const StructConstant::Field& field) {
+  boost::hash_combine(seed, field.offset);
+  boost::hash_combine(seed, field.value);
+}
+
+/// \brief Combine the hash of a list of elements
+template < typename T >
+void hash_combine(std::size_t& seed, const std::vector< T >& elements) {
+  boost::hash_combine(seed, elements.size());
+  for (const T& element : elements) {
+    hash_combine(seed, element);
+  }
+}
+
+/// \brief Return the structural hash of the given values
+template < typename... Args >
+std::size_t hash_all(const Args&... args) {
+  std::size_t seed = 0;
+  (void)std::initializer_list< int >{(hash_combine(seed, args), 0)...};
+  return seed;
+}
+
+} // end anonymous namespace
+
 ContextImpl::ContextImpl()
     : _ui1_ty(1, Unsigned),
       _ui8_ty(8, Unsigned),
@@ -72,235 +109,212 @@ ContextImpl::ContextImpl()
 ContextImpl::~ContextImpl() = default;
 
 void ContextImpl::add_bundle(std::unique_ptr< Bundle > bundle) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
   this->_bundles.emplace_back(std::move(bundle));
 }
 
 IntegerType* ContextImpl::integer_type(uint64_t bit_width, Signedness sign) {
-  auto it = this->_integer_types.find(std::make_tuple(bit_width, sign));
-  if (it == this->_integer_types.end()) {
-    auto type =
-        std::unique_ptr< IntegerType >(new IntegerType(bit_width, sign));
-    auto res = this->_integer_types.emplace(std::make_tuple(bit_width, sign),
-                                            std::move(type));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(bit_width, static_cast< int >(sign));
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  IntegerType* type =
+      this->_integer_types.find(hash, [=](IntegerType* t) {
+        return t->bit_width() == bit_width && t->sign() == sign;
+      });
+  if (type == nullptr) {
+    type = this->make< IntegerType >(bit_width, sign);
+    this->_integer_types.insert(hash, type);
   }
+  return type;
 }
 
 PointerType* ContextImpl::pointer_type(Type* pointee) {
-  auto it = this->_pointer_types.find(pointee);
-  if (it == this->_pointer_types.end()) {
-    auto type = std::unique_ptr< PointerType >(new PointerType(pointee));
-    auto res = this->_pointer_types.emplace(pointee, std::move(type));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  PointerType*& type = this->_pointer_types[pointee];
+  if (type == nullptr) {
+    type = this->make< PointerType >(pointee);
   }
+  return type;
 }
 
 ArrayType* ContextImpl::array_type(Type* element_type,
                                    const ZNumber& num_element) {
-  auto it = this->_array_types.find(std::make_tuple(element_type, num_element));
-  if (it == this->_array_types.end()) {
-    auto type =
-        std::unique_ptr< ArrayType >(new ArrayType(element_type, num_element));
-    auto res =
-        this->_array_types.emplace(std::make_tuple(element_type, num_element),
-                                   std::move(type));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(element_type, num_element);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ArrayType* type = this->_array_types.find(hash, [&](ArrayType* t) {
+    return t->element_type() == element_type &&
+           t->num_elements() == num_element;
+  });
+  if (type == nullptr) {
+    type = this->make< ArrayType >(element_type, num_element);
+    this->_array_types.insert(hash, type);
   }
+  return type;
 }
 
 VectorType* ContextImpl::vector_type(ScalarType* element_type,
                                      const ZNumber& num_element) {
-  auto it =
-      this->_vector_types.find(std::make_tuple(element_type, num_element));
-  if (it == this->_vector_types.end()) {
-    auto type = std::unique_ptr< VectorType >(
-        new VectorType(element_type, num_element));
-    auto res =
-        this->_vector_types.emplace(std::make_tuple(element_type, num_element),
-                                    std::move(type));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(element_type, num_element);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  VectorType* type = this->_vector_types.find(hash, [&](VectorType* t) {
+    return t->element_type() == element_type &&
+           t->num_elements() == num_element;
+  });
+  if (type == nullptr) {
+    type = this->make< VectorType >(element_type, num_element);
+    this->_vector_types.insert(hash, type);
   }
+  return type;
 }
 
 FunctionType* ContextImpl::function_type(
     Type* return_type,
     const FunctionType::ParamTypes& param_types,
     bool is_var_arg) {
-  auto it = this->_function_types.find(
-      std::make_tuple(return_type, param_types, is_var_arg));
-  if (it == this->_function_types.end()) {
-    auto type = std::unique_ptr< FunctionType >(
-        new FunctionType(return_type, param_types, is_var_arg));
-    auto res = this->_function_types.emplace(std::make_tuple(return_type,
-                                                             param_types,
-                                                             is_var_arg),
-                                             std::move(type));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(return_type, param_types, is_var_arg);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  FunctionType* type = this->_function_types.find(hash, [&](FunctionType* t) {
+    return t->return_type() == return_type &&
+           t->param_types() == param_types && t->is_var_arg() == is_var_arg;
+  });
+  if (type == nullptr) {
+    type = this->make< FunctionType >(return_type, param_types, is_var_arg);
+    this->_function_types.insert(hash, type);
   }
+  return type;
 }
 
 Type* ContextImpl::add_type(std::unique_ptr< Type > type) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
   this->_types.emplace_back(std::move(type));
   return this->_types.back().get();
 }
 
 UndefinedConstant* ContextImpl::undefined_cst(Type* type) {
-  auto it = this->_undefined_constants.find(type);
-  if (it == this->_undefined_constants.end()) {
-    auto cst =
-        std::unique_ptr< UndefinedConstant >(new UndefinedConstant(type));
-    auto res = this->_undefined_constants.emplace(type, std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  UndefinedConstant*& cst = this->_undefined_constants[type];
+  if (cst == nullptr) {
+    cst = this->make< UndefinedConstant >(type);
   }
+  return cst;
 }
 
 IntegerConstant* ContextImpl::integer_cst(IntegerType* type,
                                           const MachineInt& value) {
-  auto it = this->_integer_constants.find(std::make_tuple(type, value));
-  if (it == this->_integer_constants.end()) {
-    auto cst =
-        std::unique_ptr< IntegerConstant >(new IntegerConstant(type, value));
-    auto res = this->_integer_constants.emplace(std::make_tuple(type, value),
-                                                std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, value);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  IntegerConstant* cst =
+      this->_integer_constants.find(hash, [&](IntegerConstant* c) {
+        return c->type() == type && c->value() == value;
+      });
+  if (cst == nullptr) {
+    cst = this->make< IntegerConstant >(type, value);
+    this->_integer_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 FloatConstant* ContextImpl::float_cst(FloatType* type,
                                       const std::string& value) {
-  auto it = this->_float_constants.find(std::make_tuple(type, value));
-  if (it == this->_float_constants.end()) {
-    auto cst = std::unique_ptr< FloatConstant >(new FloatConstant(type, value));
-    auto res = this->_float_constants.emplace(std::make_tuple(type, value),
-                                              std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, value);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  FloatConstant* cst = this->_float_constants.find(hash, [&](FloatConstant* c) {
+    return c->type() == type && c->value() == value;
+  });
+  if (cst == nullptr) {
+    cst = this->make< FloatConstant >(type, value);
+    this->_float_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 NullConstant* ContextImpl::null_cst(PointerType* type) {
-  auto it = this->_null_constants.find(type);
-  if (it == this->_null_constants.end()) {
-    auto cst = std::unique_ptr< NullConstant >(new NullConstant(type));
-    auto res = this->_null_constants.emplace(type, std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  NullConstant*& cst = this->_null_constants[type];
+  if (cst == nullptr) {
+    cst = this->make< NullConstant >(type);
   }
+  return cst;
 }
 
 StructConstant* ContextImpl::struct_cst(StructType* type,
                                         const StructConstant::Values& values) {
-  auto it = this->_struct_constants.find(std::make_tuple(type, values));
-  if (it == this->_struct_constants.end()) {
-    auto cst =
-        std::unique_ptr< StructConstant >(new StructConstant(type, values));
-    auto res = this->_struct_constants.emplace(std::make_tuple(type, values),
-                                               std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, values);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  StructConstant* cst =
+      this->_struct_constants.find(hash, [&](StructConstant* c) {
+        return c->type() == type && c->values() == values;
+      });
+  if (cst == nullptr) {
+    cst = this->make< StructConstant >(type, values);
+    this->_struct_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 ArrayConstant* ContextImpl::array_cst(ArrayType* type,
                                       const ArrayConstant::Values& values) {
-  auto it = this->_array_constants.find(std::make_tuple(type, values));
-  if (it == this->_array_constants.end()) {
-    auto cst =
-        std::unique_ptr< ArrayConstant >(new ArrayConstant(type, values));
-    auto res = this->_array_constants.emplace(std::make_tuple(type, values),
-                                              std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, values);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  ArrayConstant* cst = this->_array_constants.find(hash, [&](ArrayConstant* c) {
+    return c->type() == type && c->values() == values;
+  });
+  if (cst == nullptr) {
+    cst = this->make< ArrayConstant >(type, values);
+    this->_array_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 VectorConstant* ContextImpl::vector_cst(VectorType* type,
                                         const VectorConstant::Values& values) {
-  auto it = this->_vector_constants.find(std::make_tuple(type, values));
-  if (it == this->_vector_constants.end()) {
-    auto cst =
-        std::unique_ptr< VectorConstant >(new VectorConstant(type, values));
-    auto res = this->_vector_constants.emplace(std::make_tuple(type, values),
-                                               std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, values);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  VectorConstant* cst =
+      this->_vector_constants.find(hash, [&](VectorConstant* c) {
+        return c->type() == type && c->values() == values;
+      });
+  if (cst == nullptr) {
+    cst = this->make< VectorConstant >(type, values);
+    this->_vector_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 AggregateZeroConstant* ContextImpl::aggregate_zero_cst(AggregateType* type) {
-  auto it = this->_aggregate_zero_constants.find(type);
-  if (it == this->_aggregate_zero_constants.end()) {
-    auto cst = std::unique_ptr< AggregateZeroConstant >(
-        new AggregateZeroConstant(type));
-    auto res = this->_aggregate_zero_constants.emplace(type, std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  AggregateZeroConstant*& cst = this->_aggregate_zero_constants[type];
+  if (cst == nullptr) {
+    cst = this->make< AggregateZeroConstant >(type);
   }
+  return cst;
 }
 
 FunctionPointerConstant* ContextImpl::function_pointer_cst(Function* function) {
-  auto it = this->_function_pointer_constants.find(function);
-  if (it == this->_function_pointer_constants.end()) {
-    ikos_assert_msg(function, "function is null");
-    PointerType* fun_ptr_type = this->pointer_type(function->type());
-    auto cst = std::unique_ptr< FunctionPointerConstant >(
-        new FunctionPointerConstant(fun_ptr_type, function));
-    auto res =
-        this->_function_pointer_constants.emplace(function, std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  ikos_assert_msg(function, "function is null");
+  PointerType* fun_ptr_type = this->pointer_type(function->type());
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  FunctionPointerConstant*& cst = this->_function_pointer_constants[function];
+  if (cst == nullptr) {
+    cst = this->make< FunctionPointerConstant >(fun_ptr_type, function);
   }
+  return cst;
 }
 
 InlineAssemblyConstant* ContextImpl::inline_assembly_cst(
     PointerType* type, const std::string& code) {
-  auto it = this->_inline_assembly_constants.find(std::make_tuple(type, code));
-  if (it == this->_inline_assembly_constants.end()) {
-    auto cst = std::unique_ptr< InlineAssemblyConstant >(
-        new InlineAssemblyConstant(type, code));
-    auto res =
-        this->_inline_assembly_constants.emplace(std::make_tuple(type, code),
-                                                 std::move(cst));
-    ikos_assert(res.second);
-    return res.first->second.get();
-  } else {
-    return it->second.get();
+  std::size_t hash = hash_all(type, code);
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  InlineAssemblyConstant* cst =
+      this->_inline_assembly_constants.find(hash,
+                                            [&](InlineAssemblyConstant* c) {
+                                              return c->type() == type &&
+                                                     c->code() == code;
+                                            });
+  if (cst == nullptr) {
+    cst = this->make< InlineAssemblyConstant >(type, code);
+    this->_inline_assembly_constants.insert(hash, cst);
   }
+  return cst;
 }
 
 } // end namespace ar
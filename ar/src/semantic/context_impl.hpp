@@ -43,20 +43,51 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
-#include <tuple>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include <boost/container/flat_map.hpp>
-
 #include <ikos/ar/semantic/bundle.hpp>
 #include <ikos/ar/semantic/type.hpp>
 #include <ikos/ar/semantic/value.hpp>
+#include <ikos/ar/support/arena.hpp>
 
 namespace ikos {
 namespace ar {
 
+/// \brief Hash-consing table
+///
+/// Objects are indexed by their structural hash, which is computed once per
+/// lookup. The structural comparison only happens on objects with the same
+/// hash, and the table does not hold a copy of the keys.
+template < typename T >
+class HashConsTable {
+private:
+  // Map from structural hash to objects
+  std::unordered_multimap< std::size_t, T* > _map;
+
+public:
+  /// \brief Return the object with the given hash satisfying the given
+  /// predicate, or null
+  template < typename Predicate >
+  T* find(std::size_t hash, Predicate equal) const {
+    auto range = this->_map.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (equal(it->second)) {
+        return it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  /// \brief Insert an object with the given hash
+  void insert(std::size_t hash, T* object) { this->_map.emplace(hash, object); }
+
+}; // end class HashConsTable
+
 class ContextImpl {
 private:
   // List of owned bundles
@@ -90,86 +121,61 @@ private:
   // Libc FILE opaque type (used for intrinsics)
   OpaqueType _libc_file_ty;
 
-  // Using boost::container::flat_map with std::pair causes crashes on FreeBSD.
-  // As a workaround, we use std::tuple instead of std::pair here.
-  // see https://github.com/NASA-SW-VnV/ikos/issues/22
-  // see https://github.com/boostorg/container/issues/97
+  // Protects the bundle list, the arena and the tables below
+  std::mutex _mutex;
+
+  // Arena of the types and constants below
+  Arena _arena;
 
   // Integer types
-  boost::container::flat_map< std::tuple< uint64_t, Signedness >,
-                              std::unique_ptr< IntegerType > >
-      _integer_types;
+  HashConsTable< IntegerType > _integer_types;
 
   // Pointer types
-  boost::container::flat_map< Type*, std::unique_ptr< PointerType > >
-      _pointer_types;
+  std::unordered_map< Type*, PointerType* > _pointer_types;
 
   // Array types
-  boost::container::flat_map< std::tuple< Type*, ZNumber >,
-                              std::unique_ptr< ArrayType > >
-      _array_types;
+  HashConsTable< ArrayType > _array_types;
 
   // Vector types
-  boost::container::flat_map< std::tuple< ScalarType*, ZNumber >,
-                              std::unique_ptr< VectorType > >
-      _vector_types;
+  HashConsTable< VectorType > _vector_types;
 
   // Function types
-  boost::container::flat_map<
-      std::tuple< Type*, FunctionType::ParamTypes, bool >,
-      std::unique_ptr< FunctionType > >
-      _function_types;
+  HashConsTable< FunctionType > _function_types;
 
   // Other types (struct and opaque)
   std::vector< std::unique_ptr< Type > > _types;
 
   // Undefined constants
-  boost::container::flat_map< Type*, std::unique_ptr< UndefinedConstant > >
-      _undefined_constants;
+  std::unordered_map< Type*, UndefinedConstant* > _undefined_constants;
 
   // Integer constants
-  boost::container::flat_map< std::tuple< IntegerType*, MachineInt >,
-                              std::unique_ptr< IntegerConstant > >
-      _integer_constants;
+  HashConsTable< IntegerConstant > _integer_constants;
 
   // Float constants
-  boost::container::flat_map< std::tuple< FloatType*, std::string >,
-                              std::unique_ptr< FloatConstant > >
-      _float_constants;
+  HashConsTable< FloatConstant > _float_constants;
 
   // Null constants
-  boost::container::flat_map< PointerType*, std::unique_ptr< NullConstant > >
-      _null_constants;
+  std::unordered_map< PointerType*, NullConstant* > _null_constants;
 
   // Structure constants
-  boost::container::flat_map< std::tuple< StructType*, StructConstant::Values >,
-                              std::unique_ptr< StructConstant > >
-      _struct_constants;
+  HashConsTable< StructConstant > _struct_constants;
 
   // Array constants
-  boost::container::flat_map< std::tuple< ArrayType*, ArrayConstant::Values >,
-                              std::unique_ptr< ArrayConstant > >
-      _array_constants;
+  HashConsTable< ArrayConstant > _array_constants;
 
   // Vector constants
-  boost::container::flat_map< std::tuple< VectorType*, VectorConstant::Values >,
-                              std::unique_ptr< VectorConstant > >
-      _vector_constants;
+  HashConsTable< VectorConstant > _vector_constants;
 
   // Aggregate zero constants
-  boost::container::flat_map< AggregateType*,
-                              std::unique_ptr< AggregateZeroConstant > >
+  std::unordered_map< AggregateType*, AggregateZeroConstant* >
       _aggregate_zero_constants;
 
   // Function pointer constants
-  boost::container::flat_map< Function*,
-                              std::unique_ptr< FunctionPointerConstant > >
+  std::unordered_map< Function*, FunctionPointerConstant* >
       _function_pointer_constants;
 
   // Inline assembly constants
-  boost::container::flat_map< std::tuple< PointerType*, std::string >,
-                              std::unique_ptr< InlineAssemblyConstant > >
-      _inline_assembly_constants;
+  HashConsTable< InlineAssemblyConstant > _inline_assembly_constants;
 
 public:
   /// \brief Default constructor
@@ -277,6 +283,14 @@ public:
   InlineAssemblyConstant* inline_assembly_cst(PointerType* type,
                                               const std::string& code);
 
+private:
+  /// \brief Create an object in the arena
+  template < typename T, typename... Args >
+  T* make(Args&&... args) {
+    void* p = this->_arena.allocate(sizeof(T), alignof(T));
+    return this->_arena.track(new (p) T(std::forward< Args >(args)...));
+  }
+
 }; // end class ContextImpl
 
 } // end namespace ar
@@ -393,9 +393,9 @@ InternalVariable::InternalVariable(Code* code, Type* type)
 }
 
 InternalVariable* InternalVariable::create(Code* code, Type* type) {
-  auto iv =
-      std::unique_ptr< InternalVariable >(new InternalVariable(code, type));
-  return code->add_internal_variable(std::move(iv));
+  void* p = code->_arena.allocate(sizeof(InternalVariable),
+                                  alignof(InternalVariable));
+  return code->add_internal_variable(new (p) InternalVariable(code, type));
 }
 
 Context& InternalVariable::context() const {
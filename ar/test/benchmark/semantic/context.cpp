@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * Benchmark of the interning of types and constants in the AR context
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <string>
+
+#include <ikos/ar/semantic/context.hpp>
+#include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+#include "../benchmark.hpp"
+
+namespace ar = ikos::ar;
+namespace benchmark = ikos::ar::benchmark;
+
+using ar::ZNumber;
+
+namespace {
+
+/// \brief Create the initializer of a `[n x si32]` global, with n distinct
+/// integer constants
+ar::Value* create_array(ar::Context& ctx, int n) {
+  ar::IntegerType* si32 = ar::IntegerType::si32(ctx);
+  ar::ArrayConstant::Values values;
+  values.reserve(static_cast< std::size_t >(n));
+  for (int i = 0; i < n; i++) {
+    values.push_back(ar::IntegerConstant::get(ctx, si32, i));
+  }
+  return ar::ArrayConstant::get(ctx,
+                                ar::ArrayType::get(ctx, si32, ZNumber(n)),
+                                values);
+}
+
+/// \brief Create the initializers of n `{si32, si64}` globals
+ar::Value* create_structs(ar::Context& ctx,
+                          ar::StructType* type,
+                          int n) {
+  ar::IntegerType* si32 = ar::IntegerType::si32(ctx);
+  ar::IntegerType* si64 = ar::IntegerType::si64(ctx);
+  ar::Value* last = nullptr;
+  for (int i = 0; i < n; i++) {
+    last = ar::StructConstant::get(
+        ctx,
+        type,
+        {{ZNumber(0), ar::IntegerConstant::get(ctx, si32, i)},
+         {ZNumber(8), ar::IntegerConstant::get(ctx, si64, -i)}});
+  }
+  return last;
+}
+
+/// \brief Create n distinct `[16 x si8]` string constants
+ar::Value* create_strings(ar::Context& ctx, int n) {
+  ar::IntegerType* si8 = ar::IntegerType::si8(ctx);
+  ar::ArrayType* type = ar::ArrayType::get(ctx, si8, ZNumber(16));
+  ar::Value* last = nullptr;
+  for (int i = 0; i < n; i++) {
+    std::string str = "string_" + std::to_string(i);
+    str.resize(16, '\0');
+    ar::ArrayConstant::Values values;
+    values.reserve(str.size());
+    for (char c : str) {
+      values.push_back(ar::IntegerConstant::get(ctx, si8, c));
+    }
+    last = ar::ArrayConstant::get(ctx, type, values);
+  }
+  return last;
+}
+
+/// \brief Create the `{si32, si64}` structure type
+ar::StructType* create_struct_type(ar::Context& ctx) {
+  return ar::StructType::create(ctx,
+                                {{ZNumber(0), ar::IntegerType::si32(ctx)},
+                                 {ZNumber(8), ar::IntegerType::si64(ctx)}},
+                                false);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  // About 10^6 constants with the default scale
+  const int n = benchmark::scale(argc, argv, 100000);
+
+  benchmark::measure("array [4n x si32]", [=] {
+    ar::Context ctx;
+    benchmark::do_not_optimize(create_array(ctx, 4 * n));
+  });
+  benchmark::measure("n structs {si32, si64}", [=] {
+    ar::Context ctx;
+    benchmark::do_not_optimize(
+        create_structs(ctx, create_struct_type(ctx), n));
+  });
+  benchmark::measure("n strings [16 x si8]", [=] {
+    ar::Context ctx;
+    benchmark::do_not_optimize(create_strings(ctx, n));
+  });
+
+  // Look up the constants of a module that are already interned
+  ar::Context ctx;
+  ar::StructType* type = create_struct_type(ctx);
+  create_array(ctx, 4 * n);
+  create_structs(ctx, type, n);
+  create_strings(ctx, n);
+  benchmark::measure("lookup of interned constants", [&] {
+    benchmark::do_not_optimize(create_array(ctx, 4 * n));
+    benchmark::do_not_optimize(create_structs(ctx, type, n));
+    benchmark::do_not_optimize(create_strings(ctx, n));
+  });
+
+  return 0;
+}
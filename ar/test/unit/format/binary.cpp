@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * Tests for the binary format
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#define BOOST_TEST_MODULE test_binary
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/ar/format/binary.hpp>
+#include <ikos/ar/format/text.hpp>
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/context.hpp>
+#include <ikos/ar/semantic/data_layout.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+namespace ar = ikos::ar;
+
+namespace {
+
+/// \brief Bundle with a global variable `g`, a declaration `si32 h()` and a
+/// function `si32 f()` using them
+struct Fixture {
+  ar::Context ctx;
+  ar::Bundle* bundle;
+  std::string data;
+
+  Fixture()
+      : bundle(ar::Bundle::create(
+            ctx,
+            ar::DataLayout::create(ar::LittleEndian,
+                                   ar::DataLayoutInfo(64, 8, 8)),
+            "x86_64-pc-linux-gnu")) {
+    ar::IntegerType* si32 = ar::IntegerType::si32(ctx);
+    ar::GlobalVariable* g =
+        ar::GlobalVariable::create(bundle,
+                                   ar::PointerType::get(ctx, si32),
+                                   "g",
+                                   /*is_definition=*/false,
+                                   /*alignment=*/4);
+    ar::FunctionType* type = ar::FunctionType::get(ctx, si32, {}, false);
+    ar::Function* h = ar::Function::create(bundle, type, "h", false);
+    ar::Function* f = ar::Function::create(bundle, type, "f", true);
+
+    ar::Code* code = f->body();
+    ar::BasicBlock* entry = ar::BasicBlock::create(code);
+    ar::BasicBlock* exit = ar::BasicBlock::create(code);
+    code->set_entry_block(entry);
+    code->set_exit_block(exit);
+    entry->add_successor(exit);
+
+    ar::InternalVariable* x = ar::InternalVariable::create(code, si32);
+    ar::InternalVariable* y = ar::InternalVariable::create(code, si32);
+    ar::InternalVariable* z = ar::InternalVariable::create(code, si32);
+    entry->push_back(ar::Call::create(x, h, {}));
+    entry->push_back(
+        ar::BinaryOperation::create(ar::BinaryOperation::SAdd,
+                                    y,
+                                    x,
+                                    ar::IntegerConstant::get(ctx, si32, 2)));
+    entry->push_back(ar::Store::create(g, y, 4, false));
+    exit->push_back(ar::Load::create(z, g, 4, false));
+    exit->push_back(ar::ReturnValue::create(z));
+
+    std::ostringstream buf;
+    ar::BinaryWriter().write(buf, bundle);
+    data = buf.str();
+  }
+};
+
+/// \brief Text of the bundle, independent of the order of the symbol tables
+std::string to_text(ar::Bundle* bundle) {
+  std::ostringstream buf;
+  ar::TextFormatter(ar::Formatter::DefaultFormat | ar::Formatter::OrderGlobals)
+      .format(buf, bundle);
+  return buf.str();
+}
+
+/// \brief Return true if reading the given data throws a FormatError
+bool throws_format_error(const std::string& data) {
+  ar::Context ctx;
+  ar::BinaryReader reader;
+  try {
+    reader.read(ctx, data.data(), data.size());
+  } catch (const ar::FormatError&) {
+    return true;
+  }
+  return false;
+}
+
+} // end anonymous namespace
+
+BOOST_FIXTURE_TEST_CASE(test_round_trip, Fixture) {
+  BOOST_CHECK(ar::BinaryReader::has_header(data.data(), data.size()));
+
+  ar::Context ctx;
+  ar::BinaryReader reader;
+  ar::Bundle* copy = reader.read(ctx, data.data(), data.size());
+  BOOST_CHECK(to_text(copy) == to_text(bundle));
+
+  // The loaded bundle can be written and loaded again
+  std::ostringstream buf;
+  ar::BinaryWriter().write(buf, copy);
+  std::string data2 = buf.str();
+  BOOST_CHECK(data2.size() == data.size());
+
+  ar::Context ctx2;
+  ar::BinaryReader reader2;
+  ar::Bundle* copy2 = reader2.read(ctx2, data2.data(), data2.size());
+  BOOST_CHECK(to_text(copy2) == to_text(bundle));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_truncated, Fixture) {
+  BOOST_CHECK(throws_format_error(""));
+  for (std::size_t size = 0; size < data.size(); size++) {
+    BOOST_CHECK_MESSAGE(throws_format_error(data.substr(0, size)),
+                        "prefix of " << size << " bytes");
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_corrupt_header, Fixture) {
+  // Magic number
+  std::string bad_magic = data;
+  bad_magic[0] = 'X';
+  BOOST_CHECK(!ar::BinaryReader::has_header(bad_magic.data(),
+                                            bad_magic.size()));
+  BOOST_CHECK(throws_format_error(bad_magic));
+
+  // Version, right after the 8 bytes of the magic number
+  std::string bad_version = data;
+  uint32_t version = ar::BinaryFormatVersion + 1;
+  std::memcpy(&bad_version[8], &version, sizeof(version));
+  BOOST_CHECK(throws_format_error(bad_version));
+
+  // Byte order mark
+  std::string bad_bom = data;
+  std::swap(bad_bom[12], bad_bom[15]);
+  std::swap(bad_bom[13], bad_bom[14]);
+  BOOST_CHECK(throws_format_error(bad_bom));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_corrupt_tables, Fixture) {
+  // Number of strings, right after the header, larger than the file
+  std::string bad_count = data;
+  uint32_t count = 0xFFFFFFFF;
+  std::memcpy(&bad_count[16], &count, sizeof(count));
+  BOOST_CHECK(throws_format_error(bad_count));
+
+  // Trailing data
+  BOOST_CHECK(throws_format_error(data + std::string(1, '\0')));
+  BOOST_CHECK(throws_format_error(data + data));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_corrupt_bytes, Fixture) {
+  // Overwriting any byte either throws a FormatError or gives a well-formed
+  // bundle, e.g. when it changes the value of a constant
+  for (std::size_t pos = 0; pos < data.size(); pos++) {
+    for (char c : {'\x00', '\x7F', '\xFF'}) {
+      std::string corrupt = data;
+      corrupt[pos] = c;
+      ar::Context ctx;
+      ar::BinaryReader reader;
+      try {
+        ar::Bundle* bundle = reader.read(ctx, corrupt.data(), corrupt.size());
+        BOOST_CHECK(!to_text(bundle).empty());
+      } catch (const ar::FormatError&) {
+      }
+    }
+  }
+}
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ *
+ * Tests for BasicBlock and Code
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_code
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/context.hpp>
+#include <ikos/ar/semantic/data_layout.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+namespace ar = ikos::ar;
+
+namespace {
+
+/// \brief Function `si32 f()` with an empty body
+struct Fixture {
+  ar::Context ctx;
+  ar::Bundle* bundle;
+  ar::IntegerType* si32;
+  ar::Function* fun;
+  ar::Code* code;
+
+  Fixture()
+      : bundle(ar::Bundle::create(
+            ctx,
+            ar::DataLayout::create(ar::LittleEndian,
+                                   ar::DataLayoutInfo(64, 8, 8)),
+            "x86_64-pc-linux-gnu")),
+        si32(ar::IntegerType::si32(ctx)),
+        fun(ar::Function::create(
+            bundle, ar::FunctionType::get(ctx, si32, {}, false), "f", true)),
+        code(fun->body()) {}
+
+  ar::IntegerConstant* cst(int n) {
+    return ar::IntegerConstant::get(this->ctx, this->si32, n);
+  }
+
+  ar::InternalVariable* var() {
+    return ar::InternalVariable::create(this->code, this->si32);
+  }
+};
+
+std::string to_string(const ar::Statement* stmt) {
+  std::ostringstream buf;
+  stmt->dump(buf);
+  return buf.str();
+}
+
+std::vector< std::string > to_strings(const ar::BasicBlock* bb) {
+  std::vector< std::string > strs;
+  for (const ar::Statement* stmt : *bb) {
+    strs.push_back(to_string(stmt));
+  }
+  return strs;
+}
+
+} // end anonymous namespace
+
+BOOST_FIXTURE_TEST_CASE(test_insert, Fixture) {
+  ar::BasicBlock* bb = ar::BasicBlock::create(code);
+  ar::InternalVariable* x = var();
+  ar::InternalVariable* y = var();
+
+  int tag = 0;
+  auto stmt = ar::Assignment::create(x, cst(1));
+  stmt->set_frontend(&tag);
+  bb->push_back(std::move(stmt));
+  bb->push_back(ar::ReturnValue::create(y));
+  bb->insert_before(std::next(bb->begin()),
+                    ar::BinaryOperation::create(ar::BinaryOperation::SAdd,
+                                                y,
+                                                x,
+                                                cst(2)));
+  bb->push_front(ar::Unreachable::create());
+  bb->remove(bb->begin());
+
+  BOOST_CHECK(bb->num_statements() == 3);
+  for (ar::Statement* s : *bb) {
+    BOOST_CHECK(s->parent() == bb);
+  }
+  BOOST_CHECK(bb->front()->frontend< int >() == &tag);
+  BOOST_CHECK(ar::isa< ar::BinaryOperation >(*std::next(bb->begin())));
+  BOOST_CHECK(ar::isa< ar::ReturnValue >(bb->back()));
+
+  // Clones are allocated on the heap and have no parent
+  std::unique_ptr< ar::Statement > copy = bb->front()->clone();
+  BOOST_CHECK(!copy->has_parent());
+  BOOST_CHECK(copy->frontend< int >() == &tag);
+  BOOST_CHECK(to_string(copy.get()) == to_string(bb->front()));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_replace, Fixture) {
+  ar::BasicBlock* bb = ar::BasicBlock::create(code);
+  ar::InternalVariable* x = var();
+
+  bb->push_back(ar::Assignment::create(x, cst(1)));
+  bb->push_back(ar::ReturnValue::create(x));
+  std::string previous = to_string(bb->front());
+
+  std::unique_ptr< ar::Statement > old =
+      bb->replace(bb->begin(), ar::Assignment::create(x, cst(2)));
+  BOOST_CHECK(!old->has_parent());
+  BOOST_CHECK(to_string(old.get()) == previous);
+  BOOST_CHECK(bb->front()->parent() == bb);
+  BOOST_CHECK(to_string(bb->front()) != previous);
+
+  // The removed statement can be inserted again
+  bb->push_back(std::move(old));
+  BOOST_CHECK(bb->num_statements() == 3);
+  BOOST_CHECK(to_string(bb->back()) == previous);
+
+  std::unique_ptr< ar::Statement > last = bb->pop_back();
+  BOOST_CHECK(!last->has_parent());
+  BOOST_CHECK(to_string(last.get()) == previous);
+  BOOST_CHECK(bb->num_statements() == 2);
+  BOOST_CHECK(ar::isa< ar::ReturnValue >(bb->back()));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_stable_pointers, Fixture) {
+  ar::BasicBlock* bb1 = ar::BasicBlock::create(code);
+  ar::BasicBlock* bb2 = ar::BasicBlock::create(code);
+  code->set_entry_block(bb1);
+  bb1->add_successor(bb2);
+  ar::InternalVariable* x = var();
+
+  // Pointers kept on statements remain valid after insertion
+  auto stmt = ar::Assignment::create(x, cst(1));
+  ar::Statement* ptr = stmt.get();
+  bb1->push_back(std::move(stmt));
+  for (int i = 0; i < 100; i++) {
+    bb1->push_front(ar::Assignment::create(x, cst(i)));
+    bb2->push_back(ar::Assignment::create(x, cst(-i)));
+  }
+  BOOST_CHECK(bb1->back() == ptr);
+  BOOST_CHECK(ptr->parent() == bb1);
+
+  // Statements removed with replace() and pop_back() are returned as is
+  auto last = std::next(bb1->begin(), 100);
+  std::unique_ptr< ar::Statement > old =
+      bb1->replace(last, ar::ReturnValue::create(x));
+  BOOST_CHECK(old.get() == ptr);
+  bb2->push_back(std::move(old));
+  BOOST_CHECK(bb2->back() == ptr);
+  BOOST_CHECK(ptr->parent() == bb2);
+  BOOST_CHECK(bb2->pop_back().get() == ptr);
+
+  // Erasing a basic block keeps the others
+  std::vector< std::string > stmts1 = to_strings(bb1);
+  bb1->remove_successor(bb2);
+  code->erase_basic_block(bb2);
+  BOOST_CHECK(std::distance(code->begin(), code->end()) == 1);
+  BOOST_CHECK(to_strings(bb1) == stmts1);
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * Tests for Arena
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#define BOOST_TEST_MODULE test_arena
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/ar/support/arena.hpp>
+
+namespace {
+
+/// \brief Increment a counter when destroyed
+struct Counted {
+  int* counter;
+
+  explicit Counted(int* counter_) : counter(counter_) {}
+
+  ~Counted() { ++(*counter); }
+};
+
+bool is_aligned(void* p, std::size_t alignment) {
+  return reinterpret_cast< std::uintptr_t >(p) % alignment == 0;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_allocate) {
+  ikos::ar::Arena arena;
+
+  // Alignment
+  for (std::size_t alignment = 1; alignment <= 64; alignment *= 2) {
+    arena.allocate(1, 1);
+    BOOST_CHECK(is_aligned(arena.allocate(3, alignment), alignment));
+  }
+
+  // Allocations in the same chunk are contiguous
+  auto p = static_cast< char* >(arena.allocate(8, 8));
+  auto q = static_cast< char* >(arena.allocate(8, 8));
+  BOOST_CHECK(q == p + 8);
+
+  // Allocations larger than the maximum chunk size
+  std::vector< char* > blocks;
+  for (int i = 0; i < 4; i++) {
+    auto b = static_cast< char* >(arena.allocate(1024 * 1024, 16));
+    BOOST_CHECK(is_aligned(b, 16));
+    b[0] = 'a';
+    b[1024 * 1024 - 1] = 'b';
+    blocks.push_back(b);
+  }
+  for (char* b : blocks) {
+    BOOST_CHECK(b[0] == 'a');
+    BOOST_CHECK(b[1024 * 1024 - 1] == 'b');
+  }
+
+  // Many small allocations do not overlap
+  std::vector< std::uint64_t* > ints;
+  for (std::uint64_t i = 0; i < 100000; i++) {
+    auto n = static_cast< std::uint64_t* >(
+        arena.allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+    *n = i;
+    ints.push_back(n);
+  }
+  for (std::uint64_t i = 0; i < 100000; i++) {
+    BOOST_CHECK(*ints[i] == i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_create) {
+  int counter = 0;
+  {
+    ikos::ar::Arena arena;
+    for (int i = 0; i < 1000; i++) {
+      Counted* c = arena.create< Counted >(&counter);
+      BOOST_CHECK(c->counter == &counter);
+    }
+    BOOST_CHECK(counter == 0);
+  }
+  BOOST_CHECK(counter == 1000);
+
+  // Objects allocated with allocate() are not destroyed by the arena
+  counter = 0;
+  {
+    ikos::ar::Arena arena;
+    void* p = arena.allocate(sizeof(Counted), alignof(Counted));
+    auto c = new (p) Counted(&counter);
+    c->~Counted();
+  }
+  BOOST_CHECK(counter == 1);
+}
@@ -99,12 +99,19 @@ if (NOT FRONTEND_LLVM_FOUND)
     DOC "Path to ikos-pp binary"
   )
 
+  find_program(FRONTEND_LLVM_IKOS_IMPORT_EXECUTABLE
+    NAMES ikos-import
+    HINTS ${FRONTEND_LLVM_BIN_SEARCH_DIRS}
+    DOC "Path to ikos-import binary"
+  )
+
   include(FindPackageHandleStandardArgs)
   find_package_handle_standard_args(FrontendLLVM
     REQUIRED_VARS
       FRONTEND_LLVM_INCLUDE_DIR
       FRONTEND_LLVM_TO_AR_LIB
       FRONTEND_LLVM_IKOS_PP_EXECUTABLE
+      FRONTEND_LLVM_IKOS_IMPORT_EXECUTABLE
     FAIL_MESSAGE
       "Could NOT find ikos llvm frontend. Please provide -DFRONTEND_LLVM_ROOT=/path/to/frontend")
 endif()
@@ -0,0 +1,351 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Hash-consing of patricia tree nodes
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <ikos/core/adt/patricia_tree/node.hpp>
+#include <ikos/core/support/mpl.hpp>
+
+namespace ikos {
+namespace core {
+namespace patricia_tree_utils {
+
+/// \brief Return the flag for hash-consing of tree nodes
+inline std::atomic< bool >& hash_consing_flag() {
+  static std::atomic< bool > flag(false);
+  return flag;
+}
+
+/// \brief Return true if tree nodes are hash-consed
+inline bool hash_consing() {
+  return hash_consing_flag().load(std::memory_order_relaxed);
+}
+
+/// \brief Enable or disable hash-consing of tree nodes
+///
+/// When enabled, a new node is first looked up in a table of canonical nodes
+/// of the current thread, so that structurally equal subtrees are shared. The
+/// binary operations then detect equal subtrees with a pointer comparison,
+/// and memoize their results on pairs of large subtrees.
+///
+/// This must not be called while patricia trees are used by other threads.
+inline void set_hash_consing(bool enable) {
+  hash_consing_flag().store(enable);
+}
+
+/// Helpers for hash_value
+namespace detail {
+
+template < typename T >
+using hash_value_t = decltype(hash_value(std::declval< const T& >()));
+
+} // end namespace detail
+
+/// \brief Return the hash of an integral or enumeration value
+template < typename T >
+inline std::enable_if_t< std::is_integral< T >::value ||
+                             std::is_enum< T >::value,
+                         std::size_t >
+value_hash(const T& x) {
+  return std::hash< T >()(x);
+}
+
+/// \brief Return the hash of a value implementing `hash_value(const T&)`
+template < typename T >
+inline std::enable_if_t< !std::is_integral< T >::value &&
+                             !std::is_enum< T >::value &&
+                             is_detected< detail::hash_value_t, T >::value,
+                         std::size_t >
+value_hash(const T& x) {
+  return hash_value(x);
+}
+
+/// \brief Return 0 for values that cannot be hashed
+///
+/// Leaves with the same key then share the same hash, and are told apart with
+/// `operator==` on values.
+template < typename T >
+inline std::enable_if_t< !std::is_integral< T >::value &&
+                             !std::is_enum< T >::value &&
+                             !is_detected< detail::hash_value_t, T >::value,
+                         std::size_t >
+value_hash(const T&) {
+  return 0;
+}
+
+/// \brief Table of canonical nodes of the current thread
+///
+/// The table uses open addressing with linear probing, and holds a reference
+/// on each canonical node. When the table is half full, it is rebuilt with the
+/// nodes that are still referenced outside of the table.
+template < typename Tree >
+class HashConsTable {
+private:
+  /// \brief Minimum capacity of the table, must be a power of 2
+  static constexpr std::size_t MinCapacity = 4096;
+
+private:
+  std::vector< NodePtr< const Tree > > _slots;
+  std::size_t _size = 0;
+
+public:
+  /// \brief Return the table of the current thread
+  static HashConsTable& local() {
+    static thread_local HashConsTable table;
+    return table;
+  }
+
+  /// \brief Return the canonical node with the given hash that satisfies
+  /// `equals`, or nullptr
+  ///
+  /// The predicate should be a callable of type:
+  ///   bool(const Tree& tree)
+  template < typename Predicate >
+  NodePtr< const Tree > find(std::size_t hash, const Predicate& equals) const {
+    if (this->_slots.empty()) {
+      return nullptr;
+    }
+    std::size_t mask = this->_slots.size() - 1;
+    for (std::size_t i = slot(hash, mask);; i = (i + 1) & mask) {
+      const NodePtr< const Tree >& node = this->_slots[i];
+      if (node == nullptr) {
+        return nullptr;
+      }
+      if (node->hash() == hash && equals(*node)) {
+        return node;
+      }
+    }
+  }
+
+  /// \brief Insert a canonical node
+  void insert(NodePtr< const Tree > node) {
+    if (2 * (this->_size + 1) > this->_slots.size()) {
+      this->rebuild();
+    }
+    this->insert_slot(std::move(node));
+  }
+
+  /// \brief Return the number of canonical nodes
+  std::size_t size() const { return this->_size; }
+
+private:
+  /// \brief Return the first slot for the given hash
+  static std::size_t slot(std::size_t hash, std::size_t mask) {
+    // Fibonacci hashing, to spread the bits of combined hashes
+    return (hash * static_cast< std::size_t >(0x9e3779b97f4a7c15ULL)) & mask;
+  }
+
+  /// \brief Insert a node, assuming there is a free slot
+  void insert_slot(NodePtr< const Tree > node) {
+    std::size_t mask = this->_slots.size() - 1;
+    std::size_t i = slot(node->hash(), mask);
+    while (this->_slots[i] != nullptr) {
+      i = (i + 1) & mask;
+    }
+    this->_slots[i] = std::move(node);
+    this->_size++;
+  }
+
+  /// \brief Release the nodes only referenced by the table, and resize it so
+  /// that it is at most a quarter full
+  ///
+  /// Children of released nodes are released by the next rebuild.
+  void rebuild() {
+    std::vector< NodePtr< const Tree > > slots;
+    slots.swap(this->_slots);
+    std::size_t live = 0;
+    for (NodePtr< const Tree >& node : slots) {
+      if (node != nullptr && node->use_count() == 1) {
+        node.reset();
+      } else if (node != nullptr) {
+        live++;
+      }
+    }
+    std::size_t capacity = MinCapacity;
+    while (capacity < 4 * live) {
+      capacity *= 2;
+    }
+    this->_slots.resize(capacity);
+    this->_size = 0;
+    for (NodePtr< const Tree >& node : slots) {
+      if (node != nullptr) {
+        this->insert_slot(std::move(node));
+      }
+    }
+  }
+
+}; // end class HashConsTable
+
+/// \brief Minimum total size of two trees to memoize a binary operation
+constexpr std::size_t MinMemoizedSize = 16;
+
+/// \brief Return true if the result of a binary operation on `s` and `t`
+/// should be memoized
+template < typename Tree >
+inline bool should_memoize(const NodePtr< const Tree >& s,
+                           const NodePtr< const Tree >& t) {
+  return hash_consing() && s->size() + t->size() >= MinMemoizedSize;
+}
+
+/// \brief Return true if the result of a binary operation on `s` and `t`
+/// with the given function should be memoized
+///
+/// Only operations with a stateless function are memoized, since their result
+/// then only depends on the operands.
+template < typename Tree, typename Function >
+inline bool should_memoize(const NodePtr< const Tree >& s,
+                           const NodePtr< const Tree >& t,
+                           const Function&) {
+  return std::is_empty< Function >::value && should_memoize(s, t);
+}
+
+/// \brief Tag for memoized lower or equal comparisons
+template < typename Compare >
+struct LeqOperation {};
+
+/// \brief Tag for memoized joins
+template < typename CombiningFunction >
+struct JoinOperation {};
+
+/// \brief Tag for memoized intersections
+template < typename CombiningFunction >
+struct IntersectOperation {};
+
+/// \brief Bounded cache of the results of a binary operation on trees
+///
+/// The cache is direct-mapped: a pair of trees has a single slot, and
+/// replaces the previous entry. Entries hold references on the operands, so
+/// that a node address cannot be reused while it is cached.
+///
+/// `Operation` is a tag type that identifies the binary operation.
+template < typename Tree, typename Result, typename Operation >
+class BinaryOperationCache {
+private:
+  /// \brief Number of entries
+  static constexpr std::size_t Size = 1024;
+
+  struct Entry {
+    NodePtr< const Tree > left;
+    NodePtr< const Tree > right;
+    Result result;
+  };
+
+private:
+  std::vector< Entry > _entries;
+
+public:
+  /// \brief Return the cache of the current thread
+  static BinaryOperationCache& local() {
+    static thread_local BinaryOperationCache cache;
+    return cache;
+  }
+
+  /// \brief Return the cached result for (`left`, `right`), or nullptr
+  const Result* find(const NodePtr< const Tree >& left,
+                     const NodePtr< const Tree >& right) const {
+    if (this->_entries.empty()) {
+      return nullptr;
+    }
+    const Entry& entry = this->_entries[slot(left, right)];
+    if (entry.left == left && entry.right == right) {
+      return &entry.result;
+    }
+    return nullptr;
+  }
+
+  /// \brief Cache the result for (`left`, `right`)
+  void insert(const NodePtr< const Tree >& left,
+              const NodePtr< const Tree >& right,
+              Result result) {
+    if (this->_entries.empty()) {
+      this->_entries.resize(Size);
+    }
+    Entry& entry = this->_entries[slot(left, right)];
+    entry.left = left;
+    entry.right = right;
+    entry.result = std::move(result);
+  }
+
+private:
+  /// \brief Return the slot of (`left`, `right`)
+  static std::size_t slot(const NodePtr< const Tree >& left,
+                          const NodePtr< const Tree >& right) {
+    std::size_t hash = left->hash();
+    boost::hash_combine(hash, right->hash());
+    return hash % Size;
+  }
+
+}; // end class BinaryOperationCache
+
+/// \brief Return the result of `compute()` for the binary operation on `s`
+/// and `t`, using the cache of the current thread
+template < typename Operation,
+           typename Tree,
+           typename Compute,
+           typename Result = decltype(std::declval< const Compute& >()()) >
+inline Result memoize(const NodePtr< const Tree >& s,
+                      const NodePtr< const Tree >& t,
+                      const Compute& compute) {
+  auto& cache = BinaryOperationCache< Tree, Result, Operation >::local();
+  if (const Result* result = cache.find(s, t)) {
+    return *result;
+  }
+  Result result = compute();
+  cache.insert(s, t, result);
+  return result;
+}
+
+} // end namespace patricia_tree_utils
+} // end namespace core
+} // end namespace ikos
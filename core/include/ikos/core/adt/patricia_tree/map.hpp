@@ -51,11 +51,12 @@
 
 #include <iostream>
 #include <iterator>
-#include <memory>
 #include <stack>
 
 #include <boost/optional.hpp>
 
+#include <ikos/core/adt/patricia_tree/hash_consing.hpp>
+#include <ikos/core/adt/patricia_tree/node.hpp>
 #include <ikos/core/adt/patricia_tree/utils.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
@@ -78,73 +79,73 @@ class PatriciaTreeIterator;
 
 template < typename Key, typename Value >
 inline bool empty(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree);
+    const NodePtr< const PatriciaTree< Key, Value > >& tree);
 
 template < typename Key, typename Value >
 inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree);
+    const NodePtr< const PatriciaTree< Key, Value > >& tree);
 
 template < typename Key, typename Value >
 inline boost::optional< const Value& > find_value(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key);
 
 template < typename Key, typename Value, typename Compare >
-inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool leq(const NodePtr< const PatriciaTree< Key, Value > >& s,
+                const NodePtr< const PatriciaTree< Key, Value > >& t,
                 const Compare& cmp);
 
 template < typename Key, typename Value, typename Compare >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool equals(const NodePtr< const PatriciaTree< Key, Value > >& s,
+                   const NodePtr< const PatriciaTree< Key, Value > >& t,
                    const Compare& cmp);
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > insert_or_assign(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > update_or_insert(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > update_or_ignore(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value);
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > erase(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key);
 
 template < typename Key, typename Value, typename UnaryOp >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > transform(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const UnaryOp& op);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline NodePtr< const PatriciaTree< Key, Value > > join(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const CombiningFunction& combine);
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline NodePtr< const PatriciaTree< Key, Value > > intersect(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const CombiningFunction& combine);
 
 template < typename Key, typename Value, typename BinaryOp >
 inline typename BinaryOp::ResultType binary_operation(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const BinaryOp& op);
 
 } // end namespace patricia_tree_map_impl
@@ -169,11 +170,12 @@ public:
   using Iterator = patricia_tree_map_impl::PatriciaTreeIterator< Key, Value >;
 
 private:
-  std::shared_ptr< const PatriciaTree > _tree;
+  patricia_tree_utils::NodePtr< const PatriciaTree > _tree;
 
 private:
   /// \brief Private constructor
-  explicit PatriciaTreeMap(std::shared_ptr< const PatriciaTree > tree)
+  explicit PatriciaTreeMap(
+      patricia_tree_utils::NodePtr< const PatriciaTree > tree)
       : _tree(std::move(tree)) {}
 
 public:
@@ -403,9 +405,9 @@ public:
   // Allow binary_operation to call the private constructor
   template < typename K, typename V, typename BinaryOp >
   friend typename BinaryOp::ResultType patricia_tree_map_impl::binary_operation(
-      const std::shared_ptr<
+      const patricia_tree_utils::NodePtr<
           const patricia_tree_map_impl::PatriciaTree< K, V > >& s,
-      const std::shared_ptr<
+      const patricia_tree_utils::NodePtr<
           const patricia_tree_map_impl::PatriciaTree< K, V > >& t,
       const BinaryOp& op);
 
@@ -414,12 +416,13 @@ public:
 namespace patricia_tree_map_impl {
 
 template < typename Key, typename Value >
-class PatriciaTree {
+class PatriciaTree : public RefCountedNode {
 private:
   std::size_t _size;
+  std::size_t _hash;
 
 public:
-  explicit PatriciaTree(std::size_t size) : _size(size) {}
+  PatriciaTree(std::size_t size, std::size_t hash) : _size(size), _hash(hash) {}
 
   // PatriciaTree is immutable
   PatriciaTree(const PatriciaTree&) = delete;
@@ -427,10 +430,16 @@ public:
   PatriciaTree& operator=(const PatriciaTree&) = delete;
   PatriciaTree& operator=(PatriciaTree&&) = delete;
 
-  virtual ~PatriciaTree() = default;
+  ~PatriciaTree() override = default;
 
   std::size_t size() const { return this->_size; }
 
+  /// \brief Return the structural hash of the tree
+  ///
+  /// The hash is only computed when hash-consing is enabled, it is 0 for a
+  /// tree created while hash-consing was disabled.
+  std::size_t hash() const { return this->_hash; }
+
   bool is_leaf() const { return this->_size == 1; }
 
   bool is_node() const { return !this->is_leaf(); }
@@ -442,30 +451,45 @@ class PatriciaTreeNode final : public PatriciaTree< Key, Value > {
 private:
   Index _prefix;
   Index _branching_bit;
-  std::shared_ptr< const PatriciaTree< Key, Value > > _left_tree;
-  std::shared_ptr< const PatriciaTree< Key, Value > > _right_tree;
+  NodePtr< const PatriciaTree< Key, Value > > _left_tree;
+  NodePtr< const PatriciaTree< Key, Value > > _right_tree;
 
 public:
-  PatriciaTreeNode(
-      Index prefix,
-      Index branching_bit,
-      std::shared_ptr< const PatriciaTree< Key, Value > > left_tree,
-      std::shared_ptr< const PatriciaTree< Key, Value > > right_tree)
-      : PatriciaTree< Key, Value >(left_tree->size() + right_tree->size()),
+  PatriciaTreeNode(Index prefix,
+                   Index branching_bit,
+                   NodePtr< const PatriciaTree< Key, Value > > left_tree,
+                   NodePtr< const PatriciaTree< Key, Value > > right_tree,
+                   std::size_t hash)
+      : PatriciaTree< Key, Value >(left_tree->size() + right_tree->size(),
+                                   hash),
         _prefix(prefix),
         _branching_bit(branching_bit),
         _left_tree(std::move(left_tree)),
         _right_tree(std::move(right_tree)) {}
 
+  /// \brief Return the structural hash of a node
+  static std::size_t compute_hash(
+      Index prefix,
+      Index branching_bit,
+      const PatriciaTree< Key, Value >& left_tree,
+      const PatriciaTree< Key, Value >& right_tree) {
+    std::size_t result = 0;
+    boost::hash_combine(result, prefix);
+    boost::hash_combine(result, branching_bit);
+    boost::hash_combine(result, left_tree.hash());
+    boost::hash_combine(result, right_tree.hash());
+    return result;
+  }
+
   Index prefix() const { return this->_prefix; }
 
   Index branching_bit() const { return this->_branching_bit; }
 
-  const std::shared_ptr< const PatriciaTree< Key, Value > >& left_tree() const {
+  const NodePtr< const PatriciaTree< Key, Value > >& left_tree() const {
     return this->_left_tree;
   }
 
-  const std::shared_ptr< const PatriciaTree< Key, Value > >& right_tree()
+  const NodePtr< const PatriciaTree< Key, Value > >& right_tree()
       const {
     return this->_right_tree;
   }
@@ -478,8 +502,16 @@ private:
   std::pair< Key, Value > _pair;
 
 public:
-  PatriciaTreeLeaf(const Key& key, const Value& value)
-      : PatriciaTree< Key, Value >(1), _pair(key, value) {}
+  PatriciaTreeLeaf(const Key& key, const Value& value, std::size_t hash)
+      : PatriciaTree< Key, Value >(1, hash), _pair(key, value) {}
+
+  /// \brief Return the structural hash of a leaf
+  static std::size_t compute_hash(const Key& key, const Value& value) {
+    std::size_t result = 0;
+    boost::hash_combine(result, IndexableTraits< Key >::index(key));
+    boost::hash_combine(result, value_hash(value));
+    return result;
+  }
 
   const Key& key() const { return this->_pair.first; }
 
@@ -491,13 +523,13 @@ public:
 
 template < typename Key, typename Value >
 inline bool empty(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+    const NodePtr< const PatriciaTree< Key, Value > >& tree) {
   return tree == nullptr;
 }
 
 template < typename Key, typename Value >
 inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+    const NodePtr< const PatriciaTree< Key, Value > >& tree) {
   if (tree != nullptr) {
     return tree->size();
   } else {
@@ -507,22 +539,20 @@ inline std::size_t size(
 
 /// \brief Return the leaf associated with the given key, or nullptr
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > find_leaf(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTreeLeaf< Key, Value > > find_leaf(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     if (leaf->key() != key) {
       return nullptr;
     }
     return leaf;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   if (is_zero_bit(IndexableTraits< Key >::index(key), node->branching_bit())) {
     return find_leaf(node->left_tree(), key);
   } else {
@@ -532,7 +562,7 @@ inline std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > find_leaf(
 
 template < typename Key, typename Value >
 inline boost::optional< const Value& > find_value(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key) {
   auto leaf = find_leaf(tree, key);
   if (leaf == nullptr) {
@@ -542,33 +572,22 @@ inline boost::optional< const Value& > find_value(
   }
 }
 
+/// \brief Lower or equal comparison of non-null trees
 template < typename Key, typename Value, typename Compare >
-inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
-                const Compare& cmp) {
-  if (s == t) {
-    return true;
-  }
-  if (s == nullptr) {
-    return false;
-  }
-  if (t == nullptr) {
-    return true;
-  }
+inline bool leq_non_null(const NodePtr< const PatriciaTree< Key, Value > >& s,
+                         const NodePtr< const PatriciaTree< Key, Value > >& t,
+                         const Compare& cmp) {
   if (s->is_leaf()) {
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     return s_leaf->key() == t_leaf->key() &&
            cmp(s_leaf->value(), t_leaf->value());
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     auto s_value = find_value(s, t_leaf->key());
     if (s_value) {
       return cmp(*s_value, t_leaf->value());
@@ -576,10 +595,8 @@ inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
       return false;
     }
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
   if (s_node->size() < t_node->size()) {
     return false;
   }
@@ -602,8 +619,29 @@ inline bool leq(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
 }
 
 template < typename Key, typename Value, typename Compare >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline bool leq(const NodePtr< const PatriciaTree< Key, Value > >& s,
+                const NodePtr< const PatriciaTree< Key, Value > >& t,
+                const Compare& cmp) {
+  if (s == t) {
+    return true;
+  }
+  if (s == nullptr) {
+    return false;
+  }
+  if (t == nullptr) {
+    return true;
+  }
+  if (should_memoize(s, t, cmp)) {
+    return memoize< LeqOperation< Compare > >(s, t, [&] {
+      return leq_non_null(s, t, cmp);
+    });
+  }
+  return leq_non_null(s, t, cmp);
+}
+
+template < typename Key, typename Value, typename Compare >
+inline bool equals(const NodePtr< const PatriciaTree< Key, Value > >& s,
+                   const NodePtr< const PatriciaTree< Key, Value > >& t,
                    const Compare& cmp) {
   if (s == t) {
     return true;
@@ -615,20 +653,16 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     return s_leaf->key() == t_leaf->key() &&
            cmp(s_leaf->value(), t_leaf->value());
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
   return s_node->size() == t_node->size() &&
          s_node->prefix() == t_node->prefix() &&
          s_node->branching_bit() == t_node->branching_bit() &&
@@ -636,75 +670,146 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
          equals(s_node->right_tree(), t_node->right_tree(), cmp);
 }
 
+/// \brief Create a leaf
+///
+/// If hash-consing is enabled, return the canonical leaf.
+template < typename Key, typename Value >
+inline NodePtr< const PatriciaTreeLeaf< Key, Value > > create_leaf(
+    const Key& key, const Value& value) {
+  if (!hash_consing()) {
+    return make_node_ptr< const PatriciaTreeLeaf< Key, Value > >(key,
+                                                                 value,
+                                                                 0);
+  }
+  auto& table = HashConsTable< PatriciaTree< Key, Value > >::local();
+  std::size_t hash = PatriciaTreeLeaf< Key, Value >::compute_hash(key, value);
+  auto canonical =
+      table.find(hash, [&](const PatriciaTree< Key, Value >& tree) {
+        if (tree.is_node()) {
+          return false;
+        }
+        const auto& leaf =
+            static_cast< const PatriciaTreeLeaf< Key, Value >& >(tree);
+        return leaf.key() == key && leaf.value() == value;
+      });
+  if (canonical != nullptr) {
+    return static_node_cast< const PatriciaTreeLeaf< Key, Value > >(
+        canonical);
+  }
+  auto leaf =
+      make_node_ptr< const PatriciaTreeLeaf< Key, Value > >(key, value, hash);
+  table.insert(leaf);
+  return leaf;
+}
+
+/// \brief Create a node with two non-null children
+///
+/// If hash-consing is enabled, return the canonical node.
+template < typename Key, typename Value >
+inline NodePtr< const PatriciaTreeNode< Key, Value > > create_node(
+    Index prefix,
+    Index branching_bit,
+    const NodePtr< const PatriciaTree< Key, Value > >& left_tree,
+    const NodePtr< const PatriciaTree< Key, Value > >& right_tree) {
+  if (!hash_consing()) {
+    return make_node_ptr<
+        const PatriciaTreeNode< Key, Value > >(prefix,
+                                               branching_bit,
+                                               left_tree,
+                                               right_tree,
+                                               0);
+  }
+  auto& table = HashConsTable< PatriciaTree< Key, Value > >::local();
+  std::size_t hash =
+      PatriciaTreeNode< Key, Value >::compute_hash(prefix,
+                                                   branching_bit,
+                                                   *left_tree,
+                                                   *right_tree);
+  auto canonical =
+      table.find(hash, [&](const PatriciaTree< Key, Value >& tree) {
+        if (tree.is_leaf()) {
+          return false;
+        }
+        const auto& node =
+            static_cast< const PatriciaTreeNode< Key, Value >& >(tree);
+        return node.prefix() == prefix &&
+               node.branching_bit() == branching_bit &&
+               node.left_tree() == left_tree && node.right_tree() == right_tree;
+      });
+  if (canonical != nullptr) {
+    return static_node_cast< const PatriciaTreeNode< Key, Value > >(
+        canonical);
+  }
+  auto node = make_node_ptr<
+      const PatriciaTreeNode< Key, Value > >(prefix,
+                                             branching_bit,
+                                             left_tree,
+                                             right_tree,
+                                             hash);
+  table.insert(node);
+  return node;
+}
+
 /// \brief Create a node
 ///
 /// Prevent the creation of a node with only one child.
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > make_node(
+inline NodePtr< const PatriciaTree< Key, Value > > make_node(
     Index prefix,
     Index branching_bit,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& left_tree,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& right_tree) {
+    const NodePtr< const PatriciaTree< Key, Value > >& left_tree,
+    const NodePtr< const PatriciaTree< Key, Value > >& right_tree) {
   if (left_tree == nullptr) {
     return right_tree;
   }
   if (right_tree == nullptr) {
     return left_tree;
   }
-  return std::make_shared< const PatriciaTreeNode< Key, Value > >(prefix,
-                                                                  branching_bit,
-                                                                  left_tree,
-                                                                  right_tree);
+  return create_node(prefix, branching_bit, left_tree, right_tree);
 }
 
 /// \brief Join non-null patricia trees
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTreeNode< Key, Value > > join_trees(
+inline NodePtr< const PatriciaTreeNode< Key, Value > > join_trees(
     Index prefix_s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
     Index prefix_t,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t) {
+    const NodePtr< const PatriciaTree< Key, Value > >& t) {
   ikos_assert(s != nullptr && t != nullptr);
 
   Index m = branching_bit(prefix_s, prefix_t);
 
   if (is_zero_bit(prefix_s, m)) {
-    return std::make_shared<
-        const PatriciaTreeNode< Key, Value > >(mask(prefix_s, m), m, s, t);
+    return create_node< Key, Value >(mask(prefix_s, m), m, s, t);
   } else {
-    return std::make_shared<
-        const PatriciaTreeNode< Key, Value > >(mask(prefix_s, m), m, t, s);
+    return create_node< Key, Value >(mask(prefix_s, m), m, t, s);
   }
 }
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > insert_or_assign(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key,
     const Value& value) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    return create_leaf< Key, Value >(key, value);
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     if (leaf->key() == key) {
       if (leaf->value() == value) {
         return tree;
       } else {
-        return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key,
-                                                                        value);
+        return create_leaf< Key, Value >(key, value);
       }
     }
-    auto new_leaf =
-        std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    auto new_leaf = create_leaf< Key, Value >(key, value);
     return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                     new_leaf,
                                     IndexableTraits< Key >::index(leaf->key()),
                                     leaf);
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -729,8 +834,7 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
                        new_right_tree);
     }
   }
-  auto new_leaf =
-      std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+  auto new_leaf = create_leaf< Key, Value >(key, value);
   return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                   new_leaf,
                                   node->prefix(),
@@ -738,38 +842,34 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > insert_or_assign(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > update_or_insert(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    return create_leaf< Key, Value >(key, value);
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     if (leaf->key() == key) {
       boost::optional< Value > new_value = combine(leaf->value(), value);
       if (new_value) {
         if (leaf->value() == *new_value) {
           return tree;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(key, *new_value);
+          return create_leaf< Key, Value >(key, *new_value);
         }
       }
       return nullptr;
     }
-    auto new_leaf =
-        std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+    auto new_leaf = create_leaf< Key, Value >(key, value);
     return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                     new_leaf,
                                     IndexableTraits< Key >::index(leaf->key()),
                                     leaf);
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -796,8 +896,7 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
                        new_right_tree);
     }
   }
-  auto new_leaf =
-      std::make_shared< const PatriciaTreeLeaf< Key, Value > >(key, value);
+  auto new_leaf = create_leaf< Key, Value >(key, value);
   return join_trees< Key, Value >(IndexableTraits< Key >::index(key),
                                   new_leaf,
                                   node->prefix(),
@@ -805,8 +904,8 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_insert(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > update_or_ignore(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const CombiningFunction& combine,
     const Key& key,
     const Value& value) {
@@ -814,24 +913,21 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     if (leaf->key() == key) {
       boost::optional< Value > new_value = combine(leaf->value(), value);
       if (new_value) {
         if (leaf->value() == *new_value) {
           return tree;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(key, *new_value);
+          return create_leaf< Key, Value >(key, *new_value);
         }
       }
       return nullptr;
     }
     return tree;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -863,10 +959,10 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > update_or_ignore(
 
 /// \brief Update or insert an existing leaf `t_leaf` in a tree `s`
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > >
+inline NodePtr< const PatriciaTree< Key, Value > >
 update_or_insert_leaf(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTreeLeaf< Key, Value > >& t_leaf,
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTreeLeaf< Key, Value > >& t_leaf,
     const CombiningFunction& combine) {
   if (s == t_leaf) {
     return s;
@@ -875,8 +971,7 @@ update_or_insert_leaf(
     return t_leaf;
   }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
     if (s_leaf->key() == t_leaf->key()) {
       boost::optional< Value > new_value =
           combine(s_leaf->value(), t_leaf->value());
@@ -886,8 +981,7 @@ update_or_insert_leaf(
         } else if (t_leaf->value() == *new_value) {
           return t_leaf;
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(s_leaf->key(), *new_value);
+          return create_leaf< Key, Value >(s_leaf->key(), *new_value);
         }
       }
       return nullptr;
@@ -899,8 +993,7 @@ update_or_insert_leaf(
                                         t_leaf->key()),
                                     t_leaf);
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
   if (match_prefix(IndexableTraits< Key >::index(t_leaf->key()),
                    s_node->prefix(),
                    s_node->branching_bit())) {
@@ -934,23 +1027,21 @@ update_or_insert_leaf(
 }
 
 template < typename Key, typename Value >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > erase(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     if (leaf->key() == key) {
       return nullptr;
     } else {
       return tree;
     }
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -979,28 +1070,25 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > erase(
 }
 
 template < typename Key, typename Value, typename UnaryOp >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& tree,
+inline NodePtr< const PatriciaTree< Key, Value > > transform(
+    const NodePtr< const PatriciaTree< Key, Value > >& tree,
     const UnaryOp& op) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(tree);
     boost::optional< Value > new_value = op(leaf->key(), leaf->value());
     if (new_value) {
       if (leaf->value() == *new_value) {
         return tree;
       } else {
-        return std::make_shared<
-            const PatriciaTreeLeaf< Key, Value > >(leaf->key(), *new_value);
+        return create_leaf< Key, Value >(leaf->key(), *new_value);
       }
     }
     return nullptr;
   }
-  auto node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(tree);
   auto new_left_tree = transform(node->left_tree(), op);
   auto new_right_tree = transform(node->right_tree(), op);
   if (node->left_tree() == new_left_tree &&
@@ -1014,23 +1102,14 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > transform(
   }
 }
 
+/// \brief Join non-null trees
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline NodePtr< const PatriciaTree< Key, Value > > join_non_null(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const CombiningFunction& combine) {
-  if (s == t) {
-    return s;
-  }
-  if (s == nullptr) {
-    return t;
-  }
-  if (t == nullptr) {
-    return s;
-  }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
     return update_or_insert_leaf(t,
                                  s_leaf,
                                  [=](const Value& t_value,
@@ -1040,14 +1119,11 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
                                  });
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     return update_or_insert_leaf(s, t_leaf, combine);
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1101,19 +1177,35 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > join(
 }
 
 template < typename Key, typename Value, typename CombiningFunction >
-inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+inline NodePtr< const PatriciaTree< Key, Value > > join(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const CombiningFunction& combine) {
   if (s == t) {
     return s;
   }
-  if (s == nullptr || t == nullptr) {
-    return nullptr;
+  if (s == nullptr) {
+    return t;
   }
+  if (t == nullptr) {
+    return s;
+  }
+  if (should_memoize(s, t, combine)) {
+    return memoize< JoinOperation< CombiningFunction > >(s, t, [&] {
+      return join_non_null(s, t, combine);
+    });
+  }
+  return join_non_null(s, t, combine);
+}
+
+/// \brief Intersect non-null trees
+template < typename Key, typename Value, typename CombiningFunction >
+inline NodePtr< const PatriciaTree< Key, Value > > intersect_non_null(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
+    const CombiningFunction& combine) {
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
     auto t_leaf = find_leaf(t, s_leaf->key());
     if (t_leaf) {
       boost::optional< Value > new_value =
@@ -1124,16 +1216,14 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
         } else if (t_leaf->value() == *new_value) {
           return std::move(t_leaf);
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(s_leaf->key(), *new_value);
+          return create_leaf< Key, Value >(s_leaf->key(), *new_value);
         }
       }
     }
     return nullptr;
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     auto s_leaf = find_leaf(s, t_leaf->key());
     if (s_leaf) {
       boost::optional< Value > new_value =
@@ -1144,17 +1234,14 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
         } else if (t_leaf->value() == *new_value) {
           return std::move(t_leaf);
         } else {
-          return std::make_shared<
-              const PatriciaTreeLeaf< Key, Value > >(t_leaf->key(), *new_value);
+          return create_leaf< Key, Value >(t_leaf->key(), *new_value);
         }
       }
     }
     return nullptr;
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1193,10 +1280,29 @@ inline std::shared_ptr< const PatriciaTree< Key, Value > > intersect(
   return nullptr;
 }
 
+template < typename Key, typename Value, typename CombiningFunction >
+inline NodePtr< const PatriciaTree< Key, Value > > intersect(
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
+    const CombiningFunction& combine) {
+  if (s == t) {
+    return s;
+  }
+  if (s == nullptr || t == nullptr) {
+    return nullptr;
+  }
+  if (should_memoize(s, t, combine)) {
+    return memoize< IntersectOperation< CombiningFunction > >(s, t, [&] {
+      return intersect_non_null(s, t, combine);
+    });
+  }
+  return intersect_non_null(s, t, combine);
+}
+
 template < typename Key, typename Value, typename BinaryOp >
 inline typename BinaryOp::ResultType binary_operation(
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& s,
-    const std::shared_ptr< const PatriciaTree< Key, Value > >& t,
+    const NodePtr< const PatriciaTree< Key, Value > >& s,
+    const NodePtr< const PatriciaTree< Key, Value > >& t,
     const BinaryOp& op) {
   if (op.has_equals() && s == t) {
     return op.equals(PatriciaTreeMap< Key, Value >(s));
@@ -1208,23 +1314,19 @@ inline typename BinaryOp::ResultType binary_operation(
     return op.left(PatriciaTreeMap< Key, Value >(s));
   }
   if (s->is_leaf()) {
-    auto s_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(s);
     return op.right_with_left_leaf(PatriciaTreeMap< Key, Value >(t),
                                    s_leaf->key(),
                                    s_leaf->value());
   }
   if (t->is_leaf()) {
-    auto t_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
     return op.left_with_right_leaf(PatriciaTreeMap< Key, Value >(s),
                                    t_leaf->key(),
                                    t_leaf->value());
   }
-  auto s_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(s);
-  auto t_node =
-      std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -1277,8 +1379,8 @@ public:
   using reference = const std::pair< Key, Value >&;
 
 private:
-  std::shared_ptr< const PatriciaTreeLeaf< Key, Value > > _leaf;
-  std::stack< std::shared_ptr< const PatriciaTreeNode< Key, Value > > > _stack;
+  NodePtr< const PatriciaTreeLeaf< Key, Value > > _leaf;
+  std::stack< NodePtr< const PatriciaTreeNode< Key, Value > > > _stack;
 
 public:
   /// \brief Create an end iterator
@@ -1286,7 +1388,7 @@ public:
 
   /// \brief Create an iterator on the given patricia tree
   explicit PatriciaTreeIterator(
-      const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+      const NodePtr< const PatriciaTree< Key, Value > >& tree) {
     if (tree != nullptr) {
       this->look_for_next_leaf(tree);
     }
@@ -1338,18 +1440,16 @@ public:
 private:
   /// \brief Find the leftmost leaf, store all intermediate nodes
   void look_for_next_leaf(
-      const std::shared_ptr< const PatriciaTree< Key, Value > >& tree) {
+      const NodePtr< const PatriciaTree< Key, Value > >& tree) {
     auto t = tree;
     ikos_assert(t != nullptr);
     while (t->is_node()) {
-      auto node =
-          std::static_pointer_cast< const PatriciaTreeNode< Key, Value > >(t);
+      auto node = static_node_cast< const PatriciaTreeNode< Key, Value > >(t);
       this->_stack.push(node);
       t = node->left_tree();
       ikos_assert(t != nullptr); // a node always has two children
     }
-    this->_leaf =
-        std::static_pointer_cast< const PatriciaTreeLeaf< Key, Value > >(t);
+    this->_leaf = static_node_cast< const PatriciaTreeLeaf< Key, Value > >(t);
   }
 
 }; // end class PatriciaTreeIterator
@@ -0,0 +1,660 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Reference counted patricia tree nodes allocated in per-thread pools
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// clang-format off
+#if defined(__has_include)
+# if __has_include(<sys/single_threaded.h>)
+#  include <sys/single_threaded.h>
+#  define IKOS_HAS_LIBC_SINGLE_THREADED 1
+# endif
+#endif
+// clang-format on
+
+namespace ikos {
+namespace core {
+namespace patricia_tree_utils {
+
+/// \brief Return the flag for thread-safe reference counting of tree nodes
+inline std::atomic< bool >& thread_safe_reference_count_flag() {
+  static std::atomic< bool > flag(true);
+  return flag;
+}
+
+/// \brief Return true if reference counts of tree nodes are atomic
+inline bool thread_safe_reference_count() {
+#ifdef IKOS_HAS_LIBC_SINGLE_THREADED
+  // No thread was ever created, same as std::shared_ptr in libstdc++
+  if (__libc_single_threaded) {
+    return false;
+  }
+#endif
+  return thread_safe_reference_count_flag().load(std::memory_order_relaxed);
+}
+
+/// \brief Enable or disable thread-safe reference counting of tree nodes
+///
+/// Reference counts of patricia tree nodes are atomic by default, as soon as
+/// the process has created a thread. A program that never shares patricia
+/// trees between threads can disable it, so that copying and destroying trees
+/// only uses plain increments and decrements.
+///
+/// This must not be called while patricia trees are used by other threads.
+///
+/// The switch is process-wide rather than per tree or per node: a node does
+/// not know whether another thread holds a reference on it, and tracking it
+/// would need a second, atomic count per node and a protocol to merge both
+/// counts when the owner drops its last reference (biased reference
+/// counting). The analyzer either shares invariants between all its threads
+/// or runs on a single thread, so the process-wide switch covers both cases.
+inline void set_thread_safe_reference_count(bool enable) {
+  thread_safe_reference_count_flag().store(enable);
+}
+
+/// \brief Pool allocator for tree nodes
+///
+/// Nodes are allocated in slabs of `SlabSize` bytes, aligned on `SlabSize`,
+/// so that the slab of a node is found from its address. Each slab holds
+/// blocks of a single size class, and belongs to one pool.
+///
+/// Each thread owns a pool. A node freed by the thread owning its slab goes
+/// back to the free list of the slab. A node freed by another thread is pushed
+/// on a lock-free list of the owning pool, which takes it back on its next
+/// allocation. A slab is released as soon as all its blocks are free, except
+/// the last slab with free blocks of each size class.
+///
+/// Nodes can outlive the thread that created them, and static patricia trees
+/// can be destroyed after thread-local objects. Hence, pools are never
+/// destroyed: when a thread exits, its pool is abandoned, and reused by the
+/// next thread that needs a pool.
+class NodePool {
+public:
+  /// \brief Size granularity and alignment of pooled nodes
+  static constexpr std::size_t Granularity = alignof(std::max_align_t);
+
+  /// \brief Number of size classes
+  static constexpr std::size_t NumSizeClasses = 16;
+
+  /// \brief Maximum size of a pooled node, larger nodes use operator new
+  static constexpr std::size_t MaxNodeSize = NumSizeClasses * Granularity;
+
+  /// \brief Size and alignment of a slab, in bytes
+  static constexpr std::size_t SlabSize = 64 * 1024;
+
+private:
+  /// \brief Free block, linked in a free list
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  /// \brief Slab header, at the beginning of each slab
+  struct Slab {
+    /// \brief Pool owning the slab
+    NodePool* owner;
+
+    /// \brief Size class of the blocks
+    std::size_t size_class;
+
+    /// \brief Number of blocks in use, including blocks freed by other
+    /// threads and not yet taken back
+    std::size_t num_used;
+
+    /// \brief Free blocks
+    FreeBlock* free_list;
+
+    /// \brief Blocks never used
+    char* unused_begin;
+    char* unused_end;
+
+    /// \brief Links in the list of slabs with free blocks of the owner
+    Slab* prev;
+    Slab* next;
+    bool available;
+  };
+
+  /// \brief Offset of the first block in a slab
+  static constexpr std::size_t SlabHeaderSize =
+      (sizeof(Slab) + Granularity - 1) / Granularity * Granularity;
+
+  /// \brief Global state of all pools
+  struct Registry {
+    std::mutex mutex;
+
+    /// \brief Pools of threads that exited
+    std::vector< NodePool* > abandoned;
+
+    /// \brief Number of slabs allocated by all pools
+    std::atomic< std::size_t > num_slabs{0};
+  };
+
+  /// \brief State of the pool of the current thread
+  enum class LocalState { None, Owned, Released };
+
+  /// \brief Abandon the pool of the current thread when it exits
+  struct LocalOwner {
+    ~LocalOwner() {
+      NodePool* pool = local_pool();
+      local_pool() = nullptr;
+      local_state() = LocalState::Released;
+      pool->abandon();
+    }
+  };
+
+private:
+  /// \brief Slabs with free blocks, for each size class
+  Slab* _available[NumSizeClasses] = {};
+
+  /// \brief Blocks freed by other threads
+  std::atomic< FreeBlock* > _remote_free{nullptr};
+
+public:
+  /// \brief Allocate a node of the given size
+  static void* allocate(std::size_t size) {
+    if (size > MaxNodeSize) {
+      return ::operator new(size);
+    }
+    NodePool* pool = local();
+    if (pool != nullptr) {
+      return pool->allocate_block(size_class(size));
+    }
+
+    // The current thread is exiting, borrow an abandoned pool
+    Registry& registry = get_registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+    pool = acquire_pool(registry);
+    void* ptr = pool->allocate_block(size_class(size));
+    registry.abandoned.push_back(pool);
+    return ptr;
+  }
+
+  /// \brief Deallocate a node of the given size
+  static void deallocate(void* ptr, std::size_t size) noexcept {
+    if (size > MaxNodeSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    auto block = static_cast< FreeBlock* >(ptr);
+    Slab* slab = slab_of(block);
+    if (slab->owner == local_pool()) {
+      slab->owner->deallocate_block(slab, block);
+    } else {
+      slab->owner->remote_deallocate_block(block);
+    }
+  }
+
+  /// \brief Release the empty slabs of the pools of exited threads
+  ///
+  /// Pools of exited threads only take back the nodes freed by other threads
+  /// once reused by a new thread. This releases them right away.
+  static void trim() {
+    Registry& registry = get_registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+    for (NodePool* pool : registry.abandoned) {
+      pool->collect_remote_blocks();
+      pool->release_empty_slabs();
+    }
+  }
+
+  /// \brief Return the number of slabs allocated by all threads
+  static std::size_t num_slabs() {
+    return get_registry().num_slabs.load(std::memory_order_relaxed);
+  }
+
+private:
+  NodePool() = default;
+
+  /// \brief Return the global state of all pools
+  static Registry& get_registry() {
+    // Never destroyed, see class description
+    static auto registry = new Registry();
+    return *registry;
+  }
+
+  /// \brief Return the pool of the current thread, or null
+  ///
+  /// Trivially destructible, hence usable until the thread exits.
+  static NodePool*& local_pool() {
+    static thread_local NodePool* pool = nullptr;
+    return pool;
+  }
+
+  /// \brief Return the state of the pool of the current thread
+  static LocalState& local_state() {
+    static thread_local LocalState state = LocalState::None;
+    return state;
+  }
+
+  /// \brief Return the pool of the current thread
+  ///
+  /// Return null if the pool was already abandoned by an exiting thread.
+  static NodePool* local() {
+    if (local_state() == LocalState::None) {
+      {
+        Registry& registry = get_registry();
+        std::lock_guard< std::mutex > lock(registry.mutex);
+        local_pool() = acquire_pool(registry);
+      }
+      local_state() = LocalState::Owned;
+      static thread_local LocalOwner owner;
+      (void)owner;
+    }
+    return local_pool();
+  }
+
+  /// \brief Take an abandoned pool, or create one
+  ///
+  /// The registry mutex must be held.
+  static NodePool* acquire_pool(Registry& registry) {
+    if (registry.abandoned.empty()) {
+      return new NodePool();
+    }
+    NodePool* pool = registry.abandoned.back();
+    registry.abandoned.pop_back();
+    return pool;
+  }
+
+  /// \brief Return the size class of the given size
+  static std::size_t size_class(std::size_t size) {
+    return size == 0 ? 0 : (size - 1) / Granularity;
+  }
+
+  /// \brief Return the slab containing the given block
+  static Slab* slab_of(void* ptr) {
+    return reinterpret_cast< Slab* >(reinterpret_cast< std::uintptr_t >(ptr) &
+                                      ~(SlabSize - 1));
+  }
+
+  /// \brief Abandon the pool, when the owning thread exits
+  void abandon() {
+    this->collect_remote_blocks();
+    Registry& registry = get_registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+    registry.abandoned.push_back(this);
+  }
+
+  /// \brief Allocate a block of the given size class
+  void* allocate_block(std::size_t cls) {
+    Slab* slab = this->_available[cls];
+    if (slab == nullptr) {
+      this->collect_remote_blocks();
+      slab = this->_available[cls];
+      if (slab == nullptr) {
+        slab = this->allocate_slab(cls);
+      }
+    }
+
+    void* ptr;
+    if (slab->free_list != nullptr) {
+      ptr = slab->free_list;
+      slab->free_list = slab->free_list->next;
+    } else {
+      ptr = slab->unused_begin;
+      slab->unused_begin += (cls + 1) * Granularity;
+    }
+    slab->num_used++;
+
+    if (slab->free_list == nullptr &&
+        static_cast< std::size_t >(slab->unused_end - slab->unused_begin) <
+            (cls + 1) * Granularity) {
+      this->remove_available(slab);
+    }
+    return ptr;
+  }
+
+  /// \brief Deallocate a block of a slab owned by this pool
+  void deallocate_block(Slab* slab, FreeBlock* block) noexcept {
+    block->next = slab->free_list;
+    slab->free_list = block;
+    slab->num_used--;
+
+    if (!slab->available) {
+      this->insert_available(slab);
+    } else if (slab->num_used == 0 &&
+               (slab->prev != nullptr || slab->next != nullptr)) {
+      this->release_slab(slab);
+    }
+  }
+
+  /// \brief Deallocate a block of a slab owned by this pool, from another
+  /// thread
+  void remote_deallocate_block(FreeBlock* block) noexcept {
+    FreeBlock* head = this->_remote_free.load(std::memory_order_relaxed);
+    do {
+      block->next = head;
+    } while (!this->_remote_free.compare_exchange_weak(
+        head, block, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  /// \brief Take back the blocks freed by other threads
+  void collect_remote_blocks() noexcept {
+    FreeBlock* block =
+        this->_remote_free.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+      FreeBlock* next = block->next;
+      this->deallocate_block(slab_of(block), block);
+      block = next;
+    }
+  }
+
+  /// \brief Release all empty slabs
+  void release_empty_slabs() noexcept {
+    for (Slab* slab : this->_available) {
+      while (slab != nullptr) {
+        Slab* next = slab->next;
+        if (slab->num_used == 0) {
+          this->release_slab(slab);
+        }
+        slab = next;
+      }
+    }
+  }
+
+  /// \brief Allocate a new slab for the given size class
+  Slab* allocate_slab(std::size_t cls) {
+    void* mem = nullptr;
+    if (::posix_memalign(&mem, SlabSize, SlabSize) != 0) {
+      throw std::bad_alloc();
+    }
+    get_registry().num_slabs.fetch_add(1, std::memory_order_relaxed);
+
+    auto slab = static_cast< Slab* >(mem);
+    slab->owner = this;
+    slab->size_class = cls;
+    slab->num_used = 0;
+    slab->free_list = nullptr;
+    slab->unused_begin = static_cast< char* >(mem) + SlabHeaderSize;
+    slab->unused_end = static_cast< char* >(mem) + SlabSize;
+    slab->prev = nullptr;
+    slab->next = nullptr;
+    slab->available = false;
+    this->insert_available(slab);
+    return slab;
+  }
+
+  /// \brief Release an empty slab
+  void release_slab(Slab* slab) noexcept {
+    this->remove_available(slab);
+    ::free(slab);
+    get_registry().num_slabs.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// \brief Insert a slab in the list of slabs with free blocks
+  void insert_available(Slab* slab) noexcept {
+    Slab*& head = this->_available[slab->size_class];
+    slab->prev = nullptr;
+    slab->next = head;
+    if (head != nullptr) {
+      head->prev = slab;
+    }
+    head = slab;
+    slab->available = true;
+  }
+
+  /// \brief Remove a slab from the list of slabs with free blocks
+  void remove_available(Slab* slab) noexcept {
+    if (slab->prev != nullptr) {
+      slab->prev->next = slab->next;
+    } else {
+      this->_available[slab->size_class] = slab->next;
+    }
+    if (slab->next != nullptr) {
+      slab->next->prev = slab->prev;
+    }
+    slab->prev = nullptr;
+    slab->next = nullptr;
+    slab->available = false;
+  }
+
+}; // end class NodePool
+
+/// \brief Base class for reference counted tree nodes
+///
+/// Nodes are allocated by the NodePool of the current thread. Reference counts
+/// are intrusive, and only atomic if `thread_safe_reference_count()`.
+class RefCountedNode {
+private:
+  mutable std::atomic< std::size_t > _ref_count;
+
+public:
+  RefCountedNode() noexcept : _ref_count(0) {}
+
+  // RefCountedNode is immutable
+  RefCountedNode(const RefCountedNode&) = delete;
+  RefCountedNode(RefCountedNode&&) = delete;
+  RefCountedNode& operator=(const RefCountedNode&) = delete;
+  RefCountedNode& operator=(RefCountedNode&&) = delete;
+
+  virtual ~RefCountedNode() = default;
+
+  /// \brief Allocate a node in the pool of the current thread
+  static void* operator new(std::size_t size) {
+    return NodePool::allocate(size);
+  }
+
+  /// \brief Deallocate a node
+  ///
+  /// Since the destructor is virtual, `size` is the size of the dynamic type.
+  static void operator delete(void* ptr, std::size_t size) noexcept {
+    NodePool::deallocate(ptr, size);
+  }
+
+  /// \brief Return the reference count
+  std::size_t use_count() const noexcept {
+    return this->_ref_count.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Increment the reference count
+  void acquire() const noexcept {
+    if (thread_safe_reference_count()) {
+      this->_ref_count.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      std::size_t count = this->_ref_count.load(std::memory_order_relaxed);
+      this->_ref_count.store(count + 1, std::memory_order_relaxed);
+    }
+  }
+
+  /// \brief Decrement the reference count
+  ///
+  /// Return true if this was the last reference
+  bool release() const noexcept {
+    if (thread_safe_reference_count()) {
+      if (this->_ref_count.fetch_sub(1, std::memory_order_release) == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+      }
+      return false;
+    } else {
+      std::size_t count = this->_ref_count.load(std::memory_order_relaxed) - 1;
+      this->_ref_count.store(count, std::memory_order_relaxed);
+      return count == 0;
+    }
+  }
+
+}; // end class RefCountedNode
+
+/// \brief Intrusive smart pointer on a RefCountedNode
+template < typename T >
+class NodePtr {
+private:
+  T* _ptr;
+
+public:
+  /// \brief Create a null pointer
+  NodePtr() noexcept : _ptr(nullptr) {}
+
+  /// \brief Create a null pointer
+  NodePtr(std::nullptr_t) noexcept : _ptr(nullptr) {} // NOLINT
+
+  /// \brief Take a reference on the given node
+  explicit NodePtr(T* ptr) noexcept : _ptr(ptr) { this->acquire(); }
+
+  /// \brief Copy constructor
+  NodePtr(const NodePtr& other) noexcept : _ptr(other._ptr) {
+    this->acquire();
+  }
+
+  /// \brief Move constructor
+  NodePtr(NodePtr&& other) noexcept : _ptr(other._ptr) {
+    other._ptr = nullptr;
+  }
+
+  /// \brief Converting copy constructor
+  template <
+      typename U,
+      typename = std::enable_if_t< std::is_convertible< U*, T* >::value > >
+  NodePtr(const NodePtr< U >& other) noexcept // NOLINT
+      : _ptr(other._ptr) {
+    this->acquire();
+  }
+
+  /// \brief Converting move constructor
+  template <
+      typename U,
+      typename = std::enable_if_t< std::is_convertible< U*, T* >::value > >
+  NodePtr(NodePtr< U >&& other) noexcept // NOLINT
+      : _ptr(other._ptr) {
+    other._ptr = nullptr;
+  }
+
+  /// \brief Copy assignment operator
+  NodePtr& operator=(const NodePtr& other) noexcept {
+    NodePtr(other).swap(*this);
+    return *this;
+  }
+
+  /// \brief Move assignment operator
+  NodePtr& operator=(NodePtr&& other) noexcept {
+    NodePtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /// \brief Destructor
+  ~NodePtr() {
+    if (this->_ptr != nullptr && this->_ptr->release()) {
+      delete this->_ptr;
+    }
+  }
+
+  /// \brief Return the raw pointer
+  T* get() const noexcept { return this->_ptr; }
+
+  T& operator*() const noexcept { return *this->_ptr; }
+
+  T* operator->() const noexcept { return this->_ptr; }
+
+  explicit operator bool() const noexcept { return this->_ptr != nullptr; }
+
+  /// \brief Release the reference, and become a null pointer
+  void reset() noexcept { NodePtr().swap(*this); }
+
+  /// \brief Swap with another pointer
+  void swap(NodePtr& other) noexcept { std::swap(this->_ptr, other._ptr); }
+
+private:
+  void acquire() const noexcept {
+    if (this->_ptr != nullptr) {
+      this->_ptr->acquire();
+    }
+  }
+
+  template < typename U >
+  friend class NodePtr;
+
+}; // end class NodePtr
+
+template < typename T, typename U >
+inline bool operator==(const NodePtr< T >& p, const NodePtr< U >& q) {
+  return p.get() == q.get();
+}
+
+template < typename T, typename U >
+inline bool operator!=(const NodePtr< T >& p, const NodePtr< U >& q) {
+  return p.get() != q.get();
+}
+
+template < typename T >
+inline bool operator==(const NodePtr< T >& p, std::nullptr_t) {
+  return p.get() == nullptr;
+}
+
+template < typename T >
+inline bool operator!=(const NodePtr< T >& p, std::nullptr_t) {
+  return p.get() != nullptr;
+}
+
+template < typename T >
+inline bool operator==(std::nullptr_t, const NodePtr< T >& p) {
+  return p.get() == nullptr;
+}
+
+template < typename T >
+inline bool operator!=(std::nullptr_t, const NodePtr< T >& p) {
+  return p.get() != nullptr;
+}
+
+/// \brief Allocate a new node
+template < typename T, typename... Args >
+inline NodePtr< T > make_node_ptr(Args&&... args) {
+  return NodePtr< T >(new T(std::forward< Args >(args)...));
+}
+
+/// \brief Static cast of a node pointer
+template < typename T, typename U >
+inline NodePtr< T > static_node_cast(const NodePtr< U >& ptr) {
+  return NodePtr< T >(static_cast< T* >(ptr.get()));
+}
+
+} // end namespace patricia_tree_utils
+} // end namespace core
+} // end namespace ikos
@@ -51,9 +51,10 @@
 
 #include <iostream>
 #include <iterator>
-#include <memory>
 #include <stack>
 
+#include <ikos/core/adt/patricia_tree/hash_consing.hpp>
+#include <ikos/core/adt/patricia_tree/node.hpp>
 #include <ikos/core/adt/patricia_tree/utils.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
@@ -75,51 +76,50 @@ template < typename Key >
 class PatriciaTreeIterator;
 
 template < typename Key >
-inline bool empty(const std::shared_ptr< const PatriciaTree< Key > >& tree);
+inline bool empty(const NodePtr< const PatriciaTree< Key > >& tree);
 
 template < typename Key >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree);
+inline std::size_t size(const NodePtr< const PatriciaTree< Key > >& tree);
 
 template < typename Key >
-inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline bool contains(const NodePtr< const PatriciaTree< Key > >& tree,
                      const Key& key);
 
 template < typename Key >
-inline bool is_subset_of(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                         const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline bool is_subset_of(const NodePtr< const PatriciaTree< Key > >& s,
+                         const NodePtr< const PatriciaTree< Key > >& t);
 
 template < typename Key >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline bool equals(const NodePtr< const PatriciaTree< Key > >& s,
+                   const NodePtr< const PatriciaTree< Key > >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key);
+inline NodePtr< const PatriciaTree< Key > > insert(
+    const NodePtr< const PatriciaTree< Key > >& tree, const Key& key);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > erase(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key);
+inline NodePtr< const PatriciaTree< Key > > erase(
+    const NodePtr< const PatriciaTree< Key > >& tree, const Key& key);
 
 template < typename Key, typename Predicate >
-inline std::shared_ptr< const PatriciaTree< Key > > filter(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline NodePtr< const PatriciaTree< Key > > filter(
+    const NodePtr< const PatriciaTree< Key > >& tree,
     const Predicate& pred);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > join(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline NodePtr< const PatriciaTree< Key > > join(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline NodePtr< const PatriciaTree< Key > > intersect(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t);
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > difference(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t);
+inline NodePtr< const PatriciaTree< Key > > difference(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t);
 
 } // end namespace patricia_tree_set_impl
 
@@ -142,11 +142,12 @@ public:
   using Iterator = patricia_tree_set_impl::PatriciaTreeIterator< Key >;
 
 private:
-  std::shared_ptr< const PatriciaTree > _tree;
+  patricia_tree_utils::NodePtr< const PatriciaTree > _tree;
 
 private:
   /// \brief Private constructor
-  explicit PatriciaTreeSet(std::shared_ptr< const PatriciaTree > tree)
+  explicit PatriciaTreeSet(
+      patricia_tree_utils::NodePtr< const PatriciaTree > tree)
       : _tree(std::move(tree)) {}
 
 public:
@@ -296,12 +297,13 @@ inline std::ostream& operator<<(std::ostream& o,
 namespace patricia_tree_set_impl {
 
 template < typename Key >
-class PatriciaTree {
+class PatriciaTree : public RefCountedNode {
 private:
   std::size_t _size;
+  std::size_t _hash;
 
 public:
-  explicit PatriciaTree(std::size_t size) : _size(size) {}
+  PatriciaTree(std::size_t size, std::size_t hash) : _size(size), _hash(hash) {}
 
   // PatriciaTree is immutable
   PatriciaTree(const PatriciaTree&) = delete;
@@ -309,10 +311,16 @@ public:
   PatriciaTree& operator=(const PatriciaTree&) = delete;
   PatriciaTree& operator=(PatriciaTree&&) = delete;
 
-  virtual ~PatriciaTree() = default;
+  ~PatriciaTree() override = default;
 
   std::size_t size() const { return this->_size; }
 
+  /// \brief Return the structural hash of the tree
+  ///
+  /// The hash is only computed when hash-consing is enabled, it is 0 for a
+  /// tree created while hash-consing was disabled.
+  std::size_t hash() const { return this->_hash; }
+
   bool is_leaf() const { return this->_size == 1; }
 
   bool is_node() const { return !this->is_leaf(); }
@@ -324,29 +332,43 @@ class PatriciaTreeNode final : public PatriciaTree< Key > {
 private:
   Index _prefix;
   Index _branching_bit;
-  std::shared_ptr< const PatriciaTree< Key > > _left_tree;
-  std::shared_ptr< const PatriciaTree< Key > > _right_tree;
+  NodePtr< const PatriciaTree< Key > > _left_tree;
+  NodePtr< const PatriciaTree< Key > > _right_tree;
 
 public:
   PatriciaTreeNode(Index prefix,
                    Index branching_bit,
-                   std::shared_ptr< const PatriciaTree< Key > > left_tree,
-                   std::shared_ptr< const PatriciaTree< Key > > right_tree)
-      : PatriciaTree< Key >(left_tree->size() + right_tree->size()),
+                   NodePtr< const PatriciaTree< Key > > left_tree,
+                   NodePtr< const PatriciaTree< Key > > right_tree,
+                   std::size_t hash)
+      : PatriciaTree< Key >(left_tree->size() + right_tree->size(), hash),
         _prefix(prefix),
         _branching_bit(branching_bit),
         _left_tree(std::move(left_tree)),
         _right_tree(std::move(right_tree)) {}
 
+  /// \brief Return the structural hash of a node
+  static std::size_t compute_hash(Index prefix,
+                                  Index branching_bit,
+                                  const PatriciaTree< Key >& left_tree,
+                                  const PatriciaTree< Key >& right_tree) {
+    std::size_t result = 0;
+    boost::hash_combine(result, prefix);
+    boost::hash_combine(result, branching_bit);
+    boost::hash_combine(result, left_tree.hash());
+    boost::hash_combine(result, right_tree.hash());
+    return result;
+  }
+
   Index prefix() const { return this->_prefix; }
 
   Index branching_bit() const { return this->_branching_bit; }
 
-  const std::shared_ptr< const PatriciaTree< Key > >& left_tree() const {
+  const NodePtr< const PatriciaTree< Key > >& left_tree() const {
     return this->_left_tree;
   }
 
-  const std::shared_ptr< const PatriciaTree< Key > >& right_tree() const {
+  const NodePtr< const PatriciaTree< Key > >& right_tree() const {
     return this->_right_tree;
   }
 
@@ -358,21 +380,25 @@ private:
   Key _key;
 
 public:
-  explicit PatriciaTreeLeaf(Key key)
-      : PatriciaTree< Key >(1), _key(std::move(key)) {}
+  PatriciaTreeLeaf(Key key, std::size_t hash)
+      : PatriciaTree< Key >(1, hash), _key(std::move(key)) {}
+
+  /// \brief Return the structural hash of a leaf
+  static std::size_t compute_hash(const Key& key) {
+    return std::hash< Index >()(IndexableTraits< Key >::index(key));
+  }
 
   const Key& key() const { return this->_key; }
 
 }; // end class PatriciaTreeLeaf
 
 template < typename Key >
-inline bool empty(const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+inline bool empty(const NodePtr< const PatriciaTree< Key > >& tree) {
   return tree == nullptr;
 }
 
 template < typename Key >
-inline std::size_t size(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+inline std::size_t size(const NodePtr< const PatriciaTree< Key > >& tree) {
   if (tree != nullptr) {
     return tree->size();
   } else {
@@ -381,16 +407,16 @@ inline std::size_t size(
 }
 
 template < typename Key >
-inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline bool contains(const NodePtr< const PatriciaTree< Key > >& tree,
                      const Key& key) {
   if (tree == nullptr) {
     return false;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(tree);
     return leaf->key() == key;
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key > >(tree);
   if (is_zero_bit(IndexableTraits< Key >::index(key), node->branching_bit())) {
     return contains(node->left_tree(), key);
   } else {
@@ -398,28 +424,20 @@ inline bool contains(const std::shared_ptr< const PatriciaTree< Key > >& tree,
   }
 }
 
+/// \brief Inclusion test of non-null trees
 template < typename Key >
-inline bool is_subset_of(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
-  if (s == t) {
-    return true;
-  }
-  if (s == nullptr) {
-    return true;
-  }
-  if (t == nullptr) {
-    return false;
-  }
+inline bool is_subset_of_non_null(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
     return contains(t, s_leaf->key());
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key > >(t);
   if (s_node->size() > t_node->size()) {
     return false;
   }
@@ -444,8 +462,29 @@ inline bool is_subset_of(
 }
 
 template < typename Key >
-inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
-                   const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline bool is_subset_of(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
+  if (s == t) {
+    return true;
+  }
+  if (s == nullptr) {
+    return true;
+  }
+  if (t == nullptr) {
+    return false;
+  }
+  if (should_memoize(s, t)) {
+    return memoize< LeqOperation< void > >(s, t, [&] {
+      return is_subset_of_non_null(s, t);
+    });
+  }
+  return is_subset_of_non_null(s, t);
+}
+
+template < typename Key >
+inline bool equals(const NodePtr< const PatriciaTree< Key > >& s,
+                   const NodePtr< const PatriciaTree< Key > >& t) {
   if (s == t) {
     return true;
   }
@@ -456,15 +495,15 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
     if (t->is_node()) {
       return false;
     }
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(t);
     return s_leaf->key() == t_leaf->key();
   }
   if (t->is_leaf()) {
     return false;
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key > >(t);
   return s_node->size() == t_node->size() &&
          s_node->prefix() == t_node->prefix() &&
          s_node->branching_bit() == t_node->branching_bit() &&
@@ -472,69 +511,123 @@ inline bool equals(const std::shared_ptr< const PatriciaTree< Key > >& s,
          equals(s_node->right_tree(), t_node->right_tree());
 }
 
+/// \brief Create a leaf
+///
+/// If hash-consing is enabled, return the canonical leaf.
+template < typename Key >
+inline NodePtr< const PatriciaTreeLeaf< Key > > create_leaf(const Key& key) {
+  if (!hash_consing()) {
+    return make_node_ptr< const PatriciaTreeLeaf< Key > >(key, 0);
+  }
+  auto& table = HashConsTable< PatriciaTree< Key > >::local();
+  std::size_t hash = PatriciaTreeLeaf< Key >::compute_hash(key);
+  auto canonical = table.find(hash, [&](const PatriciaTree< Key >& tree) {
+    return tree.is_leaf() &&
+           static_cast< const PatriciaTreeLeaf< Key >& >(tree).key() == key;
+  });
+  if (canonical != nullptr) {
+    return static_node_cast< const PatriciaTreeLeaf< Key > >(canonical);
+  }
+  auto leaf = make_node_ptr< const PatriciaTreeLeaf< Key > >(key, hash);
+  table.insert(leaf);
+  return leaf;
+}
+
+/// \brief Create a node with two non-null children
+///
+/// If hash-consing is enabled, return the canonical node.
+template < typename Key >
+inline NodePtr< const PatriciaTreeNode< Key > > create_node(
+    Index prefix,
+    Index branching_bit,
+    const NodePtr< const PatriciaTree< Key > >& left_tree,
+    const NodePtr< const PatriciaTree< Key > >& right_tree) {
+  if (!hash_consing()) {
+    return make_node_ptr< const PatriciaTreeNode< Key > >(prefix,
+                                                          branching_bit,
+                                                          left_tree,
+                                                          right_tree,
+                                                          0);
+  }
+  auto& table = HashConsTable< PatriciaTree< Key > >::local();
+  std::size_t hash = PatriciaTreeNode< Key >::compute_hash(prefix,
+                                                           branching_bit,
+                                                           *left_tree,
+                                                           *right_tree);
+  auto canonical = table.find(hash, [&](const PatriciaTree< Key >& tree) {
+    if (tree.is_leaf()) {
+      return false;
+    }
+    const auto& node = static_cast< const PatriciaTreeNode< Key >& >(tree);
+    return node.prefix() == prefix && node.branching_bit() == branching_bit &&
+           node.left_tree() == left_tree && node.right_tree() == right_tree;
+  });
+  if (canonical != nullptr) {
+    return static_node_cast< const PatriciaTreeNode< Key > >(canonical);
+  }
+  auto node = make_node_ptr< const PatriciaTreeNode< Key > >(prefix,
+                                                             branching_bit,
+                                                             left_tree,
+                                                             right_tree,
+                                                             hash);
+  table.insert(node);
+  return node;
+}
+
 /// \brief Create a node
 ///
 /// Prevent the creation of a node with only one child.
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > make_node(
+inline NodePtr< const PatriciaTree< Key > > make_node(
     Index prefix,
     Index branching_bit,
-    const std::shared_ptr< const PatriciaTree< Key > >& left_tree,
-    const std::shared_ptr< const PatriciaTree< Key > >& right_tree) {
+    const NodePtr< const PatriciaTree< Key > >& left_tree,
+    const NodePtr< const PatriciaTree< Key > >& right_tree) {
   if (left_tree == nullptr) {
     return right_tree;
   }
   if (right_tree == nullptr) {
     return left_tree;
   }
-  return std::make_shared< const PatriciaTreeNode< Key > >(prefix,
-                                                           branching_bit,
-                                                           left_tree,
-                                                           right_tree);
+  return create_node(prefix, branching_bit, left_tree, right_tree);
 }
 
 /// \brief Join non-null patricia trees
 template < typename Key >
-inline std::shared_ptr< const PatriciaTreeNode< Key > > join_trees(
+inline NodePtr< const PatriciaTreeNode< Key > > join_trees(
     Index prefix_s,
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& s,
     Index prefix_t,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+    const NodePtr< const PatriciaTree< Key > >& t) {
   ikos_assert(s != nullptr && t != nullptr);
 
   Index m = branching_bit(prefix_s, prefix_t);
 
   if (is_zero_bit(prefix_s, m)) {
-    return std::make_shared< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
-                                                             m,
-                                                             s,
-                                                             t);
+    return create_node(mask(prefix_s, m), m, s, t);
   } else {
-    return std::make_shared< const PatriciaTreeNode< Key > >(mask(prefix_s, m),
-                                                             m,
-                                                             t,
-                                                             s);
+    return create_node(mask(prefix_s, m), m, t, s);
   }
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key) {
+inline NodePtr< const PatriciaTree< Key > > insert(
+    const NodePtr< const PatriciaTree< Key > >& tree, const Key& key) {
   if (tree == nullptr) {
-    return std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+    return create_leaf(key);
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(tree);
     if (leaf->key() == key) {
       return tree;
     }
-    auto new_leaf = std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+    auto new_leaf = create_leaf(key);
     return join_trees< Key >(IndexableTraits< Key >::index(key),
                              new_leaf,
                              IndexableTraits< Key >::index(leaf->key()),
                              leaf);
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -559,7 +652,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert(
                        new_right_tree);
     }
   }
-  auto new_leaf = std::make_shared< const PatriciaTreeLeaf< Key > >(key);
+  auto new_leaf = create_leaf(key);
   return join_trees< Key >(IndexableTraits< Key >::index(key),
                            new_leaf,
                            node->prefix(),
@@ -568,9 +661,9 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert(
 
 /// \brief Insert the leaf `t_leaf` into the patricia tree `s`
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTreeLeaf< Key > >& t_leaf) {
+inline NodePtr< const PatriciaTree< Key > > insert_leaf(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTreeLeaf< Key > >& t_leaf) {
   if (s == t_leaf) {
     return s;
   }
@@ -578,7 +671,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
     return t_leaf;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
     if (s_leaf->key() == t_leaf->key()) {
       return std::move(s_leaf);
     }
@@ -587,7 +680,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
                              IndexableTraits< Key >::index(t_leaf->key()),
                              t_leaf);
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
   if (match_prefix(IndexableTraits< Key >::index(t_leaf->key()),
                    s_node->prefix(),
                    s_node->branching_bit())) {
@@ -619,20 +712,20 @@ inline std::shared_ptr< const PatriciaTree< Key > > insert_leaf(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > erase(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree, const Key& key) {
+inline NodePtr< const PatriciaTree< Key > > erase(
+    const NodePtr< const PatriciaTree< Key > >& tree, const Key& key) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(tree);
     if (leaf->key() == key) {
       return nullptr;
     } else {
       return tree;
     }
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key > >(tree);
   if (match_prefix(IndexableTraits< Key >::index(key),
                    node->prefix(),
                    node->branching_bit())) {
@@ -661,21 +754,21 @@ inline std::shared_ptr< const PatriciaTree< Key > > erase(
 }
 
 template < typename Key, typename Predicate >
-inline std::shared_ptr< const PatriciaTree< Key > > filter(
-    const std::shared_ptr< const PatriciaTree< Key > >& tree,
+inline NodePtr< const PatriciaTree< Key > > filter(
+    const NodePtr< const PatriciaTree< Key > >& tree,
     const Predicate& pred) {
   if (tree == nullptr) {
     return nullptr;
   }
   if (tree->is_leaf()) {
-    auto leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(tree);
+    auto leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(tree);
     if (pred(leaf->key())) {
       return tree;
     } else {
       return nullptr;
     }
   }
-  auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(tree);
+  auto node = static_node_cast< const PatriciaTreeNode< Key > >(tree);
   auto new_left_tree = filter(node->left_tree(), pred);
   auto new_right_tree = filter(node->right_tree(), pred);
   if (new_left_tree == node->left_tree() &&
@@ -689,29 +782,21 @@ inline std::shared_ptr< const PatriciaTree< Key > > filter(
   }
 }
 
+/// \brief Join non-null trees
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > join(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
-  if (s == t) {
-    return s;
-  }
-  if (s == nullptr) {
-    return t;
-  }
-  if (t == nullptr) {
-    return s;
-  }
+inline NodePtr< const PatriciaTree< Key > > join_non_null(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
     return insert_leaf(t, s_leaf);
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(t);
     return insert_leaf(s, t_leaf);
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -765,17 +850,33 @@ inline std::shared_ptr< const PatriciaTree< Key > > join(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > intersect(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline NodePtr< const PatriciaTree< Key > > join(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
   if (s == t) {
     return s;
   }
-  if (s == nullptr || t == nullptr) {
-    return nullptr;
+  if (s == nullptr) {
+    return t;
+  }
+  if (t == nullptr) {
+    return s;
+  }
+  if (should_memoize(s, t)) {
+    return memoize< JoinOperation< void > >(s, t, [&] {
+      return join_non_null(s, t);
+    });
   }
+  return join_non_null(s, t);
+}
+
+/// \brief Intersect non-null trees
+template < typename Key >
+inline NodePtr< const PatriciaTree< Key > > intersect_non_null(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
     if (contains(t, s_leaf->key())) {
       return s;
     } else {
@@ -783,15 +884,15 @@ inline std::shared_ptr< const PatriciaTree< Key > > intersect(
     }
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(t);
     if (contains(s, t_leaf->key())) {
       return t;
     } else {
       return nullptr;
     }
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -829,9 +930,27 @@ inline std::shared_ptr< const PatriciaTree< Key > > intersect(
 }
 
 template < typename Key >
-inline std::shared_ptr< const PatriciaTree< Key > > difference(
-    const std::shared_ptr< const PatriciaTree< Key > >& s,
-    const std::shared_ptr< const PatriciaTree< Key > >& t) {
+inline NodePtr< const PatriciaTree< Key > > intersect(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
+  if (s == t) {
+    return s;
+  }
+  if (s == nullptr || t == nullptr) {
+    return nullptr;
+  }
+  if (should_memoize(s, t)) {
+    return memoize< IntersectOperation< void > >(s, t, [&] {
+      return intersect_non_null(s, t);
+    });
+  }
+  return intersect_non_null(s, t);
+}
+
+template < typename Key >
+inline NodePtr< const PatriciaTree< Key > > difference(
+    const NodePtr< const PatriciaTree< Key > >& s,
+    const NodePtr< const PatriciaTree< Key > >& t) {
   if (s == t) {
     return nullptr;
   }
@@ -842,7 +961,7 @@ inline std::shared_ptr< const PatriciaTree< Key > > difference(
     return s;
   }
   if (s->is_leaf()) {
-    auto s_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(s);
+    auto s_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(s);
     if (contains(t, s_leaf->key())) {
       return nullptr;
     } else {
@@ -850,11 +969,11 @@ inline std::shared_ptr< const PatriciaTree< Key > > difference(
     }
   }
   if (t->is_leaf()) {
-    auto t_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    auto t_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(t);
     return erase(s, t_leaf->key());
   }
-  auto s_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(s);
-  auto t_node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+  auto s_node = static_node_cast< const PatriciaTreeNode< Key > >(s);
+  auto t_node = static_node_cast< const PatriciaTreeNode< Key > >(t);
   Index m = s_node->branching_bit();
   Index n = t_node->branching_bit();
   Index p = s_node->prefix();
@@ -910,8 +1029,8 @@ public:
   using reference = const Key&;
 
 private:
-  std::shared_ptr< const PatriciaTreeLeaf< Key > > _leaf;
-  std::stack< std::shared_ptr< const PatriciaTreeNode< Key > > > _stack;
+  NodePtr< const PatriciaTreeLeaf< Key > > _leaf;
+  std::stack< NodePtr< const PatriciaTreeNode< Key > > > _stack;
 
 public:
   /// \brief Create an end iterator
@@ -919,7 +1038,7 @@ public:
 
   /// \brief Create an iterator on the given patricia tree
   explicit PatriciaTreeIterator(
-      const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+      const NodePtr< const PatriciaTree< Key > >& tree) {
     if (tree != nullptr) {
       this->look_for_next_leaf(tree);
     }
@@ -970,17 +1089,16 @@ public:
 
 private:
   /// \brief Find the leftmost leaf, store all intermediate nodes
-  void look_for_next_leaf(
-      const std::shared_ptr< const PatriciaTree< Key > >& tree) {
+  void look_for_next_leaf(const NodePtr< const PatriciaTree< Key > >& tree) {
     auto t = tree;
     ikos_assert(t != nullptr);
     while (t->is_node()) {
-      auto node = std::static_pointer_cast< const PatriciaTreeNode< Key > >(t);
+      auto node = static_node_cast< const PatriciaTreeNode< Key > >(t);
       this->_stack.push(node);
       t = node->left_tree();
       ikos_assert(t != nullptr); // a node always has two children
     }
-    this->_leaf = std::static_pointer_cast< const PatriciaTreeLeaf< Key > >(t);
+    this->_leaf = static_node_cast< const PatriciaTreeLeaf< Key > >(t);
   }
 
 }; // end class PatriciaTreeIterator
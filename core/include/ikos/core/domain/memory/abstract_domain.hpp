@@ -187,6 +187,9 @@ public:
   /// \brief Forget the lifetime of a memory location
   virtual void lifetime_forget(MemoryLocationRef m) = 0;
 
+  /// \brief Forget the lifetime of all memory locations
+  virtual void lifetime_forget_all() = 0;
+
   /// \brief Set the lifetime of a memory location
   virtual void lifetime_set(MemoryLocationRef m, Lifetime value) = 0;
 
@@ -210,6 +213,13 @@ public:
   virtual void partitioning_disable() = 0;
 
   /// @}
+  /// \name Statistics methods
+  /// @{
+
+  /// \brief Return the number of memory cells tracked by the abstract value
+  virtual std::size_t num_cells() const = 0;
+
+  /// @}
 
 }; // end class AbstractDomain
 
@@ -770,6 +770,8 @@ public:
 
   void lifetime_forget(MemoryLocationRef) override {}
 
+  void lifetime_forget_all() override {}
+
   Lifetime lifetime_to_lifetime(MemoryLocationRef) const override {
     if (this->is_bottom()) {
       return Lifetime::bottom();
@@ -794,6 +796,17 @@ public:
 
   /// @}
 
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override {
+    return this->_scalar.num_variables();
+  }
+
+  std::size_t num_cells() const override { return 0; }
+
+  /// @}
+
   void dump(std::ostream& o) const override { this->_scalar.dump(o); }
 
   static std::string name() {
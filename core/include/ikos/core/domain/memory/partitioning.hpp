@@ -1584,6 +1584,12 @@ public:
     }
   }
 
+  void lifetime_forget_all() override {
+    for (Partition& partition : this->_partitions) {
+      partition.memory.lifetime_forget_all();
+    }
+  }
+
   Lifetime lifetime_to_lifetime(MemoryLocationRef m) const override {
     auto result = Lifetime::bottom();
     for (const Partition& partition : this->_partitions) {
@@ -1592,6 +1598,26 @@ public:
     return result;
   }
 
+  /// @}
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override {
+    std::size_t n = 0;
+    for (const Partition& partition : this->_partitions) {
+      n += partition.memory.num_variables();
+    }
+    return n;
+  }
+
+  std::size_t num_cells() const override {
+    std::size_t n = 0;
+    for (const Partition& partition : this->_partitions) {
+      n += partition.memory.num_cells();
+    }
+    return n;
+  }
+
   /// @}
 
   void dump(std::ostream& o) const override {
@@ -701,6 +701,9 @@ private:
     /// \brief Forget the lifetime of a memory location
     virtual void lifetime_forget(MemoryLocationRef m) = 0;
 
+    /// \brief Forget the lifetime of all memory locations
+    virtual void lifetime_forget_all() = 0;
+
     /// \brief Set the lifetime of a memory location
     virtual void lifetime_set(MemoryLocationRef m, Lifetime value) = 0;
 
@@ -723,6 +726,16 @@ private:
     /// \brief Disable the current partitioning
     virtual void partitioning_disable() = 0;
 
+    /// @}
+    /// \name Statistics methods
+    /// @{
+
+    /// \brief Return the number of variables tracked by the abstract value
+    virtual std::size_t num_variables() const = 0;
+
+    /// \brief Return the number of memory cells tracked by the abstract value
+    virtual std::size_t num_cells() const = 0;
+
     /// @}
 
     /// \brief Dump the abstract value, for debugging purpose
@@ -1428,6 +1441,8 @@ private:
       this->_inv.lifetime_forget(m);
     }
 
+    void lifetime_forget_all() override { this->_inv.lifetime_forget_all(); }
+
     void lifetime_set(MemoryLocationRef m, Lifetime value) override {
       this->_inv.lifetime_set(m, value);
     }
@@ -1452,6 +1467,16 @@ private:
 
     void partitioning_disable() override { this->_inv.partitioning_disable(); }
 
+    /// @}
+    /// \name Statistics methods
+    /// @{
+
+    std::size_t num_variables() const override {
+      return this->_inv.num_variables();
+    }
+
+    std::size_t num_cells() const override { return this->_inv.num_cells(); }
+
     /// @}
 
     void dump(std::ostream& o) const override { this->_inv.dump(o); }
@@ -2083,6 +2108,8 @@ public:
     this->_ptr->lifetime_forget(m);
   }
 
+  void lifetime_forget_all() override { this->_ptr->lifetime_forget_all(); }
+
   void lifetime_set(MemoryLocationRef m, Lifetime value) override {
     this->_ptr->lifetime_set(m, value);
   }
@@ -2107,6 +2134,16 @@ public:
 
   void partitioning_disable() override { this->_ptr->partitioning_disable(); }
 
+  /// @}
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override {
+    return this->_ptr->num_variables();
+  }
+
+  std::size_t num_cells() const override { return this->_ptr->num_cells(); }
+
   /// @}
 
   void dump(std::ostream& o) const override { this->_ptr->dump(o); }
@@ -2207,6 +2207,14 @@ public:
     this->_lifetime.forget(m);
   }
 
+  void lifetime_forget_all() override {
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_lifetime.set_to_top();
+  }
+
   void lifetime_set(MemoryLocationRef m, Lifetime value) override {
     this->_lifetime.set(m, value);
   }
@@ -2231,6 +2239,28 @@ public:
 
   /// @}
 
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override {
+    return this->_scalar.num_variables();
+  }
+
+  std::size_t num_cells() const override {
+    if (this->_cells.is_bottom()) {
+      return 0;
+    }
+
+    std::size_t n = 0;
+    for (auto it = this->_cells.begin(), et = this->_cells.end(); it != et;
+         ++it) {
+      n += it->second.size();
+    }
+    return n;
+  }
+
+  /// @}
+
   void dump(std::ostream& o) const override {
     if (this->is_bottom()) {
       o << "⊥";
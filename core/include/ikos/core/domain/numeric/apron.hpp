@@ -44,6 +44,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -256,7 +257,9 @@ private:
 
   /// \brief Deleter for ap_abstract0_t*
   struct InvDeleter {
-    void operator()(ap_abstract0_t* inv) { ap_abstract0_free(manager(), inv); }
+    void operator()(ap_abstract0_t* inv) {
+      ap_abstract0_free(manager(), bind(inv));
+    }
   };
 
   /// \brief Wrapper for ap_abstract0_t
@@ -268,11 +271,85 @@ private:
   VariableMap _var_map;
 
 private:
-  /// \brief Get the manager for the given apron domain
+  /// \brief Manager of the apron domain owned by a thread
+  ///
+  /// APRON managers are not thread-safe: every operation uses the scratch
+  /// buffers of the manager, and an ap_abstract0_t holds a reference on the
+  /// manager that created it, through a reference count that is not atomic.
+  /// Hence each thread has its own manager, and only that thread updates its
+  /// reference count. Other threads release their references through
+  /// `released`, which the owner applies on its next call to manager().
+  struct ThreadManager {
+    ap_manager_t* man;
+    std::atomic< std::size_t > released;
+
+    explicit ThreadManager(ap_manager_t* man_) : man(man_), released(0) {}
+  };
+
+  /// \brief Managers of all threads
+  ///
+  /// Managers are never freed, since abstract values can outlive the thread
+  /// that created them.
+  struct ThreadManagers {
+    std::mutex mutex;
+    std::vector< std::unique_ptr< ThreadManager > > managers;
+
+    /// \brief Return the ThreadManager of the given manager
+    ThreadManager& find(ap_manager_t* man) {
+      std::lock_guard< std::mutex > lock(this->mutex);
+      for (const auto& tm : this->managers) {
+        if (tm->man == man) {
+          return *tm;
+        }
+      }
+      ikos_unreachable("unknown apron manager");
+    }
+  };
+
+  /// \brief Return the managers of all threads
+  static ThreadManagers& thread_managers() {
+    static ThreadManagers Managers;
+    return Managers;
+  }
+
+  /// \brief Return the manager of the current thread
+  static ThreadManager& thread_manager() {
+    // Initialized at first call in each thread
+    static thread_local ThreadManager* Tm = [] {
+      ThreadManagers& all = thread_managers();
+      std::lock_guard< std::mutex > lock(all.mutex);
+      all.managers.push_back(std::make_unique< ThreadManager >(
+          apron::alloc_domain_manager(Domain)));
+      return all.managers.back().get();
+    }();
+    return *Tm;
+  }
+
+  /// \brief Get the manager for the given apron domain, in the current thread
   static ap_manager_t* manager() {
-    // Initialized at first call
-    static ap_manager_t* Man = apron::alloc_domain_manager(Domain);
-    return Man;
+    ThreadManager& tm = thread_manager();
+    if (tm.released.load(std::memory_order_relaxed) > 0) {
+      for (std::size_t n = tm.released.exchange(0); n > 0; n--) {
+        // The first reference, from alloc_domain_manager(), is never released
+        ap_manager_free(tm.man);
+      }
+    }
+    return tm.man;
+  }
+
+  /// \brief Move the reference of `inv` on its manager to the manager of the
+  /// current thread
+  ///
+  /// This must be called before any destructive operation on an abstract
+  /// value that might have been created by another thread, since APRON
+  /// releases the manager of the operand when it differs.
+  static ap_abstract0_t* bind(ap_abstract0_t* inv) {
+    ap_manager_t* man = manager();
+    if (inv->man != man) {
+      thread_managers().find(inv->man).released++;
+      inv->man = ap_manager_copy(man);
+    }
+    return inv;
   }
 
   /*
@@ -337,7 +414,7 @@ private:
     ap_dimchange_t* dimchange = add_dimensions(this->_inv.get(), 1);
     ap_abstract0_add_dimensions(manager(),
                                 true,
-                                this->_inv.get(),
+                                bind(this->_inv.get()),
                                 dimchange,
                                 false);
     ap_dimchange_free(dimchange);
@@ -375,13 +452,21 @@ private:
     if (result.size() > lhs_var_map.size()) {
       ap_dimchange_t* dimchange =
           add_dimensions(lhs_inv, result.size() - lhs_var_map.size());
-      ap_abstract0_add_dimensions(manager(), true, lhs_inv, dimchange, false);
+      ap_abstract0_add_dimensions(manager(),
+                                  true,
+                                  bind(lhs_inv),
+                                  dimchange,
+                                  false);
       ap_dimchange_free(dimchange);
     }
     if (result.size() > rhs_var_map.size()) {
       ap_dimchange_t* dimchange =
           add_dimensions(rhs_inv, result.size() - rhs_var_map.size());
-      ap_abstract0_add_dimensions(manager(), true, rhs_inv, dimchange, false);
+      ap_abstract0_add_dimensions(manager(),
+                                  true,
+                                  bind(rhs_inv),
+                                  dimchange,
+                                  false);
       ap_dimchange_free(dimchange);
     }
 
@@ -390,7 +475,7 @@ private:
 
     // Build and apply the permutation map for rhs_inv
     ap_dimperm_t* rhs_perm = build_perm_map(rhs_var_map, result);
-    ap_abstract0_permute_dimensions(manager(), true, rhs_inv, rhs_perm);
+    ap_abstract0_permute_dimensions(manager(), true, bind(rhs_inv), rhs_perm);
     ap_dimperm_free(rhs_perm);
 
     ikos_assert(result.size() == dimension(lhs_inv));
@@ -663,13 +748,19 @@ public:
     } else if (ap_abstract0_is_bottom(manager(), other._inv.get())) {
       return;
     } else if (this->same_var_map(other)) {
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     } else {
       this->_var_map = merge_var_maps(this->_var_map,
                                       this->_inv.get(),
                                       other._var_map,
                                       other._inv.get());
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     }
   }
 
@@ -688,14 +779,17 @@ public:
     } else if (ap_abstract0_is_bottom(manager(), other._inv.get())) {
       return;
     } else if (this->same_var_map(other)) {
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     } else {
       InvPtr rhs = InvPtr(ap_abstract0_copy(manager(), other._inv.get()));
       this->_var_map = merge_var_maps(this->_var_map,
                                       this->_inv.get(),
                                       other._var_map,
                                       rhs.get());
-      ap_abstract0_join(manager(), true, this->_inv.get(), rhs.get());
+      ap_abstract0_join(manager(), true, bind(this->_inv.get()), rhs.get());
     }
   }
 
@@ -871,7 +965,7 @@ public:
     ap_dim_t v_dim = this->var_dim_insert(x);
     ap_abstract0_assign_texpr(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               v_dim,
                               t,
                               nullptr);
@@ -925,7 +1019,7 @@ private:
     ap_dim_t x_dim = this->var_dim_insert(x);
     ap_abstract0_assign_texpr(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               x_dim,
                               t,
                               nullptr);
@@ -1022,7 +1116,10 @@ public:
       ap_csts.p[i++] = this->to_ap_constraint(cst);
     }
 
-    ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &ap_csts);
+    ap_abstract0_meet_tcons_array(manager(),
+                                  true,
+                                  bind(this->_inv.get()),
+                                  &ap_csts);
 
     // Improve the precision
     for (i = 0; i < csts.size() &&
@@ -1110,7 +1207,10 @@ public:
           ap_tcons0_make(AP_CONS_EQMOD,
                          this->to_ap_expr(VariableExprT(x) - value.residue()),
                          apron::to_ap_scalar(value.modulus()));
-      ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &csts);
+      ap_abstract0_meet_tcons_array(manager(),
+                                    true,
+                                    bind(this->_inv.get()),
+                                    &csts);
       ap_tcons0_array_clear(&csts);
     }
   }
@@ -1138,7 +1238,7 @@ public:
     std::vector< ap_dim_t > vector_dims{dim};
     ap_abstract0_forget_array(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               &vector_dims[0],
                               vector_dims.size(),
                               false);
@@ -1146,7 +1246,7 @@ public:
         remove_dimensions(this->_inv.get(), vector_dims);
     ap_abstract0_remove_dimensions(manager(),
                                    true,
-                                   this->_inv.get(),
+                                   bind(this->_inv.get()),
                                    dimchange);
     ap_dimchange_free(dimchange);
     this->_var_map.transform([dim](VariableRef, ap_dim_t d) {
@@ -48,6 +48,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #include <boost/container/flat_map.hpp>
@@ -56,6 +58,7 @@
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
 #include <ikos/core/domain/numeric/interval.hpp>
 #include <ikos/core/number/bound.hpp>
+#include <ikos/core/number/z_number.hpp>
 #include <ikos/core/support/assert.hpp>
 #include <ikos/core/value/numeric/interval.hpp>
 
@@ -65,6 +68,66 @@ namespace ikos {
 namespace core {
 namespace numeric {
 
+namespace octagon_impl {
+
+/// \brief Bound on the absolute value of encoded finite bounds
+constexpr int64_t FixedWidthLimit = int64_t(1) << 56;
+
+/// \brief Encoded sums greater than this threshold are +oo
+constexpr int64_t FixedWidthInfinityThreshold = int64_t(1) << 60;
+
+/// \brief Encoding of +oo
+constexpr int64_t FixedWidthInfinity = int64_t(1) << 61;
+
+/// \brief Fixed-width encoding of bounds, used by the strong closure
+///
+/// Finite bounds are encoded in [-FixedWidthLimit, FixedWidthLimit] and +oo
+/// is encoded as FixedWidthInfinity. A sum of three encoded bounds does not
+/// overflow, and a sum involving +oo is greater than
+/// FixedWidthInfinityThreshold.
+///
+/// By default, bounds cannot be encoded.
+template < typename Number >
+struct FixedWidthBound {
+  static bool encode(const Bound< Number >& /*b*/, int64_t& /*n*/) {
+    return false;
+  }
+
+  static Bound< Number > decode(int64_t /*n*/) {
+    ikos_unreachable("unreachable");
+  }
+};
+
+/// \brief Fixed-width encoding of integer bounds
+template <>
+struct FixedWidthBound< ZNumber > {
+  static bool encode(const ZBound& b, int64_t& n) {
+    if (b.is_plus_infinity()) {
+      n = FixedWidthInfinity;
+      return true;
+    } else if (b.is_minus_infinity()) {
+      return false;
+    }
+
+    boost::optional< ZNumber > v = b.number();
+    if (!v->fits< int64_t >()) {
+      return false;
+    }
+    n = v->to< int64_t >();
+    return n >= -FixedWidthLimit && n <= FixedWidthLimit;
+  }
+
+  static ZBound decode(int64_t n) {
+    if (n == FixedWidthInfinity) {
+      return ZBound::plus_infinity();
+    } else {
+      return ZBound(ZNumber(n));
+    }
+  }
+};
+
+} // end namespace octagon_impl
+
 /// \brief Octagon abstract domain
 ///
 /// Warning: The memory of this domain is managed in a brute force
@@ -96,6 +159,9 @@ private:
   // \brief Map from variable to index
   using VarIndexMap = boost::container::flat_map< VariableRef, MatrixIndex >;
 
+  /// \brief Fixed-width encoding of bounds
+  using FixedWidthBoundT = octagon_impl::FixedWidthBound< Number >;
+
   using Parent = numeric::AbstractDomain< Number, VariableRef, Octagon >;
 
 private:
@@ -302,8 +368,27 @@ private:
     this->_norm_vector.resize(this->_var_index_map.size(), 0);
   }
 
+  /// \brief Mark the variable at the given index as modified
+  ///
+  /// The next closure will only use modified variables as pivots.
+  void set_modified(MatrixIndex k) {
+    if (this->_is_bottom) {
+      return;
+    }
+    this->_is_normalized = false;
+    this->_norm_vector[k - 1] = 0;
+  }
+
   /// \brief Compute the strong closure algorithm
   ///
+  /// The closure is incremental: if the matrix was closed before the
+  /// modification of a set of variables, only these variables are used as
+  /// pivots, followed by one strengthening step. This costs O(n^2) per
+  /// modified variable.
+  ///
+  /// The closure first runs on fixed-width integers if the bounds fit, and
+  /// falls back to `BoundT` otherwise.
+  ///
   /// TODO(marthaud): This is not thread-safe.
   void unsafe_normalize() const {
     if (this->_is_normalized) {
@@ -319,15 +404,39 @@ private:
 
     const MatrixIndex num_var = this->_matrix.size();
 
+    std::vector< MatrixIndex > pivots;
     for (MatrixIndex k = 1; k <= num_var; ++k) {
-      if (this->_norm_vector[k - 1]) {
-        continue;
+      if (!this->_norm_vector[k - 1]) {
+        pivots.push_back(k);
+      }
+    }
+
+    if (!pivots.empty() && !self->fixed_width_closure(pivots)) {
+      self->closure(pivots);
+    }
+
+    // Check for negative cycle
+    for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
+      if (this->_matrix(i, i) < BoundT(0)) {
+        self->_is_bottom = true;
+        self->_is_normalized = true;
+        return;
       }
+      self->_matrix(i, i) = BoundT(0);
+    }
+
+    self->set_normalized(true);
+  }
+
+  /// \brief Strong closure using `BoundT`
+  void closure(const std::vector< MatrixIndex >& pivots) {
+    const MatrixIndex num_var = this->_matrix.size();
 
+    for (MatrixIndex k : pivots) {
       for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
         for (MatrixIndex j = 1; j <= 2 * num_var; ++j) {
           // to ensure the "closed" property
-          self->_matrix(i, j) =
+          this->_matrix(i, j) =
               c(this->_matrix(i, j),
                 this->_matrix(i, 2 * k - 1) + this->_matrix(2 * k - 1, j),
                 this->_matrix(i, 2 * k) + this->_matrix(2 * k, j),
@@ -337,31 +446,98 @@ private:
                     this->_matrix(2 * k - 1, j));
         }
       }
+    }
 
-      // to ensure for all i,j: m_ij <= (m_i+i- + m_j-j+)/2
-      for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
-        for (MatrixIndex j = 1; j <= 2 * num_var; ++j) {
-          self->_matrix(i, j) = min(this->_matrix(i, j),
-                                    (this->_matrix(i, i + 2 * (i % 2) - 1) +
-                                     this->_matrix(j + 2 * (j % 2) - 1, j)) /
-                                        BoundT(2));
+    // to ensure for all i,j: m_ij <= (m_i+i- + m_j-j+)/2
+    for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
+      for (MatrixIndex j = 1; j <= 2 * num_var; ++j) {
+        this->_matrix(i, j) = min(this->_matrix(i, j),
+                                  (this->_matrix(i, i + 2 * (i % 2) - 1) +
+                                   this->_matrix(j + 2 * (j % 2) - 1, j)) /
+                                      BoundT(2));
+      }
+    }
+  }
+
+  /// \brief Strong closure using fixed-width integers
+  ///
+  /// The loops are written on contiguous columns so that the compiler can
+  /// vectorize them.
+  ///
+  /// Returns false if a bound cannot be encoded or if an intermediate result
+  /// is out of range, in which case the matrix is left unchanged.
+  bool fixed_width_closure(const std::vector< MatrixIndex >& pivots) {
+    const int64_t limit = octagon_impl::FixedWidthLimit;
+    const int64_t threshold = octagon_impl::FixedWidthInfinityThreshold;
+    const int64_t inf = octagon_impl::FixedWidthInfinity;
+    const std::size_t n = 2 * this->_matrix.size();
+
+    // Column-major matrix, m[n * j + i] is entry (i + 1, j + 1)
+    std::vector< int64_t > m(n * n);
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t i = 0; i < n; ++i) {
+        if (!FixedWidthBoundT::encode(this->_matrix(i + 1, j + 1),
+                                      m[n * j + i])) {
+          return false;
         }
       }
+    }
+    const std::vector< int64_t > init = m;
+
+    for (MatrixIndex k : pivots) {
+      const std::size_t a = 2 * k - 2;
+      const std::size_t b = 2 * k - 1;
+      const int64_t* col_a = &m[n * a];
+      const int64_t* col_b = &m[n * b];
+      bool out_of_range = false;
+
+      for (std::size_t j = 0; j < n; ++j) {
+        int64_t* col = &m[n * j];
+        const int64_t s_a = col[a];
+        const int64_t s_b = col[b];
+        const int64_t t_a = std::min(s_a, col_b[a] + s_b);
+        const int64_t t_b = std::min(s_b, col_a[b] + s_a);
+        int64_t out = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+          const int64_t r =
+              std::min(col[i], std::min(col_a[i] + t_a, col_b[i] + t_b));
+          col[i] = (r > threshold) ? inf : r;
+          out |= static_cast< int64_t >(col[i] < -limit) |
+                 (static_cast< int64_t >(col[i] > limit) &
+                  static_cast< int64_t >(col[i] != inf));
+        }
+        out_of_range = out_of_range || out != 0;
+      }
 
-      self->_norm_vector[k - 1] = 1;
+      if (out_of_range) {
+        return false;
+      }
     }
 
-    // Check for negative cycle
-    for (MatrixIndex i = 1; i <= 2 * num_var; ++i) {
-      if (this->_matrix(i, i) < BoundT(0)) {
-        self->_is_bottom = true;
-        self->_is_normalized = true;
-        return;
+    // to ensure for all i,j: m_ij <= (m_i+i- + m_j-j+)/2
+    std::vector< int64_t > unary(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      unary[i] = m[n * (i ^ 1) + i];
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+      int64_t* col = &m[n * j];
+      const int64_t s = col[j ^ 1];
+      for (std::size_t i = 0; i < n; ++i) {
+        int64_t t = unary[i] + s;
+        t = (t > threshold) ? 2 * inf : t;
+        col[i] = std::min(col[i], t / 2);
       }
-      self->_matrix(i, i) = BoundT(0);
     }
 
-    self->_is_normalized = true;
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t i = 0; i < n; ++i) {
+        if (m[n * j + i] != init[n * j + i]) {
+          this->_matrix(i + 1, j + 1) =
+              FixedWidthBoundT::decode(m[n * j + i]);
+        }
+      }
+    }
+    return true;
   }
 
 public:
@@ -1017,6 +1193,7 @@ private:
 
   void apply_constraint(MatrixIndex var, bool is_positive, BoundT constraint) {
     // Application of single variable octagonal constraints.
+    this->set_modified(var);
     constraint *= BoundT(2);
     if (is_positive) { // 2*v1 <= constraint
       this->_matrix(2 * var, 2 * var - 1) =
@@ -1038,6 +1215,8 @@ private:
                         bool is2_positive,
                         const BoundT& constraint) {
     // Application of double variable octagonal constraints.
+    this->set_modified(i);
+    this->set_modified(j);
     if (is1_positive && is2_positive) { // v1 + v2 <= constraint
       this->_matrix(2 * j, 2 * i - 1) =
           min(this->_matrix(2 * j, 2 * i - 1), constraint);
@@ -1126,8 +1305,6 @@ public:
 
       this->set(x, this->to_interval(e));
     }
-
-    this->set_normalized(false);
   }
 
 private:
@@ -1303,7 +1480,8 @@ private:
       }
     }
 
-    this->_norm_vector[i - 1] = 0;
+    this->set_modified(i);
+    this->set_modified(j);
     // Result is not normalized.
   }
 
@@ -0,0 +1,1622 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Sparse domain of Difference-Bound Matrices
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Based on Graeme Gange, Jorge A. Navas, Peter Schachte, Harald Sondergaard
+ * and Peter J. Stuckey's paper: Exploiting Sparsity in Difference-Bound
+ * Matrices, in SAS, 189-211, 2016.
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+
+#include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/linear_interval_solver.hpp>
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/support/assert.hpp>
+#include <ikos/core/value/numeric/congruence.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+#include <ikos/core/value/numeric/interval_congruence.hpp>
+
+namespace ikos {
+namespace core {
+namespace numeric {
+
+/// \brief Sparse Difference-Bound Matrices abstract domain
+///
+/// The difference constraints are stored as a graph in split normal form:
+/// the bounds of each variable are stored separately, and relations between
+/// variables are stored in adjacency lists. A relation `y - x <= c` implied by
+/// the bounds of x and y is not stored, which keeps the graph sparse.
+///
+/// The graph is kept closed after each operation, using an incremental
+/// closure. Only the widening and narrowing produce a graph that is not closed.
+///
+/// It has the same precision as numeric::DBM.
+template < typename Number,
+           typename VariableRef,
+           std::size_t MaxReductionCycles = 10 >
+class SparseDBM final
+    : public numeric::AbstractDomain<
+          Number,
+          VariableRef,
+          SparseDBM< Number, VariableRef, MaxReductionCycles > > {
+public:
+  using BoundT = Bound< Number >;
+  using IntervalT = Interval< Number >;
+  using CongruenceT = Congruence< Number >;
+  using IntervalCongruenceT = IntervalCongruence< Number >;
+  using VariableExprT = VariableExpression< Number, VariableRef >;
+  using LinearExpressionT = LinearExpression< Number, VariableRef >;
+  using LinearConstraintT = LinearConstraint< Number, VariableRef >;
+  using LinearConstraintSystemT = LinearConstraintSystem< Number, VariableRef >;
+
+private:
+  /// \brief Adjacency list, from variable to edge weight
+  using EdgeMap = boost::container::flat_map< VariableRef, Number >;
+
+  /// \brief Graph, from variable to adjacency list
+  using Graph = boost::container::flat_map< VariableRef, EdgeMap >;
+
+  /// \brief Bounds of a variable
+  struct VarBounds {
+    BoundT lb;
+    BoundT ub;
+  };
+
+  /// \brief Map from variable to bounds
+  using BoundsMap = boost::container::flat_map< VariableRef, VarBounds >;
+
+  /// \brief List of variables
+  using VariableVector = std::vector< VariableRef >;
+
+  /// \brief List of pairs of variables
+  using VariablePairVector =
+      std::vector< std::pair< VariableRef, VariableRef > >;
+
+  /// \brief Solver
+  using LinearIntervalSolverT =
+      LinearIntervalSolver< Number, VariableRef, SparseDBM >;
+
+  /// \brief Parent
+  using Parent = numeric::AbstractDomain< Number, VariableRef, SparseDBM >;
+
+private:
+  bool _is_bottom;
+
+  // True if the graph is closed
+  bool _is_normalized;
+
+  // Bounds of variables
+  //
+  // Variables without any finite bound are not in the map.
+  BoundsMap _bounds;
+
+  // Relations between variables: `_succs[x][y] = c` represents `y - x <= c`
+  Graph _succs;
+
+  // Reverse graph: `_preds[y][x] = c` represents `y - x <= c`
+  Graph _preds;
+
+private:
+  struct TopTag {};
+  struct BottomTag {};
+
+  /// \brief Create the top abstract value
+  explicit SparseDBM(TopTag) : _is_bottom(false), _is_normalized(true) {}
+
+  /// \brief Create the bottom abstract value
+  explicit SparseDBM(BottomTag) : _is_bottom(true), _is_normalized(true) {}
+
+public:
+  /// \brief Create the top abstract value
+  static SparseDBM top() { return SparseDBM(TopTag{}); }
+
+  /// \brief Create the bottom abstract value
+  static SparseDBM bottom() { return SparseDBM(BottomTag{}); }
+
+  /// \brief Copy constructor
+  SparseDBM(const SparseDBM&) = default;
+
+  /// \brief Move constructor
+  SparseDBM(SparseDBM&&) = default;
+
+  /// \brief Copy assignment operator
+  SparseDBM& operator=(const SparseDBM&) = default;
+
+  /// \brief Move assignment operator
+  SparseDBM& operator=(SparseDBM&&) = default;
+
+  /// \brief Destructor
+  ~SparseDBM() override = default;
+
+private:
+  /*
+   * Graph utils
+   */
+
+  /// \brief Return the lower bound of x
+  BoundT lb(VariableRef x) const {
+    auto it = this->_bounds.find(x);
+    if (it == this->_bounds.end()) {
+      return BoundT::minus_infinity();
+    } else {
+      return it->second.lb;
+    }
+  }
+
+  /// \brief Return the upper bound of x
+  BoundT ub(VariableRef x) const {
+    auto it = this->_bounds.find(x);
+    if (it == this->_bounds.end()) {
+      return BoundT::plus_infinity();
+    } else {
+      return it->second.ub;
+    }
+  }
+
+  /// \brief Set the bounds of x
+  void set_bounds(VariableRef x, BoundT lb, BoundT ub) {
+    if (lb.is_infinite() && ub.is_infinite()) {
+      this->_bounds.erase(x);
+      return;
+    }
+
+    auto it = this->_bounds.find(x);
+    if (it == this->_bounds.end()) {
+      this->_bounds.emplace(x, VarBounds{std::move(lb), std::move(ub)});
+    } else {
+      it->second.lb = std::move(lb);
+      it->second.ub = std::move(ub);
+    }
+  }
+
+  /// \brief Return the weight of the edge x -> y, i.e the bound on `y - x`
+  BoundT edge(VariableRef x, VariableRef y) const {
+    auto it = this->_succs.find(x);
+    if (it == this->_succs.end()) {
+      return BoundT::plus_infinity();
+    }
+    auto it2 = it->second.find(y);
+    if (it2 == it->second.end()) {
+      return BoundT::plus_infinity();
+    }
+    return BoundT(it2->second);
+  }
+
+  /// \brief Return the bound on `y - x` implied by the bounds of x and y
+  BoundT implied_edge(VariableRef x, VariableRef y) const {
+    return this->ub(y) - this->lb(x);
+  }
+
+  /// \brief Return the bound on `y - x` given by the edge x -> y and the
+  /// bounds of x and y
+  ///
+  /// This is the bound of the closed graph if the graph is closed.
+  BoundT closed_edge(VariableRef x, VariableRef y) const {
+    return min(this->edge(x, y), this->implied_edge(x, y));
+  }
+
+  /// \brief Set the weight of the edge x -> y
+  void set_edge(VariableRef x, VariableRef y, const Number& c) {
+    auto res = this->_succs[x].emplace(y, c);
+    if (!res.second) {
+      res.first->second = c;
+    }
+    res = this->_preds[y].emplace(x, c);
+    if (!res.second) {
+      res.first->second = c;
+    }
+  }
+
+  /// \brief Remove all the edges from and to x
+  void remove_edges(VariableRef x) {
+    auto it = this->_succs.find(x);
+    if (it != this->_succs.end()) {
+      for (const auto& e : it->second) {
+        auto pred = this->_preds.find(e.first);
+        pred->second.erase(x);
+        if (pred->second.empty()) {
+          this->_preds.erase(pred);
+        }
+      }
+      this->_succs.erase(it);
+    }
+
+    it = this->_preds.find(x);
+    if (it != this->_preds.end()) {
+      for (const auto& e : it->second) {
+        auto succ = this->_succs.find(e.first);
+        succ->second.erase(x);
+        if (succ->second.empty()) {
+          this->_succs.erase(succ);
+        }
+      }
+      this->_preds.erase(it);
+    }
+  }
+
+  /// \brief Return a copy of the successors of x
+  std::vector< std::pair< VariableRef, Number > > successors(
+      VariableRef x) const {
+    auto it = this->_succs.find(x);
+    if (it == this->_succs.end()) {
+      return {};
+    } else {
+      return {it->second.begin(), it->second.end()};
+    }
+  }
+
+  /// \brief Return a copy of the predecessors of x
+  std::vector< std::pair< VariableRef, Number > > predecessors(
+      VariableRef x) const {
+    auto it = this->_preds.find(x);
+    if (it == this->_preds.end()) {
+      return {};
+    } else {
+      return {it->second.begin(), it->second.end()};
+    }
+  }
+
+  /*
+   * Incremental closure
+   *
+   * These methods require a closed graph and keep it closed. They return false
+   * if the result is bottom, in which case the graph is left in an
+   * inconsistent state and should be set to bottom by the caller.
+   */
+
+  /// \brief Refine the upper bound of x, without propagation
+  bool tighten_ub(VariableRef x, const BoundT& c) {
+    BoundT x_ub = this->ub(x);
+    if (c >= x_ub) {
+      return true;
+    }
+    BoundT x_lb = this->lb(x);
+    if (c < x_lb) {
+      return false;
+    }
+    this->set_bounds(x, std::move(x_lb), c);
+    return true;
+  }
+
+  /// \brief Refine the lower bound of x, without propagation
+  bool tighten_lb(VariableRef x, const BoundT& c) {
+    BoundT x_lb = this->lb(x);
+    if (c <= x_lb) {
+      return true;
+    }
+    BoundT x_ub = this->ub(x);
+    if (c > x_ub) {
+      return false;
+    }
+    this->set_bounds(x, c, std::move(x_ub));
+    return true;
+  }
+
+  /// \brief Add `x <= c`
+  bool close_ub(VariableRef x, const BoundT& c) {
+    if (c >= this->ub(x)) {
+      return true;
+    }
+    if (!this->tighten_ub(x, c)) {
+      return false;
+    }
+
+    // For all y such that y - x <= w, y <= c + w
+    auto it = this->_succs.find(x);
+    if (it != this->_succs.end()) {
+      for (const auto& e : it->second) {
+        if (!this->tighten_ub(e.first, c + BoundT(e.second))) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// \brief Add `x >= c`
+  bool close_lb(VariableRef x, const BoundT& c) {
+    if (c <= this->lb(x)) {
+      return true;
+    }
+    if (!this->tighten_lb(x, c)) {
+      return false;
+    }
+
+    // For all y such that x - y <= w, y >= c - w
+    auto it = this->_preds.find(x);
+    if (it != this->_preds.end()) {
+      for (const auto& e : it->second) {
+        if (!this->tighten_lb(e.first, c - BoundT(e.second))) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// \brief Add `y - x <= c`, with x != y
+  bool close_edge(VariableRef x, VariableRef y, const Number& c) {
+    ikos_assert(!(x == y));
+    BoundT w(c);
+
+    if (w >= this->closed_edge(x, y)) {
+      return true; // redundant
+    }
+    if (w + this->closed_edge(y, x) < BoundT(0)) {
+      return false; // negative cycle
+    }
+
+    // New shortest paths are p -> x -> y -> s
+    auto srcs = this->predecessors(x);
+    srcs.emplace_back(x, Number(0));
+    auto dsts = this->successors(y);
+    dsts.emplace_back(y, Number(0));
+
+    // Paths going through the bounds of x and y
+    BoundT x_ub = this->ub(x);
+    if (x_ub.is_finite()) {
+      for (const auto& s : dsts) {
+        if (!this->tighten_ub(s.first, x_ub + w + BoundT(s.second))) {
+          return false;
+        }
+      }
+    }
+    BoundT y_lb = this->lb(y);
+    if (y_lb.is_finite()) {
+      for (const auto& p : srcs) {
+        if (!this->tighten_lb(p.first, y_lb - w - BoundT(p.second))) {
+          return false;
+        }
+      }
+    }
+
+    // Paths between variables
+    for (const auto& p : srcs) {
+      for (const auto& s : dsts) {
+        if (p.first == s.first) {
+          continue;
+        }
+        Number v = p.second + c + s.second;
+        if (BoundT(v) < this->closed_edge(p.first, s.first)) {
+          this->set_edge(p.first, s.first, v);
+        }
+      }
+    }
+    return true;
+  }
+
+  /// \brief Apply x = y + c, with x != y
+  ///
+  /// Precondition: the graph is closed and x is unconstrained
+  void close_assign(VariableRef x, VariableRef y, const Number& c) {
+    ikos_assert(!(x == y));
+    BoundT k(c);
+    this->set_bounds(x, this->lb(y) + k, this->ub(y) + k);
+
+    for (const auto& s : this->successors(y)) {
+      if (!(s.first == x) &&
+          BoundT(s.second) - k < this->implied_edge(x, s.first)) {
+        this->set_edge(x, s.first, s.second - c);
+      }
+    }
+    for (const auto& p : this->predecessors(y)) {
+      if (!(p.first == x) &&
+          BoundT(p.second) + k < this->implied_edge(p.first, x)) {
+        this->set_edge(p.first, x, p.second + c);
+      }
+    }
+
+    if (-k < this->implied_edge(x, y)) {
+      this->set_edge(x, y, -c);
+    }
+    if (k < this->implied_edge(y, x)) {
+      this->set_edge(y, x, c);
+    }
+  }
+
+  /// \brief Forget all informations about x
+  ///
+  /// Precondition: the graph is closed
+  void close_forget(VariableRef x) {
+    this->remove_edges(x);
+    this->_bounds.erase(x);
+  }
+
+public:
+  void normalize() override {
+    if (this->_is_normalized) {
+      return;
+    }
+
+    if (this->_is_bottom) {
+      this->set_to_bottom();
+      return;
+    }
+
+    // Rebuild the graph with the incremental closure
+    SparseDBM closed = SparseDBM::top();
+    for (const auto& b : this->_bounds) {
+      if (!closed.close_ub(b.first, b.second.ub) ||
+          !closed.close_lb(b.first, b.second.lb)) {
+        this->set_to_bottom();
+        return;
+      }
+    }
+    for (const auto& x : this->_succs) {
+      for (const auto& e : x.second) {
+        if (!closed.close_edge(x.first, e.first, e.second)) {
+          this->set_to_bottom();
+          return;
+        }
+      }
+    }
+    this->operator=(std::move(closed));
+  }
+
+  bool is_bottom() const override {
+    if (this->_is_normalized) {
+      return this->_is_bottom;
+    } else if (this->_is_bottom) {
+      return true;
+    } else {
+      return this->normalize_copy()._is_bottom;
+    }
+  }
+
+  bool is_top() const override {
+    return !this->_is_bottom && this->_bounds.empty() && this->_succs.empty();
+  }
+
+  void set_to_bottom() override {
+    this->_is_bottom = true;
+    this->_is_normalized = true;
+    this->_bounds.clear();
+    this->_succs.clear();
+    this->_preds.clear();
+  }
+
+  void set_to_top() override {
+    this->_is_bottom = false;
+    this->_is_normalized = true;
+    this->_bounds.clear();
+    this->_succs.clear();
+    this->_preds.clear();
+  }
+
+private:
+  /// \brief Return a normalized copy
+  SparseDBM normalize_copy() const {
+    SparseDBM tmp = *this;
+    tmp.normalize();
+    return tmp;
+  }
+
+public:
+  bool leq(const SparseDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().leq(other);
+    }
+    if (!other._is_normalized) {
+      return this->leq(other.normalize_copy());
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      return true;
+    } else if (other._is_bottom) {
+      return false;
+    }
+
+    // Relations implied by the bounds of `other` are implied by the bounds
+    // of `this`, so we only need to check the bounds and the edges.
+    for (const auto& b : other._bounds) {
+      if (!(this->ub(b.first) <= b.second.ub) ||
+          !(this->lb(b.first) >= b.second.lb)) {
+        return false;
+      }
+    }
+
+    for (const auto& x : other._succs) {
+      for (const auto& e : x.second) {
+        if (!(this->closed_edge(x.first, e.first) <= BoundT(e.second))) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool equals(const SparseDBM& other) const override {
+    return this->leq(other) && other.leq(*this);
+  }
+
+private:
+  /// \brief Add the pairs of variables with an edge in the given list
+  void collect_edges(VariablePairVector& pairs) const {
+    for (const auto& x : this->_succs) {
+      for (const auto& e : x.second) {
+        pairs.emplace_back(x.first, e.first);
+      }
+    }
+  }
+
+  /// \brief Add the pairs of variables (x, y) with a finite bound on `y - x`
+  /// in the given list
+  void collect_entries(VariablePairVector& pairs) const {
+    this->collect_edges(pairs);
+
+    // Relations implied by the bounds
+    VariableVector lbs;
+    VariableVector ubs;
+    for (const auto& b : this->_bounds) {
+      if (b.second.lb.is_finite()) {
+        lbs.push_back(b.first);
+      }
+      if (b.second.ub.is_finite()) {
+        ubs.push_back(b.first);
+      }
+    }
+    for (VariableRef x : lbs) {
+      for (VariableRef y : ubs) {
+        if (!(x == y)) {
+          pairs.emplace_back(x, y);
+        }
+      }
+    }
+  }
+
+  /// \brief Add the pairs of variables (x, y) that are implied by the bounds
+  /// in both `this` and `other`, and might be tighter in the join than the
+  /// implied relation of the join
+  ///
+  /// The join of two implied relations is implied by the joined bounds,
+  /// unless the lower bound of x and the upper bound of y are taken from
+  /// different sides.
+  void collect_join_pairs(const SparseDBM& other,
+                          VariablePairVector& pairs) const {
+    VariableVector lbs_this; // lb(x) comes from `this`
+    VariableVector lbs_other;
+    VariableVector ubs_this; // ub(y) comes from `this`
+    VariableVector ubs_other;
+
+    for (auto l = this->_bounds.begin(), r = other._bounds.begin();
+         l != this->_bounds.end() && r != other._bounds.end();) {
+      if (l->first < r->first) {
+        ++l;
+      } else if (r->first < l->first) {
+        ++r;
+      } else {
+        if (l->second.lb < r->second.lb) {
+          lbs_this.push_back(l->first);
+        } else if (r->second.lb < l->second.lb) {
+          lbs_other.push_back(l->first);
+        }
+        if (l->second.ub > r->second.ub) {
+          ubs_this.push_back(l->first);
+        } else if (r->second.ub > l->second.ub) {
+          ubs_other.push_back(l->first);
+        }
+        ++l;
+        ++r;
+      }
+    }
+
+    for (VariableRef x : lbs_this) {
+      for (VariableRef y : ubs_other) {
+        if (!(x == y)) {
+          pairs.emplace_back(x, y);
+        }
+      }
+    }
+    for (VariableRef x : lbs_other) {
+      for (VariableRef y : ubs_this) {
+        if (!(x == y)) {
+          pairs.emplace_back(x, y);
+        }
+      }
+    }
+  }
+
+  /// \brief Add the pairs of variables (x, y) with a relation implied by the
+  /// bounds in `this`, where the lower bound of x or the upper bound of y is
+  /// not stable in `dbm`
+  ///
+  /// Other implied relations are still implied by the bounds of `dbm`.
+  void collect_unstable_pairs(const SparseDBM& dbm,
+                              VariablePairVector& pairs) const {
+    VariableVector lbs;
+    VariableVector ubs;
+    VariableVector unstable_lbs;
+    VariableVector unstable_ubs;
+    for (const auto& b : this->_bounds) {
+      if (b.second.lb.is_finite()) {
+        lbs.push_back(b.first);
+        if (!(dbm.lb(b.first) == b.second.lb)) {
+          unstable_lbs.push_back(b.first);
+        }
+      }
+      if (b.second.ub.is_finite()) {
+        ubs.push_back(b.first);
+        if (!(dbm.ub(b.first) == b.second.ub)) {
+          unstable_ubs.push_back(b.first);
+        }
+      }
+    }
+    for (VariableRef x : unstable_lbs) {
+      for (VariableRef y : ubs) {
+        if (!(x == y)) {
+          pairs.emplace_back(x, y);
+        }
+      }
+    }
+    for (VariableRef x : lbs) {
+      for (VariableRef y : unstable_ubs) {
+        if (!(x == y)) {
+          pairs.emplace_back(x, y);
+        }
+      }
+    }
+  }
+
+  /// \brief Return true if the variable is constrained
+  bool is_constrained(VariableRef x) const {
+    return this->_bounds.find(x) != this->_bounds.end() ||
+           this->_succs.find(x) != this->_succs.end() ||
+           this->_preds.find(x) != this->_preds.end();
+  }
+
+  /// \brief Apply a pointwise binary operator
+  ///
+  /// The operator is applied on the bound of `y - x` for all pairs (x, y),
+  /// as for a dense matrix. With a meet semantic, a bound on unconstrained
+  /// variables in one operand is taken from the other operand, as in
+  /// numeric::DBM.
+  ///
+  /// Relations implied by the bounds of the result are not stored.
+  template < typename BinaryOperator >
+  SparseDBM pointwise_binary_op(const SparseDBM& other,
+                                const BinaryOperator& op) const {
+    // Result dbm
+    auto dbm = SparseDBM::top();
+
+    auto apply = [&op](bool in_left,
+                       bool in_right,
+                       const BoundT& left,
+                       const BoundT& right) -> BoundT {
+      if (!op.meet_semantic() || (in_left && in_right)) {
+        return op(left, right);
+      } else if (in_left) {
+        return left;
+      } else if (in_right) {
+        return right;
+      } else {
+        return BoundT::plus_infinity();
+      }
+    };
+
+    // Bounds
+    VariableVector vars;
+    vars.reserve(this->_bounds.size() + other._bounds.size());
+    for (const auto& b : this->_bounds) {
+      vars.push_back(b.first);
+    }
+    for (const auto& b : other._bounds) {
+      vars.push_back(b.first);
+    }
+    std::sort(vars.begin(), vars.end());
+    vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+
+    for (VariableRef x : vars) {
+      bool in_this = this->is_constrained(x);
+      bool in_other = other.is_constrained(x);
+      BoundT ub = apply(in_this, in_other, this->ub(x), other.ub(x));
+      BoundT neg_lb = apply(in_this, in_other, -this->lb(x), -other.lb(x));
+      dbm.set_bounds(x, -neg_lb, std::move(ub));
+    }
+
+    // Relations
+    VariablePairVector pairs;
+    if (op.closed()) {
+      this->collect_edges(pairs);
+      other.collect_edges(pairs);
+      this->collect_join_pairs(other, pairs);
+    } else if (op.meet_semantic()) {
+      this->collect_entries(pairs);
+      other.collect_entries(pairs);
+    } else {
+      this->collect_edges(pairs);
+      this->collect_unstable_pairs(dbm, pairs);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    for (const auto& p : pairs) {
+      BoundT w = apply(this->is_constrained(p.first) &&
+                           this->is_constrained(p.second),
+                       other.is_constrained(p.first) &&
+                           other.is_constrained(p.second),
+                       this->closed_edge(p.first, p.second),
+                       other.closed_edge(p.first, p.second));
+      if (!(w < dbm.implied_edge(p.first, p.second))) {
+        continue; // redundant
+      }
+      dbm.set_edge(p.first, p.second, *w.number());
+    }
+
+    dbm._is_normalized = op.closed();
+    return dbm;
+  }
+
+  struct JoinOperator {
+    bool meet_semantic() const { return false; }
+
+    // The join of closed graphs is closed
+    bool closed() const { return true; }
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      return max(x, y);
+    }
+  };
+
+  struct WideningOperator {
+    bool meet_semantic() const { return false; }
+
+    bool closed() const { return false; }
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (y <= x) {
+        return x;
+      } else {
+        return BoundT::plus_infinity();
+      }
+    }
+  };
+
+  struct WideningThresholdOperator {
+    BoundT threshold;
+
+    explicit WideningThresholdOperator(const Number& threshold_)
+        : threshold(threshold_) {}
+
+    bool meet_semantic() const { return false; }
+
+    bool closed() const { return false; }
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (y <= x) {
+        return x;
+      } else if (threshold >= y) {
+        return threshold;
+      } else {
+        return BoundT::plus_infinity();
+      }
+    }
+  };
+
+  struct NarrowingOperator {
+    bool meet_semantic() const { return true; }
+
+    bool closed() const { return false; }
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (x.is_plus_infinity()) {
+        return y;
+      } else {
+        return x;
+      }
+    }
+  };
+
+  struct NarrowingThresholdOperator {
+    BoundT threshold;
+
+    explicit NarrowingThresholdOperator(const Number& threshold_)
+        : threshold(threshold_) {}
+
+    bool meet_semantic() const { return true; }
+
+    bool closed() const { return false; }
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (x.is_plus_infinity() || x == threshold) {
+        return y;
+      } else {
+        return x;
+      }
+    }
+  };
+
+public:
+  void join_with(SparseDBM&& other) override {
+    // Requires normalization
+    this->normalize();
+    other.normalize();
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      this->operator=(std::move(other));
+    } else if (other._is_bottom) {
+      return;
+    } else {
+      this->operator=(this->pointwise_binary_op(other, JoinOperator{}));
+    }
+  }
+
+  void join_with(const SparseDBM& other) override {
+    // Requires normalization
+    this->normalize();
+    if (!other._is_normalized) {
+      this->join_with(other.normalize_copy());
+      return;
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      this->operator=(other);
+    } else if (other._is_bottom) {
+      return;
+    } else {
+      this->operator=(this->pointwise_binary_op(other, JoinOperator{}));
+    }
+  }
+
+  SparseDBM join(const SparseDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().join(other);
+    } else if (!other._is_normalized) {
+      return this->join(other.normalize_copy());
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->pointwise_binary_op(other, JoinOperator{});
+    }
+  }
+
+  void widen_with(const SparseDBM& other) override {
+    this->operator=(this->widening(other));
+  }
+
+  SparseDBM widening(const SparseDBM& other) const override {
+    // Requires the normalization of the right hand side.
+    // The left hand side should not be normalized.
+    if (!other._is_normalized) {
+      return this->widening(other.normalize_copy());
+    }
+
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->pointwise_binary_op(other, WideningOperator{});
+    }
+  }
+
+  SparseDBM widening_threshold(const SparseDBM& other,
+                               const Number& threshold) const override {
+    // Requires the normalization of the right hand side.
+    // The left hand side should not be normalized.
+    if (!other._is_normalized) {
+      return this->widening_threshold(other.normalize_copy(), threshold);
+    }
+
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->pointwise_binary_op(other,
+                                       WideningThresholdOperator{threshold});
+    }
+  }
+
+  void widen_threshold_with(const SparseDBM& other,
+                            const Number& threshold) override {
+    this->operator=(this->widening_threshold(other, threshold));
+  }
+
+  SparseDBM meet(const SparseDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().meet(other);
+    } else if (!other._is_normalized) {
+      return this->meet(other.normalize_copy());
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    }
+
+    // Add the constraints of `other` in `this`. Relations implied by the
+    // bounds of `other` are implied by the bounds of the result.
+    SparseDBM dbm = *this;
+    for (const auto& b : other._bounds) {
+      if (!dbm.close_ub(b.first, b.second.ub) ||
+          !dbm.close_lb(b.first, b.second.lb)) {
+        return bottom();
+      }
+    }
+    for (const auto& x : other._succs) {
+      for (const auto& e : x.second) {
+        if (!dbm.close_edge(x.first, e.first, e.second)) {
+          return bottom();
+        }
+      }
+    }
+    return dbm;
+  }
+
+  void meet_with(const SparseDBM& other) override {
+    this->operator=(this->meet(other));
+  }
+
+  SparseDBM narrowing(const SparseDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().narrowing(other);
+    } else if (!other._is_normalized) {
+      return this->narrowing(other.normalize_copy());
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      return this->pointwise_binary_op(other, NarrowingOperator{});
+    }
+  }
+
+  void narrow_with(const SparseDBM& other) override {
+    this->operator=(this->narrowing(other));
+  }
+
+  SparseDBM narrowing_threshold(const SparseDBM& other,
+                                const Number& threshold) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().narrowing_threshold(other, threshold);
+    } else if (!other._is_normalized) {
+      return this->narrowing_threshold(other.normalize_copy(), threshold);
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      return this->pointwise_binary_op(other,
+                                       NarrowingThresholdOperator{threshold});
+    }
+  }
+
+  void narrow_threshold_with(const SparseDBM& other,
+                             const Number& threshold) override {
+    this->operator=(this->narrowing_threshold(other, threshold));
+  }
+
+private:
+  /// \brief Add constraint `y - x <= c`
+  void add_constraint(VariableRef x, VariableRef y, const Number& c) {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (x == y) {
+      if (c < 0) {
+        this->set_to_bottom();
+      }
+      return;
+    }
+
+    if (!this->close_edge(x, y, c)) {
+      this->set_to_bottom();
+    }
+  }
+
+  /// \brief Add constraints `lb <= x <= ub`
+  void add_bounds(VariableRef x, const BoundT& lb, const BoundT& ub) {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (!this->close_ub(x, ub) || !this->close_lb(x, lb)) {
+      this->set_to_bottom();
+    }
+  }
+
+  /// \brief Apply x = y + c
+  void assign_add(VariableRef x, VariableRef y, const Number& c) {
+    if (x == y) {
+      this->increment(x, c);
+      return;
+    }
+
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->close_forget(x);
+    this->close_assign(x, y, c);
+  }
+
+  /// \brief Apply x = x + c
+  void increment(VariableRef x, const Number& c) {
+    if (c == 0) {
+      return;
+    }
+
+    BoundT k(c);
+    auto b = this->_bounds.find(x);
+    if (b != this->_bounds.end()) {
+      b->second.lb += k;
+      b->second.ub += k;
+    }
+
+    auto it = this->_succs.find(x);
+    if (it != this->_succs.end()) {
+      for (auto& e : it->second) {
+        e.second -= c;
+        this->_preds.find(e.first)->second.find(x)->second -= c;
+      }
+    }
+
+    it = this->_preds.find(x);
+    if (it != this->_preds.end()) {
+      for (auto& e : it->second) {
+        e.second += c;
+        this->_succs.find(e.first)->second.find(x)->second += c;
+      }
+    }
+  }
+
+public:
+  void assign(VariableRef x, int n) override { this->assign(x, Number(n)); }
+
+  void assign(VariableRef x, const Number& n) override {
+    this->set(x, IntervalT(n));
+  }
+
+  void assign(VariableRef x, VariableRef y) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->assign_add(x, y, Number(0));
+  }
+
+  void assign(VariableRef x, const LinearExpressionT& e) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (e.is_constant()) { // x = c
+      this->set(x, IntervalT(e.constant()));
+      return;
+    }
+
+    if (e.num_terms() == 1 && e.begin()->second == 1) { // x = y + c
+      this->assign_add(x, e.begin()->first, e.constant());
+      return;
+    }
+
+    // Projection using intervals, requires normalization
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->set(x, this->to_interval(e));
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             VariableRef z) override {
+    // Requires normalization
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    IntervalT v_y = this->to_interval(y);
+    IntervalT v_z = this->to_interval(z);
+
+    if (v_z.singleton()) {
+      this->apply(op, x, y, *v_z.singleton());
+    } else if (v_y.singleton()) {
+      this->apply(op, x, *v_y.singleton(), z);
+    } else {
+      this->set(x, apply_bin_operator(op, v_y, v_z));
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const Number& z) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        this->assign_add(x, y, z);
+      } break;
+      case BinaryOperator::Sub: {
+        this->assign_add(x, y, -z);
+      } break;
+      case BinaryOperator::Mul: {
+        if (z == 1) { // x = y
+          this->assign_add(x, y, Number(0));
+        } else {
+          // Requires normalization
+          this->normalize();
+
+          if (this->_is_bottom) {
+            return;
+          }
+
+          this->set(x, this->to_interval(y) * IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Div: {
+        if (z == 1) { // x = y
+          this->assign_add(x, y, Number(0));
+        } else {
+          // Requires normalization
+          this->normalize();
+
+          if (this->_is_bottom) {
+            return;
+          }
+
+          this->set(x, this->to_interval(y) / IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Mod: {
+        if (z == 0) {
+          this->set_to_bottom();
+          return;
+        }
+
+        // Requires normalization
+        this->normalize();
+
+        if (this->_is_bottom) {
+          return;
+        }
+
+        IntervalT v_y = this->to_interval(y);
+        boost::optional< Number > n = v_y.mod_to_sub(z);
+
+        if (n) {
+          // Equivalent to x = y - n
+          this->assign_add(x, y, -(*n));
+        } else {
+          this->set(x, IntervalT(BoundT(0), BoundT(abs(z) - 1)));
+
+          // If y < abs(z) then x >= y
+          if (v_y.ub() < BoundT(abs(z))) {
+            this->add_constraint(x, y, Number(0));
+          }
+
+          // If y >= -abs(z) then x <= y + abs(z)
+          if (v_y.lb() >= BoundT(-abs(z))) {
+            this->add_constraint(y, x, abs(z));
+          }
+        }
+      } break;
+      case BinaryOperator::Rem:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        // Requires normalization
+        this->normalize();
+
+        if (this->_is_bottom) {
+          return;
+        }
+
+        this->set(x,
+                  apply_bin_operator(op, this->to_interval(y), IntervalT(z)));
+      } break;
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             const Number& y,
+             VariableRef z) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        this->assign_add(x, z, y);
+      } break;
+      case BinaryOperator::Sub: {
+        // Requires normalization
+        this->normalize();
+
+        if (this->_is_bottom) {
+          return;
+        }
+
+        this->set(x, IntervalT(y) - this->to_interval(z));
+      } break;
+      case BinaryOperator::Mul: {
+        if (y == 1) { // x = z
+          this->assign_add(x, z, Number(0));
+        } else {
+          // Requires normalization
+          this->normalize();
+
+          if (this->_is_bottom) {
+            return;
+          }
+
+          this->set(x, IntervalT(y) * this->to_interval(z));
+        }
+      } break;
+      case BinaryOperator::Div:
+      case BinaryOperator::Rem:
+      case BinaryOperator::Mod:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        // Requires normalization
+        this->normalize();
+
+        if (this->_is_bottom) {
+          return;
+        }
+
+        this->set(x,
+                  apply_bin_operator(op, IntervalT(y), this->to_interval(z)));
+      } break;
+    }
+  }
+
+private:
+  /// \brief Add a difference constraint `sum(terms) <= c` or `= c`
+  ///
+  /// Returns false if the constraint is not a difference constraint
+  bool add_difference_constraint(const LinearConstraintT& cst) {
+    auto it = cst.begin();
+    auto it2 = ++cst.begin();
+    const Number& c = cst.constant();
+
+    if (cst.num_terms() == 1 && it->second == 1) {
+      // x <= c
+      if (cst.is_equality()) {
+        this->add_bounds(it->first, BoundT(c), BoundT(c));
+      } else {
+        this->add_bounds(it->first, BoundT::minus_infinity(), BoundT(c));
+      }
+    } else if (cst.num_terms() == 1 && it->second == -1) {
+      // -x <= c
+      if (cst.is_equality()) {
+        this->add_bounds(it->first, BoundT(-c), BoundT(-c));
+      } else {
+        this->add_bounds(it->first, BoundT(-c), BoundT::plus_infinity());
+      }
+    } else if (cst.num_terms() == 2 && it->second == 1 && it2->second == -1) {
+      // x - y <= c
+      this->add_constraint(it2->first, it->first, c);
+      if (cst.is_equality()) {
+        this->add_constraint(it->first, it2->first, -c);
+      }
+    } else if (cst.num_terms() == 2 && it->second == -1 && it2->second == 1) {
+      // y - x <= c
+      this->add_constraint(it->first, it2->first, c);
+      if (cst.is_equality()) {
+        this->add_constraint(it2->first, it->first, -c);
+      }
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+public:
+  void add(const LinearConstraintT& cst) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (cst.num_terms() == 0) {
+      if (cst.is_contradiction()) {
+        this->set_to_bottom();
+      }
+      return;
+    }
+
+    if ((cst.is_inequality() || cst.is_equality()) &&
+        this->add_difference_constraint(cst)) {
+      return;
+    }
+
+    // Use the linear interval solver
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    LinearIntervalSolverT solver(MaxReductionCycles);
+    solver.add(cst);
+    solver.run(*this);
+  }
+
+  void add(const LinearConstraintSystemT& csts) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    LinearIntervalSolverT solver(MaxReductionCycles);
+
+    for (const LinearConstraintT& cst : csts) {
+      if (cst.num_terms() == 0) {
+        if (cst.is_contradiction()) {
+          this->set_to_bottom();
+          return;
+        }
+      } else if (!(cst.is_inequality() || cst.is_equality()) ||
+                 !this->add_difference_constraint(cst)) {
+        solver.add(cst);
+      }
+
+      if (this->_is_bottom) {
+        return;
+      }
+    }
+
+    if (!solver.empty()) {
+      // Use the linear interval solver
+      this->normalize();
+
+      if (this->_is_bottom) {
+        return;
+      }
+
+      solver.run(*this);
+    }
+  }
+
+  void set(VariableRef x, const IntervalT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->normalize();
+
+      if (this->_is_bottom) {
+        return;
+      }
+
+      this->close_forget(x);
+      this->set_bounds(x, value.lb(), value.ub());
+    }
+  }
+
+  void set(VariableRef x, const CongruenceT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      boost::optional< Number > n = value.singleton();
+      if (n) {
+        this->set(x, IntervalT(*n));
+      } else {
+        this->forget(x);
+      }
+    }
+  }
+
+  void set(VariableRef x, const IntervalCongruenceT& value) override {
+    this->set(x, value.interval());
+  }
+
+  void refine(VariableRef x, const IntervalT& value) override {
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->add_bounds(x, value.lb(), value.ub());
+    }
+  }
+
+  void refine(VariableRef x, const CongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x), value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void refine(VariableRef x, const IntervalCongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x));
+      iv.meet_with(value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void forget(VariableRef x) override {
+    if (this->_is_bottom) {
+      return;
+    }
+
+    // Requires normalization, to keep the relations going through x
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->close_forget(x);
+  }
+
+  IntervalT to_interval(VariableRef x) const override {
+    if (this->_is_bottom) {
+      return IntervalT::bottom();
+    } else {
+      return IntervalT(this->lb(x), this->ub(x));
+    }
+  }
+
+  IntervalT to_interval(const LinearExpressionT& e) const override {
+    return Parent::to_interval(e);
+  }
+
+  CongruenceT to_congruence(VariableRef x) const override {
+    if (this->_is_bottom) {
+      return CongruenceT::bottom();
+    } else {
+      boost::optional< Number > n = this->to_interval(x).singleton();
+      if (n) {
+        return CongruenceT(*n);
+      } else {
+        return CongruenceT::top();
+      }
+    }
+  }
+
+  CongruenceT to_congruence(const LinearExpressionT& e) const override {
+    return Parent::to_congruence(e);
+  }
+
+  IntervalCongruenceT to_interval_congruence(VariableRef x) const override {
+    return IntervalCongruenceT(this->to_interval(x));
+  }
+
+  IntervalCongruenceT to_interval_congruence(
+      const LinearExpressionT& e) const override {
+    return Parent::to_interval_congruence(e);
+  }
+
+  LinearConstraintSystemT to_linear_constraint_system() const override {
+    if (this->_is_bottom) {
+      return LinearConstraintSystemT(LinearConstraintT::contradiction());
+    }
+
+    LinearConstraintSystemT csts;
+    for (const auto& b : this->_bounds) {
+      csts.add(within_interval(b.first, IntervalT(b.second.lb, b.second.ub)));
+    }
+    for (const auto& x : this->_succs) {
+      for (const auto& e : x.second) {
+        csts.add(within_interval(VariableExprT(e.first) -
+                                     VariableExprT(x.first),
+                                 IntervalT(BoundT::minus_infinity(),
+                                           BoundT(e.second))));
+      }
+    }
+    return csts;
+  }
+
+  void dump(std::ostream& o) const override {
+    this->to_linear_constraint_system().dump(o);
+  }
+
+  static std::string name() { return "sparse-dbm"; }
+
+}; // end class SparseDBM
+
+} // end namespace numeric
+} // end namespace core
+} // end namespace ikos
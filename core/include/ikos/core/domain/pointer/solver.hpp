@@ -55,11 +55,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <iosfwd>
 #include <memory>
+#include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/memory_location.hpp>
@@ -376,6 +382,13 @@ public:
 }; // end class LoadConstraint
 
 /// \brief System of pointer constraints
+///
+/// The system is solved with a worklist: each constraint is indexed by the
+/// pointer variables and memory locations it reads, and it is only processed
+/// again when one of them changes. Stores and loads propagate differences:
+/// a constraint only handles the memory locations and operand values it has
+/// not seen yet. Pointer variables in a cycle of copy constraints `p = q + 0`
+/// are collapsed into a single representative before solving.
 template < typename VariableRef, typename MemoryLocationRef >
 class ConstraintSystem {
 public:
@@ -417,6 +430,21 @@ private:
   using MemoryMap = std::
       unordered_map< MemoryLocationRef, PointerAbsValueT, MemoryLocationHash >;
 
+  /// \brief Solver state of a constraint, for the difference propagation
+  struct ConstraintState {
+    // True if the constraint is in the worklist
+    bool queued = false;
+
+    // Memory locations already handled by a store or a load
+    PointsToSetT seen = PointsToSetT::empty();
+
+    // Memory locations updated since the last visit of a load
+    std::vector< MemoryLocationRef > pending;
+
+    // Last operand value written by a store
+    boost::optional< PointerAbsValueT > operand;
+  };
+
 public:
   using PointerIterator = typename PointerMap::const_iterator;
   using MemoryIterator = typename MemoryMap::const_iterator;
@@ -439,11 +467,42 @@ private:
   // Signedness of pointer offsets (usually Unsigned)
   Signedness _offsets_sign;
 
-  // Number of iterations
-  std::size_t _iteration = 0;
+  // Representative of pointer variables collapsed in a cycle of copies
+  //
+  // Variables that are not part of a cycle are not in the map.
+  std::unordered_map< VariableRef, VariableRef, VariableHash > _rep;
+
+  // Map from pointer variables to the indexes of constraints reading them
+  std::unordered_map< VariableRef, std::vector< std::size_t >, VariableHash >
+      _var_users;
+
+  // Map from memory locations to the indexes of loads reading them
+  std::unordered_map< MemoryLocationRef,
+                      std::vector< std::size_t >,
+                      MemoryLocationHash >
+      _mem_users;
+
+  // Number of updates of each pointer variable, for the widening
+  std::unordered_map< VariableRef, std::size_t, VariableHash > _pointer_updates;
 
-  // Change seen during iteration
-  bool _change_seen = false;
+  // Number of updates of each memory location, for the widening
+  std::unordered_map< MemoryLocationRef, std::size_t, MemoryLocationHash >
+      _memory_updates;
+
+  // Solver state of each constraint, indexed as `_csts`
+  std::vector< ConstraintState > _states;
+
+  // Worklist of constraint indexes for the current pass, in increasing order
+  std::priority_queue< std::size_t,
+                       std::vector< std::size_t >,
+                       std::greater< std::size_t > >
+      _worklist;
+
+  // Worklist of constraint indexes for the next pass
+  std::vector< std::size_t > _next_worklist;
+
+  // Index of the constraint being processed
+  std::size_t _cursor = 0;
 
 public:
   /// \brief Default constructor
@@ -550,34 +609,222 @@ private:
     }
   };
 
-  /// \brief Perform a step of the fixpoint convergence using the given operator
+  /// \brief Return the representative of the given pointer variable
+  VariableRef find_rep(VariableRef p) const {
+    auto it = this->_rep.find(p);
+    if (it == this->_rep.end()) {
+      return p;
+    } else {
+      return it->second;
+    }
+  }
+
+  /// \brief Return true if the given offset is exactly zero
+  static bool is_zero_offset(const machine_int::Interval& offset) {
+    return !offset.is_bottom() && offset.is_zero();
+  }
+
+  /// \brief Collapse the cycles of copy constraints `p = q + 0`
   ///
-  /// It processes all the constraints once.
-  void step(const BinaryOp& op) {
-    for (auto it = this->_csts.begin(), et = this->_csts.end(); it != et;
-         ++it) {
-      this->process_constraint(it->get(), op);
+  /// All the pointer variables of a strongly connected component have the
+  /// same value in the solution, so they share a single representative.
+  void collapse_cycles() {
+    using VariableVector = std::vector< VariableRef >;
+    using IndexMap =
+        std::unordered_map< VariableRef, std::size_t, VariableHash >;
+
+    struct Frame {
+      VariableRef var;
+      std::size_t next;
+    };
+
+    this->_rep.clear();
+
+    // Build the graph of copies, from operand to result
+    std::unordered_map< VariableRef, VariableVector, VariableHash > succs;
+    for (const auto& cst : this->_csts) {
+      if (cst->kind() != ConstraintT::AssignKind) {
+        continue;
+      }
+      auto assign = static_cast< const AssignConstraintT* >(cst.get());
+      if (assign->operand()->kind() != OperandT::VariableKind) {
+        continue;
+      }
+      auto var_op = static_cast< const VariableOperandT* >(assign->operand());
+      if (is_zero_offset(var_op->offset()) &&
+          !(var_op->var() == assign->result())) {
+        succs[var_op->var()].push_back(assign->result());
+      }
+    }
+
+    // Iterative Tarjan's algorithm
+    IndexMap index;
+    IndexMap lowlink;
+    std::unordered_set< VariableRef, VariableHash > on_stack;
+    VariableVector stack;
+    std::vector< Frame > call_stack;
+    std::size_t counter = 0;
+
+    auto visit = [&](VariableRef v) {
+      index.emplace(v, counter);
+      lowlink.emplace(v, counter);
+      counter++;
+      stack.push_back(v);
+      on_stack.insert(v);
+      call_stack.push_back(Frame{v, 0});
+    };
+
+    for (const auto& entry : succs) {
+      if (index.find(entry.first) != index.end()) {
+        continue;
+      }
+      visit(entry.first);
+      while (!call_stack.empty()) {
+        VariableRef v = call_stack.back().var;
+        auto it = succs.find(v);
+        if (it != succs.end() && call_stack.back().next < it->second.size()) {
+          VariableRef w = it->second[call_stack.back().next++];
+          if (index.find(w) == index.end()) {
+            visit(w);
+          } else if (on_stack.find(w) != on_stack.end()) {
+            lowlink[v] = std::min(lowlink[v], index[w]);
+          }
+          continue;
+        }
+
+        call_stack.pop_back();
+        if (!call_stack.empty()) {
+          VariableRef u = call_stack.back().var;
+          lowlink[u] = std::min(lowlink[u], lowlink[v]);
+        }
+        if (lowlink[v] == index[v]) {
+          VariableRef w = v;
+          do {
+            w = stack.back();
+            stack.pop_back();
+            on_stack.erase(w);
+            if (!(w == v)) {
+              this->_rep.emplace(w, v);
+            }
+          } while (!(w == v));
+        }
+      }
+    }
+
+    // Merge the current values into the representatives
+    for (const auto& entry : this->_rep) {
+      auto it = this->_pointers.find(entry.first);
+      if (it == this->_pointers.end()) {
+        continue;
+      }
+      PointerAbsValueT value = std::move(it->second);
+      this->_pointers.erase(it);
+      this->pointer_ref(entry.second).join_with(value);
     }
   }
 
-  /// \brief Process the given constraint
+  /// \brief Copy the value of the representatives to the collapsed variables
+  void expand_cycles() {
+    for (const auto& entry : this->_rep) {
+      this->pointer_ref(entry.first) = this->get_pointer(entry.second);
+    }
+    this->_rep.clear();
+  }
+
+  /// \brief Index the constraints by the pointer variables they read
+  void build_index() {
+    this->_states.clear();
+    this->_states.resize(this->_csts.size());
+    for (std::size_t i = 0; i < this->_csts.size(); i++) {
+      const ConstraintT* cst = this->_csts[i].get();
+      switch (cst->kind()) {
+        case ConstraintT::AssignKind: {
+          auto assign = static_cast< const AssignConstraintT* >(cst);
+          this->add_operand_user(assign->operand(), i);
+        } break;
+        case ConstraintT::StoreKind: {
+          auto store = static_cast< const StoreConstraintT* >(cst);
+          this->_var_users[this->find_rep(store->pointer())].push_back(i);
+          this->add_operand_user(store->operand(), i);
+        } break;
+        case ConstraintT::LoadKind: {
+          auto load = static_cast< const LoadConstraintT* >(cst);
+          this->add_operand_user(load->operand(), i);
+        } break;
+        default: {
+          ikos_unreachable("unexpected kind");
+        }
+      }
+    }
+  }
+
+  /// \brief Record that the constraint `i` reads the given operand
+  void add_operand_user(const OperandT* op, std::size_t i) {
+    if (op->kind() == OperandT::VariableKind) {
+      auto variable_op = static_cast< const VariableOperandT* >(op);
+      this->_var_users[this->find_rep(variable_op->var())].push_back(i);
+    }
+  }
+
+  /// \brief Free the memory used by the solver
+  void clear_index() {
+    this->_var_users.clear();
+    this->_mem_users.clear();
+    this->_pointer_updates.clear();
+    this->_memory_updates.clear();
+    this->_states.clear();
+    this->_next_worklist.clear();
+  }
+
+  /// \brief Add the constraint `i` in the worklist, if it is not already
+  ///
+  /// Constraints are processed in passes, in the order they were added, as
+  /// the previous solver did. A constraint before the cursor is delayed to
+  /// the next pass.
+  void enqueue(std::size_t i) {
+    ConstraintState& state = this->_states[i];
+    if (state.queued) {
+      return;
+    }
+    state.queued = true;
+    if (i > this->_cursor) {
+      this->_worklist.push(i);
+    } else {
+      this->_next_worklist.push_back(i);
+    }
+  }
+
+  /// \brief Process the constraint `i`
   ///
   /// It updates this->_pointers and this->_memory
-  void process_constraint(const ConstraintT* cst, const BinaryOp& op) {
+  void process_constraint(std::size_t i, const BinaryOp& op) {
+    const ConstraintT* cst = this->_csts[i].get();
+    ConstraintState& state = this->_states[i];
     switch (cst->kind()) {
       case ConstraintT::AssignKind: {
         auto assign = static_cast< const AssignConstraintT* >(cst);
         PointerAbsValueT op_value = this->process_operand(assign->operand());
-        this->add_pointer(assign->result(), op_value, op);
+        this->add_pointer(this->find_rep(assign->result()), op_value, op);
       } break;
       case ConstraintT::StoreKind: {
         auto store = static_cast< const StoreConstraintT* >(cst);
-        PointerAbsValueT ptr_value = this->get_pointer(store->pointer());
+        PointerAbsValueT ptr_value =
+            this->get_pointer(this->find_rep(store->pointer()));
         PointerAbsValueT op_value = this->process_operand(store->operand());
         if (ptr_value.is_bottom()) {
           return;
         }
-        for (MemoryLocationRef addr : ptr_value.points_to()) {
+        // Values only increase, so the operand has to be written again only
+        // if it is not included in the last written value.
+        bool new_operand = !state.operand || !op_value.leq(*state.operand);
+        if (new_operand) {
+          state.operand = op_value;
+        }
+        PointsToSetT addrs =
+            new_operand ? ptr_value.points_to()
+                        : ptr_value.points_to().difference(state.seen);
+        state.seen.join_with(ptr_value.points_to());
+        for (MemoryLocationRef addr : addrs) {
           this->add_memory(addr, op_value, op);
         }
       } break;
@@ -587,8 +834,17 @@ private:
         if (op_value.is_bottom()) {
           return;
         }
-        for (MemoryLocationRef addr : op_value.points_to()) {
-          this->add_pointer(load->result(), this->get_memory(addr), op);
+        VariableRef result = this->find_rep(load->result());
+        PointsToSetT addrs = op_value.points_to().difference(state.seen);
+        state.seen.join_with(op_value.points_to());
+        for (MemoryLocationRef addr : addrs) {
+          this->_mem_users[addr].push_back(i);
+          this->add_pointer(result, this->get_memory(addr), op);
+        }
+        std::vector< MemoryLocationRef > pending;
+        std::swap(pending, state.pending);
+        for (MemoryLocationRef addr : pending) {
+          this->add_pointer(result, this->get_memory(addr), op);
         }
       } break;
       default: {
@@ -602,7 +858,8 @@ private:
     switch (op->kind()) {
       case OperandT::VariableKind: {
         auto variable_op = static_cast< const VariableOperandT* >(op);
-        PointerAbsValueT value = this->get_pointer(variable_op->var());
+        PointerAbsValueT value =
+            this->get_pointer(this->find_rep(variable_op->var()));
         value.add_offset(variable_op->offset());
         return value;
       }
@@ -656,11 +913,8 @@ public:
   MemoryIterator memory_end() const { return this->_memory.cend(); }
 
 private:
-  /// \brief Add a pointer abstraction for the given pointer
-  void add_pointer(VariableRef p,
-                   const PointerAbsValueT& value,
-                   const BinaryOp& op) {
-    // Get a reference on the current value
+  /// \brief Return a reference on the abstract value of the given pointer
+  PointerAbsValueT& pointer_ref(VariableRef p) {
     auto it = this->_pointers.find(p);
     if (it == this->_pointers.end()) {
       // add default value
@@ -670,7 +924,25 @@ private:
                                                        this->_offsets_sign));
       it = res.first;
     }
-    this->add_apply(it->second, value, op);
+    return it->second;
+  }
+
+  /// \brief Add a pointer abstraction for the given pointer
+  void add_pointer(VariableRef p,
+                   const PointerAbsValueT& value,
+                   const BinaryOp& op) {
+    PointerAbsValueT& before = this->pointer_ref(p);
+    if (op.convergence_achieved(before, value)) {
+      return;
+    }
+    op.apply(before, value, ++this->_pointer_updates[p]);
+
+    auto it = this->_var_users.find(p);
+    if (it != this->_var_users.end()) {
+      for (std::size_t i : it->second) {
+        this->enqueue(i);
+      }
+    }
   }
 
   /// \brief Add a pointer abstraction for the given memory location
@@ -687,30 +959,53 @@ private:
                                                        this->_offsets_sign));
       it = res.first;
     }
-    this->add_apply(it->second, value, op);
-  }
+    if (op.convergence_achieved(it->second, value)) {
+      return;
+    }
+    op.apply(it->second, value, ++this->_memory_updates[m]);
 
-  /// \brief Add `after` in `before`, applying the given binary operator `op`
-  void add_apply(PointerAbsValueT& before,
-                 const PointerAbsValueT& after,
-                 const BinaryOp& op) {
-    if (!op.convergence_achieved(before, after)) {
-      this->_change_seen = true;
-      op.apply(before, after, this->_iteration);
+    auto users = this->_mem_users.find(m);
+    if (users != this->_mem_users.end()) {
+      for (std::size_t i : users->second) {
+        this->_states[i].pending.push_back(m);
+        this->enqueue(i);
+      }
     }
   }
 
 public:
   /// \brief Solve the constraint system
+  ///
+  /// The widening is applied on a pointer variable or a memory location once
+  /// it has been updated `widening_threshold` times. Note that the previous
+  /// round-robin solver counted passes over all the constraints instead, and
+  /// widened every update after `widening_threshold` passes. Offsets of
+  /// values updated fewer times are now joined, hence might be more precise.
   void solve(std::size_t widening_threshold = 50,
              std::size_t /*narrowing_threshold*/ = 1) {
-    this->_iteration = 0;
     Extrapolate widening_op(widening_threshold);
-    do {
-      this->_iteration++;
-      this->_change_seen = false;
-      this->step(widening_op);
-    } while (this->_change_seen);
+    this->collapse_cycles();
+    this->build_index();
+    for (std::size_t i = 0; i < this->_csts.size(); i++) {
+      this->_states[i].queued = true;
+      this->_next_worklist.push_back(i);
+    }
+    while (!this->_worklist.empty() || !this->_next_worklist.empty()) {
+      if (this->_worklist.empty()) {
+        // Start a new pass
+        for (std::size_t i : this->_next_worklist) {
+          this->_worklist.push(i);
+        }
+        this->_next_worklist.clear();
+      }
+      std::size_t i = this->_worklist.top();
+      this->_worklist.pop();
+      this->_states[i].queued = false;
+      this->_cursor = i;
+      this->process_constraint(i, widening_op);
+    }
+    this->expand_cycles();
+    this->clear_index();
 
     // TODO(marthaud): commented out because this is unsound.
     //
@@ -723,12 +1018,6 @@ public:
     // As a short fix, the narrowing step is disabled.
     //
     // See https://babelfish.arc.nasa.gov/jira/projects/IKOS/issues/IKOS-71
-
-    // Refine narrowing_op;
-    // this->_iteration = 0;
-    // for (; this->_iteration < narrowing_threshold; ++this->_iteration) {
-    //  this->step(narrowing_op);
-    // }
   }
 
   /// \brief Dump the constraint system, for debugging purpose
@@ -482,6 +482,15 @@ public:
   virtual void scalar_forget(VariableRef x) = 0;
 
   /// @}
+  /// \name Statistics methods
+  /// @{
+
+  /// \brief Return the number of variables tracked by the abstract value
+  ///
+  /// This is an estimate of the size of the abstract value, for statistics.
+  virtual std::size_t num_variables() const = 0;
+
+  /// @}
 
 }; // end class AbstractDomain
 
@@ -547,6 +547,12 @@ public:
 
   void scalar_forget(VariableRef) override {}
 
+  /// @}
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override { return 0; }
+
   /// @}
 
   void dump(std::ostream& o) const override {
@@ -1337,6 +1337,14 @@ public:
     }
   }
 
+  /// @}
+  /// \name Statistics methods
+  /// @{
+
+  std::size_t num_variables() const override {
+    return this->_uninitialized.num_variables();
+  }
+
   /// @}
 
   void dump(std::ostream& o) const override {
@@ -114,6 +114,9 @@ public:
     return this->_tree.end();
   }
 
+  /// \brief Return the number of keys bound to a value other than top
+  std::size_t size() const { return this->_tree.size(); }
+
   void normalize() override {}
 
   bool is_bottom() const override { return this->_is_bottom; }
@@ -92,6 +92,9 @@ public:
   /// \brief Get the uninitialized value for the given variable
   virtual Uninitialized get(VariableRef x) const = 0;
 
+  /// \brief Return the number of variables with a known value
+  virtual std::size_t num_variables() const = 0;
+
 }; // end class AbstractDomain
 
 /// \brief Check if a type is an uninitialized abstract domain
@@ -153,6 +153,8 @@ public:
     }
   }
 
+  std::size_t num_variables() const override { return 0; }
+
   void dump(std::ostream& o) const override {
     if (this->_is_bottom) {
       o << "⊥";
@@ -174,6 +174,8 @@ public:
 
   Uninitialized get(VariableRef x) const override { return this->_inv.get(x); }
 
+  std::size_t num_variables() const override { return this->_inv.size(); }
+
   void dump(std::ostream& o) const override { return this->_inv.dump(o); }
 
   static std::string name() { return "uninitialized domain"; }
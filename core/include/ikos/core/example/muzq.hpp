@@ -749,9 +749,11 @@ private:
 
 public:
   /// \brief Create a fixpoint iterator on the given ControlFlowGraph
-  explicit FixpointIterator(ControlFlowGraphT& cfg)
+  explicit FixpointIterator(ControlFlowGraphT& cfg,
+                            InvariantStorage storage = InvariantStorage::Full)
       : Parent(&cfg,
-               AbstractDomain(ZNumDomain::bottom(), QNumDomain::bottom())) {}
+               AbstractDomain(ZNumDomain::bottom(), QNumDomain::bottom()),
+               storage) {}
 
   /// \brief Return the invariant at the given checkpoint
   const AbstractDomain& checkpoint(const std::string& name) {
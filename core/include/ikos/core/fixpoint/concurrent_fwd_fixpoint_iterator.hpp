@@ -50,6 +50,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -60,6 +61,7 @@
 #include <tbb/parallel_for_each.h>
 
 #include <ikos/core/fixpoint/fixpoint_iterator.hpp>
+#include <ikos/core/fixpoint/work_stealing_scheduler.hpp>
 #include <ikos/core/fixpoint/wpo.hpp>
 
 namespace ikos {
@@ -85,11 +87,14 @@ private:
 
 private:
   GraphRef _cfg;
-  WpoT _wpo;
+  std::shared_ptr< const WpoT > _wpo;
   AbstractValue _bottom;
   NodeRef _entry;
   std::vector< WorkNode, tbb::cache_aligned_allocator< WorkNode > > _work_nodes;
   std::unordered_map< NodeRef, WorkNode* > _node_to_work;
+  ConcurrentScheduling _scheduling;
+  ConcurrentProcessing _processing;
+  std::atomic< bool > _cancelled;
   bool _converged;
 
 public:
@@ -97,35 +102,68 @@ public:
   ///
   /// \param cfg The control flow graph
   /// \param bottom The bottom abstract value
-  explicit InterleavedConcurrentFwdFixpointIterator(GraphRef cfg,
-                                                    AbstractValue bottom)
+  /// \param scheduling The scheduling of ready nodes
+  /// \param processing When process_pre() and process_post() are called
+  explicit InterleavedConcurrentFwdFixpointIterator(
+      GraphRef cfg,
+      AbstractValue bottom,
+      ConcurrentScheduling scheduling = ConcurrentScheduling::ParallelForEach,
+      ConcurrentProcessing processing = ConcurrentProcessing::AfterFixpoint)
+      : InterleavedConcurrentFwdFixpointIterator(
+            cfg,
+            std::make_shared< const WpoT >(cfg),
+            std::move(bottom),
+            scheduling,
+            processing) {}
+
+  /// \brief Create an interleaved concurrent forward fixpoint iterator
+  ///
+  /// \param cfg The control flow graph
+  /// \param wpo The weak partial order of the graph, shared between fixpoint
+  ///   iterators on the same graph
+  /// \param bottom The bottom abstract value
+  /// \param scheduling The scheduling of ready nodes
+  /// \param processing When process_pre() and process_post() are called
+  InterleavedConcurrentFwdFixpointIterator(
+      GraphRef cfg,
+      std::shared_ptr< const WpoT > wpo,
+      AbstractValue bottom,
+      ConcurrentScheduling scheduling = ConcurrentScheduling::ParallelForEach,
+      ConcurrentProcessing processing = ConcurrentProcessing::AfterFixpoint)
       : _cfg(cfg),
-        _wpo(cfg),
+        _wpo(std::move(wpo)),
         _bottom(std::move(bottom)),
         _entry(GraphTrait::entry(cfg)),
-        _converged(false) {}
+        _scheduling(scheduling),
+        _processing(processing),
+        _cancelled(false),
+        _converged(false) {
+    ikos_assert(this->_wpo != nullptr);
+  }
 
   /// \brief No copy constructor
   InterleavedConcurrentFwdFixpointIterator(
       const InterleavedConcurrentFwdFixpointIterator&) = delete;
 
-  /// \brief Move constructor
+  /// \brief No move constructor
+  ///
+  /// Work nodes hold a reference on the iterator.
   InterleavedConcurrentFwdFixpointIterator(
-      InterleavedConcurrentFwdFixpointIterator&&) = default;
+      InterleavedConcurrentFwdFixpointIterator&&) = delete;
 
   /// \brief No copy assignment operator
   InterleavedConcurrentFwdFixpointIterator& operator=(
       const InterleavedConcurrentFwdFixpointIterator&) = delete;
 
-  /// \brief Move assignment operator
+  /// \brief No move assignment operator
   InterleavedConcurrentFwdFixpointIterator& operator=(
-      InterleavedConcurrentFwdFixpointIterator&&) = default;
+      InterleavedConcurrentFwdFixpointIterator&&) = delete;
 
   /// \brief Return the control flow graph
   GraphRef cfg() const override { return this->_cfg; }
 
   /// \brief Return the weak partial order of the graph
-  const WpoT& wpo() const { return this->_wpo; }
+  const WpoT& wpo() const { return *this->_wpo; }
 
   /// \brief Return the bottom abstract value
   const AbstractValue& bottom() const { return this->_bottom; }
@@ -133,9 +171,27 @@ public:
   /// \brief Return the entry node of the graph
   NodeRef entry() const { return this->_entry; }
 
+  /// \brief Return the scheduling of ready nodes
+  ConcurrentScheduling scheduling() const { return this->_scheduling; }
+
+  /// \brief Return when process_pre() and process_post() are called
+  ConcurrentProcessing processing() const { return this->_processing; }
+
   /// \brief Return true if the fixpoint is reached
   bool converged() const override { return this->_converged; }
 
+  /// \brief Cancel the current fixpoint computation
+  ///
+  /// This is thread-safe, and can be called from analyze_node() or
+  /// analyze_edge(). Nodes being processed are completed, then run() returns
+  /// without calling process_pre() and process_post(), and the fixpoint is not
+  /// converged. With ConcurrentProcessing::Pipelined, the nodes that were
+  /// already stable might have been processed.
+  void cancel() { this->_cancelled = true; }
+
+  /// \brief Return true if the current fixpoint computation was cancelled
+  bool cancelled() const { return this->_cancelled; }
+
   /// \brief Return the pre invariant for the given node
   const AbstractValue& pre(NodeRef node) const override {
     auto it = this->_node_to_work.find(node);
@@ -254,6 +310,9 @@ private:
     WpoIndex _index;
     InterleavedConcurrentFwdFixpointIterator& _iterator;
 
+    // Scheduling priority, see ConcurrentScheduling::WorkStealing
+    std::size_t _priority;
+
     // Reference count of number of inputs that are not yet updated
     std::atomic< std::size_t > _ref_count;
     WorkNodeVector _successors;
@@ -271,6 +330,14 @@ private:
     // For exit nodes
     WorkNode* _head;
 
+    // For pipelined processing, see ConcurrentProcessing::Pipelined
+    //
+    // A top level node is not part of any cycle. A top level exit node holds
+    // the plain and head nodes of its component, including nested ones.
+    bool _top_level;
+    bool _stable;
+    WorkNodeVector _members;
+
   public:
     /// \brief Constructor
     WorkNode(WpoNodeKind kind,
@@ -284,12 +351,15 @@ private:
           _node(node),
           _index(index),
           _iterator(iterator),
+          _priority(0),
           _ref_count(ref_count),
           _iteration_kind(FixpointIterationKind::Increasing),
           _iteration_count(0),
           _pre(std::move(pre)),
           _post(std::move(post)),
-          _head(nullptr) {
+          _head(nullptr),
+          _top_level(false),
+          _stable(false) {
       this->_pre.normalize();
     }
 
@@ -301,6 +371,7 @@ private:
           _node(other._node),
           _index(other._index),
           _iterator(other._iterator),
+          _priority(other._priority),
           _ref_count(other._ref_count.load()),
           _successors(other._successors),
           _iteration_kind(other._iteration_kind),
@@ -308,7 +379,10 @@ private:
           _predecessors(other._predecessors),
           _pre(other._pre),
           _post(other._post),
-          _head(other._head) {}
+          _head(other._head),
+          _top_level(other._top_level),
+          _stable(other._stable),
+          _members(other._members) {}
 
     /// \brief Move constructor
     WorkNode(WorkNode&& other)
@@ -316,6 +390,7 @@ private:
           _node(other._node),
           _index(other._index),
           _iterator(other._iterator),
+          _priority(other._priority),
           _ref_count(other._ref_count.load()),
           _successors(std::move(other._successors)),
           _iteration_kind(other._iteration_kind),
@@ -323,7 +398,10 @@ private:
           _predecessors(std::move(other._predecessors)),
           _pre(std::move(other._pre)),
           _post(std::move(other._post)),
-          _head(other._head) {}
+          _head(other._head),
+          _top_level(other._top_level),
+          _stable(other._stable),
+          _members(std::move(other._members)) {}
 
     /// \brief No copy assignment operator
     WorkNode& operator=(const WorkNode&) = delete;
@@ -340,6 +418,12 @@ private:
     /// \brief Return the graph node
     NodeRef node() const { return this->_node; }
 
+    /// \brief Return the scheduling priority
+    std::size_t priority() const { return this->_priority; }
+
+    /// \brief Set the scheduling priority
+    void set_priority(std::size_t priority) { this->_priority = priority; }
+
     /// \brief Set the head of the given exit node
     void set_head(WorkNode* work_node) {
       ikos_assert(work_node != nullptr);
@@ -353,6 +437,17 @@ private:
       this->_successors.push_back(work_node);
     }
 
+    /// \brief Mark the node as not part of any cycle
+    void set_top_level() { this->_top_level = true; }
+
+    /// \brief Add a member of the component of the given top level exit node
+    void add_member(WorkNode* work_node) {
+      ikos_assert(work_node != nullptr);
+      ikos_assert(this->_kind == WpoNodeKind::Exit);
+      ikos_assert(work_node->_kind != WpoNodeKind::Exit);
+      this->_members.push_back(work_node);
+    }
+
     /// \brief Add a predecessor work node
     void add_predecessor(WorkNode* work_node) {
       ikos_assert(work_node != nullptr);
@@ -390,7 +485,33 @@ private:
     /// \brief Decrement the reference counter
     std::size_t decr_ref_count() { return --this->_ref_count; }
 
+    /// \brief Call process_pre() and process_post() on the nodes that became
+    /// stable after the last update, see ConcurrentProcessing::Pipelined
+    ///
+    /// This must be called by the thread that updated the node.
+    void process_stable() {
+      if (!this->_stable) {
+        return;
+      }
+
+      if (this->_kind == WpoNodeKind::Exit) {
+        for (WorkNode* member : this->_members) {
+          member->process();
+        }
+      } else {
+        this->process();
+      }
+    }
+
   private:
+    /// \brief Process the invariants of a stable node, and release its pre
+    void process() {
+      ikos_assert(this->_kind != WpoNodeKind::Exit);
+      this->_iterator.process_pre(this->_node, this->_pre);
+      this->_iterator.process_post(this->_node, this->_post);
+      this->_pre = this->_iterator.bottom();
+    }
+
     /// \brief Reset the reference counter
     void reset_ref_count() {
       this->_ref_count =
@@ -429,6 +550,7 @@ private:
       this->_pre.normalize();
       this->set_post(this->_iterator.analyze_node(this->_node, this->_pre));
       this->reset_ref_count();
+      this->_stable = this->_top_level;
       return this->_successors;
     }
 
@@ -464,6 +586,7 @@ private:
       if (converged) {
         this->reset_ref_count();
         this->handle_irreducible();
+        this->_stable = this->_top_level;
         return this->_successors;
       } else {
         this->reset_ref_count();
@@ -560,15 +683,21 @@ private:
 
   }; // end class WorkNode
 
-  /// \brief Worker on a node for tbb::parallel_for_each
+  /// \brief Worker on a node, for tbb::parallel_for_each or
+  /// WorkStealingScheduler
   class Worker {
   public:
     // Required by tbb::parallel_for_each
     using argument_type = WorkNode*;
 
+  private:
+    const std::atomic< bool >& _cancelled;
+    bool _pipelined;
+
   public:
     /// \brief Constructor
-    Worker() = default;
+    Worker(const std::atomic< bool >& cancelled, bool pipelined)
+        : _cancelled(cancelled), _pipelined(pipelined) {}
 
     /// \brief No copy constructor
     Worker(const Worker&) = delete;
@@ -586,8 +715,12 @@ private:
     ~Worker() = default;
 
     /// \brief Process a work node
-    void operator()(WorkNode* work_node,
-                    tbb::feeder< argument_type >& feeder) const {
+    template < typename Feeder >
+    void operator()(WorkNode* work_node, Feeder& feeder) const {
+      if (this->_cancelled.load(std::memory_order_relaxed)) {
+        return;
+      }
+
       const auto& successors = work_node->update();
 
       for (WorkNode* successor : successors) {
@@ -595,13 +728,113 @@ private:
           feeder.add(successor);
         }
       }
+
+      // Successors are already available to other workers
+      if (this->_pipelined) {
+        work_node->process_stable();
+      }
+    }
+
+    /// \brief Return the scheduling priority of a work node
+    std::size_t priority(WorkNode* work_node) const {
+      return work_node->priority();
     }
-  };
+
+  }; // end class Worker
+
+  /// \brief Set the priority of the work nodes to the length of their
+  /// critical path in the weak partial order
+  ///
+  /// The critical path of a node is the longest chain of nodes that can only
+  /// be processed after it. It is computed in reverse topological order.
+  void compute_priorities() {
+    std::size_t size = this->_work_nodes.size();
+    std::vector< std::size_t > remaining(size);
+    std::vector< WpoIndex > worklist;
+
+    for (std::size_t idx = 0; idx < size; idx++) {
+      remaining[idx] = this->_wpo->successors(idx).size();
+      this->_work_nodes[idx].set_priority(1);
+      if (remaining[idx] == 0) {
+        worklist.push_back(idx);
+      }
+    }
+
+    while (!worklist.empty()) {
+      WpoIndex idx = worklist.back();
+      worklist.pop_back();
+      std::size_t length = this->_work_nodes[idx].priority() + 1;
+
+      for (WpoIndex pred : this->_wpo->predecessors(idx)) {
+        WorkNode& work_node = this->_work_nodes[pred];
+        work_node.set_priority(std::max(work_node.priority(), length));
+        if (--remaining[pred] == 0) {
+          worklist.push_back(pred);
+        }
+      }
+    }
+  }
+
+  /// \brief Find the nodes that are not part of any cycle, and the members
+  /// of the outermost components, for ConcurrentProcessing::Pipelined
+  ///
+  /// The members of a component are reachable from its head in the weak
+  /// partial order without going through its exit. Components are either
+  /// nested or disjoint, so the outermost component of a node is the largest
+  /// one containing it.
+  void compute_components() {
+    std::size_t size = this->_work_nodes.size();
+    std::vector< WpoIndex > outermost(size, size);
+    std::vector< std::size_t > component_size(size, 0);
+    std::vector< WpoIndex > visited(size, size);
+    std::vector< WpoIndex > members;
+    std::vector< WpoIndex > worklist;
+
+    for (WpoIndex head = 0; head < size; head++) {
+      if (this->_wpo->kind(head) != WpoNodeKind::Head) {
+        continue;
+      }
+
+      WpoIndex exit = this->_wpo->exit_of_head(head);
+      members.clear();
+      worklist.push_back(head);
+      visited[head] = head;
+
+      while (!worklist.empty()) {
+        WpoIndex idx = worklist.back();
+        worklist.pop_back();
+        members.push_back(idx);
+
+        for (WpoIndex succ : this->_wpo->successors(idx)) {
+          if (succ != exit && visited[succ] != head) {
+            visited[succ] = head;
+            worklist.push_back(succ);
+          }
+        }
+      }
+
+      component_size[exit] = members.size();
+      for (WpoIndex idx : members) {
+        if (outermost[idx] == size ||
+            component_size[outermost[idx]] < members.size()) {
+          outermost[idx] = exit;
+        }
+      }
+    }
+
+    for (WpoIndex idx = 0; idx < size; idx++) {
+      if (outermost[idx] == size) {
+        this->_work_nodes[idx].set_top_level();
+      } else if (this->_wpo->kind(idx) != WpoNodeKind::Exit) {
+        this->_work_nodes[outermost[idx]].add_member(&this->_work_nodes[idx]);
+      }
+    }
+  }
 
 public:
   /// \brief Compute the fixpoint with the given initial abstract value
   void run(AbstractValue init) override {
-    std::size_t size = this->_wpo.size();
+    std::size_t size = this->_wpo->size();
 
     // Clear the fixpoint
     this->clear();
@@ -610,8 +843,8 @@ public:
     this->_work_nodes.reserve(size);
 
     for (std::size_t idx = 0; idx < size; idx++) {
-      WpoNodeKind kind = this->_wpo.kind(idx);
-      NodeRef node = this->_wpo.node(idx);
+      WpoNodeKind kind = this->_wpo->kind(idx);
+      NodeRef node = this->_wpo->node(idx);
       AbstractValue pre = this->_bottom;
 
       if (node == this->_entry && kind != WpoNodeKind::Exit) {
@@ -623,7 +856,7 @@ public:
           /* node = */ node,
           /* index = */ idx,
           /* iterator = */ *this,
-          /* ref_count = */ this->_wpo.num_predecessors(idx),
+          /* ref_count = */ this->_wpo->num_predecessors(idx),
           /* pre = */ std::move(pre),
           /* post = */ this->_bottom));
     }
@@ -641,12 +874,12 @@ public:
     for (std::size_t idx = 0; idx < size; idx++) {
       WorkNode& work_node = this->_work_nodes[idx];
 
-      for (std::size_t succ : this->_wpo.successors(idx)) {
+      for (std::size_t succ : this->_wpo->successors(idx)) {
         work_node.add_successor(&this->_work_nodes[succ]);
       }
 
       if (work_node.kind() == WpoNodeKind::Exit) {
-        work_node.set_head(&this->_work_nodes[this->_wpo.head_of_exit(idx)]);
+        work_node.set_head(&this->_work_nodes[this->_wpo->head_of_exit(idx)]);
       } else {
         NodeRef node = work_node.node();
         for (auto it = GraphTrait::predecessor_begin(node),
@@ -658,11 +891,35 @@ public:
       }
     }
 
+    bool pipelined = this->_processing == ConcurrentProcessing::Pipelined;
+    if (pipelined) {
+      this->compute_components();
+    }
+
     // Run the analysis
-    std::array< WorkNode*, 1 > root = {this->_node_to_work[this->_entry]};
-    tbb::parallel_for_each(std::begin(root), std::end(root), Worker());
+    WorkNode* root = this->_node_to_work[this->_entry];
+    Worker worker(this->_cancelled, pipelined);
+
+    if (this->_scheduling == ConcurrentScheduling::WorkStealing) {
+      this->compute_priorities();
+      WorkStealingScheduler< WorkNode*, Worker > scheduler(worker);
+      scheduler.run(root);
+    } else {
+      std::array< WorkNode*, 1 > roots = {root};
+      tbb::parallel_for_each(std::begin(roots), std::end(roots), worker);
+    }
+
+    if (this->_cancelled) {
+      return;
+    }
+
     this->_converged = true;
 
+    if (pipelined) {
+      // Nodes were processed during the analysis
+      return;
+    }
+
     // Call process_pre/process_post methods
     for (WorkNode& work_node : this->_work_nodes) {
       if (work_node.kind() != WpoNodeKind::Exit) {
@@ -675,6 +932,7 @@ public:
 
   /// \brief Clear the current fixpoint
   void clear() override {
+    this->_cancelled = false;
     this->_converged = false;
     this->_work_nodes.clear();
     this->_node_to_work.clear();
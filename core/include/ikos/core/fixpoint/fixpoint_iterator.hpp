@@ -137,5 +137,47 @@ public:
 /// \brief Kind of fixpoint iteration
 enum class FixpointIterationKind { Increasing, Decreasing };
 
+/// \brief Storage of the invariants of a fixpoint iterator
+enum class InvariantStorage {
+  /// \brief Keep the pre and post invariants of all nodes
+  Full,
+
+  /// \brief Keep only the invariants needed to resume the computation
+  ///
+  /// Pre invariants are kept for the entry node and the heads of cycles, and
+  /// post invariants are released once all the successors have consumed them.
+  /// Other invariants are recomputed on demand.
+  Sparse,
+};
+
+/// \brief Scheduling of the nodes of a concurrent fixpoint iterator
+enum class ConcurrentScheduling {
+  /// \brief Feed ready nodes to tbb::parallel_for_each
+  ParallelForEach,
+
+  /// \brief Use per-worker priority queues with work stealing
+  ///
+  /// Ready nodes are ordered by the length of their critical path in the weak
+  /// partial order, and a worker keeps the most urgent successor of the node
+  /// it just processed.
+  WorkStealing,
+};
+
+/// \brief Processing of the invariants of a concurrent fixpoint iterator
+enum class ConcurrentProcessing {
+  /// \brief Call process_pre() and process_post() on all nodes once the
+  /// fixpoint is reached
+  AfterFixpoint,
+
+  /// \brief Call process_pre() and process_post() as soon as nodes are stable
+  ///
+  /// A node outside of any cycle is processed right after its analysis, and
+  /// the nodes of a cycle are processed once the outermost cycle containing
+  /// them converged, while the rest of the graph is still analyzed. Nodes are
+  /// processed concurrently, by the worker threads. The pre invariant of a
+  /// node is released once processed.
+  Pipelined,
+};
+
 } // end namespace core
 } // end namespace ikos
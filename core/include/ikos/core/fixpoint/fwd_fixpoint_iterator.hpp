@@ -49,10 +49,14 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <ikos/core/fixpoint/fixpoint_iterator.hpp>
+#include <ikos/core/fixpoint/statistics.hpp>
 #include <ikos/core/fixpoint/wto.hpp>
+#include <ikos/core/support/assert.hpp>
 
 namespace ikos {
 namespace core {
@@ -65,6 +69,15 @@ class WtoIterator;
 template < typename GraphRef, typename AbstractValue, typename GraphTrait >
 class WtoProcessor;
 
+template < typename GraphRef,
+           typename AbstractValue,
+           typename GraphTrait,
+           typename Function >
+class WtoReplayer;
+
+template < typename GraphRef, typename GraphTrait >
+class WtoReleaseBuilder;
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
 /// \brief Interleaved forward fixpoint iterator
@@ -78,21 +91,39 @@ class InterleavedFwdFixpointIterator
   friend class interleaved_fwd_fixpoint_iterator_impl::
       WtoIterator< GraphRef, AbstractValue, GraphTrait >;
 
+  template < typename, typename, typename, typename >
+  friend class interleaved_fwd_fixpoint_iterator_impl::WtoReplayer;
+
 private:
   using NodeRef = typename GraphTrait::NodeRef;
+  using FixpointStatisticsT = FixpointStatistics< NodeRef, AbstractValue >;
   using InvariantTable = std::unordered_map< NodeRef, AbstractValue >;
+  using ReleaseTable = std::unordered_map< NodeRef, std::vector< NodeRef > >;
   using WtoT = Wto< GraphRef, GraphTrait >;
   using WtoIterator = interleaved_fwd_fixpoint_iterator_impl::
       WtoIterator< GraphRef, AbstractValue, GraphTrait >;
   using WtoProcessor = interleaved_fwd_fixpoint_iterator_impl::
       WtoProcessor< GraphRef, AbstractValue, GraphTrait >;
+  using WtoReleaseBuilder = interleaved_fwd_fixpoint_iterator_impl::
+      WtoReleaseBuilder< GraphRef, GraphTrait >;
 
 private:
   GraphRef _cfg;
-  WtoT _wto;
+  std::shared_ptr< const WtoT > _wto;
   AbstractValue _bottom;
+  InvariantStorage _storage;
   InvariantTable _pre;
   InvariantTable _post;
+
+  /// \brief Map from a component (vertex or head of a cycle) to the nodes
+  /// whose post invariant is no longer needed once the component is visited
+  ///
+  /// Only used with the sparse storage.
+  ReleaseTable _release;
+
+  /// \brief Statistics on the iterations, or null
+  FixpointStatisticsT* _statistics;
+
   bool _converged;
 
 public:
@@ -100,8 +131,36 @@ public:
   ///
   /// \param cfg The control flow graph
   /// \param bottom The bottom abstract value
-  InterleavedFwdFixpointIterator(GraphRef cfg, AbstractValue bottom)
-      : _cfg(cfg), _wto(cfg), _bottom(std::move(bottom)), _converged(false) {}
+  /// \param storage The storage of the invariants
+  InterleavedFwdFixpointIterator(
+      GraphRef cfg,
+      AbstractValue bottom,
+      InvariantStorage storage = InvariantStorage::Full)
+      : InterleavedFwdFixpointIterator(cfg,
+                                       std::make_shared< const WtoT >(cfg),
+                                       std::move(bottom),
+                                       storage) {}
+
+  /// \brief Create an interleaved forward fixpoint iterator
+  ///
+  /// \param cfg The control flow graph
+  /// \param wto The weak topological order of the graph, shared between
+  ///   fixpoint iterators on the same graph
+  /// \param bottom The bottom abstract value
+  /// \param storage The storage of the invariants
+  InterleavedFwdFixpointIterator(
+      GraphRef cfg,
+      std::shared_ptr< const WtoT > wto,
+      AbstractValue bottom,
+      InvariantStorage storage = InvariantStorage::Full)
+      : _cfg(cfg),
+        _wto(std::move(wto)),
+        _bottom(std::move(bottom)),
+        _storage(storage),
+        _statistics(nullptr),
+        _converged(false) {
+    ikos_assert(this->_wto != nullptr);
+  }
 
   /// \brief No copy constructor
   InterleavedFwdFixpointIterator(const InterleavedFwdFixpointIterator&) =
@@ -122,14 +181,28 @@ public:
   GraphRef cfg() const override { return this->_cfg; }
 
   /// \brief Return the weak topological order of the graph
-  const WtoT& wto() const { return this->_wto; }
+  const WtoT& wto() const { return *this->_wto; }
 
   /// \brief Return the bottom abstract value
   const AbstractValue& bottom() const { return this->_bottom; }
 
+  /// \brief Return the storage of the invariants
+  InvariantStorage storage() const { return this->_storage; }
+
   /// \brief Return true if the fixpoint is reached
   bool converged() const override { return this->_converged; }
 
+  /// \brief Return the statistics on the iterations, or null
+  FixpointStatisticsT* statistics() const { return this->_statistics; }
+
+  /// \brief Record statistics on the iterations in the given object
+  ///
+  /// Statistics are accumulated over calls to `run()`. Pass null to disable
+  /// them, which is the default.
+  void set_statistics(FixpointStatisticsT* statistics) {
+    this->_statistics = statistics;
+  }
+
 private:
   /// \brief Set the invariant for the given node
   void set(InvariantTable& table, NodeRef node, AbstractValue inv) const {
@@ -163,15 +236,47 @@ private:
     }
   }
 
+  /// \brief Return the stored pre invariant for the given node, or bottom
+  const AbstractValue& get_pre(NodeRef node) const {
+    return this->get(this->_pre, node);
+  }
+
+  /// \brief Return the stored post invariant for the given node, or bottom
+  const AbstractValue& get_post(NodeRef node) const {
+    return this->get(this->_post, node);
+  }
+
+  /// \brief Release the post invariants consumed by the given component
+  ///
+  /// The component is either a vertex or the head of a cycle.
+  void release(InvariantTable& table, NodeRef component) const {
+    auto it = this->_release.find(component);
+    if (it != this->_release.end()) {
+      for (NodeRef node : it->second) {
+        table.erase(node);
+      }
+    }
+  }
+
 public:
   /// \brief Return the pre invariant for the given node
+  ///
+  /// Only available with the full storage. With the sparse storage, use
+  /// `replay()` instead.
   const AbstractValue& pre(NodeRef node) const override {
-    return this->get(this->_pre, node);
+    ikos_assert_msg(this->_storage == InvariantStorage::Full,
+                    "pre invariants are not stored with the sparse storage");
+    return this->get_pre(node);
   }
 
   /// \brief Return the post invariant for the given node
+  ///
+  /// Only available with the full storage. With the sparse storage, use
+  /// `replay()` instead.
   const AbstractValue& post(NodeRef node) const override {
-    return this->get(this->_post, node);
+    ikos_assert_msg(this->_storage == InvariantStorage::Full,
+                    "post invariants are not stored with the sparse storage");
+    return this->get_post(node);
   }
 
   /// \brief Extrapolate the new state after an increasing iteration
@@ -278,18 +383,45 @@ public:
   virtual void notify_leave_cycle(NodeRef head) { ikos_ignore(head); }
 
   /// \brief Compute the fixpoint with the given initial abstract value
+  ///
+  /// With the sparse storage, process_pre() and process_post() are only
+  /// called on the nodes that are not in a cycle, during the computation.
   void run(AbstractValue init) override {
     this->clear();
     this->set_pre(GraphTrait::entry(this->_cfg), std::move(init));
 
+    if (this->_storage == InvariantStorage::Sparse && this->_release.empty()) {
+      WtoReleaseBuilder builder(*this->_wto);
+      this->_wto->accept(builder);
+      this->_release = builder.release_table();
+    }
+
     // Compute the fixpoint
     WtoIterator iterator(*this);
-    this->_wto.accept(iterator);
+    this->_wto->accept(iterator);
     this->_converged = true;
 
-    // Call process_pre/process_post methods
-    WtoProcessor processor(*this);
-    this->_wto.accept(processor);
+    if (this->_storage == InvariantStorage::Full) {
+      // Call process_pre/process_post methods
+      WtoProcessor processor(*this);
+      this->_wto->accept(processor);
+    }
+  }
+
+  /// \brief Call `f(node, pre)` on each node, in the weak topological order
+  ///
+  /// `f` must return the post invariant of the node. With the sparse storage,
+  /// pre invariants that are not stored are recomputed from the post
+  /// invariants returned by `f`, which are released as soon as all the
+  /// successors have consumed them.
+  ///
+  /// Nodes that are unreachable from the entry are not visited.
+  template < typename Function >
+  void replay(Function f) {
+    interleaved_fwd_fixpoint_iterator_impl::
+        WtoReplayer< GraphRef, AbstractValue, GraphTrait, Function >
+            replayer(*this, std::move(f));
+    this->_wto->accept(replayer);
   }
 
   /// \brief Clear the pre invariants
@@ -322,6 +454,8 @@ public:
   using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
   using WtoT = Wto< GraphRef, GraphTrait >;
   using WtoNestingT = WtoNesting< GraphRef, GraphTrait >;
+  using FixpointStatisticsT = FixpointStatistics< NodeRef, AbstractValue >;
+  using OperationTimer = FixpointOperationTimer< NodeRef, AbstractValue >;
 
 private:
   /// \brief Fixpoint engine
@@ -330,9 +464,14 @@ private:
   /// \brief Graph entry point
   NodeRef _entry;
 
+  /// \brief Statistics on the iterations, or null
+  FixpointStatisticsT* _statistics;
+
 public:
   explicit WtoIterator(InterleavedIterator& iterator)
-      : _iterator(iterator), _entry(GraphTrait::entry(iterator.cfg())) {}
+      : _iterator(iterator),
+        _entry(GraphTrait::entry(iterator.cfg())),
+        _statistics(iterator.statistics()) {}
 
   void visit(const WtoVertexT& vertex) override {
     NodeRef node = vertex.node();
@@ -340,7 +479,7 @@ public:
 
     // Use the invariant for the entry point
     if (node == this->_entry) {
-      pre = this->_iterator.pre(node);
+      pre = this->_iterator.get_pre(node);
     }
 
     // Collect invariants from incoming edges
@@ -349,13 +488,20 @@ public:
          it != et;
          ++it) {
       NodeRef pred = *it;
-      pre.join_with(
-          this->_iterator.analyze_edge(pred, node, this->_iterator.post(pred)));
+      this->join_with(pre,
+                      this->analyze_edge(pred,
+                                         node,
+                                         this->_iterator.get_post(pred)));
     }
 
     pre.normalize();
-    this->_iterator.set_pre(node, pre);
-    this->_iterator.set_post(node, this->_iterator.analyze_node(node, pre));
+
+    if (this->_iterator.storage() == InvariantStorage::Full) {
+      this->_iterator.set_pre(node, pre);
+      this->_iterator.set_post(node, this->analyze_node(node, pre));
+    } else {
+      this->visit_sparse(node, std::move(pre));
+    }
   }
 
   void visit(const WtoCycleT& cycle) override {
@@ -364,6 +510,9 @@ public:
     const WtoNestingT& cycle_nesting = this->_iterator.wto().nesting(head);
 
     this->_iterator.notify_enter_cycle(head);
+    if (this->_statistics != nullptr) {
+      this->_statistics->enter_cycle(head);
+    }
 
     // Collect invariants from incoming edges
     for (auto it = GraphTrait::predecessor_begin(head),
@@ -372,9 +521,10 @@ public:
          ++it) {
       NodeRef pred = *it;
       if (this->_iterator.wto().nesting(pred) <= cycle_nesting) {
-        pre.join_with(this->_iterator.analyze_edge(pred,
-                                                   head,
-                                                   this->_iterator.post(pred)));
+        this->join_with(pre,
+                        this->analyze_edge(pred,
+                                           head,
+                                           this->_iterator.get_post(pred)));
       }
     }
 
@@ -383,8 +533,11 @@ public:
     for (unsigned iteration = 1;; ++iteration) {
       this->_iterator.notify_cycle_iteration(head, iteration, kind);
       pre.normalize();
+      if (this->_statistics != nullptr) {
+        this->_statistics->iteration(kind, pre);
+      }
       this->_iterator.set_pre(head, pre);
-      this->_iterator.set_post(head, this->_iterator.analyze_node(head, pre));
+      this->_iterator.set_post(head, this->analyze_node(head, pre));
 
       for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
         it->accept(*this);
@@ -402,25 +555,24 @@ public:
            ++it) {
         NodeRef pred = *it;
         AbstractValue inv =
-            this->_iterator.analyze_edge(pred,
-                                         head,
-                                         this->_iterator.post(pred));
+            this->analyze_edge(pred, head, this->_iterator.get_post(pred));
         if (this->_iterator.wto().nesting(pred) <= cycle_nesting) {
-          new_pre_in.join_with(std::move(inv));
+          this->join_with(new_pre_in, std::move(inv));
         } else {
-          new_pre_back.join_with(std::move(inv));
+          this->join_with(new_pre_back, std::move(inv));
         }
       }
 
-      new_pre_in.join_loop_with(std::move(new_pre_back));
+      {
+        OperationTimer timer(this->_statistics, FixpointOperation::Join);
+        new_pre_in.join_loop_with(std::move(new_pre_back));
+      }
       AbstractValue new_pre(std::move(new_pre_in));
       new_pre.normalize();
 
       if (kind == FixpointIterationKind::Increasing) {
         // Increasing iteration with widening
-        AbstractValue inv =
-            this->_iterator.extrapolate(head, iteration, pre, new_pre);
-        inv.normalize();
+        AbstractValue inv = this->extrapolate(head, iteration, pre, new_pre);
         if (this->_iterator.is_increasing_iterations_fixpoint(head,
                                                               iteration,
                                                               pre,
@@ -436,9 +588,7 @@ public:
 
       if (kind == FixpointIterationKind::Decreasing) {
         // Decreasing iteration with narrowing
-        AbstractValue inv =
-            this->_iterator.refine(head, iteration, pre, new_pre);
-        inv.normalize();
+        AbstractValue inv = this->refine(head, iteration, pre, new_pre);
         if (this->_iterator.is_decreasing_iterations_fixpoint(head,
                                                               iteration,
                                                               pre,
@@ -452,7 +602,72 @@ public:
       }
     }
 
+    if (this->_statistics != nullptr) {
+      this->_statistics->leave_cycle();
+    }
     this->_iterator.notify_leave_cycle(head);
+
+    if (this->_iterator.storage() == InvariantStorage::Sparse) {
+      this->_iterator.release(this->_iterator._post, head);
+    }
+  }
+
+private:
+  /// \brief Analyze a vertex with the sparse storage
+  void visit_sparse(NodeRef node, AbstractValue pre) {
+    if (node == this->_entry) {
+      this->_iterator.set_pre(node, pre);
+    }
+    this->_iterator.set_post(node, this->analyze_node(node, pre));
+
+    if (this->_iterator.wto().nesting(node).empty()) {
+      // Invariants outside of cycles are final
+      this->_iterator.process_pre(node, pre);
+      this->_iterator.process_post(node, this->_iterator.get_post(node));
+    }
+
+    this->_iterator.release(this->_iterator._post, node);
+  }
+
+  /// \brief Apply the semantic transformer of a node
+  AbstractValue analyze_node(NodeRef node, AbstractValue pre) {
+    OperationTimer timer(this->_statistics, FixpointOperation::Transfer);
+    return this->_iterator.analyze_node(node, std::move(pre));
+  }
+
+  /// \brief Apply the semantic transformer of an edge
+  AbstractValue analyze_edge(NodeRef src, NodeRef dest, AbstractValue post) {
+    OperationTimer timer(this->_statistics, FixpointOperation::Transfer);
+    return this->_iterator.analyze_edge(src, dest, std::move(post));
+  }
+
+  /// \brief Join `inv` with `other`
+  void join_with(AbstractValue& inv, AbstractValue other) {
+    OperationTimer timer(this->_statistics, FixpointOperation::Join);
+    inv.join_with(std::move(other));
+  }
+
+  /// \brief Extrapolate the new state after an increasing iteration
+  AbstractValue extrapolate(NodeRef head,
+                            unsigned iteration,
+                            const AbstractValue& before,
+                            const AbstractValue& after) {
+    OperationTimer timer(this->_statistics, FixpointOperation::Widening);
+    AbstractValue inv =
+        this->_iterator.extrapolate(head, iteration, before, after);
+    inv.normalize();
+    return inv;
+  }
+
+  /// \brief Refine the new state after a decreasing iteration
+  AbstractValue refine(NodeRef head,
+                       unsigned iteration,
+                       const AbstractValue& before,
+                       const AbstractValue& after) {
+    OperationTimer timer(this->_statistics, FixpointOperation::Narrowing);
+    AbstractValue inv = this->_iterator.refine(head, iteration, before, after);
+    inv.normalize();
+    return inv;
   }
 
 }; // end class WtoIterator
@@ -490,6 +705,196 @@ public:
 
 }; // end class WtoProcessor
 
+template < typename GraphRef,
+           typename AbstractValue,
+           typename GraphTrait,
+           typename Function >
+class WtoReplayer final : public WtoComponentVisitor< GraphRef, GraphTrait > {
+public:
+  using InterleavedIterator =
+      InterleavedFwdFixpointIterator< GraphRef, AbstractValue, GraphTrait >;
+  using NodeRef = typename GraphTrait::NodeRef;
+  using WtoVertexT = WtoVertex< GraphRef, GraphTrait >;
+  using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
+  using InvariantTable = std::unordered_map< NodeRef, AbstractValue >;
+
+private:
+  /// \brief Fixpoint engine
+  InterleavedIterator& _iterator;
+
+  /// \brief Function called on each node
+  Function _f;
+
+  /// \brief Post invariants returned by `_f`, not consumed yet
+  InvariantTable _post;
+
+public:
+  WtoReplayer(InterleavedIterator& iterator, Function f)
+      : _iterator(iterator), _f(std::move(f)) {}
+
+  void visit(const WtoVertexT& vertex) override {
+    NodeRef node = vertex.node();
+
+    if (this->_iterator.storage() == InvariantStorage::Full) {
+      this->_f(node, this->_iterator.pre(node));
+      return;
+    }
+
+    auto it = this->_iterator._pre.find(node);
+    if (it != this->_iterator._pre.end()) {
+      this->replay(node, it->second);
+    } else {
+      AbstractValue pre = this->_iterator.bottom();
+
+      // Collect invariants from incoming edges
+      for (auto pred_it = GraphTrait::predecessor_begin(node),
+                pred_et = GraphTrait::predecessor_end(node);
+           pred_it != pred_et;
+           ++pred_it) {
+        NodeRef pred = *pred_it;
+        pre.join_with(this->_iterator.analyze_edge(pred,
+                                                   node,
+                                                   this->_iterator.get(
+                                                       this->_post, pred)));
+      }
+
+      pre.normalize();
+      this->replay(node, pre);
+    }
+
+    this->_iterator.release(this->_post, node);
+  }
+
+  void visit(const WtoCycleT& cycle) override {
+    NodeRef head = cycle.head();
+
+    if (this->_iterator.storage() == InvariantStorage::Full) {
+      this->_f(head, this->_iterator.pre(head));
+    } else {
+      // The pre invariant of a cycle head is always stored
+      this->replay(head, this->_iterator.get_pre(head));
+    }
+
+    for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+      it->accept(*this);
+    }
+
+    if (this->_iterator.storage() == InvariantStorage::Sparse) {
+      this->_iterator.release(this->_post, head);
+    }
+  }
+
+private:
+  /// \brief Call `_f` on the given node and keep the post invariant
+  void replay(NodeRef node, const AbstractValue& pre) {
+    this->_iterator.set(this->_post, node, this->_f(node, pre));
+  }
+
+}; // end class WtoReplayer
+
+template < typename GraphRef, typename GraphTrait >
+class WtoReleaseBuilder final
+    : public WtoComponentVisitor< GraphRef, GraphTrait > {
+public:
+  using NodeRef = typename GraphTrait::NodeRef;
+  using WtoVertexT = WtoVertex< GraphRef, GraphTrait >;
+  using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
+  using WtoT = Wto< GraphRef, GraphTrait >;
+  using WtoNestingT = WtoNesting< GraphRef, GraphTrait >;
+  using ReleaseTable = std::unordered_map< NodeRef, std::vector< NodeRef > >;
+
+private:
+  /// \brief Weak topological order
+  const WtoT& _wto;
+
+  /// \brief Position of each component (vertex or head of a cycle) in the
+  /// order in which their visit ends
+  std::unordered_map< NodeRef, std::size_t > _finish;
+
+  /// \brief Heads of cycles
+  std::unordered_set< NodeRef > _heads;
+
+public:
+  explicit WtoReleaseBuilder(const WtoT& wto) : _wto(wto) {}
+
+  void visit(const WtoVertexT& vertex) override {
+    this->_finish.emplace(vertex.node(), this->_finish.size());
+  }
+
+  void visit(const WtoCycleT& cycle) override {
+    this->_heads.insert(cycle.head());
+
+    for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+      it->accept(*this);
+    }
+
+    this->_finish.emplace(cycle.head(), this->_finish.size());
+  }
+
+  /// \brief Return the map from a component to the nodes whose post
+  /// invariant is no longer needed once the component is visited
+  ///
+  /// Nodes without successors are never released.
+  ReleaseTable release_table() const {
+    ReleaseTable table;
+
+    for (const auto& entry : this->_finish) {
+      NodeRef node = entry.first;
+      NodeRef last = node;
+      bool found = false;
+
+      for (auto it = GraphTrait::successor_begin(node),
+                et = GraphTrait::successor_end(node);
+           it != et;
+           ++it) {
+        NodeRef component = this->consumer(node, *it);
+        if (!found ||
+            this->_finish.at(component) > this->_finish.at(last)) {
+          last = component;
+          found = true;
+        }
+      }
+
+      if (found) {
+        table[last].push_back(node);
+      }
+    }
+
+    return table;
+  }
+
+private:
+  /// \brief Return the component after which the post invariant of `pred` is
+  /// no longer read on the edge `pred -> succ`
+  ///
+  /// This is the outermost component containing `succ` but not `pred`, or the
+  /// cycle headed by `succ` if `pred` is in it.
+  NodeRef consumer(NodeRef pred, NodeRef succ) const {
+    std::vector< NodeRef > pred_cycles = this->cycles(pred);
+    std::vector< NodeRef > succ_cycles = this->cycles(succ);
+
+    std::size_t i = 0;
+    while (i < pred_cycles.size() && i < succ_cycles.size() &&
+           pred_cycles[i] == succ_cycles[i]) {
+      i++;
+    }
+
+    return (i < succ_cycles.size()) ? succ_cycles[i] : succ;
+  }
+
+  /// \brief Return the heads of the cycles containing the given node, from
+  /// the outermost to the innermost, including the node itself if it is a head
+  std::vector< NodeRef > cycles(NodeRef node) const {
+    const WtoNestingT& nesting = this->_wto.nesting(node);
+    std::vector< NodeRef > heads(nesting.begin(), nesting.end());
+    if (this->_heads.count(node) != 0) {
+      heads.push_back(node);
+    }
+    return heads;
+  }
+
+}; // end class WtoReleaseBuilder
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
 } // end namespace core
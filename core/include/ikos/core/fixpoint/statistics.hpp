@@ -0,0 +1,308 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Statistics on the iterations of a fixpoint iterator
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ikos/core/fixpoint/fixpoint_iterator.hpp>
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Counters on the iterations of a cycle, or of a whole fixpoint
+struct FixpointCounters {
+  /// \brief Number of increasing iterations
+  std::size_t increasing_iterations = 0;
+
+  /// \brief Number of decreasing iterations
+  std::size_t decreasing_iterations = 0;
+
+  /// \brief Number of calls to extrapolate()
+  std::size_t widenings = 0;
+
+  /// \brief Number of calls to refine()
+  std::size_t narrowings = 0;
+
+  /// \brief Time spent in analyze_node() and analyze_edge(), in seconds
+  double transfer_time = 0;
+
+  /// \brief Time spent in joins, in seconds
+  double join_time = 0;
+
+  /// \brief Time spent in extrapolate(), in seconds
+  double widening_time = 0;
+
+  /// \brief Time spent in refine(), in seconds
+  double narrowing_time = 0;
+
+  /// \brief Maximum number of variables in the invariant of a cycle head
+  std::size_t max_variables = 0;
+
+  /// \brief Maximum number of memory cells in the invariant of a cycle head
+  std::size_t max_cells = 0;
+
+  /// \brief Add the counters of another fixpoint
+  void merge(const FixpointCounters& other) {
+    this->increasing_iterations += other.increasing_iterations;
+    this->decreasing_iterations += other.decreasing_iterations;
+    this->widenings += other.widenings;
+    this->narrowings += other.narrowings;
+    this->transfer_time += other.transfer_time;
+    this->join_time += other.join_time;
+    this->widening_time += other.widening_time;
+    this->narrowing_time += other.narrowing_time;
+    this->max_variables = std::max(this->max_variables, other.max_variables);
+    this->max_cells = std::max(this->max_cells, other.max_cells);
+  }
+
+  /// \brief Return the total time, in seconds
+  double time() const {
+    return this->transfer_time + this->join_time + this->widening_time +
+           this->narrowing_time;
+  }
+
+}; // end struct FixpointCounters
+
+/// \brief Operations timed by the fixpoint statistics
+enum class FixpointOperation { Transfer, Join, Widening, Narrowing };
+
+/// \brief Statistics on the iterations of a fixpoint iterator
+///
+/// The fixpoint iterator reports its operations to this object, which keeps
+/// counters for the whole fixpoint and for each cycle head. Iterations are
+/// counted for the innermost cycle only, while times spent in a nested cycle
+/// are also accounted to the enclosing cycles.
+///
+/// The size of the invariants is computed by `state_size()`, which returns
+/// zeros by default.
+template < typename NodeRef, typename AbstractValue >
+class FixpointStatistics {
+public:
+  using Clock = std::chrono::steady_clock;
+  using CycleCounters = std::unordered_map< NodeRef, FixpointCounters >;
+
+private:
+  /// \brief Counters for the whole fixpoint
+  FixpointCounters _total;
+
+  /// \brief Counters for each cycle head
+  CycleCounters _cycles;
+
+  /// \brief Heads of the cycles being analyzed, from the outermost
+  std::vector< NodeRef > _heads;
+
+public:
+  /// \brief Default constructor
+  FixpointStatistics() = default;
+
+  /// \brief No copy constructor
+  FixpointStatistics(const FixpointStatistics&) = delete;
+
+  /// \brief Move constructor
+  FixpointStatistics(FixpointStatistics&&) = default;
+
+  /// \brief No copy assignment operator
+  FixpointStatistics& operator=(const FixpointStatistics&) = delete;
+
+  /// \brief Move assignment operator
+  FixpointStatistics& operator=(FixpointStatistics&&) = default;
+
+  /// \brief Destructor
+  virtual ~FixpointStatistics() = default;
+
+  /// \brief Return the number of variables and memory cells of an invariant
+  virtual std::pair< std::size_t, std::size_t > state_size(
+      const AbstractValue&) const {
+    return {0, 0};
+  }
+
+  /// \brief Return the counters for the whole fixpoint
+  const FixpointCounters& total() const { return this->_total; }
+
+  /// \brief Return the counters for each cycle head
+  const CycleCounters& cycles() const { return this->_cycles; }
+
+  /// \brief Notify the beginning of the analysis of a cycle
+  void enter_cycle(NodeRef head) {
+    this->_cycles[head];
+    this->_heads.push_back(head);
+  }
+
+  /// \brief Notify the end of the analysis of a cycle
+  void leave_cycle() {
+    ikos_assert(!this->_heads.empty());
+    this->_heads.pop_back();
+  }
+
+  /// \brief Notify the beginning of an iteration on the innermost cycle
+  ///
+  /// \param kind The kind of iteration
+  /// \param pre The invariant of the cycle head for this iteration
+  void iteration(FixpointIterationKind kind, const AbstractValue& pre) {
+    ikos_assert(!this->_heads.empty());
+    FixpointCounters& cycle = this->_cycles[this->_heads.back()];
+    std::pair< std::size_t, std::size_t > size = this->state_size(pre);
+
+    for (FixpointCounters* counters : {&this->_total, &cycle}) {
+      if (kind == FixpointIterationKind::Increasing) {
+        counters->increasing_iterations++;
+      } else {
+        counters->decreasing_iterations++;
+      }
+      counters->max_variables = std::max(counters->max_variables, size.first);
+      counters->max_cells = std::max(counters->max_cells, size.second);
+    }
+  }
+
+  /// \brief Record an operation that started at the given time
+  ///
+  /// Calls to extrapolate() and refine() are counted for the innermost cycle.
+  void record(FixpointOperation op, Clock::time_point start) {
+    double seconds =
+        std::chrono::duration< double >(Clock::now() - start).count();
+
+    count(this->_total, op);
+    add_time(this->_total, op, seconds);
+    if (!this->_heads.empty()) {
+      count(this->_cycles.at(this->_heads.back()), op);
+    }
+    for (NodeRef head : this->_heads) {
+      add_time(this->_cycles.at(head), op, seconds);
+    }
+  }
+
+  /// \brief Clear the statistics
+  void clear() {
+    this->_total = FixpointCounters();
+    this->_cycles.clear();
+    this->_heads.clear();
+  }
+
+private:
+  /// \brief Count an operation in the given counters
+  static void count(FixpointCounters& counters, FixpointOperation op) {
+    if (op == FixpointOperation::Widening) {
+      counters.widenings++;
+    } else if (op == FixpointOperation::Narrowing) {
+      counters.narrowings++;
+    }
+  }
+
+  /// \brief Add the time of an operation to the given counters
+  static void add_time(FixpointCounters& counters,
+                       FixpointOperation op,
+                       double seconds) {
+    switch (op) {
+      case FixpointOperation::Transfer: {
+        counters.transfer_time += seconds;
+      } break;
+      case FixpointOperation::Join: {
+        counters.join_time += seconds;
+      } break;
+      case FixpointOperation::Widening: {
+        counters.widening_time += seconds;
+      } break;
+      case FixpointOperation::Narrowing: {
+        counters.narrowing_time += seconds;
+      } break;
+    }
+  }
+
+}; // end class FixpointStatistics
+
+/// \brief Record the time of an operation on the scope, if statistics are
+/// enabled
+template < typename NodeRef, typename AbstractValue >
+class FixpointOperationTimer {
+private:
+  using FixpointStatisticsT = FixpointStatistics< NodeRef, AbstractValue >;
+
+private:
+  FixpointStatisticsT* _statistics;
+  FixpointOperation _op;
+  typename FixpointStatisticsT::Clock::time_point _start;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param statistics The fixpoint statistics, or null
+  /// \param op The operation
+  FixpointOperationTimer(FixpointStatisticsT* statistics, FixpointOperation op)
+      : _statistics(statistics), _op(op) {
+    if (this->_statistics != nullptr) {
+      this->_start = FixpointStatisticsT::Clock::now();
+    }
+  }
+
+  /// \brief No copy constructor
+  FixpointOperationTimer(const FixpointOperationTimer&) = delete;
+
+  /// \brief No move constructor
+  FixpointOperationTimer(FixpointOperationTimer&&) = delete;
+
+  /// \brief No copy assignment operator
+  FixpointOperationTimer& operator=(const FixpointOperationTimer&) = delete;
+
+  /// \brief No move assignment operator
+  FixpointOperationTimer& operator=(FixpointOperationTimer&&) = delete;
+
+  /// \brief Destructor
+  ~FixpointOperationTimer() {
+    if (this->_statistics != nullptr) {
+      this->_statistics->record(this->_op, this->_start);
+    }
+  }
+
+}; // end class FixpointOperationTimer
+
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,374 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Work stealing scheduler for concurrent fixpoint iterators
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <tbb/cache_aligned_allocator.h>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Work stealing scheduler
+///
+/// Each worker owns a priority queue of ready tasks. A worker processes the
+/// most urgent task of its own queue, and steals from the other queues when
+/// its own is empty. When a task produces new ready tasks, the most urgent one
+/// is kept by the worker and processed next, the others are pushed on its
+/// queue, where idle workers can steal them.
+///
+/// Workers are tbb tasks, spawned when ready tasks are pushed and there are
+/// free worker slots. They terminate after failing to find work for a few
+/// rounds, so that the threads can be used by other tbb algorithms.
+///
+/// The Body must provide:
+///   void operator()(Task, Feeder&) const;
+///   std::size_t priority(Task) const;
+///
+/// Tasks with higher priorities are processed first.
+template < typename Task, typename Body >
+class WorkStealingScheduler {
+public:
+  using Priority = std::size_t;
+
+public:
+  class Feeder;
+
+private:
+  /// \brief Number of rounds without work before a worker terminates
+  static constexpr unsigned IdleRounds = 64;
+
+  /// \brief A task with its priority
+  struct Item {
+    Priority priority = 0;
+    Task task;
+  };
+
+  /// \brief Order items by priority, for std::push_heap and std::pop_heap
+  struct ItemCompare {
+    bool operator()(const Item& a, const Item& b) const {
+      return a.priority < b.priority;
+    }
+  };
+
+  /// \brief Priority queue of a worker slot
+  struct alignas(64) WorkQueue {
+    // Protects the heap
+    std::mutex mutex;
+
+    // Ready tasks, as a max-heap
+    std::vector< Item > heap;
+
+    // Size of the heap, to skip empty queues without locking
+    std::atomic< std::size_t > size{0};
+
+    // True if a worker currently owns the slot
+    std::atomic< bool > claimed{false};
+  };
+
+private:
+  const Body& _body;
+  std::size_t _num_workers;
+  std::vector< WorkQueue, tbb::cache_aligned_allocator< WorkQueue > > _queues;
+  std::atomic< std::size_t > _active;
+  std::atomic< bool > _cancelled;
+  std::mutex _exception_mutex;
+  std::exception_ptr _exception;
+  tbb::task_group* _group;
+
+public:
+  /// \brief Create a scheduler
+  ///
+  /// \param body The function object processing a task
+  /// \param num_workers The maximum number of workers, defaults to the
+  ///   number of threads available
+  explicit WorkStealingScheduler(const Body& body,
+                                 std::size_t num_workers = default_workers())
+      : _body(body),
+        _num_workers(std::max(num_workers, std::size_t(1))),
+        _queues(_num_workers),
+        _active(0),
+        _cancelled(false),
+        _group(nullptr) {}
+
+  /// \brief No copy constructor
+  WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+
+  /// \brief No move constructor
+  WorkStealingScheduler(WorkStealingScheduler&&) = delete;
+
+  /// \brief No copy assignment operator
+  WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+  /// \brief No move assignment operator
+  WorkStealingScheduler& operator=(WorkStealingScheduler&&) = delete;
+
+  /// \brief Destructor
+  ~WorkStealingScheduler() = default;
+
+  /// \brief Return the default number of workers
+  static std::size_t default_workers() {
+    return std::min(static_cast< std::size_t >(
+                        tbb::this_task_arena::max_concurrency()),
+                    tbb::global_control::active_value(
+                        tbb::global_control::max_allowed_parallelism));
+  }
+
+  /// \brief Return the maximum number of workers
+  std::size_t num_workers() const { return this->_num_workers; }
+
+  /// \brief Process the given task and all the tasks it feeds
+  ///
+  /// The calling thread takes part in the computation.
+  ///
+  /// If the body throws an exception, the scheduler is cancelled and the
+  /// exception is rethrown once all workers terminated.
+  ///
+  /// \returns false if the scheduler was cancelled, true otherwise
+  bool run(Task root) {
+    this->_cancelled = false;
+    this->_exception = nullptr;
+
+    tbb::task_group group;
+    this->_group = &group;
+
+    this->_queues[0].claimed = true;
+    this->_active = 1;
+    this->push(0, Item{this->_body.priority(root), root});
+    this->work(0);
+    group.wait();
+
+    this->_group = nullptr;
+
+    // Drop the remaining tasks, if cancelled
+    for (WorkQueue& queue : this->_queues) {
+      queue.heap.clear();
+      queue.size = 0;
+    }
+
+    if (this->_exception) {
+      std::rethrow_exception(this->_exception);
+    }
+
+    return !this->_cancelled;
+  }
+
+  /// \brief Cancel the computation
+  ///
+  /// Workers stop after their current task. This is thread-safe.
+  void cancel() { this->_cancelled = true; }
+
+  /// \brief Return true if the computation was cancelled
+  bool cancelled() const { return this->_cancelled; }
+
+public:
+  /// \brief Collect the tasks that became ready while processing a task
+  class Feeder {
+  private:
+    WorkStealingScheduler& _scheduler;
+    std::size_t _slot;
+    Item _next;
+    bool _has_next;
+
+  public:
+    /// \brief Constructor
+    Feeder(WorkStealingScheduler& scheduler, std::size_t slot)
+        : _scheduler(scheduler), _slot(slot), _has_next(false) {}
+
+    /// \brief No copy constructor
+    Feeder(const Feeder&) = delete;
+
+    /// \brief No copy assignment operator
+    Feeder& operator=(const Feeder&) = delete;
+
+    /// \brief Add a ready task
+    void add(Task task) {
+      Item item{this->_scheduler._body.priority(task), task};
+
+      if (!this->_has_next) {
+        this->_next = item;
+        this->_has_next = true;
+        return;
+      }
+
+      if (this->_next.priority < item.priority) {
+        std::swap(this->_next, item);
+      }
+      this->_scheduler.push(this->_slot, item);
+      this->_scheduler.spawn();
+    }
+
+  private:
+    /// \brief Take the task to process next, if any
+    bool next(Item& item) {
+      if (this->_has_next) {
+        item = this->_next;
+        this->_has_next = false;
+        return true;
+      }
+      return false;
+    }
+
+    friend class WorkStealingScheduler;
+
+  }; // end class Feeder
+
+private:
+  /// \brief Main loop of the worker owning the given slot
+  void work(std::size_t slot) {
+    Item item;
+    bool has_item = false;
+    unsigned idle = 0;
+
+    while (!this->_cancelled.load(std::memory_order_relaxed)) {
+      if (!has_item) {
+        has_item = this->pop(slot, item) || this->steal(slot, item);
+      }
+      if (!has_item) {
+        if (++idle > IdleRounds) {
+          break;
+        }
+        std::this_thread::yield();
+        continue;
+      }
+
+      idle = 0;
+      Feeder feeder(*this, slot);
+      try {
+        // Isolation prevents this thread from picking up another worker of
+        // this scheduler while it waits on nested parallel algorithms.
+        tbb::this_task_arena::isolate(
+            [this, &item, &feeder] { this->_body(item.task, feeder); });
+      } catch (...) {
+        std::lock_guard< std::mutex > lock(this->_exception_mutex);
+        if (!this->_exception) {
+          this->_exception = std::current_exception();
+        }
+        this->cancel();
+        break;
+      }
+      has_item = feeder.next(item);
+    }
+
+    // The queue of the slot is empty, unless cancelled
+    this->_active--;
+    this->_queues[slot].claimed = false;
+  }
+
+  /// \brief Spawn a new worker, if there is a free slot
+  void spawn() {
+    if (this->_active.load(std::memory_order_relaxed) >= this->_num_workers) {
+      return;
+    }
+
+    for (std::size_t slot = 0; slot < this->_num_workers; slot++) {
+      bool expected = false;
+      if (this->_queues[slot].claimed.compare_exchange_strong(expected,
+                                                              true)) {
+        this->_active++;
+        this->_group->run([this, slot] { this->work(slot); });
+        return;
+      }
+    }
+  }
+
+  /// \brief Push an item on the queue of the given slot
+  void push(std::size_t slot, const Item& item) {
+    WorkQueue& queue = this->_queues[slot];
+    std::lock_guard< std::mutex > lock(queue.mutex);
+    queue.heap.push_back(item);
+    std::push_heap(queue.heap.begin(), queue.heap.end(), ItemCompare());
+    queue.size++;
+  }
+
+  /// \brief Pop the most urgent item of the given queue
+  bool pop_from(WorkQueue& queue, Item& item) {
+    if (queue.size.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
+
+    std::lock_guard< std::mutex > lock(queue.mutex);
+    if (queue.heap.empty()) {
+      return false;
+    }
+    std::pop_heap(queue.heap.begin(), queue.heap.end(), ItemCompare());
+    item = queue.heap.back();
+    queue.heap.pop_back();
+    queue.size--;
+    return true;
+  }
+
+  /// \brief Pop the most urgent item of the queue of the given slot
+  bool pop(std::size_t slot, Item& item) {
+    return this->pop_from(this->_queues[slot], item);
+  }
+
+  /// \brief Steal an item from the queue of another slot
+  bool steal(std::size_t slot, Item& item) {
+    for (std::size_t i = 1; i < this->_num_workers; i++) {
+      if (this->pop_from(this->_queues[(slot + i) % this->_num_workers],
+                         item)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+}; // end class WorkStealingScheduler
+
+} // end namespace core
+} // end namespace ikos
@@ -49,6 +49,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
@@ -58,9 +60,9 @@
 #include <boost/container/slist.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
-#include <ikos/core/number/bound.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/graph.hpp>
+#include <ikos/core/support/assert.hpp>
 
 namespace ikos {
 namespace core {
@@ -129,6 +131,9 @@ public:
   /// \brief End iterator over the head of cycles
   Iterator end() const { return this->_nodes.cend(); }
 
+  /// \brief Return true if the node is not in any cycle
+  bool empty() const { return this->_nodes.empty(); }
+
   /// \brief Return the common prefix of the given nestings
   WtoNesting operator^(const WtoNesting& other) const {
     WtoNesting res;
@@ -376,11 +381,15 @@ public:
 private:
   using WtoComponentPtr = std::unique_ptr< WtoComponentT >;
   using WtoComponentList = boost::container::slist< WtoComponentPtr >;
-  using Dfn = Bound< ZNumber >;
+  using Dfn = std::size_t;
   using DfnTable = std::unordered_map< NodeRef, Dfn >;
   using Stack = std::vector< NodeRef >;
-  using WtoNestingPtr = std::shared_ptr< WtoNestingT >;
-  using NestingTable = std::unordered_map< NodeRef, WtoNestingPtr >;
+  using NestingIndex = std::size_t;
+  using NestingList = std::vector< WtoNestingT >;
+  using NestingTable = std::unordered_map< NodeRef, NestingIndex >;
+
+  /// \brief Depth-first number of a visited node that is not on the stack
+  static constexpr Dfn DfnInfinity = std::numeric_limits< Dfn >::max();
 
 public:
   /// \brief Iterator over the components
@@ -390,7 +399,16 @@ public:
 
 private:
   WtoComponentList _components;
+
+  /// \brief List of distinct nestings
+  ///
+  /// All the nodes directly within the same cycle share the same nesting. The
+  /// first one is the empty nesting, for nodes that are not in a cycle.
+  NestingList _nestings;
+
+  /// \brief Map from a node to the index of its nesting in `_nestings`
   NestingTable _nesting_table;
+
   DfnTable _dfn_table;
   Dfn _num;
   Stack _stack;
@@ -400,20 +418,24 @@ private:
   class NestingBuilder final
       : public WtoComponentVisitor< GraphRef, GraphTrait > {
   private:
-    WtoNestingPtr _nesting;
+    NestingIndex _nesting;
+    NestingList& _nestings;
     NestingTable& _nesting_table;
 
   public:
-    explicit NestingBuilder(NestingTable& nesting_table)
-        : _nesting(std::make_shared< WtoNestingT >()),
-          _nesting_table(nesting_table) {}
+    NestingBuilder(NestingList& nestings, NestingTable& nesting_table)
+        : _nesting(0), _nestings(nestings), _nesting_table(nesting_table) {
+      this->_nestings.emplace_back();
+    }
 
     void visit(const WtoCycleT& cycle) override {
       NodeRef head = cycle.head();
-      WtoNestingPtr previous_nesting = this->_nesting;
+      NestingIndex previous_nesting = this->_nesting;
       this->_nesting_table.insert(std::make_pair(head, this->_nesting));
-      this->_nesting = std::make_shared< WtoNestingT >(*this->_nesting);
-      this->_nesting->add(head);
+      WtoNestingT nesting = this->_nestings[this->_nesting];
+      nesting.add(head);
+      this->_nesting = this->_nestings.size();
+      this->_nestings.push_back(std::move(nesting));
       for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
         it->accept(*this);
       }
@@ -434,12 +456,12 @@ private:
     if (it != this->_dfn_table.end()) {
       return it->second;
     } else {
-      return Dfn(0);
+      return 0;
     }
   }
 
   /// \brief Set the depth-first number of the given node
-  void set_dfn(NodeRef n, const Dfn& dfn) {
+  void set_dfn(NodeRef n, Dfn dfn) {
     auto res = this->_dfn_table.insert(std::make_pair(n, dfn));
     if (!res.second) {
       (res.first)->second = dfn;
@@ -465,7 +487,7 @@ private:
          it != et;
          ++it) {
       NodeRef succ = *it;
-      if (this->dfn(succ) == Dfn(0)) {
+      if (this->dfn(succ) == 0) {
         this->visit(succ, partition);
       }
     }
@@ -476,12 +498,12 @@ private:
   ///
   /// Algorithm to build a weak topological order of a graph
   Dfn visit(NodeRef vertex, WtoComponentList& partition) {
-    Dfn head(0);
-    Dfn min(0);
+    Dfn head = 0;
+    Dfn min = 0;
     bool loop;
 
     this->push(vertex);
-    this->_num += Dfn(1);
+    this->_num += 1;
     head = this->_num;
     this->set_dfn(vertex, head);
     loop = false;
@@ -491,7 +513,7 @@ private:
          ++it) {
       NodeRef succ = *it;
       Dfn succ_dfn = this->dfn(succ);
-      if (succ_dfn == Dfn(0)) {
+      if (succ_dfn == 0) {
         min = this->visit(succ, partition);
       } else {
         min = succ_dfn;
@@ -502,11 +524,11 @@ private:
       }
     }
     if (head == this->dfn(vertex)) {
-      this->set_dfn(vertex, Dfn::plus_infinity());
+      this->set_dfn(vertex, DfnInfinity);
       NodeRef element = this->pop();
       if (loop) {
         while (element != vertex) {
-          this->set_dfn(element, Dfn(0));
+          this->set_dfn(element, 0);
           element = this->pop();
         }
         partition.push_front(this->component(vertex));
@@ -519,7 +541,7 @@ private:
 
   /// \brief Build the nesting table
   void build_nesting() {
-    NestingBuilder builder(this->_nesting_table);
+    NestingBuilder builder(this->_nestings, this->_nesting_table);
     for (auto it = this->begin(), et = this->end(); it != et; ++it) {
       it->accept(builder);
     }
@@ -529,8 +551,8 @@ public:
   /// \brief Compute the weak topological order of the given graph
   explicit Wto(GraphRef cfg) : _num(0) {
     this->visit(GraphTrait::entry(cfg), this->_components);
-    this->_dfn_table.clear();
-    this->_stack.clear();
+    this->_dfn_table = DfnTable();
+    this->_stack = Stack();
     this->build_nesting();
   }
 
@@ -565,11 +587,18 @@ public:
   const WtoNestingT& nesting(NodeRef n) const {
     auto it = this->_nesting_table.find(n);
     ikos_assert_msg(it != this->_nesting_table.end(), "node not found");
-    return *(it->second);
+    return this->_nestings[it->second];
+  }
+
+  /// \brief Return true if the given node is in the weak topological order
+  ///
+  /// Nodes that are unreachable from the entry are not.
+  bool contains(NodeRef n) const {
+    return this->_nesting_table.find(n) != this->_nesting_table.end();
   }
 
   /// \brief Accept the given visitor
-  void accept(WtoComponentVisitor< GraphRef, GraphTrait >& v) {
+  void accept(WtoComponentVisitor< GraphRef, GraphTrait >& v) const {
     for (const auto& c : this->_components) {
       c->accept(v);
     }
@@ -46,9 +46,9 @@
 #pragma once
 
 #include <algorithm>
-#include <vector>
 
 #include <ikos/core/adt/patricia_tree/set.hpp>
+#include <ikos/core/adt/small_vector.hpp>
 #include <ikos/core/linear_expression.hpp>
 #include <ikos/core/support/assert.hpp>
 
@@ -576,7 +576,10 @@ public:
   using LinearConstraintT = LinearConstraint< Number, VariableRef >;
 
 private:
-  using Constraints = std::vector< LinearConstraintT >;
+  /// \brief Constraints, the first 2 are stored inline
+  ///
+  /// Guards and assignments usually produce one or two constraints.
+  using Constraints = SmallVector< LinearConstraintT, 2 >;
 
 public:
   using Iterator = typename Constraints::iterator;
@@ -45,10 +45,10 @@
 
 #include <iostream>
 
-#include <boost/container/flat_map.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/adt/patricia_tree/set.hpp>
+#include <ikos/core/adt/small_flat_map.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/variable.hpp>
@@ -113,7 +113,11 @@ public:
   using VariableExpressionT = VariableExpression< Number, VariableRef >;
 
 private:
-  using Map = boost::container::flat_map< VariableRef, Number >;
+  /// \brief Map from variables to coefficients
+  ///
+  /// Most expressions of the analyzed programs have at most 3 terms, these are
+  /// stored inline without any heap allocation.
+  using Map = SmallFlatMap< VariableRef, Number, 3 >;
 
 public:
   /// \brief Iterator over the terms
@@ -49,6 +49,7 @@
 
 #include <type_traits>
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/exception.hpp>
@@ -470,6 +471,19 @@ inline Bound< Number > abs(const Bound< Number >& b) {
   return (b >= Bound< Number >(0)) ? b : -b;
 }
 
+/// \brief Return the hash of a bound
+template < typename Number >
+inline std::size_t hash_value(const Bound< Number >& b) {
+  std::size_t result = 0;
+  boost::hash_combine(result, b.is_infinite());
+  if (b.is_infinite()) {
+    boost::hash_combine(result, b.is_plus_infinity());
+  } else {
+    boost::hash_combine(result, *b.number());
+  }
+  return result;
+}
+
 /// \brief Write a bound on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o, const Bound< Number >& bound) {
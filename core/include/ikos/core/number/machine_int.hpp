@@ -132,8 +132,15 @@ public:
     ikos_assert_msg(bit_width > 0, "invalid bit width");
 
     if (this->is_small()) {
-      ZNumber m = mod(n, power_of_2(this->_bit_width));
-      this->_n.i = m.to< uint64_t >();
+      if (n.fits< int64_t >()) {
+        // Wrapped by normalize()
+        this->_n.i = static_cast< uint64_t >(n.to< int64_t >());
+      } else if (n.fits< uint64_t >()) {
+        this->_n.i = n.to< uint64_t >();
+      } else {
+        ZNumber m = mod(n, power_of_2(this->_bit_width));
+        this->_n.i = m.to< uint64_t >();
+      }
     } else {
       this->_n.p = new ZNumber(n);
     }
@@ -1091,15 +1098,17 @@ inline MachineInt mul(const MachineInt& lhs,
   assert_compatible(lhs, rhs);
   if (lhs.is_small()) {
     MachineInt result(lhs._n.i * rhs._n.i, lhs._bit_width, lhs._sign);
-    if (lhs.bit_width() == 1) {
-      if (lhs.is_signed()) {
-        overflow = (lhs.is_min() && rhs.is_min());
-      } else {
-        overflow = false;
-      }
+    if (lhs.is_signed()) {
+      int64_t n;
+      overflow = __builtin_mul_overflow(lhs.to< int64_t >(),
+                                        rhs.to< int64_t >(),
+                                        &n) ||
+                 MachineInt::sign_extend_64(static_cast< uint64_t >(n),
+                                            lhs._bit_width) != n;
     } else {
-      overflow = !lhs.is_zero() && !rhs.is_zero() &&
-                 (div(result, rhs) != lhs || div(result, lhs) != rhs);
+      uint64_t n;
+      overflow = __builtin_mul_overflow(lhs._n.i, rhs._n.i, &n) ||
+                 (lhs._bit_width < 64 && (n >> lhs._bit_width) != 0);
     }
     return result;
   } else {
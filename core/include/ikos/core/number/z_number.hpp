@@ -47,7 +47,10 @@
 #pragma once
 
 #include <functional>
+#include <cstdlib>
+#include <cstring>
 #include <iosfwd>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -283,12 +286,103 @@ template <>
 struct MpzTo< long long >
     : public MpzToLongLong< sizeof(long long) == sizeof(long) > {};
 
+/// \brief Helper to check if a long fits in the given integer type
+template < typename T, bool = std::is_signed< T >::value >
+struct LongFits;
+
+template < typename T >
+struct LongFits< T, true > {
+  bool operator()(long n) {
+    return n >= std::numeric_limits< T >::min() &&
+           n <= std::numeric_limits< T >::max();
+  }
+};
+
+template < typename T >
+struct LongFits< T, false > {
+  bool operator()(long n) {
+    return n >= 0 &&
+           static_cast< unsigned long >(n) <= std::numeric_limits< T >::max();
+  }
+};
+
+/// \brief Helper to check if the given integer fits in a long
+template < typename T, bool = std::is_signed< T >::value >
+struct FitsLong;
+
+template < typename T >
+struct FitsLong< T, true > {
+  bool operator()(T n) {
+    return static_cast< long long >(n) >= std::numeric_limits< long >::min() &&
+           static_cast< long long >(n) <= std::numeric_limits< long >::max();
+  }
+};
+
+template < typename T >
+struct FitsLong< T, false > {
+  bool operator()(T n) {
+    return static_cast< unsigned long long >(n) <=
+           static_cast< unsigned long long >(
+               std::numeric_limits< long >::max());
+  }
+};
+
 } // end namespace detail
 
 /// \brief Class for unlimited precision integers
+///
+/// Numbers that fit in a `long` are stored inline and computed with checked
+/// machine arithmetic. A number is promoted to a GMP integer when an operation
+/// overflows, and demoted as soon as it fits in a `long` again, so that every
+/// value has a unique representation.
 class ZNumber {
 private:
-  mpz_class _n;
+  /// \brief Type of inline numbers
+  using SmallInt = long;
+
+  static_assert(sizeof(mp_limb_t) >= sizeof(SmallInt), "unexpected size");
+
+  /// \brief True if the number is stored in `_small`, false if in `_big`
+  bool _is_small;
+
+  union {
+    /// \brief Inline number
+    SmallInt _small;
+
+    /// \brief GMP number, never fits in a SmallInt
+    mpz_t _big;
+  };
+
+  /// \brief Read-only view of a ZNumber as a GMP integer
+  ///
+  /// This does not allocate memory for inline numbers.
+  class MpzView {
+  private:
+    mp_limb_t _limb;
+    mpz_t _tmp;
+    mpz_srcptr _ptr;
+
+  public:
+    explicit MpzView(const ZNumber& n) {
+      if (n._is_small) {
+        this->_limb = n._small < 0
+                          ? -static_cast< mp_limb_t >(n._small)
+                          : static_cast< mp_limb_t >(n._small);
+        mpz_roinit_n(this->_tmp,
+                     &this->_limb,
+                     n._small < 0 ? -1 : (n._small > 0 ? 1 : 0));
+        this->_ptr = this->_tmp;
+      } else {
+        this->_ptr = n._big;
+      }
+    }
+
+    MpzView(const MpzView&) = delete;
+
+    MpzView& operator=(const MpzView&) = delete;
+
+    mpz_srcptr get() const { return this->_ptr; }
+  };
 
 public:
   /// \brief Create a ZNumber from a string representation
@@ -331,50 +425,112 @@ public:
   /// @{
 
   /// \brief Default constructor that creates a ZNumber equals to 0
-  ZNumber() = default;
+  ZNumber() noexcept : _is_small(true), _small(0) {}
 
   /// \brief Copy constructor
-  ZNumber(const ZNumber&) = default;
+  ZNumber(const ZNumber& o) : _is_small(o._is_small) {
+    if (o._is_small) {
+      this->_small = o._small;
+    } else {
+      mpz_init_set(this->_big, o._big);
+    }
+  }
 
   /// \brief Move constructor
-  // TODO(marthaud): Add noexcept when mpz_class(mpz_class&&) becomes noexcept
-  ZNumber(ZNumber&&) = default;
+  ZNumber(ZNumber&& o) noexcept : _is_small(true), _small(0) {
+    this->steal(o);
+  }
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(const mpz_class& n) : _n(n) {}
+  explicit ZNumber(const mpz_class& n) : _is_small(true), _small(0) {
+    if (n.fits_slong_p()) {
+      this->_small = n.get_si();
+    } else {
+      mpz_init_set(this->_big, n.get_mpz_t());
+      this->_is_small = false;
+    }
+  }
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(mpz_class&& n) : _n(std::move(n)) {}
+  explicit ZNumber(mpz_class&& n) : _is_small(true), _small(0) {
+    if (n.fits_slong_p()) {
+      this->_small = n.get_si();
+    } else {
+      mpz_init(this->_big);
+      mpz_swap(this->_big, n.get_mpz_t());
+      this->_is_small = false;
+    }
+  }
 
   /// \brief Create a ZNumber from an integral type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
-  explicit ZNumber(T n) : _n(detail::MpzAdapter< T >()(n)) {}
+  explicit ZNumber(T n) : _is_small(true), _small(0) {
+    if (detail::FitsLong< T >()(n)) {
+      this->_small = static_cast< SmallInt >(n);
+    } else {
+      mpz_class m(detail::MpzAdapter< T >()(n));
+      mpz_init_set(this->_big, m.get_mpz_t());
+      this->_is_small = false;
+    }
+  }
 
   /// \brief Destructor
-  ~ZNumber() = default;
+  ~ZNumber() {
+    if (!this->_is_small) {
+      mpz_clear(this->_big);
+    }
+  }
 
   /// @}
   /// \name Assignment Operators
   /// @{
 
   /// \brief Copy assignment
-  ZNumber& operator=(const ZNumber&) = default;
+  ZNumber& operator=(const ZNumber& o) {
+    if (this == &o) {
+      return *this;
+    }
+    if (o._is_small) {
+      this->clear();
+      this->_small = o._small;
+    } else if (this->_is_small) {
+      mpz_init_set(this->_big, o._big);
+      this->_is_small = false;
+    } else {
+      mpz_set(this->_big, o._big);
+    }
+    return *this;
+  }
 
   /// \brief Move assignment
-  ZNumber& operator=(ZNumber&&) noexcept = default;
+  ZNumber& operator=(ZNumber&& o) noexcept {
+    if (this != &o) {
+      this->clear();
+      this->steal(o);
+    }
+    return *this;
+  }
 
   /// \brief Assignment for integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator=(T n) {
-    this->_n = detail::MpzAdapter< T >()(n);
-    return *this;
+    return this->operator=(ZNumber(n));
   }
 
   /// \brief Addition assignment
   ZNumber& operator+=(const ZNumber& x) {
-    this->_n += x._n;
+    SmallInt r;
+    if (this->_is_small && x._is_small &&
+        !__builtin_add_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_add(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -382,13 +538,21 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator+=(T x) {
-    this->_n += detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator+=(ZNumber(x));
   }
 
   /// \brief Subtraction assignment
   ZNumber& operator-=(const ZNumber& x) {
-    this->_n -= x._n;
+    SmallInt r;
+    if (this->_is_small && x._is_small &&
+        !__builtin_sub_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_sub(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -396,13 +560,21 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator-=(T x) {
-    this->_n -= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator-=(ZNumber(x));
   }
 
   /// \brief Multiplication assignment
   ZNumber& operator*=(const ZNumber& x) {
-    this->_n *= x._n;
+    SmallInt r;
+    if (this->_is_small && x._is_small &&
+        !__builtin_mul_overflow(this->_small, x._small, &r)) {
+      this->_small = r;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_mul(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -410,16 +582,24 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator*=(T x) {
-    this->_n *= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator*=(ZNumber(x));
   }
 
   /// \brief Integer division assignment
   ///
   /// Integer division with rounding towards zero.
   ZNumber& operator/=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n /= x._n;
+    ikos_assert_msg(!x.is_zero(), "division by zero");
+    if (this->_is_small && x._is_small &&
+        !(this->_small == std::numeric_limits< SmallInt >::min() &&
+          x._small == -1)) {
+      this->_small /= x._small;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_tdiv_q(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -430,8 +610,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator/=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n /= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator/=(ZNumber(x));
   }
 
   /// \brief Remainder assignment
@@ -442,8 +621,15 @@ public:
   /// The sign of `x` is ignored, and the result will have the same sign as
   /// `this`.
   ZNumber& operator%=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n %= x._n;
+    ikos_assert_msg(!x.is_zero(), "division by zero");
+    if (this->_is_small && x._is_small) {
+      this->_small = (x._small == -1) ? 0 : (this->_small % x._small);
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_tdiv_r(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -458,13 +644,19 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator%=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n %= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator%=(ZNumber(x));
   }
 
   /// \brief Bitwise AND assignment
   ZNumber& operator&=(const ZNumber& x) {
-    this->_n &= x._n;
+    if (this->_is_small && x._is_small) {
+      this->_small &= x._small;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_and(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -472,13 +664,19 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator&=(T x) {
-    this->_n &= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator&=(ZNumber(x));
   }
 
   /// \brief Bitwise OR assignment
   ZNumber& operator|=(const ZNumber& x) {
-    this->_n |= x._n;
+    if (this->_is_small && x._is_small) {
+      this->_small |= x._small;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_ior(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -486,13 +684,19 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator|=(T x) {
-    this->_n |= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator|=(ZNumber(x));
   }
 
   /// \brief Bitwise XOR assignment
   ZNumber& operator^=(const ZNumber& x) {
-    this->_n ^= x._n;
+    if (this->_is_small && x._is_small) {
+      this->_small ^= x._small;
+      return *this;
+    }
+    MpzView y(x);
+    this->promote();
+    mpz_xor(this->_big, this->_big, y.get());
+    this->normalize();
     return *this;
   }
 
@@ -500,17 +704,16 @@ public:
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator^=(T x) {
-    this->_n ^= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator^=(ZNumber(x));
   }
 
   /// \brief Left binary shift assignment
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator<<=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n <<= x._n.get_ui();
+    ikos_assert_msg(x.sign() >= 0, "shift count is negative");
+    ikos_assert_msg(x.fits< unsigned long >(), "shift count is too big");
+    this->shift_left(x.to< unsigned long >());
     return *this;
   }
 
@@ -521,7 +724,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator<<=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n <<= static_cast< unsigned long int >(x);
+    this->shift_left(static_cast< unsigned long int >(x));
     return *this;
   }
 
@@ -529,9 +732,9 @@ public:
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator>>=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n >>= x._n.get_ui();
+    ikos_assert_msg(x.sign() >= 0, "shift count is negative");
+    ikos_assert_msg(x.fits< unsigned long >(), "shift count is too big");
+    this->shift_right(x.to< unsigned long >());
     return *this;
   }
 
@@ -542,7 +745,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator>>=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n >>= static_cast< unsigned long int >(x);
+    this->shift_right(static_cast< unsigned long int >(x));
     return *this;
   }
 
@@ -555,30 +758,51 @@ public:
 
   /// \brief Prefix increment
   ZNumber& operator++() {
-    ++this->_n;
+    if (this->_is_small &&
+        this->_small != std::numeric_limits< SmallInt >::max()) {
+      ++this->_small;
+      return *this;
+    }
+    this->promote();
+    mpz_add_ui(this->_big, this->_big, 1);
+    this->normalize();
     return *this;
   }
 
   /// \brief Postfix increment
   const ZNumber operator++(int) {
     ZNumber r(*this);
-    ++this->_n;
+    ++(*this);
     return r;
   }
 
   /// \brief Unary minus
-  const ZNumber operator-() const { return ZNumber(-this->_n); }
+  const ZNumber operator-() const {
+    if (this->_is_small &&
+        this->_small != std::numeric_limits< SmallInt >::min()) {
+      return ZNumber(-this->_small);
+    }
+    MpzView x(*this);
+    return adopt([&x](mpz_ptr r) { mpz_neg(r, x.get()); });
+  }
 
   /// \brief Prefix decrement
   ZNumber& operator--() {
-    --this->_n;
+    if (this->_is_small &&
+        this->_small != std::numeric_limits< SmallInt >::min()) {
+      --this->_small;
+      return *this;
+    }
+    this->promote();
+    mpz_sub_ui(this->_big, this->_big, 1);
+    this->normalize();
     return *this;
   }
 
   /// \brief Postfix decrement
   const ZNumber operator--(int) {
     ZNumber r(*this);
-    --this->_n;
+    --(*this);
     return r;
   }
 
@@ -586,14 +810,17 @@ public:
   ///
   /// This is undefined for negative numbers.
   ZNumber next_power_of_2() const {
-    ikos_assert(this->_n >= 0);
+    ikos_assert(this->sign() >= 0);
 
-    if (this->_n <= 1) {
+    if (this->_is_small && this->_small <= 1) {
       return ZNumber(1);
     }
 
-    ZNumber n(this->_n - 1);
-    return ZNumber(mpz_class(1) << n.size_in_bits());
+    ZNumber n(*this);
+    --n;
+    ZNumber r(1);
+    r.shift_left(n.size_in_bits());
+    return r;
   }
 
   /// @}
@@ -604,54 +831,191 @@ public:
   ///
   /// This is undefined if the number is 0.
   uint64_t trailing_zeros() const {
-    ikos_assert(this->_n != 0);
-    return mpz_scan1(this->_n.get_mpz_t(), 0);
+    ikos_assert(!this->is_zero());
+    if (this->_is_small) {
+      return static_cast< uint64_t >(
+          __builtin_ctzl(static_cast< unsigned long >(this->_small)));
+    }
+    return mpz_scan1(this->_big, 0);
   }
 
   /// \brief Return the number of trailing '1' bits
   ///
   /// This is undefined if the number is -1.
   uint64_t trailing_ones() const {
-    ikos_assert(this->_n != -1);
-    return mpz_scan0(this->_n.get_mpz_t(), 0);
+    ikos_assert(!(this->_is_small && this->_small == -1));
+    if (this->_is_small) {
+      return static_cast< uint64_t >(
+          __builtin_ctzl(~static_cast< unsigned long >(this->_small)));
+    }
+    return mpz_scan0(this->_big, 0);
   }
 
   /// \brief Return the number of bits
   ///
   /// The sign is ignored.
   uint64_t size_in_bits() const {
-    return mpz_sizeinbase(this->_n.get_mpz_t(), 2);
+    if (this->_is_small) {
+      if (this->_small == 0) {
+        return 1;
+      }
+      auto n = this->_small < 0
+                   ? -static_cast< unsigned long >(this->_small)
+                   : static_cast< unsigned long >(this->_small);
+      return std::numeric_limits< unsigned long >::digits -
+             static_cast< uint64_t >(__builtin_clzl(n));
+    }
+    return mpz_sizeinbase(this->_big, 2);
   }
 
   /// @}
   /// \name Conversion Functions
   /// @{
 
-  /// \brief Get the internal representation
-  const mpz_class& mpz() const { return this->_n; }
+  /// \brief Return the number as a mpz_class
+  mpz_class mpz() const { return mpz_class(MpzView(*this).get()); }
 
   /// \brief Return true if the number fits in the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   bool fits() const {
-    return detail::MpzFits< T >()(this->_n);
+    if (this->_is_small) {
+      return detail::LongFits< T >()(this->_small);
+    }
+    return detail::MpzFits< T >()(this->mpz());
   }
 
   /// \brief Return the number as the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   T to() const {
-    ikos_assert_msg(detail::MpzFits< T >()(this->_n), "does not fit");
-    return detail::MpzTo< T >()(this->_n);
+    ikos_assert_msg(this->fits< T >(), "does not fit");
+    if (this->_is_small) {
+      return static_cast< T >(this->_small);
+    }
+    return detail::MpzTo< T >()(this->mpz());
   }
 
   /// \brief Return a string representation of the ZNumber in the given base
   ///
   /// The base can vary from 2 to 36, or from -2 to -36
-  std::string str(int base = 10) const { return this->_n.get_str(base); }
+  std::string str(int base = 10) const {
+    if (this->_is_small && base == 10) {
+      return std::to_string(this->_small);
+    }
+    MpzView n(*this);
+    std::string s(mpz_sizeinbase(n.get(), std::abs(base)) + 2, '\0');
+    mpz_get_str(&s[0], base, n.get());
+    s.resize(std::strlen(s.c_str()));
+    return s;
+  }
 
   /// @}
 
+private:
+  /// \brief Return true if the number is 0
+  bool is_zero() const { return this->_is_small && this->_small == 0; }
+
+  /// \brief Return -1, 0 or 1 depending on the sign of the number
+  int sign() const {
+    if (this->_is_small) {
+      return (this->_small > 0) - (this->_small < 0);
+    }
+    return mpz_sgn(this->_big);
+  }
+
+  /// \brief Release the GMP number, if any, and switch to an inline number
+  void clear() {
+    if (!this->_is_small) {
+      mpz_clear(this->_big);
+      this->_is_small = true;
+      this->_small = 0;
+    }
+  }
+
+  /// \brief Take the value of `o`, leaving it equal to 0
+  ///
+  /// This must only be called on an inline number.
+  void steal(ZNumber& o) noexcept {
+    if (o._is_small) {
+      this->_small = o._small;
+    } else {
+      this->_big[0] = o._big[0];
+      this->_is_small = false;
+      o._is_small = true;
+      o._small = 0;
+    }
+  }
+
+  /// \brief Switch to a GMP number, keeping the same value
+  void promote() {
+    if (this->_is_small) {
+      SmallInt n = this->_small;
+      mpz_init_set_si(this->_big, n);
+      this->_is_small = false;
+    }
+  }
+
+  /// \brief Switch back to an inline number, if the value fits
+  void normalize() {
+    if (!this->_is_small && mpz_fits_slong_p(this->_big)) {
+      SmallInt n = mpz_get_si(this->_big);
+      mpz_clear(this->_big);
+      this->_is_small = true;
+      this->_small = n;
+    }
+  }
+
+  /// \brief Create a ZNumber from a GMP operation writing its result in `r`
+  template < typename F >
+  static ZNumber adopt(F f) {
+    ZNumber r;
+    mpz_init(r._big);
+    r._is_small = false;
+    f(r._big);
+    r.normalize();
+    return r;
+  }
+
+  /// \brief Left binary shift assignment
+  void shift_left(unsigned long n) {
+    if (this->_is_small) {
+      if (this->_small == 0) {
+        return;
+      }
+      if (n < std::numeric_limits< unsigned long >::digits) {
+        auto r = static_cast< SmallInt >(
+            static_cast< unsigned long >(this->_small) << n);
+        if ((r >> n) == this->_small) {
+          this->_small = r;
+          return;
+        }
+      }
+    }
+    this->promote();
+    mpz_mul_2exp(this->_big, this->_big, n);
+    this->normalize();
+  }
+
+  /// \brief Right binary shift assignment, rounding towards -oo
+  void shift_right(unsigned long n) {
+    if (this->_is_small) {
+      if (n < std::numeric_limits< unsigned long >::digits) {
+        this->_small >>= n;
+      } else {
+        this->_small = (this->_small < 0) ? -1 : 0;
+      }
+      return;
+    }
+    mpz_fdiv_q_2exp(this->_big, this->_big, n);
+    this->normalize();
+  }
+
+public:
+  friend bool operator==(const ZNumber&, const ZNumber&);
+
+  friend bool operator<(const ZNumber&, const ZNumber&);
+
   friend ZNumber mod(const ZNumber&, const ZNumber&);
 
   friend ZNumber gcd(const ZNumber&, const ZNumber&);
@@ -661,18 +1025,9 @@ public:
   friend void gcd_extended(
       const ZNumber&, const ZNumber&, ZNumber&, ZNumber&, ZNumber&);
 
-  friend std::istream& operator>>(std::istream& i, ZNumber& n);
+  friend std::ostream& operator<<(std::ostream& o, const ZNumber& n);
 
-  friend class QNumber;
-
-  friend ZNumber single_mask(const ZNumber& size);
-
-  friend ZNumber double_mask(const ZNumber& low, const ZNumber& high);
-
-  friend ZNumber make_clipped_mask(const ZNumber& low,
-                                   const ZNumber& size,
-                                   const ZNumber& lower_clip,
-                                   const ZNumber& size_clip);
+  friend std::size_t hash_value(const ZNumber&);
 
 }; // end class ZNumber
 
@@ -681,67 +1036,74 @@ public:
 
 /// \brief Addition
 inline ZNumber operator+(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() + rhs.mpz());
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() + detail::MpzAdapter< T >()(rhs));
+  return lhs + ZNumber(rhs);
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) + rhs.mpz());
+  return ZNumber(lhs) + rhs;
 }
 
 /// \brief Subtraction
 inline ZNumber operator-(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() - rhs.mpz());
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() - detail::MpzAdapter< T >()(rhs));
+  return lhs - ZNumber(rhs);
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) - rhs.mpz());
+  return ZNumber(lhs) - rhs;
 }
 
 /// \brief Multiplication
 inline ZNumber operator*(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() * rhs.mpz());
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() * detail::MpzAdapter< T >()(rhs));
+  return lhs * ZNumber(rhs);
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) * rhs.mpz());
+  return ZNumber(lhs) * rhs;
 }
 
 /// \brief Integer division
 ///
 /// Integer division with rounding towards zero.
 inline ZNumber operator/(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() / rhs.mpz());
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Integer division with integral types
@@ -751,7 +1113,7 @@ template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(const ZNumber& lhs, T rhs) {
   ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() / detail::MpzAdapter< T >()(rhs));
+  return lhs / ZNumber(rhs);
 }
 
 /// \brief Integer division with integral types
@@ -760,8 +1122,7 @@ inline ZNumber operator/(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) / rhs.mpz());
+  return ZNumber(lhs) / rhs;
 }
 
 /// \brief Remainder
@@ -772,8 +1133,9 @@ inline ZNumber operator/(T lhs, const ZNumber& rhs) {
 /// The sign of `rhs` is ignored, and the result will have the same sign as
 /// `lhs`.
 inline ZNumber operator%(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() % rhs.mpz());
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Remainder with integral types
@@ -787,7 +1149,7 @@ template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(const ZNumber& lhs, T rhs) {
   ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() % detail::MpzAdapter< T >()(rhs));
+  return lhs % ZNumber(rhs);
 }
 
 /// \brief Remainder with integral types
@@ -800,74 +1162,79 @@ inline ZNumber operator%(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) % rhs.mpz());
+  return ZNumber(lhs) % rhs;
 }
 
 /// \brief Bitwise AND
 inline ZNumber operator&(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() & rhs.mpz());
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() & detail::MpzAdapter< T >()(rhs));
+  return lhs & ZNumber(rhs);
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) & rhs.mpz());
+  return ZNumber(lhs) & rhs;
 }
 
 /// \brief Bitwise OR
 inline ZNumber operator|(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() | rhs.mpz());
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() | detail::MpzAdapter< T >()(rhs));
+  return lhs | ZNumber(rhs);
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) | rhs.mpz());
+  return ZNumber(lhs) | rhs;
 }
 
 /// \brief Bitwise XOR
 inline ZNumber operator^(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() ^ rhs.mpz());
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() ^ detail::MpzAdapter< T >()(rhs));
+  return lhs ^ ZNumber(rhs);
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) ^ rhs.mpz());
+  return ZNumber(lhs) ^ rhs;
 }
 
 /// \brief Left binary shift
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() << rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -876,8 +1243,9 @@ inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator<<(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() << static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -895,9 +1263,9 @@ inline ZNumber operator<<(T lhs, const ZNumber& rhs) {
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() >> rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -906,8 +1274,9 @@ inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator>>(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() >> static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -927,116 +1296,130 @@ inline ZNumber operator>>(T lhs, const ZNumber& rhs) {
 
 /// \brief Equality operator
 inline bool operator==(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() == rhs.mpz();
+  if (lhs._is_small && rhs._is_small) {
+    return lhs._small == rhs._small;
+  } else if (lhs._is_small || rhs._is_small) {
+    return false;
+  } else {
+    return mpz_cmp(lhs._big, rhs._big) == 0;
+  }
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() == detail::MpzAdapter< T >()(rhs);
+  return lhs == ZNumber(rhs);
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) == rhs.mpz();
+  return ZNumber(lhs) == rhs;
 }
 
 /// \brief Inequality operator
 inline bool operator!=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() != rhs.mpz();
+  return !(lhs == rhs);
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() != detail::MpzAdapter< T >()(rhs);
+  return !(lhs == ZNumber(rhs));
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) != rhs.mpz();
+  return !(ZNumber(lhs) == rhs);
 }
 
 /// \brief Less than comparison
 inline bool operator<(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() < rhs.mpz();
+  if (lhs._is_small && rhs._is_small) {
+    return lhs._small < rhs._small;
+  } else if (lhs._is_small) {
+    return mpz_cmp_si(rhs._big, lhs._small) > 0;
+  } else if (rhs._is_small) {
+    return mpz_cmp_si(lhs._big, rhs._small) < 0;
+  } else {
+    return mpz_cmp(lhs._big, rhs._big) < 0;
+  }
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() < detail::MpzAdapter< T >()(rhs);
+  return lhs < ZNumber(rhs);
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) < rhs.mpz();
+  return ZNumber(lhs) < rhs;
 }
 
 /// \brief Less or equal comparison
 inline bool operator<=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() <= rhs.mpz();
+  return !(rhs < lhs);
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() <= detail::MpzAdapter< T >()(rhs);
+  return !(ZNumber(rhs) < lhs);
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) <= rhs.mpz();
+  return !(rhs < ZNumber(lhs));
 }
 
 /// \brief Greater than comparison
 inline bool operator>(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() > rhs.mpz();
+  return rhs < lhs;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() > detail::MpzAdapter< T >()(rhs);
+  return ZNumber(rhs) < lhs;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) > rhs.mpz();
+  return rhs < ZNumber(lhs);
 }
 
 /// \brief Greater or equal comparison
 inline bool operator>=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() >= rhs.mpz();
+  return !(lhs < rhs);
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() >= detail::MpzAdapter< T >()(rhs);
+  return !(lhs < ZNumber(rhs));
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) >= rhs.mpz();
+  return !(ZNumber(lhs) < rhs);
 }
 
 /// @}
@@ -1090,15 +1473,26 @@ inline const ZNumber& max(const ZNumber& a,
 ///
 /// The sign of `d` is ignored, and the result is always non-negative.
 inline ZNumber mod(const ZNumber& n, const ZNumber& d) {
-  ikos_assert_msg(d.mpz() != 0, "division by zero");
-  ZNumber r;
-  mpz_mod(r._n.get_mpz_t(), n._n.get_mpz_t(), d._n.get_mpz_t());
-  return r;
+  ikos_assert_msg(!d.is_zero(), "division by zero");
+  if (n._is_small && d._is_small) {
+    if (d._small == -1) {
+      return ZNumber(0);
+    }
+    ZNumber::SmallInt r = n._small % d._small;
+    if (r < 0) {
+      r = (d._small < 0) ? (r - d._small) : (r + d._small);
+    }
+    return ZNumber(r);
+  }
+  ZNumber::MpzView x(n);
+  ZNumber::MpzView y(d);
+  return ZNumber::adopt(
+      [&x, &y](mpz_ptr r) { mpz_mod(r, x.get(), y.get()); });
 }
 
 /// \brief Return the absolute value of the given number
 inline ZNumber abs(const ZNumber& n) {
-  return ZNumber(abs(n.mpz()));
+  return (n < 0) ? -n : n;
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1107,9 +1501,23 @@ inline ZNumber abs(const ZNumber& n) {
 /// negative. Except if both inputs are zero; then this function defines
 /// `gcd(0, 0) = 0`.
 inline ZNumber gcd(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_gcd(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  using SmallInt = ZNumber::SmallInt;
+  if (a._is_small && b._is_small &&
+      a._small != std::numeric_limits< SmallInt >::min() &&
+      b._small != std::numeric_limits< SmallInt >::min()) {
+    SmallInt x = std::abs(a._small);
+    SmallInt y = std::abs(b._small);
+    while (y != 0) {
+      SmallInt t = x % y;
+      x = y;
+      y = t;
+    }
+    return ZNumber(x);
+  }
+  ZNumber::MpzView x(a);
+  ZNumber::MpzView y(b);
+  return ZNumber::adopt(
+      [&x, &y](mpz_ptr r) { mpz_gcd(r, x.get(), y.get()); });
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1119,9 +1527,25 @@ inline ZNumber gcd(const ZNumber& a, const ZNumber& b, const ZNumber& c) {
 
 /// \brief Return the least common multiple of the given numbers
 inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_lcm(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  using SmallInt = ZNumber::SmallInt;
+  if (a.is_zero() || b.is_zero()) {
+    return ZNumber(0);
+  }
+  if (a._is_small && b._is_small &&
+      a._small != std::numeric_limits< SmallInt >::min() &&
+      b._small != std::numeric_limits< SmallInt >::min()) {
+    SmallInt g = gcd(a, b)._small;
+    SmallInt r;
+    if (!__builtin_mul_overflow(std::abs(a._small) / g,
+                                std::abs(b._small),
+                                &r)) {
+      return ZNumber(r);
+    }
+  }
+  ZNumber::MpzView x(a);
+  ZNumber::MpzView y(b);
+  return ZNumber::adopt(
+      [&x, &y](mpz_ptr r) { mpz_lcm(r, x.get(), y.get()); });
 }
 
 /// \brief Run Euclid's algorithm
@@ -1132,11 +1556,50 @@ inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
 /// negative (or zero if both inputs are zero).
 inline void gcd_extended(
     const ZNumber& a, const ZNumber& b, ZNumber& g, ZNumber& u, ZNumber& v) {
-  mpz_gcdext(g._n.get_mpz_t(),
-             u._n.get_mpz_t(),
-             v._n.get_mpz_t(),
-             a._n.get_mpz_t(),
-             b._n.get_mpz_t());
+  using SmallInt = ZNumber::SmallInt;
+  if (a._is_small && b._is_small &&
+      a._small != std::numeric_limits< SmallInt >::min() &&
+      b._small != std::numeric_limits< SmallInt >::min()) {
+    // Coefficients are bounded by `max(abs(a), abs(b))`, hence they never
+    // overflow
+    SmallInt r0 = a._small, r1 = b._small;
+    SmallInt s0 = 1, s1 = 0;
+    SmallInt t0 = 0, t1 = 1;
+    while (r1 != 0) {
+      SmallInt q = r0 / r1;
+      SmallInt tmp = r0 - q * r1;
+      r0 = r1;
+      r1 = tmp;
+      tmp = s0 - q * s1;
+      s0 = s1;
+      s1 = tmp;
+      tmp = t0 - q * t1;
+      t0 = t1;
+      t1 = tmp;
+    }
+    if (r0 < 0) {
+      r0 = -r0;
+      s0 = -s0;
+      t0 = -t0;
+    }
+    g = ZNumber(r0);
+    u = ZNumber(s0);
+    v = ZNumber(t0);
+    return;
+  }
+  ZNumber::MpzView x(a);
+  ZNumber::MpzView y(b);
+  ZNumber rg, ru, rv;
+  rg.promote();
+  ru.promote();
+  rv.promote();
+  mpz_gcdext(rg._big, ru._big, rv._big, x.get(), y.get());
+  rg.normalize();
+  ru.normalize();
+  rv.normalize();
+  g = std::move(rg);
+  u = std::move(ru);
+  v = std::move(rv);
 }
 
 /// @}
@@ -1145,13 +1608,20 @@ inline void gcd_extended(
 
 /// \brief Write a ZNumber on a stream, in base 10
 inline std::ostream& operator<<(std::ostream& o, const ZNumber& n) {
-  o << n.mpz();
+  if (n._is_small) {
+    o << n._small;
+  } else {
+    o << static_cast< mpz_srcptr >(n._big);
+  }
   return o;
 }
 
 /// \brief Read a ZNumber from a stream, in base 10
 inline std::istream& operator>>(std::istream& i, ZNumber& n) {
-  i >> n._n;
+  mpz_class m;
+  if (i >> m) {
+    n = ZNumber(std::move(m));
+  }
   return i;
 }
 
@@ -1159,12 +1629,15 @@ inline std::istream& operator>>(std::istream& i, ZNumber& n) {
 
 /// \brief Return the hash of a ZNumber
 inline std::size_t hash_value(const ZNumber& n) {
-  const mpz_class& m = n.mpz();
   std::size_t result = 0;
-  boost::hash_combine(result, m.get_mpz_t()[0]._mp_size);
-  for (int i = 0, e = std::abs(m.get_mpz_t()[0]._mp_size); i < e; ++i) {
+  if (n._is_small) {
+    boost::hash_combine(result, n._small);
+    return result;
+  }
+  boost::hash_combine(result, n._big[0]._mp_size);
+  for (int i = 0, e = std::abs(n._big[0]._mp_size); i < e; ++i) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    boost::hash_combine(result, m.get_mpz_t()[0]._mp_d[i]);
+    boost::hash_combine(result, n._big[0]._mp_d[i]);
   }
   return result;
 }
@@ -45,6 +45,8 @@
 
 #include <sstream>
 
+#include <boost/functional/hash.hpp>
+
 #include <ikos/core/domain/abstract_domain.hpp>
 #include <ikos/core/support/assert.hpp>
 
@@ -179,7 +181,14 @@ public:
 
   static std::string name() { return "lifetime"; }
 
+  friend std::size_t hash_value(const Lifetime&);
+
 }; // end class Lifetime
 
+/// \brief Return the hash of a lifetime value
+inline std::size_t hash_value(const Lifetime& value) {
+  return boost::hash< unsigned >()(value._kind);
+}
+
 } // end namespace core
 } // end namespace ikos
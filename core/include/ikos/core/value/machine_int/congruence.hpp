@@ -51,6 +51,7 @@
 
 #pragma once
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -72,7 +73,9 @@ private:
   /// Use the congruence on unlimited precision integers (ZNumber) internally
   ///
   /// Writing a congruence class using MachineInt appears to be very hard,
-  /// because of overflows and the limited bit-width for the modulus.
+  /// because of overflows and the limited bit-width for the modulus: the
+  /// modulus of a wrapped congruence can be 2**bit_width. Only constants are
+  /// wrapped on 64-bit integers, see wrap().
 
 private:
   /// \brief Congruence on unlimited precision integers
@@ -150,6 +153,11 @@ private:
                           Signedness sign) {
     if (c.is_bottom()) {
       return ZCongruence::bottom();
+    } else if (bit_width <= 64 && c.modulus() == 0 &&
+               c.residue().fits< int64_t >()) {
+      // Constant, wrapped on 64-bit integers
+      return ZCongruence(
+          MachineInt(c.residue(), bit_width, sign).to_z_number());
     } else if (sign == Signed) {
       ZNumber n = power_of_2(bit_width);
       ZNumber m = power_of_2(bit_width - 1);
@@ -841,6 +849,15 @@ inline Congruence xor_(const Congruence& lhs, const Congruence& rhs) {
 /// \name Input / Output
 /// @{
 
+/// \brief Return the hash of a congruence
+inline std::size_t hash_value(const Congruence& congruence) {
+  std::size_t result = 0;
+  boost::hash_combine(result, congruence.to_z_congruence());
+  boost::hash_combine(result, congruence.bit_width());
+  boost::hash_combine(result, static_cast< unsigned >(congruence.sign()));
+  return result;
+}
+
 /// \brief Write a congruence on a stream
 inline std::ostream& operator<<(std::ostream& o, const Congruence& congruence) {
   congruence.dump(o);
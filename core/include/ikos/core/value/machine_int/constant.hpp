@@ -43,6 +43,7 @@
 
 #pragma once
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -712,6 +713,17 @@ inline Constant xor_(const Constant& lhs, const Constant& rhs) {
 /// \name Input / Output
 /// @{
 
+/// \brief Return the hash of a constant
+inline std::size_t hash_value(const Constant& constant) {
+  std::size_t result = 0;
+  boost::hash_combine(result, constant.is_bottom());
+  boost::hash_combine(result, constant.is_top());
+  if (constant.is_integer()) {
+    boost::hash_combine(result, *constant.integer());
+  }
+  return result;
+}
+
 /// \brief Write a constant on a stream
 inline std::ostream& operator<<(std::ostream& o, const Constant& constant) {
   constant.dump(o);
@@ -43,6 +43,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -463,6 +468,293 @@ public:
 
   /// @}
 
+private:
+  /// \name Native Arithmetic
+  ///
+  /// For bit widths up to 64, the bounds of arithmetic operations are computed
+  /// on 64-bit integers with overflow intrinsics, instead of a ZInterval.
+  /// Signed integers and unsigned integers of less than 64 bits use int64_t,
+  /// unsigned 64-bit integers use uint64_t.
+  ///
+  /// These return boost::none when a bound cannot be represented, and the
+  /// caller falls back to the ZInterval operation.
+  /// @{
+
+  /// \brief Return true if the bounds are handled as int64_t
+  bool is_int64() const {
+    return this->bit_width() < 64 ||
+           (this->bit_width() == 64 && this->sign() == Signed);
+  }
+
+  /// \brief Return true if the bounds are handled as uint64_t
+  bool is_uint64() const {
+    return this->bit_width() == 64 && this->sign() == Unsigned;
+  }
+
+  /// \brief Create an interval from bounds computed on int64_t, with wrapping
+  static Interval from_int64(int64_t lb,
+                             int64_t ub,
+                             uint64_t bit_width,
+                             Signedness sign,
+                             WrapTag) {
+    ikos_assert(lb <= ub);
+    uint64_t span = static_cast< uint64_t >(ub) - static_cast< uint64_t >(lb);
+
+    if (bit_width < 64 && (span >> bit_width) != 0) {
+      return top(bit_width, sign);
+    }
+
+    MachineInt i_lb(lb, bit_width, sign);
+    MachineInt i_ub(ub, bit_width, sign);
+
+    if (i_lb <= i_ub) {
+      return Interval(std::move(i_lb), std::move(i_ub));
+    }
+
+    return top(bit_width, sign);
+  }
+
+  /// \brief Create an interval from bounds computed on int64_t, with
+  /// truncation
+  static Interval from_int64(int64_t lb,
+                             int64_t ub,
+                             uint64_t bit_width,
+                             Signedness sign,
+                             TruncTag) {
+    int64_t min, max;
+
+    if (sign == Signed) {
+      max = static_cast< int64_t >((uint64_t(1) << (bit_width - 1)) - 1);
+      min = -max - 1;
+    } else {
+      max = static_cast< int64_t >((uint64_t(1) << bit_width) - 1);
+      min = 0;
+    }
+
+    lb = std::max(lb, min);
+    ub = std::min(ub, max);
+
+    if (lb > ub) {
+      return bottom(bit_width, sign);
+    }
+
+    return Interval(MachineInt(lb, bit_width, sign),
+                    MachineInt(ub, bit_width, sign));
+  }
+
+  /// \brief Create an interval from bounds computed on uint64_t, with wrapping
+  ///
+  /// `wrapped` is the number of bounds that wrapped around 2**64, in the same
+  /// direction. `upward` is true if the bounds wrapped by overflowing, false
+  /// if they wrapped by underflowing.
+  static Interval from_uint64(uint64_t lb,
+                              uint64_t ub,
+                              unsigned wrapped,
+                              bool /*upward*/,
+                              WrapTag) {
+    if (wrapped == 1) {
+      // The interval crosses 2**64
+      return top(64, Unsigned);
+    }
+
+    return Interval(MachineInt(lb, 64, Unsigned), MachineInt(ub, 64, Unsigned));
+  }
+
+  /// \brief Create an interval from bounds computed on uint64_t, with
+  /// truncation
+  ///
+  /// `wrapped` is the number of bounds that wrapped around 2**64, in the same
+  /// direction. `upward` is true if the bounds wrapped by overflowing, false
+  /// if they wrapped by underflowing.
+  static Interval from_uint64(
+      uint64_t lb, uint64_t ub, unsigned wrapped, bool upward, TruncTag) {
+    if (wrapped == 2) {
+      return bottom(64, Unsigned);
+    } else if (wrapped == 1) {
+      if (upward) {
+        ub = std::numeric_limits< uint64_t >::max();
+      } else {
+        lb = 0;
+      }
+    }
+
+    return Interval(MachineInt(lb, 64, Unsigned), MachineInt(ub, 64, Unsigned));
+  }
+
+  /// \brief Compute the bounds of [a, b] * [c, d] on int64_t
+  ///
+  /// Returns false if a product overflows.
+  static bool mul_int64(
+      int64_t a, int64_t b, int64_t c, int64_t d, int64_t& lb, int64_t& ub) {
+    int64_t p[4];
+
+    if (__builtin_mul_overflow(a, c, &p[0]) ||
+        __builtin_mul_overflow(a, d, &p[1]) ||
+        __builtin_mul_overflow(b, c, &p[2]) ||
+        __builtin_mul_overflow(b, d, &p[3])) {
+      return false;
+    }
+
+    lb = std::min(std::min(p[0], p[1]), std::min(p[2], p[3]));
+    ub = std::max(std::max(p[0], p[1]), std::max(p[2], p[3]));
+    return true;
+  }
+
+  /// \brief Native addition
+  template < typename Tag >
+  static boost::optional< Interval > add_native(const Interval& lhs,
+                                                const Interval& rhs,
+                                                Tag tag) {
+    if (lhs.is_int64()) {
+      int64_t lb, ub;
+
+      if (__builtin_add_overflow(lhs._lb.to< int64_t >(),
+                                 rhs._lb.to< int64_t >(),
+                                 &lb) ||
+          __builtin_add_overflow(lhs._ub.to< int64_t >(),
+                                 rhs._ub.to< int64_t >(),
+                                 &ub)) {
+        return boost::none;
+      }
+
+      return from_int64(lb, ub, lhs.bit_width(), lhs.sign(), tag);
+    } else if (lhs.is_uint64()) {
+      uint64_t lb, ub;
+      unsigned wrapped = 0;
+      wrapped += __builtin_add_overflow(lhs._lb.to< uint64_t >(),
+                                        rhs._lb.to< uint64_t >(),
+                                        &lb);
+      wrapped += __builtin_add_overflow(lhs._ub.to< uint64_t >(),
+                                        rhs._ub.to< uint64_t >(),
+                                        &ub);
+      return from_uint64(lb, ub, wrapped, /*upward = */ true, tag);
+    } else {
+      return boost::none;
+    }
+  }
+
+  /// \brief Native subtraction
+  template < typename Tag >
+  static boost::optional< Interval > sub_native(const Interval& lhs,
+                                                const Interval& rhs,
+                                                Tag tag) {
+    if (lhs.is_int64()) {
+      int64_t lb, ub;
+
+      if (__builtin_sub_overflow(lhs._lb.to< int64_t >(),
+                                 rhs._ub.to< int64_t >(),
+                                 &lb) ||
+          __builtin_sub_overflow(lhs._ub.to< int64_t >(),
+                                 rhs._lb.to< int64_t >(),
+                                 &ub)) {
+        return boost::none;
+      }
+
+      return from_int64(lb, ub, lhs.bit_width(), lhs.sign(), tag);
+    } else if (lhs.is_uint64()) {
+      uint64_t lb, ub;
+      unsigned wrapped = 0;
+      wrapped += __builtin_sub_overflow(lhs._lb.to< uint64_t >(),
+                                        rhs._ub.to< uint64_t >(),
+                                        &lb);
+      wrapped += __builtin_sub_overflow(lhs._ub.to< uint64_t >(),
+                                        rhs._lb.to< uint64_t >(),
+                                        &ub);
+      return from_uint64(lb, ub, wrapped, /*upward = */ false, tag);
+    } else {
+      return boost::none;
+    }
+  }
+
+  /// \brief Native multiplication of `lhs` by the coefficients [c, d]
+  ///
+  /// The coefficients are given as raw 64-bit values of the same signedness
+  /// as `lhs`.
+  template < typename Tag >
+  static boost::optional< Interval > mul_native(const Interval& lhs,
+                                                uint64_t c,
+                                                uint64_t d,
+                                                Tag tag) {
+    if (lhs.is_int64()) {
+      int64_t lb, ub;
+
+      if (!mul_int64(lhs._lb.to< int64_t >(),
+                     lhs._ub.to< int64_t >(),
+                     static_cast< int64_t >(c),
+                     static_cast< int64_t >(d),
+                     lb,
+                     ub)) {
+        return boost::none;
+      }
+
+      return from_int64(lb, ub, lhs.bit_width(), lhs.sign(), tag);
+    } else if (lhs.is_uint64()) {
+      // All bounds are non-negative, hence the product is monotonic
+      uint64_t lb, ub;
+      bool lb_overflow =
+          __builtin_mul_overflow(lhs._lb.to< uint64_t >(), c, &lb);
+      bool ub_overflow =
+          __builtin_mul_overflow(lhs._ub.to< uint64_t >(), d, &ub);
+
+      if (lb_overflow && std::is_same< Tag, WrapTag >::value) {
+        // Bounds might wrap a different number of times
+        return boost::none;
+      }
+
+      return from_uint64(lb,
+                         ub,
+                         unsigned(lb_overflow) + unsigned(ub_overflow),
+                         /*upward = */ true,
+                         tag);
+    } else {
+      return boost::none;
+    }
+  }
+
+  /// \brief Native multiplication
+  template < typename Tag >
+  static boost::optional< Interval > mul_native(const Interval& lhs,
+                                                const Interval& rhs,
+                                                Tag tag) {
+    if (lhs.is_int64()) {
+      return mul_native(lhs,
+                        static_cast< uint64_t >(rhs._lb.to< int64_t >()),
+                        static_cast< uint64_t >(rhs._ub.to< int64_t >()),
+                        tag);
+    } else if (lhs.is_uint64()) {
+      return mul_native(lhs,
+                        rhs._lb.to< uint64_t >(),
+                        rhs._ub.to< uint64_t >(),
+                        tag);
+    } else {
+      return boost::none;
+    }
+  }
+
+  /// \brief Native left shift by [c, d], with 0 <= c <= d < bit_width
+  template < typename Tag >
+  static boost::optional< Interval > shl_native(const Interval& lhs,
+                                                const Interval& shift,
+                                                Tag tag) {
+    if (lhs.bit_width() > 64) {
+      return boost::none;
+    }
+
+    uint64_t c = shift._lb.to< uint64_t >();
+    uint64_t d = shift._ub.to< uint64_t >();
+
+    if (lhs.is_int64() && d >= 63) {
+      // 2**63 does not fit in a int64_t
+      return boost::none;
+    }
+
+    // [a, b] << [c, d] = [a, b] * [1 << c, 1 << d]
+    return mul_native(lhs, uint64_t(1) << c, uint64_t(1) << d, tag);
+  }
+
+  /// @}
+
+public:
   /// \brief If the interval is a singleton [n, n], return n, otherwise return
   /// boost::none
   boost::optional< MachineInt > singleton() const {
@@ -497,6 +789,18 @@ public:
 
   // Friends
 
+  friend Interval add(const Interval& lhs, const Interval& rhs);
+
+  friend Interval add_no_wrap(const Interval& lhs, const Interval& rhs);
+
+  friend Interval sub(const Interval& lhs, const Interval& rhs);
+
+  friend Interval sub_no_wrap(const Interval& lhs, const Interval& rhs);
+
+  friend Interval mul(const Interval& lhs, const Interval& rhs);
+
+  friend Interval mul_no_wrap(const Interval& lhs, const Interval& rhs);
+
   friend Interval rem(const Interval& lhs, const Interval& rhs);
 
   friend Interval shl(const Interval& lhs, const Interval& rhs);
@@ -525,6 +829,8 @@ inline Interval add(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::add_native(lhs, rhs, Interval::WrapTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() + rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -540,6 +846,8 @@ inline Interval add_no_wrap(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::add_native(lhs, rhs, Interval::TruncTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() + rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -555,6 +863,8 @@ inline Interval sub(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::sub_native(lhs, rhs, Interval::WrapTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() - rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -570,6 +880,8 @@ inline Interval sub_no_wrap(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::sub_native(lhs, rhs, Interval::TruncTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() - rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -585,6 +897,8 @@ inline Interval mul(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::mul_native(lhs, rhs, Interval::WrapTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() * rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -600,6 +914,8 @@ inline Interval mul_no_wrap(const Interval& lhs, const Interval& rhs) {
     return lhs;
   } else if (rhs.is_bottom()) {
     return rhs;
+  } else if (auto r = Interval::mul_native(lhs, rhs, Interval::TruncTag{})) {
+    return std::move(*r);
   } else {
     return Interval::from_z_interval(lhs.to_z_interval() * rhs.to_z_interval(),
                                      lhs.bit_width(),
@@ -706,6 +1022,10 @@ inline Interval shl(const Interval& lhs, const Interval& rhs) {
       return shift;
     }
 
+    if (auto r = Interval::shl_native(lhs, shift, Interval::WrapTag{})) {
+      return std::move(*r);
+    }
+
     // [a, b] << [c, d] = [a, b] * [1 << c, 1 << d]
     numeric::ZInterval coeff(ZBound(1 << shift._lb.to_z_number()),
                              ZBound(1 << shift._ub.to_z_number()));
@@ -738,6 +1058,10 @@ inline Interval shl_no_wrap(const Interval& lhs, const Interval& rhs) {
       return shift;
     }
 
+    if (auto r = Interval::shl_native(lhs, shift, Interval::TruncTag{})) {
+      return std::move(*r);
+    }
+
     // [a, b] << [c, d] = [a, b] * [1 << c, 1 << d]
     numeric::ZInterval coeff(ZBound(1 << shift._lb.to_z_number()),
                              ZBound(1 << shift._ub.to_z_number()));
@@ -964,6 +1288,17 @@ inline Interval xor_(const Interval& lhs, const Interval& rhs) {
 /// \name Input / Output
 /// @{
 
+/// \brief Return the hash of an interval
+inline std::size_t hash_value(const Interval& interval) {
+  std::size_t result = 0;
+  if (interval.is_bottom()) {
+    return result;
+  }
+  boost::hash_combine(result, interval.lb());
+  boost::hash_combine(result, interval.ub());
+  return result;
+}
+
 /// \brief Write an interval on a stream
 inline std::ostream& operator<<(std::ostream& o, const Interval& interval) {
   interval.dump(o);
@@ -802,6 +802,14 @@ inline IntervalCongruence xor_(const IntervalCongruence& lhs,
 /// \name Input / Output
 /// @{
 
+/// \brief Return the hash of an interval-congruence
+inline std::size_t hash_value(const IntervalCongruence& iv) {
+  std::size_t result = 0;
+  boost::hash_combine(result, iv.interval());
+  boost::hash_combine(result, iv.to_z_congruence());
+  return result;
+}
+
 /// \brief Write an interval-congruence on a stream
 inline std::ostream& operator<<(std::ostream& o, const IntervalCongruence& iv) {
   iv.dump(o);
@@ -45,6 +45,8 @@
 
 #include <sstream>
 
+#include <boost/functional/hash.hpp>
+
 #include <ikos/core/domain/abstract_domain.hpp>
 #include <ikos/core/support/assert.hpp>
 
@@ -179,7 +181,14 @@ public:
 
   static std::string name() { return "nullity"; }
 
+  friend std::size_t hash_value(const Nullity&);
+
 }; // end class Nullity
 
+/// \brief Return the hash of a nullity value
+inline std::size_t hash_value(const Nullity& value) {
+  return boost::hash< unsigned >()(value._kind);
+}
+
 } // end namespace core
 } // end namespace ikos
@@ -46,6 +46,7 @@
 
 #pragma once
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -835,6 +836,22 @@ inline Congruence< QNumber > operator/(const Congruence< QNumber >& lhs,
   return Congruence< QNumber >(lhs.to_constant() / rhs.to_constant());
 }
 
+/// \brief Return the hash of a congruence on integers
+inline std::size_t hash_value(const Congruence< ZNumber >& congruence) {
+  std::size_t result = 0;
+  if (congruence.is_bottom()) {
+    return result;
+  }
+  boost::hash_combine(result, congruence.modulus());
+  boost::hash_combine(result, congruence.residue());
+  return result;
+}
+
+/// \brief Return the hash of a congruence on rationals
+inline std::size_t hash_value(const Congruence< QNumber >& congruence) {
+  return hash_value(congruence.to_constant());
+}
+
 /// \brief Write a congruence on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o,
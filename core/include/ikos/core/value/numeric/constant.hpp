@@ -47,6 +47,7 @@
 
 #include <type_traits>
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -530,6 +531,18 @@ inline Constant< ZNumber > operator^(const Constant< ZNumber >& lhs,
   }
 }
 
+/// \brief Return the hash of a constant
+template < typename Number >
+inline std::size_t hash_value(const Constant< Number >& constant) {
+  std::size_t result = 0;
+  boost::hash_combine(result, constant.is_bottom());
+  boost::hash_combine(result, constant.is_top());
+  if (constant.is_number()) {
+    boost::hash_combine(result, *constant.number());
+  }
+  return result;
+}
+
 /// \brief Write a constant on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o,
@@ -49,6 +49,7 @@
 
 #include <type_traits>
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/abstract_domain.hpp>
@@ -754,6 +755,18 @@ inline Interval< ZNumber > operator^(const Interval< ZNumber >& lhs,
   }
 }
 
+/// \brief Return the hash of an interval
+template < typename Number >
+inline std::size_t hash_value(const Interval< Number >& interval) {
+  std::size_t result = 0;
+  if (interval.is_bottom()) {
+    return result;
+  }
+  boost::hash_combine(result, interval.lb());
+  boost::hash_combine(result, interval.ub());
+  return result;
+}
+
 /// \brief Write an interval on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o,
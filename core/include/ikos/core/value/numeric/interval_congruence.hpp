@@ -566,6 +566,18 @@ inline IntervalCongruence< QNumber > operator/(
   return IntervalCongruence< QNumber >(lhs.interval() / rhs.interval());
 }
 
+/// \brief Return the hash of an interval-congruence
+template < typename Number >
+inline std::size_t hash_value(const IntervalCongruence< Number >& iv) {
+  std::size_t result = 0;
+  if (iv.is_bottom()) {
+    return result;
+  }
+  boost::hash_combine(result, iv.interval());
+  boost::hash_combine(result, iv.congruence());
+  return result;
+}
+
 /// \brief Write an interval-congruence on a stream
 template < typename Number >
 inline std::ostream& operator<<(std::ostream& o,
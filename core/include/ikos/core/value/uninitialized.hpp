@@ -45,6 +45,8 @@
 
 #include <sstream>
 
+#include <boost/functional/hash.hpp>
+
 #include <ikos/core/domain/abstract_domain.hpp>
 #include <ikos/core/support/assert.hpp>
 
@@ -185,7 +187,14 @@ public:
 
   static std::string name() { return "uninitialized"; }
 
+  friend std::size_t hash_value(const Uninitialized&);
+
 }; // end class Uninitialized
 
+/// \brief Return the hash of an uninitialized value
+inline std::size_t hash_value(const Uninitialized& value) {
+  return boost::hash< unsigned >()(value._kind);
+}
+
 } // end namespace core
 } // end namespace ikos
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * Benchmark of patricia tree maps (join, meet, leq)
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <thread>
+
+#include <boost/optional.hpp>
+
+#include <ikos/core/adt/patricia_tree/map.hpp>
+
+#include "../../benchmark.hpp"
+
+using Index = ikos::core::Index;
+using Map = ikos::core::PatriciaTreeMap< Index, long >;
+
+namespace benchmark = ikos::core::benchmark;
+
+namespace {
+
+/// \brief Number of calls to the global operator new
+std::atomic< std::size_t > NumAllocations{0};
+
+} // end anonymous namespace
+
+void* operator new(std::size_t size) {
+  NumAllocations++;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+/// \brief Return a map of `n` random keys
+Map make_map(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution< Index > key(0, 16 * n);
+  Map m;
+  for (std::size_t i = 0; i < n; i++) {
+    m.insert_or_assign(key(rng), static_cast< long >(i));
+  }
+  return m;
+}
+
+/// \brief Return `m` with `n` updated keys, sharing the other subtrees
+Map update_map(const Map& m, std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::vector< Index > keys;
+  for (const auto& entry : m) {
+    keys.push_back(entry.first);
+  }
+  std::uniform_int_distribution< std::size_t > pick(0, keys.size() - 1);
+  Map r = m;
+  for (std::size_t i = 0; i < n; i++) {
+    r.insert_or_assign(keys[pick(rng)], -static_cast< long >(i));
+  }
+  return r;
+}
+
+boost::optional< long > max(long a, long b) {
+  return std::max(a, b);
+}
+
+boost::optional< long > min(long a, long b) {
+  return std::min(a, b);
+}
+
+/// \brief Measure `f` and print the global allocations of one run
+template < typename Function >
+void measure(const std::string& name, int iterations, Function f) {
+  NumAllocations = 0;
+  f();
+  std::size_t allocations = NumAllocations.load();
+  benchmark::measure(name, [&] {
+    for (int i = 0; i < iterations; i++) {
+      f();
+    }
+  });
+  std::cout << "  operator new calls per run: " << allocations << "\n";
+}
+
+/// \brief Run all the cases on maps of `n` elements
+void run(std::size_t n, int iterations) {
+  Map m1 = make_map(n, 1);
+  Map m2 = make_map(n, 2);
+  Map m3 = update_map(m1, n / 100, 3);
+
+  measure("join, disjoint trees", iterations, [&] {
+    benchmark::do_not_optimize(m1.join(m2, max));
+  });
+  measure("join, 1% updated", iterations, [&] {
+    benchmark::do_not_optimize(m1.join(m3, max));
+  });
+  measure("meet, disjoint trees", iterations, [&] {
+    benchmark::do_not_optimize(m1.intersect(m2, min));
+  });
+  measure("meet, 1% updated", iterations, [&] {
+    benchmark::do_not_optimize(m1.intersect(m3, min));
+  });
+  measure("leq, 1% updated", iterations, [&] {
+    bool r = m3.leq(m1, std::less_equal<>());
+    benchmark::do_not_optimize(r);
+  });
+  measure("copy and destroy", iterations, [&] {
+    Map copy = m1;
+    copy.insert_or_assign(0, 0);
+    benchmark::do_not_optimize(copy);
+  });
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  int iterations = benchmark::scale(argc, argv, 20);
+  std::size_t n = 100000;
+
+  // Reference counts are never atomic in a process without threads
+  std::thread([] {}).join();
+
+  std::cout << "maps of " << n << " elements, " << iterations
+            << " runs per measure\n";
+  for (bool atomic : {true, false}) {
+    ikos::core::patricia_tree_utils::set_thread_safe_reference_count(atomic);
+    std::cout << (atomic ? "atomic" : "plain") << " reference counts:\n";
+    run(n, iterations);
+  }
+  std::cout << "slabs in use: "
+            << ikos::core::patricia_tree_utils::NodePool::num_slabs() << "\n";
+  return 0;
+}
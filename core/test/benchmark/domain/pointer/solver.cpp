@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * Benchmark of the pointer constraint solver
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ikos/core/domain/pointer/solver.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+
+#include "../../benchmark.hpp"
+
+using ikos::core::Unsigned;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemLocation = VariableFactory::VariableRef;
+using VarOperand =
+    ikos::core::pointer::VariableOperand< Variable, MemLocation >;
+using AddrOperand =
+    ikos::core::pointer::AddressOperand< Variable, MemLocation >;
+using Assign = ikos::core::pointer::AssignConstraint< Variable, MemLocation >;
+using Store = ikos::core::pointer::StoreConstraint< Variable, MemLocation >;
+using Load = ikos::core::pointer::LoadConstraint< Variable, MemLocation >;
+using ConstraintSystem =
+    ikos::core::pointer::ConstraintSystem< Variable, MemLocation >;
+
+namespace benchmark = ikos::core::benchmark;
+
+namespace {
+
+/// \brief Create `n` variables with the given prefix
+std::vector< Variable > make_variables(VariableFactory& vfac,
+                                       const std::string& prefix,
+                                       int n) {
+  std::vector< Variable > vars;
+  vars.reserve(static_cast< std::size_t >(n));
+  for (int i = 0; i < n; i++) {
+    vars.push_back(vfac.get(prefix + std::to_string(i)));
+  }
+  return vars;
+}
+
+/// \brief Chain of copies `v[i] = v[i - 1] + 4`, added in reverse order
+void copy_chain(int n) {
+  VariableFactory vfac;
+  std::vector< Variable > vars = make_variables(vfac, "v", n);
+  MemLocation x = vfac.get("x");
+  Interval zero(Int(0, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+
+  ConstraintSystem s(64, Unsigned);
+  for (int i = n - 1; i > 0; i--) {
+    s.add(Assign::create(vars[i], VarOperand::create(vars[i - 1], four)));
+  }
+  s.add(Assign::create(vars[0], AddrOperand::create(x, zero)));
+  s.solve();
+  benchmark::do_not_optimize(s);
+}
+
+/// \brief Variables with copies, loads and stores on their neighbours
+void local_graph(int n) {
+  VariableFactory vfac;
+  std::vector< Variable > vars = make_variables(vfac, "v", n);
+  std::vector< MemLocation > mems = make_variables(vfac, "m", n / 10);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval eight(Int(8, 64, Unsigned));
+  std::mt19937 rng(42);
+  std::uniform_int_distribution< int > near(1, 8);
+
+  ConstraintSystem s(64, Unsigned);
+  for (int i = 0; i < n; i++) {
+    int j = (i + near(rng)) % n;
+    switch (i % 4) {
+      case 0:
+        s.add(Assign::create(vars[i],
+                             AddrOperand::create(mems[i % mems.size()],
+                                                 zero)));
+        break;
+      case 1:
+        s.add(Assign::create(vars[i], VarOperand::create(vars[j], eight)));
+        break;
+      case 2:
+        s.add(Store::create(vars[i], VarOperand::create(vars[j], zero)));
+        break;
+      default:
+        s.add(Load::create(vars[i], VarOperand::create(vars[j], zero)));
+        break;
+    }
+  }
+  s.solve();
+  benchmark::do_not_optimize(s);
+}
+
+/// \brief Dense random graph of copies, loads and stores
+void dense_graph(int n) {
+  VariableFactory vfac;
+  std::vector< Variable > vars = make_variables(vfac, "v", n);
+  std::vector< MemLocation > mems = make_variables(vfac, "m", n / 10);
+  Interval zero(Int(0, 64, Unsigned));
+  std::mt19937 rng(42);
+  std::uniform_int_distribution< int > any(0, n - 1);
+
+  ConstraintSystem s(64, Unsigned);
+  for (std::size_t i = 0; i < mems.size(); i++) {
+    s.add(Assign::create(vars[i], AddrOperand::create(mems[i], zero)));
+  }
+  for (int i = 0; i < 4 * n; i++) {
+    Variable a = vars[any(rng)];
+    Variable b = vars[any(rng)];
+    switch (i % 3) {
+      case 0:
+        s.add(Assign::create(a, VarOperand::create(b, zero)));
+        break;
+      case 1:
+        s.add(Store::create(a, VarOperand::create(b, zero)));
+        break;
+      default:
+        s.add(Load::create(a, VarOperand::create(b, zero)));
+        break;
+    }
+  }
+  s.solve();
+  benchmark::do_not_optimize(s);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  int chain_length = benchmark::scale(argc, argv, 5000);
+  int local_size = benchmark::scale(argc, argv, 20000);
+  int dense_size = benchmark::scale(argc, argv, 1000);
+
+  benchmark::measure("copy chain, reverse order",
+                     [=] { copy_chain(chain_length); });
+  benchmark::measure("local copies, loads and stores",
+                     [=] { local_graph(local_size); });
+  benchmark::measure("dense random graph", [=] { dense_graph(dense_size); });
+  return 0;
+}
@@ -0,0 +1,248 @@
+/*******************************************************************************
+ *
+ * Benchmark of the schedulers of the concurrent fixpoint iterator
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <ikos/core/domain/numeric/interval.hpp>
+#include <ikos/core/example/muzq.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/fixpoint/concurrent_fwd_fixpoint_iterator.hpp>
+#include <ikos/core/support/cast.hpp>
+
+#include "../benchmark.hpp"
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using ZVarExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using ZLinearExpression = ikos::core::LinearExpression< ZNumber, Variable >;
+using Statement = ikos::core::muzq::Statement< Variable >;
+using ZLinearAssignment = ikos::core::muzq::ZLinearAssignment< Variable >;
+using ZLinearAssertion = ikos::core::muzq::ZLinearAssertion< Variable >;
+using BasicBlock = ikos::core::muzq::BasicBlock< Variable >;
+using ControlFlowGraph = ikos::core::muzq::ControlFlowGraph< Variable >;
+using ZIntervalDomain =
+    ikos::core::numeric::IntervalDomain< ZNumber, Variable >;
+using ConcurrentScheduling = ikos::core::ConcurrentScheduling;
+
+namespace benchmark = ikos::core::benchmark;
+
+namespace {
+
+/// \brief Concurrent fixpoint iterator on the integer statements of a
+/// ControlFlowGraph
+class FixpointIterator final
+    : public ikos::core::InterleavedConcurrentFwdFixpointIterator<
+          ControlFlowGraph*,
+          ZIntervalDomain > {
+public:
+  using InterleavedConcurrentFwdFixpointIterator::
+      InterleavedConcurrentFwdFixpointIterator;
+
+  ZIntervalDomain analyze_node(BasicBlock* bb, ZIntervalDomain inv) override {
+    for (Statement* stmt : *bb) {
+      if (auto s = ikos::core::dyn_cast< ZLinearAssignment >(stmt)) {
+        inv.assign(s->result(), s->operand());
+      } else if (auto s = ikos::core::dyn_cast< ZLinearAssertion >(stmt)) {
+        inv.add(s->constraint());
+      }
+    }
+    return inv;
+  }
+
+  ZIntervalDomain analyze_edge(BasicBlock* /*src*/,
+                               BasicBlock* /*dest*/,
+                               ZIntervalDomain inv) override {
+    return inv;
+  }
+
+  void process_pre(BasicBlock*, const ZIntervalDomain&) override {}
+
+  void process_post(BasicBlock*, const ZIntervalDomain&) override {}
+};
+
+/// \brief Add two nested loops after `prev`, return the exit of the loops
+BasicBlock* add_loops(ControlFlowGraph& cfg,
+                      VariableFactory& vfac,
+                      BasicBlock* prev,
+                      const std::string& id) {
+  Variable x(vfac.get("x" + id));
+  Variable y(vfac.get("y" + id));
+  BasicBlock* head = cfg.get("head" + id);
+  BasicBlock* body = cfg.get("body" + id);
+  BasicBlock* inner = cfg.get("inner" + id);
+  BasicBlock* inner_body = cfg.get("inner_body" + id);
+  BasicBlock* latch = cfg.get("latch" + id);
+  BasicBlock* exit = cfg.get("exit" + id);
+  prev->add(std::make_unique< ZLinearAssignment >(x, ZLinearExpression(0)));
+  prev->add_successor(head);
+  head->add_successor(body);
+  head->add_successor(exit);
+  body->add_successor(inner);
+  inner->add_successor(inner_body);
+  inner->add_successor(latch);
+  inner_body->add_successor(inner);
+  latch->add_successor(head);
+  body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) <= 99));
+  body->add(std::make_unique< ZLinearAssignment >(y, ZLinearExpression(0)));
+  inner_body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) <= 9));
+  inner_body->add(std::make_unique< ZLinearAssignment >(y, ZVarExpr(y) + 1));
+  latch->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) >= 10));
+  latch->add(std::make_unique< ZLinearAssignment >(x, ZVarExpr(x) + 1));
+  exit->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) >= 100));
+  return exit;
+}
+
+/// \brief Add a diamond after `prev`, return the join block
+BasicBlock* add_diamond(ControlFlowGraph& cfg,
+                        VariableFactory& vfac,
+                        BasicBlock* prev,
+                        const std::string& id,
+                        int k) {
+  Variable x(vfac.get("x" + id));
+  BasicBlock* left = cfg.get("left" + id);
+  BasicBlock* right = cfg.get("right" + id);
+  BasicBlock* join = cfg.get("join" + id);
+  prev->add_successor(left);
+  prev->add_successor(right);
+  left->add_successor(join);
+  right->add_successor(join);
+  left->add(std::make_unique< ZLinearAssignment >(x, ZLinearExpression(k)));
+  right->add(std::make_unique< ZLinearAssignment >(x, ZVarExpr(x) + 1));
+  return join;
+}
+
+/// \brief Build a sequence of diamonds and nested loops
+///
+/// Most nodes depend on the previous one, there is little parallelism.
+void build_chain(ControlFlowGraph& cfg, VariableFactory& vfac, int segments) {
+  BasicBlock* prev = cfg.get("entry");
+  for (int k = 0; k < segments; k++) {
+    std::string id = std::to_string(k);
+    if (k % 2 == 0) {
+      prev = add_diamond(cfg, vfac, prev, id, k);
+    } else {
+      prev = add_loops(cfg, vfac, prev, id);
+    }
+  }
+}
+
+/// \brief Build `width` independent branches of diamonds and nested loops,
+/// joined at the end
+void build_wide(ControlFlowGraph& cfg,
+                VariableFactory& vfac,
+                int width,
+                int segments) {
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* end = cfg.get("end");
+  for (int w = 0; w < width; w++) {
+    BasicBlock* prev = cfg.get("branch" + std::to_string(w));
+    entry->add_successor(prev);
+    for (int k = 0; k < segments; k++) {
+      std::string id = std::to_string(w) + "_" + std::to_string(k);
+      if (k % 2 == 0) {
+        prev = add_diamond(cfg, vfac, prev, id, k);
+      } else {
+        prev = add_loops(cfg, vfac, prev, id);
+      }
+    }
+    prev->add_successor(end);
+  }
+}
+
+const char* scheduling_name(ConcurrentScheduling scheduling) {
+  switch (scheduling) {
+    case ConcurrentScheduling::ParallelForEach:
+      return "parallel_for_each";
+    case ConcurrentScheduling::WorkStealing:
+      return "work stealing";
+  }
+  return "";
+}
+
+/// \brief Measure both schedulers on the given graph, with 1 to N threads
+void run(const std::string& name, ControlFlowGraph& cfg) {
+  unsigned max_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                                threads);
+    tbb::task_arena arena(static_cast< int >(threads));
+    for (ConcurrentScheduling scheduling :
+         {ConcurrentScheduling::ParallelForEach,
+          ConcurrentScheduling::WorkStealing}) {
+      FixpointIterator iterator(&cfg, ZIntervalDomain::bottom(), scheduling);
+      benchmark::measure(name + ", " + std::to_string(threads) + " threads, " +
+                             scheduling_name(scheduling),
+                         [&] {
+                           arena.execute(
+                               [&] { iterator.run(ZIntervalDomain::top()); });
+                         });
+    }
+  }
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  int segments = benchmark::scale(argc, argv, 400);
+
+  {
+    ControlFlowGraph cfg("entry");
+    VariableFactory vfac;
+    build_chain(cfg, vfac, segments);
+    run("chain", cfg);
+  }
+  {
+    ControlFlowGraph cfg("entry");
+    VariableFactory vfac;
+    build_wide(cfg, vfac, 16, segments / 16);
+    run("wide", cfg);
+  }
+  return 0;
+}
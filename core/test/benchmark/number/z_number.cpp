@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * Benchmark of ZNumber through Interval, Congruence and DBM
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+#include <vector>
+
+#include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/value/numeric/congruence.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+
+#include "../benchmark.hpp"
+
+using ZNumber = ikos::core::ZNumber;
+using Bound = ikos::core::ZBound;
+using Interval = ikos::core::numeric::ZInterval;
+using Congruence = ikos::core::numeric::ZCongruence;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using DBM = ikos::core::numeric::DBM< ZNumber, Variable >;
+
+namespace benchmark = ikos::core::benchmark;
+
+namespace {
+
+Interval interval_of(long lb, long ub) {
+  return Interval(Bound(lb), Bound(ub));
+}
+
+/// \brief Interval operations on small bounds (+, *, /, join, meet)
+void interval(int iterations) {
+  Interval acc = interval_of(0, 1);
+  for (int i = 0; i < iterations; i++) {
+    Interval a = interval_of(i % 100, i % 100 + 10);
+    Interval b = interval_of(-(i % 7) - 1, i % 13 + 1);
+    Interval c = a + b;
+    c = c * b;
+    c = c / interval_of(1, i % 5 + 2);
+    c.join_with(acc);
+    c.meet_with(interval_of(-1000000, 1000000));
+    acc = c;
+  }
+  benchmark::do_not_optimize(acc);
+}
+
+/// \brief Congruence operations on small moduli (+, *, join, meet)
+void congruence(int iterations) {
+  Congruence acc(ZNumber(0));
+  for (int i = 0; i < iterations; i++) {
+    Congruence a(ZNumber(i % 12 + 1), ZNumber(i % 5));
+    Congruence b(ZNumber(i % 8 + 2), ZNumber(i % 3));
+    Congruence c = a + b;
+    c = c * Congruence(ZNumber(i % 9));
+    c.join_with(acc);
+    c.meet_with(Congruence(ZNumber(i % 4 + 1), ZNumber(0)));
+    acc = c.is_bottom() ? Congruence(ZNumber(i)) : c;
+  }
+  benchmark::do_not_optimize(acc);
+}
+
+/// \brief DBM on 16 variables (set, add, join, widen)
+void dbm(int iterations) {
+  VariableFactory vfac;
+  std::vector< Variable > vars;
+  for (int i = 0; i < 16; i++) {
+    vars.push_back(vfac.get("x" + std::to_string(i)));
+  }
+
+  DBM acc = DBM::top();
+  for (int i = 0; i < iterations; i++) {
+    DBM inv = DBM::top();
+    for (std::size_t j = 0; j < vars.size(); j++) {
+      inv.set(vars[j], interval_of(0, static_cast< long >(i % 50 + j)));
+    }
+    for (std::size_t j = 0; j + 1 < vars.size(); j++) {
+      inv.add(VariableExpr(vars[j]) - VariableExpr(vars[j + 1]) <=
+              ZNumber(i % 3));
+    }
+    if (i % 10 == 0) {
+      acc = inv;
+    } else {
+      DBM joined = acc.join(inv);
+      acc.widen_with(joined);
+    }
+  }
+  benchmark::do_not_optimize(acc);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  int interval_iterations = benchmark::scale(argc, argv, 2000000);
+  int congruence_iterations = benchmark::scale(argc, argv, 2000000);
+  int dbm_iterations = benchmark::scale(argc, argv, 3000);
+
+  benchmark::measure("interval (+, *, /, join, meet)",
+                     [=] { interval(interval_iterations); });
+  benchmark::measure("congruence (+, *, join, meet)",
+                     [=] { congruence(congruence_iterations); });
+  benchmark::measure("dbm 16 vars (set, add, join, widen)",
+                     [=] { dbm(dbm_iterations); });
+  return 0;
+}
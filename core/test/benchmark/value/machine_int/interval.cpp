@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * Benchmark of machine integer intervals, congruences and interval-congruences
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/value/machine_int/congruence.hpp>
+#include <ikos/core/value/machine_int/interval.hpp>
+#include <ikos/core/value/machine_int/interval_congruence.hpp>
+
+#include "../../benchmark.hpp"
+
+using ZNumber = ikos::core::ZNumber;
+using MachineInt = ikos::core::MachineInt;
+using Signedness = ikos::core::Signedness;
+using Interval = ikos::core::machine_int::Interval;
+using Congruence = ikos::core::machine_int::Congruence;
+using IntervalCongruence = ikos::core::machine_int::IntervalCongruence;
+
+namespace benchmark = ikos::core::benchmark;
+
+namespace {
+
+/// \brief Return 257 intervals spread over the range of the type
+std::vector< Interval > intervals(uint64_t bit_width, Signedness sign) {
+  ZNumber min = MachineInt::min(bit_width, sign).to_z_number();
+  ZNumber max = MachineInt::max(bit_width, sign).to_z_number();
+  ZNumber span = max - min;
+  std::vector< Interval > result;
+  for (int k = 0; k <= 256; k++) {
+    ZNumber lb = min + span * k / 256;
+    ZNumber ub = lb + span / 512;
+    result.emplace_back(MachineInt(lb, bit_width, sign),
+                        MachineInt(ub <= max ? ub : max, bit_width, sign));
+  }
+  return result;
+}
+
+/// \brief Add, mul and sub_no_wrap on all pairs of intervals
+void native(const std::vector< Interval >& intervals) {
+  for (const Interval& a : intervals) {
+    for (const Interval& b : intervals) {
+      Interval r = add(a, b);
+      r = mul(r, b);
+      r = sub_no_wrap(r, a);
+      benchmark::do_not_optimize(r);
+    }
+  }
+}
+
+/// \brief Same as native(), computed on ZInterval
+void z_interval(const std::vector< Interval >& intervals) {
+  for (const Interval& a : intervals) {
+    uint64_t bit_width = a.bit_width();
+    Signedness sign = a.sign();
+    for (const Interval& b : intervals) {
+      Interval r = Interval::from_z_interval(a.to_z_interval() +
+                                                 b.to_z_interval(),
+                                             bit_width,
+                                             sign,
+                                             Interval::WrapTag{});
+      r = Interval::from_z_interval(r.to_z_interval() * b.to_z_interval(),
+                                    bit_width,
+                                    sign,
+                                    Interval::WrapTag{});
+      r = Interval::from_z_interval(r.to_z_interval() - a.to_z_interval(),
+                                    bit_width,
+                                    sign,
+                                    Interval::TruncTag{});
+      benchmark::do_not_optimize(r);
+    }
+  }
+}
+
+/// \brief Add, mul and sub_no_wrap on congruences, computed on ZNumber
+void congruence(const std::vector< Interval >& intervals) {
+  std::vector< Congruence > congruences;
+  for (const Interval& i : intervals) {
+    congruences.emplace_back(i.lb());
+  }
+  for (const Congruence& a : congruences) {
+    for (const Congruence& b : congruences) {
+      Congruence r = add(a, b);
+      r = mul(r, b);
+      r = sub_no_wrap(r, a);
+      benchmark::do_not_optimize(r);
+    }
+  }
+}
+
+/// \brief Add, mul and sub_no_wrap on interval-congruences
+void interval_congruence(const std::vector< Interval >& intervals) {
+  std::vector< IntervalCongruence > ivs;
+  for (const Interval& i : intervals) {
+    ivs.emplace_back(i);
+  }
+  for (const IntervalCongruence& a : ivs) {
+    for (const IntervalCongruence& b : ivs) {
+      IntervalCongruence r = add(a, b);
+      r = mul(r, b);
+      r = sub_no_wrap(r, a);
+      benchmark::do_not_optimize(r);
+    }
+  }
+}
+
+void run(uint64_t bit_width, Signedness sign, int iterations) {
+  std::string name = std::to_string(bit_width) +
+                     (sign == ikos::core::Signed ? " signed" : " unsigned");
+  std::vector< Interval > v = intervals(bit_width, sign);
+  benchmark::measure(name + " native", [&] {
+    for (int i = 0; i < iterations; i++) {
+      native(v);
+    }
+  });
+  benchmark::measure(name + " ZInterval", [&] {
+    for (int i = 0; i < iterations; i++) {
+      z_interval(v);
+    }
+  });
+  benchmark::measure(name + " congruence", [&] {
+    for (int i = 0; i < iterations; i++) {
+      congruence(v);
+    }
+  });
+  benchmark::measure(name + " interval-congruence", [&] {
+    for (int i = 0; i < iterations; i++) {
+      interval_congruence(v);
+    }
+  });
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+  int iterations = benchmark::scale(argc, argv, 1);
+  run(8, ikos::core::Signed, iterations);
+  run(32, ikos::core::Signed, iterations);
+  run(64, ikos::core::Signed, iterations);
+  run(64, ikos::core::Unsigned, iterations);
+  return 0;
+}
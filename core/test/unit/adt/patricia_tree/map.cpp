@@ -40,6 +40,8 @@
  *
  ******************************************************************************/
 
+#include <array>
+
 #define BOOST_TEST_MODULE test_patricia_tree_map
 #define BOOST_TEST_DYN_LINK
 #include <boost/mpl/list.hpp>
@@ -271,3 +273,44 @@ BOOST_AUTO_TEST_CASE(test_patricia_tree_map) {
       {{1, "hellozzzzz"}}};
   BOOST_CHECK(std::equal(m.begin(), m.end(), std::begin(tab4), std::end(tab4)));
 }
+
+BOOST_AUTO_TEST_CASE(test_patricia_tree_map_hash_consing) {
+  using Index = ikos::core::Index;
+  using Map = ikos::core::PatriciaTreeMap< Index, std::string >;
+  ikos::core::patricia_tree_utils::set_hash_consing(true);
+
+  // build the same map in different orders
+  Map m1;
+  Map m2;
+  for (std::size_t i = 0; i < 100; i++) {
+    m1.insert_or_assign(i, std::to_string(i));
+    m2.insert_or_assign(99 - i, std::to_string(99 - i));
+  }
+  BOOST_CHECK(m1.equals(m2, std::equal_to<>()));
+  BOOST_CHECK(m1.leq(m2, std::less_equal<>()));
+
+  // test join and intersect, twice to use memoized results
+  Map m3 = m1;
+  m3.insert_or_assign(42, "x");
+  m3.erase(7);
+  for (int k = 0; k < 2; k++) {
+    Map m = m1.join(m3, std::plus<>());
+    BOOST_CHECK(m.size() == 100);
+    BOOST_CHECK(*m.at(42) == "42x");
+    BOOST_CHECK(*m.at(7) == "7");
+    BOOST_CHECK(*m.at(8) == "8");
+
+    m = m1.intersect(m3, std::plus<>());
+    BOOST_CHECK(m.size() == 99);
+    BOOST_CHECK(*m.at(42) == "42x");
+    BOOST_CHECK(!m.at(7));
+
+    BOOST_CHECK(m1.leq(m3, std::less_equal<>()));
+    BOOST_CHECK(!m3.leq(m1, std::less_equal<>()));
+  }
+
+  // the result of a join does not depend on hash-consing
+  Map m4 = m1.join(m3, std::plus<>());
+  ikos::core::patricia_tree_utils::set_hash_consing(false);
+  BOOST_CHECK(m4.equals(m1.join(m3, std::plus<>()), std::equal_to<>()));
+}
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * Tests for the allocator and reference counts of patricia tree nodes
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <future>
+#include <thread>
+#include <utility>
+
+#define BOOST_TEST_MODULE test_patricia_tree_node
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/patricia_tree/node.hpp>
+#include <ikos/core/adt/patricia_tree/set.hpp>
+
+using ikos::core::Index;
+using ikos::core::PatriciaTreeSet;
+using ikos::core::patricia_tree_utils::NodePool;
+using ikos::core::patricia_tree_utils::RefCountedNode;
+
+namespace {
+
+constexpr Index NumElements = 100000;
+
+PatriciaTreeSet< Index > make_set(Index first) {
+  PatriciaTreeSet< Index > s;
+  for (Index i = first; i < first + NumElements; i++) {
+    s.insert(i);
+  }
+  return s;
+}
+
+struct TestNode final : public RefCountedNode {
+  int value;
+
+  explicit TestNode(int v) : value(v) {}
+};
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_cross_thread_free) {
+  std::size_t num_slabs = NodePool::num_slabs();
+
+  // Nodes allocated by a thread that exits, and freed by the main thread
+  PatriciaTreeSet< Index > s;
+  std::thread t([&s] { s = make_set(0); });
+  t.join();
+  BOOST_CHECK(s.size() == NumElements);
+  BOOST_CHECK(NodePool::num_slabs() > num_slabs);
+
+  s.clear();
+  NodePool::trim();
+  BOOST_CHECK(NodePool::num_slabs() == num_slabs);
+}
+
+BOOST_AUTO_TEST_CASE(test_cross_thread_free_reuse) {
+  // Nodes allocated by a thread, freed by the main thread, then reused by
+  // the allocating thread
+  std::promise< PatriciaTreeSet< Index > > built;
+  std::promise< void > freed;
+  std::size_t num_slabs_before = 0;
+  std::size_t num_slabs_after = 0;
+  std::thread t([&] {
+    built.set_value(make_set(0));
+    freed.get_future().wait();
+    num_slabs_before = NodePool::num_slabs();
+    PatriciaTreeSet< Index > s = make_set(NumElements);
+    num_slabs_after = NodePool::num_slabs();
+    BOOST_CHECK(s.size() == NumElements);
+  });
+  {
+    PatriciaTreeSet< Index > s = built.get_future().get();
+    BOOST_CHECK(s.size() == NumElements);
+  }
+  freed.set_value();
+  t.join();
+  // At most one slab with free blocks is kept per size class
+  BOOST_CHECK(num_slabs_after <=
+              num_slabs_before + NodePool::NumSizeClasses);
+}
+
+BOOST_AUTO_TEST_CASE(test_reference_count) {
+  using ikos::core::patricia_tree_utils::make_node_ptr;
+  using ikos::core::patricia_tree_utils::set_thread_safe_reference_count;
+  using ikos::core::patricia_tree_utils::thread_safe_reference_count;
+
+  for (bool thread_safe : {true, false}) {
+    set_thread_safe_reference_count(thread_safe);
+    if (!thread_safe) {
+      BOOST_CHECK(!thread_safe_reference_count());
+    }
+
+    auto p = make_node_ptr< TestNode >(42);
+    BOOST_CHECK(p->use_count() == 1);
+    {
+      auto q = p;
+      BOOST_CHECK(p->use_count() == 2);
+      auto r = std::move(q);
+      BOOST_CHECK(p->use_count() == 2);
+      BOOST_CHECK(r->value == 42);
+    }
+    BOOST_CHECK(p->use_count() == 1);
+
+    // Trees share nodes between copies
+    PatriciaTreeSet< Index > s = make_set(0);
+    PatriciaTreeSet< Index > s2 = s;
+    s2.insert(NumElements);
+    BOOST_CHECK(s.size() == NumElements);
+    BOOST_CHECK(s2.size() == NumElements + 1);
+    s.clear();
+    BOOST_CHECK(s2.size() == NumElements + 1);
+    BOOST_CHECK(s2.contains(0));
+  }
+  set_thread_safe_reference_count(true);
+}
@@ -197,3 +197,40 @@ BOOST_AUTO_TEST_CASE(test_patricia_tree_set) {
   s2.insert(1);
   BOOST_CHECK(s1.intersect(s2).equals(Set({1})));
 }
+
+BOOST_AUTO_TEST_CASE(test_patricia_tree_set_hash_consing) {
+  using Index = ikos::core::Index;
+  using Set = ikos::core::PatriciaTreeSet< Index >;
+  ikos::core::patricia_tree_utils::set_hash_consing(true);
+
+  // build the same set in different orders
+  Set s1;
+  Set s2;
+  for (std::size_t i = 0; i < 100; i++) {
+    s1.insert(i);
+    s2.insert(99 - i);
+  }
+  BOOST_CHECK(s1.equals(s2));
+  BOOST_CHECK(s1.is_subset_of(s2));
+
+  // test join and intersect, twice to use memoized results
+  Set s3 = s1;
+  s3.insert(200);
+  s3.erase(7);
+  for (int k = 0; k < 2; k++) {
+    Set s = s1.join(s3);
+    BOOST_CHECK(s.size() == 101);
+    BOOST_CHECK(s.contains(7));
+    BOOST_CHECK(s.contains(200));
+
+    s = s1.intersect(s3);
+    BOOST_CHECK(s.size() == 99);
+    BOOST_CHECK(!s.contains(7));
+    BOOST_CHECK(!s.contains(200));
+
+    BOOST_CHECK(!s1.is_subset_of(s3));
+    BOOST_CHECK(s1.intersect(s3).is_subset_of(s3));
+  }
+
+  ikos::core::patricia_tree_utils::set_hash_consing(false);
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * Tests for SmallFlatMap
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <type_traits>
+
+#define BOOST_TEST_MODULE test_small_flat_map
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/small_flat_map.hpp>
+
+using Map = ikos::core::SmallFlatMap< int, int, 3 >;
+
+/// \brief Whether SmallFlatMap falls back to a flat_map on a std::vector
+static constexpr bool Fallback = BOOST_VERSION < 106600;
+
+static_assert(std::is_same< Map, boost::container::flat_map< int, int > >::
+                      value == Fallback,
+              "unexpected SmallFlatMap implementation");
+
+namespace {
+
+/// \brief Return true if the elements are stored inside the map object
+bool is_inline(const Map& m) {
+  const auto* p = reinterpret_cast< const char* >(&*m.begin());
+  const auto* begin = reinterpret_cast< const char* >(&m);
+  return begin <= p && p < begin + sizeof(Map);
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_insert_find) {
+  Map m;
+  BOOST_CHECK(m.empty());
+  BOOST_CHECK(m.emplace(3, 30).second);
+  BOOST_CHECK(m.emplace(1, 10).second);
+  BOOST_CHECK(m.emplace(2, 20).second);
+  BOOST_CHECK(!m.emplace(2, 21).second);
+  BOOST_CHECK(m.size() == 3);
+  BOOST_CHECK(m.find(2)->second == 20);
+  BOOST_CHECK(m.find(4) == m.end());
+
+  // Iteration is sorted by key
+  int k = 1;
+  for (const auto& p : m) {
+    BOOST_CHECK(p.first == k);
+    BOOST_CHECK(p.second == 10 * k);
+    k++;
+  }
+
+  m[4] = 40;
+  m[1] = 11;
+  BOOST_CHECK(m.size() == 4);
+  BOOST_CHECK(m.at(1) == 11);
+  BOOST_CHECK(m.at(4) == 40);
+
+  BOOST_CHECK(m.erase(3) == 1);
+  BOOST_CHECK(m.erase(3) == 0);
+  BOOST_CHECK(m.size() == 3);
+  BOOST_CHECK(m.count(3) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_copy) {
+  Map m;
+  for (int i = 0; i < 10; i++) {
+    m.emplace(9 - i, i);
+  }
+
+  Map n = m;
+  BOOST_CHECK(n == m);
+  n.erase(0);
+  BOOST_CHECK(n != m);
+  BOOST_CHECK(n.size() == 9);
+  BOOST_CHECK(m.size() == 10);
+
+  m = std::move(n);
+  BOOST_CHECK(m.size() == 9);
+  BOOST_CHECK(m.begin()->first == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_inline_storage) {
+  Map m;
+  m.emplace(1, 1);
+  m.emplace(2, 2);
+  m.emplace(3, 3);
+  BOOST_CHECK(is_inline(m) == !Fallback);
+
+  Map n = m;
+  BOOST_CHECK(is_inline(n) == !Fallback);
+
+  // More than N elements are stored on the heap
+  m.emplace(4, 4);
+  BOOST_CHECK(!is_inline(m));
+}
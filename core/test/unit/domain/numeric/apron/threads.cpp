@@ -0,0 +1,151 @@
+/*******************************************************************************
+ *
+ * Tests for ApronDomain used from several threads
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_apron_threads
+#define BOOST_TEST_DYN_LINK
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <ikos/core/domain/numeric/apron.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using Bound = ikos::core::ZBound;
+using Interval = ikos::core::numeric::ZInterval;
+
+template < ikos::core::numeric::apron::Domain D >
+using ApronDomain = ikos::core::numeric::ApronDomain< D, ZNumber, Variable >;
+
+using ApronDomains =
+    boost::mpl::list< ApronDomain< ikos::core::numeric::apron::Interval >,
+                      ApronDomain< ikos::core::numeric::apron::Octagon >,
+                      ApronDomain< ikos::core::numeric::apron::
+                                       PolkaPolyhedra > >;
+
+namespace {
+
+constexpr int NumThreads = 4;
+constexpr int NumValues = 256;
+
+} // end anonymous namespace
+
+// Abstract values are created, read, joined and destroyed on different
+// threads, as the concurrent fixpoint iterators do.
+BOOST_AUTO_TEST_CASE_TEMPLATE(values_across_threads, Domain, ApronDomains) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                              NumThreads);
+  tbb::task_arena arena(NumThreads);
+
+  auto shared = Domain::top();
+  shared.set(x, Interval(0));
+
+  std::vector< Domain > values(NumValues, Domain::bottom());
+  std::atomic< int > errors{0};
+
+  // Each value is built from a copy of the shared value
+  arena.execute([&] {
+    tbb::parallel_for(0, NumValues, [&](int i) {
+      Domain inv = shared;
+      Domain other = Domain::top();
+      other.set(x, Interval(i));
+      inv.join_with(other);
+      if (!shared.leq(inv)) {
+        errors++;
+      }
+      inv.assign(y, VariableExpr(x) + 1);
+      if (inv.to_interval(y) != Interval(Bound(1), Bound(i + 1))) {
+        errors++;
+      }
+      values[static_cast< std::size_t >(i)] = std::move(inv);
+    });
+  });
+  BOOST_CHECK_EQUAL(errors.load(), 0);
+
+  // Each value is joined with a value built on another thread
+  arena.execute([&] {
+    tbb::parallel_for(0, NumValues, [&](int i) {
+      int j = (i + 1) % NumValues;
+      Domain inv = values[static_cast< std::size_t >(i)].join(
+          values[static_cast< std::size_t >(j)]);
+      if (inv.to_interval(x) != Interval(Bound(0), Bound(i > j ? i : j))) {
+        errors++;
+      }
+    });
+  });
+  BOOST_CHECK_EQUAL(errors.load(), 0);
+
+  // Values built on a thread are updated in place on another thread
+  arena.execute([&] {
+    tbb::parallel_for(0, NumValues, [&](int i) {
+      auto k = static_cast< std::size_t >(NumValues - 1 - i);
+      Domain other = Domain::top();
+      other.set(x, Interval(-1));
+      values[k].join_with(other);
+      values[k].forget(y);
+      if (values[k].to_interval(x) !=
+          Interval(Bound(-1), Bound(static_cast< int >(k)))) {
+        errors++;
+      }
+    });
+  });
+  BOOST_CHECK_EQUAL(errors.load(), 0);
+
+  // Values are destroyed on the main thread
+  values.clear();
+  BOOST_CHECK(shared.to_interval(x) == Interval(0));
+}
@@ -1,6 +1,6 @@
 /*******************************************************************************
  *
- * Tests for DBM
+ * Tests for DBM and SparseDBM
  *
  * Author: Maxime Arthaud
  *
@@ -46,6 +46,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/domain/numeric/sparse_dbm.hpp>
 #include <ikos/core/example/variable_factory.hpp>
 #include <ikos/core/number/z_number.hpp>
 
@@ -58,9 +59,13 @@ using Bound = ikos::core::ZBound;
 using Interval = ikos::core::numeric::ZInterval;
 using Congruence = ikos::core::numeric::ZCongruence;
 using IntervalCongruence = ikos::core::numeric::IntervalCongruence< ZNumber >;
-using DBM = ikos::core::numeric::DBM< ZNumber, Variable >;
 
-BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+// Both implementations must give the same results
+using DBMDomains =
+    boost::mpl::list< ikos::core::numeric::DBM< ZNumber, Variable >,
+                      ikos::core::numeric::SparseDBM< ZNumber, Variable > >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(is_top_and_bottom, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -89,7 +94,7 @@ BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
   BOOST_CHECK(inv.is_top());
 }
 
-BOOST_AUTO_TEST_CASE(set_to_top_and_bottom) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(set_to_top_and_bottom, DBM, DBMDomains) {
   VariableFactory vfac;
 
   auto inv = DBM::top();
@@ -105,7 +110,7 @@ BOOST_AUTO_TEST_CASE(set_to_top_and_bottom) {
   BOOST_CHECK(!inv.is_bottom());
 }
 
-BOOST_AUTO_TEST_CASE(leq) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(leq, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -201,7 +206,7 @@ BOOST_AUTO_TEST_CASE(leq) {
   BOOST_CHECK(!inv1.leq(inv2));
 }
 
-BOOST_AUTO_TEST_CASE(equals) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(equals, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -233,7 +238,7 @@ BOOST_AUTO_TEST_CASE(equals) {
   BOOST_CHECK(!inv1.equals(inv3));
 }
 
-BOOST_AUTO_TEST_CASE(join) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(join, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -327,7 +332,7 @@ BOOST_AUTO_TEST_CASE(join) {
                Interval(Bound(4), Bound::plus_infinity())));
 }
 
-BOOST_AUTO_TEST_CASE(widening) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(widening, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -352,7 +357,7 @@ BOOST_AUTO_TEST_CASE(widening) {
   BOOST_CHECK((inv2.widening(inv1) == inv2));
 }
 
-BOOST_AUTO_TEST_CASE(widening_threshold) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(widening_threshold, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -390,7 +395,7 @@ BOOST_AUTO_TEST_CASE(widening_threshold) {
   BOOST_CHECK((inv5.widening_threshold(inv4, ZNumber(10)) == inv5));
 }
 
-BOOST_AUTO_TEST_CASE(narrowing_threshold) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(narrowing_threshold, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -432,7 +437,7 @@ BOOST_AUTO_TEST_CASE(narrowing_threshold) {
   BOOST_CHECK((inv4.narrowing_threshold(inv5, ZNumber(5)) == inv4));
 }
 
-BOOST_AUTO_TEST_CASE(meet) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(meet, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -529,7 +534,7 @@ BOOST_AUTO_TEST_CASE(meet) {
   BOOST_CHECK((inv1.meet(inv2) == inv3));
 }
 
-BOOST_AUTO_TEST_CASE(narrowing) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(narrowing, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -553,7 +558,7 @@ BOOST_AUTO_TEST_CASE(narrowing) {
   BOOST_CHECK((inv2.narrowing(inv1) == inv2));
 }
 
-BOOST_AUTO_TEST_CASE(assign) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(assign, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -589,7 +594,7 @@ BOOST_AUTO_TEST_CASE(assign) {
   BOOST_CHECK(inv1.to_interval(z) == Interval(Bound(10), Bound(14)));
 }
 
-BOOST_AUTO_TEST_CASE(apply) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(apply, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -703,7 +708,7 @@ BOOST_AUTO_TEST_CASE(apply) {
   BOOST_CHECK(inv1.to_interval(z) == Interval(Bound(0), Bound(7)));
 }
 
-BOOST_AUTO_TEST_CASE(add) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(add, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -752,7 +757,7 @@ BOOST_AUTO_TEST_CASE(add) {
   BOOST_CHECK(inv.is_bottom());
 }
 
-BOOST_AUTO_TEST_CASE(set) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(set, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -778,7 +783,7 @@ BOOST_AUTO_TEST_CASE(set) {
   BOOST_CHECK(inv.to_interval(x) == Interval(Bound(1), Bound(4)));
 }
 
-BOOST_AUTO_TEST_CASE(refine) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(refine, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
 
@@ -810,7 +815,7 @@ BOOST_AUTO_TEST_CASE(refine) {
   BOOST_CHECK(inv.to_interval(x) == Interval(7));
 }
 
-BOOST_AUTO_TEST_CASE(forget) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(forget, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -829,7 +834,7 @@ BOOST_AUTO_TEST_CASE(forget) {
   BOOST_CHECK(inv.is_top());
 }
 
-BOOST_AUTO_TEST_CASE(to_interval) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(to_interval, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -843,7 +848,7 @@ BOOST_AUTO_TEST_CASE(to_interval) {
               Interval(Bound(-9), Bound(-4)));
 }
 
-BOOST_AUTO_TEST_CASE(to_congruence) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(to_congruence, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -857,7 +862,7 @@ BOOST_AUTO_TEST_CASE(to_congruence) {
                                 1) == Congruence::top());
 }
 
-BOOST_AUTO_TEST_CASE(to_interval_congruence) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(to_interval_congruence, DBM, DBMDomains) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
   Variable y(vfac.get("y"));
@@ -318,3 +318,69 @@ BOOST_AUTO_TEST_CASE(test_9) {
 
   // TODO(marthaud): Add checks
 }
+
+BOOST_AUTO_TEST_CASE(test_add_propagation) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  // Relation between variables that are already bounded
+  auto inv = Octagon::top();
+  inv.set(x, ZInterval(ZBound(0), ZBound(10)));
+  inv.set(y, ZInterval(ZBound(0), ZBound(3)));
+  inv.set(z, ZInterval(ZBound(-20), ZBound(20)));
+  inv.normalize();
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(0), ZBound(4)));
+
+  // The new bound on x is propagated to the other relations of x
+  inv.add(VariableExpr(z) + VariableExpr(x) <= 2);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) == ZInterval(ZBound(-20), ZBound(2)));
+  inv.add(VariableExpr(y) >= 2);
+  inv.add(VariableExpr(z) >= VariableExpr(y));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) == ZInterval(2));
+  BOOST_CHECK(inv.to_interval(z) == ZInterval(2));
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(0));
+
+  // Contradiction through a chain of relations
+  inv.add(VariableExpr(x) - VariableExpr(z) >= 1);
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(test_large_bounds) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  // The closure on 64-bit integers only handles bounds up to 2^56, larger
+  // bounds use the slower closure on ZNumber. Both must give the same results.
+  for (int shift : {0, 56, 58, 61, 62, 80}) {
+    ZNumber k = ZNumber(1) << shift;
+
+    auto inv = Octagon::top();
+    inv.set(x, ZInterval(ZBound(0), ZBound(10 * k)));
+    inv.set(y, ZInterval(ZBound(0), ZBound(3 * k)));
+    inv.normalize();
+    inv.add(VariableExpr(x) - VariableExpr(y) <= k);
+    inv.add(VariableExpr(z) - VariableExpr(x) <= 2 * k);
+    inv.add(VariableExpr(z) + VariableExpr(y) >= -k);
+    inv.normalize();
+
+    BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(0), ZBound(4 * k)));
+    BOOST_CHECK(inv.to_interval(z) == ZInterval(ZBound(-4 * k), ZBound(6 * k)));
+
+    inv.add(VariableExpr(z) >= 5 * k);
+    inv.normalize();
+    BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(3 * k), ZBound(4 * k)));
+    BOOST_CHECK(inv.to_interval(y) == ZInterval(ZBound(2 * k), ZBound(3 * k)));
+
+    inv.add(VariableExpr(y) - VariableExpr(x) >= 1);
+    inv.normalize();
+    BOOST_CHECK(inv.is_bottom());
+  }
+}
@@ -40,6 +40,9 @@
  *
  ******************************************************************************/
 
+#include <string>
+#include <vector>
+
 #define BOOST_TEST_MODULE test_pointer_solver
 #define BOOST_TEST_DYN_LINK
 #include <boost/mpl/list.hpp>
@@ -352,3 +355,126 @@ BOOST_AUTO_TEST_CASE(test_4) {
                                                      zero));
   BOOST_CHECK(s.get_memory(nrows) == PointerAbsValue::bottom(64, Unsigned));
 }
+
+BOOST_AUTO_TEST_CASE(test_5) {
+  // Cycle of copies:
+  //
+  // p = &x;
+  // q = p;
+  // r = q;
+  // p = r;
+  // r = &y + 4;
+  // *q = s;
+  // s = &z;
+  // t = *r;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+  Variable q(vfac.get("q"));
+  Variable r(vfac.get("r"));
+  Variable s(vfac.get("s"));
+  Variable t(vfac.get("t"));
+
+  MemLocation x(memfac.get("x"));
+  MemLocation y(memfac.get("y"));
+  MemLocation z(memfac.get("z"));
+
+  ConstraintSystem sys(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+
+  sys.add(Assign::create(p, AddrOperand::create(x, zero)));
+  sys.add(Assign::create(q, VarOperand::create(p, zero)));
+  sys.add(Assign::create(r, VarOperand::create(q, zero)));
+  sys.add(Assign::create(p, VarOperand::create(r, zero)));
+  sys.add(Assign::create(r, AddrOperand::create(y, four)));
+  sys.add(Store::create(q, VarOperand::create(s, zero)));
+  sys.add(Assign::create(s, AddrOperand::create(z, zero)));
+  sys.add(Load::create(t, VarOperand::create(r, zero)));
+
+  sys.solve();
+
+  PointerAbsValue cycle(Uninitialized::top(),
+                        Nullity::top(),
+                        PointsToSet{x, y},
+                        Interval(Int(0, 64, Unsigned), Int(4, 64, Unsigned)));
+  PointerAbsValue to_z(Uninitialized::top(),
+                       Nullity::top(),
+                       PointsToSet{z},
+                       zero);
+
+  BOOST_CHECK(sys.get_pointer(p) == cycle);
+  BOOST_CHECK(sys.get_pointer(q) == cycle);
+  BOOST_CHECK(sys.get_pointer(r) == cycle);
+  BOOST_CHECK(sys.get_memory(x) == to_z);
+  BOOST_CHECK(sys.get_memory(y) == to_z);
+  BOOST_CHECK(sys.get_pointer(t) == to_z);
+  BOOST_CHECK(sys.get_memory(z) == PointerAbsValue::bottom(64, Unsigned));
+}
+
+BOOST_AUTO_TEST_CASE(test_widening) {
+  // The widening threshold counts the updates of each pointer variable or
+  // memory location, not the passes over the constraints:
+  //
+  // p = &x;
+  // p = p + 4;  (loop)
+  // q = p;
+  // r9 = r8; ... r1 = r0;  (in reverse order)
+  // r0 = &y;
+  // z = &w;
+  // z = r9 + 4;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+  Variable q(vfac.get("q"));
+  Variable z(vfac.get("z"));
+  std::vector< Variable > r;
+  for (int i = 0; i < 10; i++) {
+    r.push_back(vfac.get("r" + std::to_string(i)));
+  }
+
+  MemLocation x(memfac.get("x"));
+  MemLocation y(memfac.get("y"));
+  MemLocation w(memfac.get("w"));
+
+  ConstraintSystem s(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+
+  s.add(Assign::create(p, AddrOperand::create(x, zero)));
+  s.add(Assign::create(p, VarOperand::create(p, four)));
+  s.add(Assign::create(q, VarOperand::create(p, zero)));
+  for (int i = 9; i > 0; i--) {
+    s.add(Assign::create(r[i], VarOperand::create(r[i - 1], zero)));
+  }
+  s.add(Assign::create(r[0], AddrOperand::create(y, zero)));
+  s.add(Assign::create(z, AddrOperand::create(w, zero)));
+  s.add(Assign::create(z, VarOperand::create(r[9], four)));
+
+  s.solve(/*widening_threshold = */ 3);
+
+  // p is updated more than 3 times, its offset is widened
+  PointerAbsValue loop(Uninitialized::top(),
+                       Nullity::top(),
+                       PointsToSet{x},
+                       Interval(Int(0, 64, Unsigned), Int::max(64, Unsigned)));
+  BOOST_CHECK(s.get_pointer(p) == loop);
+  BOOST_CHECK(s.get_pointer(q) == loop);
+
+  // z is updated twice, the second time after more than 3 passes over the
+  // constraints. Its offset is not widened.
+  BOOST_CHECK(s.get_pointer(r[9]) == PointerAbsValue(Uninitialized::top(),
+                                                     Nullity::top(),
+                                                     PointsToSet{y},
+                                                     zero));
+  BOOST_CHECK(
+      s.get_pointer(z) ==
+      PointerAbsValue(Uninitialized::top(),
+                      Nullity::top(),
+                      PointsToSet{w, y},
+                      Interval(Int(0, 64, Unsigned), Int(4, 64, Unsigned))));
+}
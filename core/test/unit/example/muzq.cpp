@@ -566,3 +566,76 @@ BOOST_AUTO_TEST_CASE(test6) {
   BOOST_CHECK(end.to_interval(temp1) ==
               ZInterval(ZBound(5), ZBound::plus_infinity()));
 }
+
+BOOST_AUTO_TEST_CASE(test7) {
+  ControlFlowGraph cfg("entry");
+
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* loop1_head = cfg.get("loop1_head");
+  BasicBlock* loop1_t = cfg.get("loop1_t");
+  BasicBlock* loop1_f = cfg.get("loop1_f");
+  BasicBlock* loop2_head = cfg.get("loop2_head");
+  BasicBlock* loop2_t = cfg.get("loop2_t");
+  BasicBlock* loop2_f = cfg.get("loop2_f");
+  BasicBlock* ret = cfg.get("ret");
+
+  entry->add_successor(loop1_head);
+  loop1_head->add_successor(loop1_t);
+  loop1_head->add_successor(loop1_f);
+  loop1_t->add_successor(loop2_head);
+  loop2_head->add_successor(loop2_t);
+  loop2_head->add_successor(loop2_f);
+  loop2_t->add_successor(loop2_head);
+  loop2_f->add_successor(loop1_head);
+  loop1_f->add_successor(ret);
+
+  VariableFactory vfac;
+  Variable i(vfac.get("i"));
+  Variable j(vfac.get("j"));
+  Variable s(vfac.get("s"));
+
+  entry->add(std::make_unique< ZLinearAssignment >(i, ZLinearExpression(0)));
+  entry->add(std::make_unique< ZLinearAssignment >(s, ZLinearExpression(0)));
+
+  loop1_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) <= 9));
+  loop1_t->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(0)));
+
+  loop2_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) <= 9));
+  loop2_t->add(std::make_unique< ZLinearAssignment >(j, ZVarExpr(j) + 1));
+  loop2_t->add(std::make_unique< ZLinearAssignment >(s, ZVarExpr(s) + 1));
+
+  loop2_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) >= 10));
+  loop2_f->add(std::make_unique< ZLinearAssignment >(i, ZVarExpr(i) + 1));
+
+  loop1_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) >= 10));
+
+  ret->add(std::make_unique< CheckPoint >("end"));
+
+  using FixpointIterator =
+      muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain >;
+
+  FixpointIterator full(cfg, InvariantStorage::Full);
+  full.run({ZIntervalDomain::top(), QIntervalDomain::top()});
+
+  FixpointIterator sparse(cfg, InvariantStorage::Sparse);
+  sparse.run({ZIntervalDomain::top(), QIntervalDomain::top()});
+
+  ZIntervalDomain end = sparse.checkpoint("end").first();
+  BOOST_CHECK(end.to_interval(i) == ZInterval(10));
+
+  // Replayed invariants match the ones of the full storage
+  std::vector< BasicBlock* > order;
+  sparse.replay(
+      [&](BasicBlock* bb, const FixpointIterator::AbstractDomain& pre) {
+        order.push_back(bb);
+        BOOST_CHECK(pre.leq(full.pre(bb)));
+        BOOST_CHECK(full.pre(bb).leq(pre));
+        FixpointIterator::AbstractDomain post = sparse.analyze_node(bb, pre);
+        BOOST_CHECK(post.leq(full.post(bb)));
+        BOOST_CHECK(full.post(bb).leq(post));
+        return post;
+      });
+  BOOST_CHECK(order.size() == 8);
+  BOOST_CHECK(order.front() == entry);
+  BOOST_CHECK(order.back() == ret);
+}
@@ -0,0 +1,362 @@
+/*******************************************************************************
+ *
+ * Tests for the concurrent forward fixpoint iterator
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_concurrent_fwd_fixpoint_iterator
+#define BOOST_TEST_DYN_LINK
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <ikos/core/domain/numeric/interval.hpp>
+#include <ikos/core/example/muzq.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/fixpoint/concurrent_fwd_fixpoint_iterator.hpp>
+#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+#include <ikos/core/support/cast.hpp>
+
+using namespace ikos::core;
+
+using VariableFactory = example::VariableFactory;
+using Variable = example::VariableFactory::VariableRef;
+using ZVarExpr = VariableExpression< ZNumber, Variable >;
+
+using Statement = muzq::Statement< Variable >;
+using ZLinearExpression = LinearExpression< ZNumber, Variable >;
+using ZLinearAssignment = muzq::ZLinearAssignment< Variable >;
+using ZLinearAssertion = muzq::ZLinearAssertion< Variable >;
+using BasicBlock = muzq::BasicBlock< Variable >;
+using ControlFlowGraph = muzq::ControlFlowGraph< Variable >;
+
+using ZInterval = numeric::Interval< ZNumber >;
+using ZIntervalDomain = numeric::IntervalDomain< ZNumber, Variable >;
+
+namespace {
+
+/// \brief Fixpoint iterator on the integer statements of a ControlFlowGraph
+template < typename Base >
+class FixpointIterator final : public Base {
+public:
+  using Hook = std::function< void(FixpointIterator&, BasicBlock*) >;
+  using ProcessHook =
+      std::function< void(BasicBlock*, const ZIntervalDomain&) >;
+
+private:
+  Hook _hook;
+  ProcessHook _process_hook;
+
+public:
+  using Base::Base;
+
+  /// \brief Set a function called before analyzing each node
+  void set_hook(Hook hook) { this->_hook = std::move(hook); }
+
+  /// \brief Set a function called on the pre invariant of each node
+  void set_process_hook(ProcessHook hook) {
+    this->_process_hook = std::move(hook);
+  }
+
+  ZIntervalDomain analyze_node(BasicBlock* bb, ZIntervalDomain inv) override {
+    if (this->_hook) {
+      this->_hook(*this, bb);
+    }
+    for (Statement* stmt : *bb) {
+      if (auto s = dyn_cast< ZLinearAssignment >(stmt)) {
+        inv.assign(s->result(), s->operand());
+      } else if (auto s = dyn_cast< ZLinearAssertion >(stmt)) {
+        inv.add(s->constraint());
+      }
+    }
+    return inv;
+  }
+
+  ZIntervalDomain analyze_edge(BasicBlock* /*src*/,
+                               BasicBlock* /*dest*/,
+                               ZIntervalDomain inv) override {
+    return inv;
+  }
+
+  void process_pre(BasicBlock* bb, const ZIntervalDomain& pre) override {
+    if (this->_process_hook) {
+      this->_process_hook(bb, pre);
+    }
+  }
+
+  void process_post(BasicBlock*, const ZIntervalDomain&) override {}
+};
+
+using SequentialIterator = FixpointIterator<
+    InterleavedFwdFixpointIterator< ControlFlowGraph*, ZIntervalDomain > >;
+
+using ConcurrentIterator =
+    FixpointIterator< InterleavedConcurrentFwdFixpointIterator<
+        ControlFlowGraph*,
+        ZIntervalDomain > >;
+
+/// \brief Build a sequence of diamonds and nested loops
+///
+/// Returns the exit block.
+BasicBlock* build_graph(ControlFlowGraph& cfg,
+                        VariableFactory& vfac,
+                        int segments) {
+  BasicBlock* prev = cfg.get("entry");
+
+  for (int k = 0; k < segments; k++) {
+    std::string id = std::to_string(k);
+    Variable x(vfac.get("x" + id));
+    Variable y(vfac.get("y" + id));
+
+    if (k % 2 == 0) {
+      // Diamond
+      BasicBlock* left = cfg.get("left" + id);
+      BasicBlock* right = cfg.get("right" + id);
+      BasicBlock* join = cfg.get("join" + id);
+      prev->add_successor(left);
+      prev->add_successor(right);
+      left->add_successor(join);
+      right->add_successor(join);
+      left->add(std::make_unique< ZLinearAssignment >(x, ZLinearExpression(k)));
+      right->add(std::make_unique< ZLinearAssignment >(x, ZVarExpr(x) + 1));
+      prev = join;
+    } else {
+      // Two nested loops
+      BasicBlock* head = cfg.get("head" + id);
+      BasicBlock* body = cfg.get("body" + id);
+      BasicBlock* inner = cfg.get("inner" + id);
+      BasicBlock* inner_body = cfg.get("inner_body" + id);
+      BasicBlock* latch = cfg.get("latch" + id);
+      BasicBlock* exit = cfg.get("exit" + id);
+      prev->add(std::make_unique< ZLinearAssignment >(x, ZLinearExpression(0)));
+      prev->add_successor(head);
+      head->add_successor(body);
+      head->add_successor(exit);
+      body->add_successor(inner);
+      inner->add_successor(inner_body);
+      inner->add_successor(latch);
+      inner_body->add_successor(inner);
+      latch->add_successor(head);
+      body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) <= 99));
+      body->add(std::make_unique< ZLinearAssignment >(y, ZLinearExpression(0)));
+      inner_body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) <= 9));
+      inner_body->add(
+          std::make_unique< ZLinearAssignment >(y, ZVarExpr(y) + 1));
+      latch->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) >= 10));
+      latch->add(std::make_unique< ZLinearAssignment >(x, ZVarExpr(x) + 1));
+      exit->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) >= 100));
+      prev = exit;
+    }
+  }
+
+  return prev;
+}
+
+/// \brief Check that two fixpoints have the same invariants
+template < typename Lhs, typename Rhs >
+void check_same_invariants(ControlFlowGraph& cfg,
+                           const Lhs& lhs,
+                           const Rhs& rhs) {
+  for (BasicBlock* bb : cfg) {
+    BOOST_CHECK(lhs.pre(bb).equals(rhs.pre(bb)));
+    BOOST_CHECK(lhs.post(bb).equals(rhs.post(bb)));
+  }
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(same_fixpoint) {
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                              4);
+  tbb::task_arena arena(4);
+
+  ControlFlowGraph cfg("entry");
+  VariableFactory vfac;
+  BasicBlock* exit = build_graph(cfg, vfac, 40);
+
+  SequentialIterator sequential(&cfg, ZIntervalDomain::bottom());
+  sequential.run(ZIntervalDomain::top());
+
+  Variable x(vfac.get("x1"));
+  BOOST_CHECK(sequential.post(exit).to_interval(x) == ZInterval(100));
+
+  for (ConcurrentScheduling scheduling :
+       {ConcurrentScheduling::ParallelForEach,
+        ConcurrentScheduling::WorkStealing}) {
+    ConcurrentIterator concurrent(&cfg, ZIntervalDomain::bottom(), scheduling);
+    arena.execute([&] { concurrent.run(ZIntervalDomain::top()); });
+    BOOST_CHECK(concurrent.converged());
+    check_same_invariants(cfg, sequential, concurrent);
+
+    // Run again on the same iterator
+    arena.execute([&] { concurrent.run(ZIntervalDomain::top()); });
+    BOOST_CHECK(concurrent.converged());
+    check_same_invariants(cfg, sequential, concurrent);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cancel) {
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                              4);
+  tbb::task_arena arena(4);
+
+  ControlFlowGraph cfg("entry");
+  VariableFactory vfac;
+  BasicBlock* exit = build_graph(cfg, vfac, 20);
+  BasicBlock* inner = cfg.get("inner5");
+
+  for (ConcurrentScheduling scheduling :
+       {ConcurrentScheduling::ParallelForEach,
+        ConcurrentScheduling::WorkStealing}) {
+    ConcurrentIterator concurrent(&cfg, ZIntervalDomain::bottom(), scheduling);
+    int processed_exit = 0;
+    concurrent.set_hook([&](ConcurrentIterator& it, BasicBlock* bb) {
+      if (bb == inner) {
+        it.cancel();
+      } else if (bb == exit) {
+        processed_exit++;
+      }
+    });
+    arena.execute([&] { concurrent.run(ZIntervalDomain::top()); });
+    BOOST_CHECK(concurrent.cancelled());
+    BOOST_CHECK(!concurrent.converged());
+    BOOST_CHECK(processed_exit == 0);
+
+    // The next run is not cancelled
+    concurrent.set_hook(nullptr);
+    arena.execute([&] { concurrent.run(ZIntervalDomain::top()); });
+    BOOST_CHECK(!concurrent.cancelled());
+    BOOST_CHECK(concurrent.converged());
+    BOOST_CHECK(!concurrent.post(exit).is_bottom());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(exception) {
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                              4);
+  tbb::task_arena arena(4);
+
+  ControlFlowGraph cfg("entry");
+  VariableFactory vfac;
+  build_graph(cfg, vfac, 20);
+  BasicBlock* inner = cfg.get("inner7");
+
+  for (ConcurrentScheduling scheduling :
+       {ConcurrentScheduling::ParallelForEach,
+        ConcurrentScheduling::WorkStealing}) {
+    ConcurrentIterator concurrent(&cfg, ZIntervalDomain::bottom(), scheduling);
+    concurrent.set_hook([&](ConcurrentIterator&, BasicBlock* bb) {
+      if (bb == inner) {
+        throw std::runtime_error("error");
+      }
+    });
+    BOOST_CHECK_THROW(arena.execute(
+                          [&] { concurrent.run(ZIntervalDomain::top()); }),
+                      std::runtime_error);
+    BOOST_CHECK(!concurrent.converged());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(pipelined) {
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                              4);
+  tbb::task_arena arena(4);
+
+  ControlFlowGraph cfg("entry");
+  VariableFactory vfac;
+  BasicBlock* exit = build_graph(cfg, vfac, 40);
+
+  SequentialIterator sequential(&cfg, ZIntervalDomain::bottom());
+  sequential.run(ZIntervalDomain::top());
+
+  for (ConcurrentScheduling scheduling :
+       {ConcurrentScheduling::ParallelForEach,
+        ConcurrentScheduling::WorkStealing}) {
+    ConcurrentIterator concurrent(&cfg,
+                                  ZIntervalDomain::bottom(),
+                                  scheduling,
+                                  ConcurrentProcessing::Pipelined);
+    std::mutex mutex;
+    std::unordered_map< BasicBlock*, ZIntervalDomain > processed;
+    bool exit_analyzed = false;
+    bool processed_before_exit = false;
+    concurrent.set_hook([&](ConcurrentIterator&, BasicBlock* bb) {
+      std::lock_guard< std::mutex > lock(mutex);
+      if (bb == exit) {
+        exit_analyzed = true;
+      }
+    });
+    concurrent.set_process_hook(
+        [&](BasicBlock* bb, const ZIntervalDomain& pre) {
+          std::lock_guard< std::mutex > lock(mutex);
+          BOOST_CHECK(processed.find(bb) == processed.end());
+          processed.emplace(bb, pre);
+          if (!exit_analyzed) {
+            processed_before_exit = true;
+          }
+        });
+    arena.execute([&] { concurrent.run(ZIntervalDomain::top()); });
+    BOOST_CHECK(concurrent.converged());
+
+    // Each node is processed once, with the final pre invariant
+    std::size_t num_nodes = 0;
+    for (BasicBlock* bb : cfg) {
+      num_nodes++;
+      auto it = processed.find(bb);
+      BOOST_CHECK(it != processed.end() &&
+                  it->second.equals(sequential.pre(bb)));
+      BOOST_CHECK(concurrent.post(bb).equals(sequential.post(bb)));
+    }
+    BOOST_CHECK(processed.size() == num_nodes);
+
+    // Checks start before the end of the fixpoint
+    BOOST_CHECK(processed_before_exit);
+
+    // Pre invariants are released
+    BOOST_CHECK(concurrent.pre(exit).is_bottom());
+  }
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ * Tests for the fixpoint statistics
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+#define BOOST_TEST_MODULE test_fixpoint_statistics
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/numeric/interval.hpp>
+#include <ikos/core/example/muzq.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+#include <ikos/core/fixpoint/statistics.hpp>
+#include <ikos/core/support/cast.hpp>
+
+using namespace ikos::core;
+
+using VariableFactory = example::VariableFactory;
+using Variable = example::VariableFactory::VariableRef;
+using ZVarExpr = VariableExpression< ZNumber, Variable >;
+
+using Statement = muzq::Statement< Variable >;
+using ZLinearExpression = LinearExpression< ZNumber, Variable >;
+using ZLinearAssignment = muzq::ZLinearAssignment< Variable >;
+using ZLinearAssertion = muzq::ZLinearAssertion< Variable >;
+using BasicBlock = muzq::BasicBlock< Variable >;
+using ControlFlowGraph = muzq::ControlFlowGraph< Variable >;
+
+using ZInterval = numeric::Interval< ZNumber >;
+using ZIntervalDomain = numeric::IntervalDomain< ZNumber, Variable >;
+
+namespace {
+
+/// \brief Fixpoint iterator on the integer statements of a ControlFlowGraph
+class FixpointIterator final
+    : public InterleavedFwdFixpointIterator< ControlFlowGraph*,
+                                             ZIntervalDomain > {
+public:
+  using InterleavedFwdFixpointIterator::InterleavedFwdFixpointIterator;
+
+  ZIntervalDomain analyze_node(BasicBlock* bb, ZIntervalDomain inv) override {
+    for (Statement* stmt : *bb) {
+      if (auto s = dyn_cast< ZLinearAssignment >(stmt)) {
+        inv.assign(s->result(), s->operand());
+      } else if (auto s = dyn_cast< ZLinearAssertion >(stmt)) {
+        inv.add(s->constraint());
+      }
+    }
+    return inv;
+  }
+
+  ZIntervalDomain analyze_edge(BasicBlock* /*src*/,
+                               BasicBlock* /*dest*/,
+                               ZIntervalDomain inv) override {
+    return inv;
+  }
+
+  void process_pre(BasicBlock*, const ZIntervalDomain&) override {}
+
+  void process_post(BasicBlock*, const ZIntervalDomain&) override {}
+};
+
+/// \brief Statistics counting the bounded variables of an invariant
+class Statistics final : public FixpointStatistics< BasicBlock*,
+                                                    ZIntervalDomain > {
+private:
+  Variable _x;
+  Variable _y;
+
+public:
+  Statistics(Variable x, Variable y) : _x(x), _y(y) {}
+
+  std::pair< std::size_t, std::size_t > state_size(
+      const ZIntervalDomain& inv) const override {
+    std::size_t n = 0;
+    for (Variable v : {this->_x, this->_y}) {
+      if (!inv.to_interval(v).is_top()) {
+        n++;
+      }
+    }
+    return {n, 0};
+  }
+};
+
+/// \brief Build two nested loops
+///
+/// Returns the exit block.
+BasicBlock* build_graph(ControlFlowGraph& cfg, Variable x, Variable y) {
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* head = cfg.get("head");
+  BasicBlock* body = cfg.get("body");
+  BasicBlock* inner = cfg.get("inner");
+  BasicBlock* inner_body = cfg.get("inner_body");
+  BasicBlock* latch = cfg.get("latch");
+  BasicBlock* exit = cfg.get("exit");
+  entry->add_successor(head);
+  head->add_successor(body);
+  head->add_successor(exit);
+  body->add_successor(inner);
+  inner->add_successor(inner_body);
+  inner->add_successor(latch);
+  inner_body->add_successor(inner);
+  latch->add_successor(head);
+  entry->add(std::make_unique< ZLinearAssignment >(x, ZLinearExpression(0)));
+  body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) <= 99));
+  body->add(std::make_unique< ZLinearAssignment >(y, ZLinearExpression(0)));
+  inner_body->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) <= 9));
+  inner_body->add(std::make_unique< ZLinearAssignment >(y, ZVarExpr(y) + 1));
+  latch->add(std::make_unique< ZLinearAssertion >(ZVarExpr(y) >= 10));
+  latch->add(std::make_unique< ZLinearAssignment >(x, ZVarExpr(x) + 1));
+  exit->add(std::make_unique< ZLinearAssertion >(ZVarExpr(x) >= 100));
+  return exit;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(nested_loops) {
+  ControlFlowGraph cfg("entry");
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  BasicBlock* exit = build_graph(cfg, x, y);
+  BasicBlock* head = cfg.get("head");
+  BasicBlock* inner = cfg.get("inner");
+
+  FixpointIterator reference(&cfg, ZIntervalDomain::bottom());
+  reference.run(ZIntervalDomain::top());
+
+  Statistics statistics(x, y);
+  FixpointIterator iterator(&cfg, ZIntervalDomain::bottom());
+  iterator.set_statistics(&statistics);
+  iterator.run(ZIntervalDomain::top());
+
+  // Statistics do not change the fixpoint
+  BOOST_CHECK(iterator.post(exit).to_interval(x) == ZInterval(100));
+  for (BasicBlock* bb : cfg) {
+    BOOST_CHECK(iterator.pre(bb).equals(reference.pre(bb)));
+    BOOST_CHECK(iterator.post(bb).equals(reference.post(bb)));
+  }
+
+  BOOST_CHECK(statistics.cycles().size() == 2);
+  const FixpointCounters& outer = statistics.cycles().at(head);
+  const FixpointCounters& nested = statistics.cycles().at(inner);
+  const FixpointCounters& total = statistics.total();
+
+  // One call to extrapolate() per increasing iteration
+  BOOST_CHECK(outer.increasing_iterations >= 2);
+  BOOST_CHECK(outer.widenings == outer.increasing_iterations);
+  BOOST_CHECK(nested.widenings == nested.increasing_iterations);
+  BOOST_CHECK(outer.narrowings >= 1);
+  BOOST_CHECK(outer.decreasing_iterations == outer.narrowings - 1);
+
+  // The inner loop is analyzed on each iteration of the outer loop
+  BOOST_CHECK(nested.increasing_iterations >= outer.increasing_iterations);
+
+  // Counters are accounted to the whole fixpoint
+  BOOST_CHECK(total.increasing_iterations ==
+              outer.increasing_iterations + nested.increasing_iterations);
+  BOOST_CHECK(total.widenings == outer.widenings + nested.widenings);
+  BOOST_CHECK(total.narrowings == outer.narrowings + nested.narrowings);
+
+  // Times of the inner loop are included in the outer loop
+  BOOST_CHECK(outer.transfer_time >= nested.transfer_time);
+  BOOST_CHECK(total.transfer_time >= outer.transfer_time);
+  BOOST_CHECK(outer.join_time >= nested.join_time);
+
+  // x is bounded at the outer head, x and y at the inner head
+  BOOST_CHECK(outer.max_variables == 1);
+  BOOST_CHECK(nested.max_variables == 2);
+  BOOST_CHECK(total.max_variables == 2);
+
+  // Statistics accumulate over runs
+  std::size_t iterations = total.increasing_iterations;
+  iterator.run(ZIntervalDomain::top());
+  BOOST_CHECK(statistics.total().increasing_iterations == 2 * iterations);
+
+  statistics.clear();
+  BOOST_CHECK(statistics.cycles().empty());
+  BOOST_CHECK(statistics.total().increasing_iterations == 0);
+}
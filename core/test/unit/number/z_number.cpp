@@ -634,3 +634,109 @@ BOOST_AUTO_TEST_CASE(test_z_number) {
   BOOST_CHECK(make_clipped_mask(Z(6), Z(2), Z(2), Z(5)).str(2) == "10000");
   BOOST_CHECK(make_clipped_mask(Z(7), Z(5), Z(2), Z(5)).str(2) == "0");
 }
+
+BOOST_AUTO_TEST_CASE(test_z_number_overflow) {
+  using Z = ikos::core::ZNumber;
+
+  // NOLINTNEXTLINE(google-runtime-int)
+  using Limits = std::numeric_limits< long >;
+
+  const Z max(Limits::max());
+  const Z min(Limits::min());
+  const Z big = Z::from_string("9223372036854775808");
+
+  // addition and subtraction
+  BOOST_CHECK((max + 1 == big));
+  BOOST_CHECK((max + 1 - 1 == max));
+  BOOST_CHECK((min - 1 == -big - 1));
+  BOOST_CHECK((min - 1 + 1 == min));
+  BOOST_CHECK((max + max == big * 2 - 2));
+  BOOST_CHECK((min + min == -big * 2));
+  BOOST_CHECK(((big - max).to< int >() == 1));
+
+  // multiplication
+  BOOST_CHECK((max * 2 == big * 2 - 2));
+  BOOST_CHECK((min * -1 == big));
+  BOOST_CHECK((min * min == big * big));
+  BOOST_CHECK(((min * min) / min == min));
+
+  // division and remainder
+  BOOST_CHECK((min / -1 == big));
+  BOOST_CHECK((min % -1 == 0));
+  BOOST_CHECK((mod(min, Z(-1)) == 0));
+  BOOST_CHECK((mod(min, min) == 0));
+  BOOST_CHECK((mod(Z(-1), min) == max));
+  BOOST_CHECK((mod(-big - 1, max) == max - 2));
+
+  // unary operators
+  BOOST_CHECK((-min == big));
+  BOOST_CHECK((-big == min));
+  BOOST_CHECK((abs(min) == big));
+  Z x = max;
+  BOOST_CHECK((++x == big));
+  BOOST_CHECK((--x == max));
+  x = min;
+  BOOST_CHECK((--x == -big - 1));
+  BOOST_CHECK((++x == min));
+
+  // shifts
+  BOOST_CHECK(((Z(1) << 63) == big));
+  BOOST_CHECK(((Z(-1) << 63) == min));
+  BOOST_CHECK(((Z(-1) << 64) == min * 2));
+  BOOST_CHECK(((Z(3) << 62) == big + (big >> 1)));
+  BOOST_CHECK(((big >> 63) == 1));
+  BOOST_CHECK(((min >> 63) == -1));
+  BOOST_CHECK(((min >> 64) == -1));
+  BOOST_CHECK(((Z(-5) >> 1) == -3));
+  BOOST_CHECK(((Z(5) >> 100) == 0));
+
+  // bitwise operators
+  BOOST_CHECK(((big | Z(1)) == big + 1));
+  BOOST_CHECK(((big & max) == 0));
+  BOOST_CHECK(((min ^ Z(-1)) == max));
+
+  // comparisons
+  BOOST_CHECK(max < big);
+  BOOST_CHECK(-big - 1 < min);
+  BOOST_CHECK(min > -big - 1);
+  BOOST_CHECK(big != max);
+  BOOST_CHECK(big > 0);
+  BOOST_CHECK(-big - 1 < 0);
+
+  // gcd, lcm
+  BOOST_CHECK((gcd(min, min) == big));
+  BOOST_CHECK((gcd(min, Z(6)) == 2));
+  BOOST_CHECK((lcm(max, Z(2)) == big * 2 - 2));
+  BOOST_CHECK((lcm(Z(-4), Z(6)) == 12));
+  Z g;
+  Z u;
+  Z v;
+  gcd_extended(min, Z(6), g, u, v);
+  BOOST_CHECK((g == Z(2) && g == min * u + Z(6) * v));
+  gcd_extended(max, Z(-3), g, u, v);
+  BOOST_CHECK((g == Z(1) && g == max * u + Z(-3) * v));
+
+  // value tests
+  BOOST_CHECK(min.size_in_bits() == 64);
+  BOOST_CHECK(max.size_in_bits() == 63);
+  BOOST_CHECK(min.trailing_zeros() == 63);
+  BOOST_CHECK(max.trailing_ones() == 63);
+  BOOST_CHECK((max.next_power_of_2() == big));
+  BOOST_CHECK((Z(5).next_power_of_2() == 8));
+
+  // conversions
+  BOOST_CHECK(min.fits< long >());
+  BOOST_CHECK(!big.fits< long >());
+  BOOST_CHECK(big.fits< unsigned long >());
+  BOOST_CHECK(!min.fits< unsigned long >());
+  BOOST_CHECK(min.str() == "-9223372036854775808");
+  BOOST_CHECK(min.str(16) == "-8000000000000000");
+  BOOST_CHECK(big.str(-16) == "8000000000000000");
+  BOOST_CHECK(Z(-255).str(16) == "-ff");
+  BOOST_CHECK((Z(big.mpz()) == big));
+  BOOST_CHECK((Z(min.mpz()) == min));
+
+  // hash
+  BOOST_CHECK(hash_value(max + 1) == hash_value(big));
+  BOOST_CHECK(hash_value(big - 1) == hash_value(max));
+}
@@ -42,6 +42,9 @@
 
 #define BOOST_TEST_MODULE test_machine_integer_interval
 #define BOOST_TEST_DYN_LINK
+#include <functional>
+#include <vector>
+
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -3379,6 +3382,212 @@ BOOST_AUTO_TEST_CASE(test_xor) {
               Interval::top(8, Unsigned));
 }
 
+BOOST_AUTO_TEST_CASE(test_mul) {
+  BOOST_CHECK(mul(Interval::bottom(8, Signed), Interval::top(8, Signed)) ==
+              Interval::bottom(8, Signed));
+  BOOST_CHECK(mul(Interval(Int(2, 8, Signed), Int(3, 8, Signed)),
+                  Interval(Int(-4, 8, Signed), Int(5, 8, Signed))) ==
+              Interval(Int(-12, 8, Signed), Int(15, 8, Signed)));
+  BOOST_CHECK(mul(Interval(Int(10, 8, Signed), Int(20, 8, Signed)),
+                  Interval(Int(10, 8, Signed), Int(20, 8, Signed))) ==
+              Interval::top(8, Signed));
+  BOOST_CHECK(mul(Interval(Int(16, 8, Signed), Int(16, 8, Signed)),
+                  Interval(Int(9, 8, Signed), Int(9, 8, Signed))) ==
+              Interval(Int(-112, 8, Signed), Int(-112, 8, Signed)));
+
+  BOOST_CHECK(mul(Interval(Int(2, 8, Unsigned), Int(3, 8, Unsigned)),
+                  Interval(Int(4, 8, Unsigned), Int(5, 8, Unsigned))) ==
+              Interval(Int(8, 8, Unsigned), Int(15, 8, Unsigned)));
+  BOOST_CHECK(mul(Interval(Int(16, 8, Unsigned), Int(17, 8, Unsigned)),
+                  Interval(Int(16, 8, Unsigned), Int(16, 8, Unsigned))) ==
+              Interval(Int(0, 8, Unsigned), Int(16, 8, Unsigned)));
+  BOOST_CHECK(
+      mul(Interval(Int(uint64_t(1) << 32, 64, Unsigned),
+                   Int(uint64_t(1) << 33, 64, Unsigned)),
+          Interval(Int(uint64_t(1) << 32, 64, Unsigned),
+                   Int(uint64_t(1) << 32, 64, Unsigned))) ==
+      Interval::top(64, Unsigned));
+}
+
+BOOST_AUTO_TEST_CASE(test_mul_no_wrap) {
+  BOOST_CHECK(mul_no_wrap(Interval(Int(10, 8, Signed), Int(20, 8, Signed)),
+                          Interval(Int(-10, 8, Signed), Int(10, 8, Signed))) ==
+              Interval(Int(-128, 8, Signed), Int(127, 8, Signed)));
+  BOOST_CHECK(mul_no_wrap(Interval(Int(2, 8, Signed), Int(3, 8, Signed)),
+                          Interval(Int(4, 8, Signed), Int(5, 8, Signed))) ==
+              Interval(Int(8, 8, Signed), Int(15, 8, Signed)));
+  BOOST_CHECK(
+      mul_no_wrap(Interval(Int(16, 8, Unsigned), Int(17, 8, Unsigned)),
+                  Interval(Int(16, 8, Unsigned), Int(16, 8, Unsigned))) ==
+      Interval::bottom(8, Unsigned));
+  BOOST_CHECK(
+      mul_no_wrap(Interval(Int(1, 64, Unsigned),
+                           Int(uint64_t(1) << 40, 64, Unsigned)),
+                  Interval(Int(uint64_t(1) << 32, 64, Unsigned),
+                           Int(uint64_t(1) << 32, 64, Unsigned))) ==
+      Interval(Int(uint64_t(1) << 32, 64, Unsigned), Int::max(64, Unsigned)));
+}
+
+namespace {
+
+using BinaryOperator = std::function< Interval(const Interval&,
+                                               const Interval&) >;
+using ZBinaryOperator = std::function< ZInterval(const ZInterval&,
+                                                 const ZInterval&) >;
+
+/// \brief Check a binary operator against the same operation on ZInterval
+template < typename Tag >
+void check_against_z_interval(const Interval& lhs,
+                              const Interval& rhs,
+                              const BinaryOperator& op,
+                              const ZBinaryOperator& z_op) {
+  Interval expected =
+      Interval::from_z_interval(z_op(lhs.to_z_interval(),
+                                     rhs.to_z_interval()),
+                                lhs.bit_width(),
+                                lhs.sign(),
+                                Tag{});
+  BOOST_CHECK_MESSAGE(op(lhs, rhs) == expected,
+                      lhs << " op " << rhs << " = " << op(lhs, rhs)
+                          << ", expected " << expected);
+}
+
+/// \brief Check all arithmetic operators against ZInterval
+void check_arithmetic(const Interval& lhs, const Interval& rhs) {
+  using WrapTag = Interval::WrapTag;
+  using TruncTag = Interval::TruncTag;
+
+  auto z_add = [](const ZInterval& a, const ZInterval& b) { return a + b; };
+  auto z_sub = [](const ZInterval& a, const ZInterval& b) { return a - b; };
+  auto z_mul = [](const ZInterval& a, const ZInterval& b) { return a * b; };
+  check_against_z_interval< WrapTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return add(a, b); },
+      z_add);
+  check_against_z_interval< TruncTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return add_no_wrap(a, b); },
+      z_add);
+  check_against_z_interval< WrapTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return sub(a, b); },
+      z_sub);
+  check_against_z_interval< TruncTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return sub_no_wrap(a, b); },
+      z_sub);
+  check_against_z_interval< WrapTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return mul(a, b); },
+      z_mul);
+  check_against_z_interval< TruncTag >(
+      lhs,
+      rhs,
+      [](const Interval& a, const Interval& b) { return mul_no_wrap(a, b); },
+      z_mul);
+
+  // Shift amounts within [0, bit_width - 1]
+  if (!rhs.lb().is_negative() &&
+      rhs.ub().to_z_number() < ikos::core::ZNumber(lhs.bit_width())) {
+    auto z_shl = [](const ZInterval& a, const ZInterval& b) {
+      return a * ZInterval(ZBound(1 << *b.lb().number()),
+                           ZBound(1 << *b.ub().number()));
+    };
+    check_against_z_interval< WrapTag >(
+        lhs,
+        rhs,
+        [](const Interval& a, const Interval& b) { return shl(a, b); },
+        z_shl);
+    check_against_z_interval< TruncTag >(
+        lhs,
+        rhs,
+        [](const Interval& a, const Interval& b) { return shl_no_wrap(a, b); },
+        z_shl);
+  }
+}
+
+/// \brief Return all the intervals for the given bit width and signedness
+std::vector< Interval > all_intervals(uint64_t bit_width,
+                                      ikos::core::Signedness sign) {
+  std::vector< Interval > intervals;
+  for (Int lb = Int::min(bit_width, sign);; ++lb) {
+    for (Int ub = lb;; ++ub) {
+      intervals.emplace_back(lb, ub);
+      if (ub.is_max()) {
+        break;
+      }
+    }
+    if (lb.is_max()) {
+      break;
+    }
+  }
+  return intervals;
+}
+
+/// \brief Return intervals with bounds close to the limits of the given bit
+/// width and signedness
+std::vector< Interval > edge_intervals(uint64_t bit_width,
+                                       ikos::core::Signedness sign) {
+  Int min = Int::min(bit_width, sign);
+  Int max = Int::max(bit_width, sign);
+  Int one(1, bit_width, sign);
+  Int two(2, bit_width, sign);
+  Int half = max / two;
+  std::vector< Int > bounds = {min,
+                               min + one,
+                               Int::zero(bit_width, sign),
+                               one,
+                               two,
+                               Int(3, bit_width, sign),
+                               half,
+                               half + one,
+                               max - one,
+                               max};
+  if (sign == Signed) {
+    bounds.push_back(-one);
+    bounds.push_back(-half);
+  }
+
+  std::vector< Interval > intervals;
+  for (const Int& lb : bounds) {
+    for (const Int& ub : bounds) {
+      if (lb <= ub) {
+        intervals.emplace_back(lb, ub);
+      }
+    }
+  }
+  return intervals;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_native_arithmetic) {
+  for (ikos::core::Signedness sign : {Signed, Unsigned}) {
+    for (uint64_t bit_width = 1; bit_width <= 4; bit_width++) {
+      std::vector< Interval > intervals = all_intervals(bit_width, sign);
+      for (const Interval& lhs : intervals) {
+        for (const Interval& rhs : intervals) {
+          check_arithmetic(lhs, rhs);
+        }
+      }
+    }
+
+    for (uint64_t bit_width : {8, 32, 62, 63, 64}) {
+      std::vector< Interval > intervals = edge_intervals(bit_width, sign);
+      for (const Interval& lhs : intervals) {
+        for (const Interval& rhs : intervals) {
+          check_arithmetic(lhs, rhs);
+        }
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_to_z_interval) {
   BOOST_CHECK(Interval::bottom(8, Signed).to_z_interval() ==
               ZInterval::bottom());
@@ -564,3 +564,15 @@ BOOST_AUTO_TEST_CASE(test_narrowing_threshold) {
                                        ZNumber(-20)) ==
               ZInterval(ZBound(0), ZBound(20)));
 }
+
+BOOST_AUTO_TEST_CASE(test_hash) {
+  BOOST_CHECK(hash_value(ZInterval(ZBound(1), ZBound(3))) ==
+              hash_value(ZInterval(ZBound(1), ZBound(3))));
+  BOOST_CHECK(hash_value(ZInterval(ZBound(1), ZBound(3))) !=
+              hash_value(ZInterval(ZBound(1), ZBound(4))));
+  BOOST_CHECK(hash_value(ZInterval(ZBound(1), ZBound::plus_infinity())) !=
+              hash_value(ZInterval(ZBound(1), ZBound(1))));
+  BOOST_CHECK(hash_value(ZInterval::top()) == hash_value(ZInterval::top()));
+  BOOST_CHECK(hash_value(ZInterval::bottom()) ==
+              hash_value(ZInterval(ZBound(3), ZBound(1))));
+}
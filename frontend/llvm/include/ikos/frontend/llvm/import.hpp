@@ -6,6 +6,7 @@
  * For convenience, this header includes:
  *   * ikos/frontend/llvm/import/exception.hpp
  *   * ikos/frontend/llvm/import/importer.hpp
+ *   * ikos/frontend/llvm/import/reachability.hpp
  *
  * Author: Maxime Arthaud
  *
@@ -49,3 +50,5 @@
 
 #include <ikos/frontend/llvm/import/exception.hpp>
 #include <ikos/frontend/llvm/import/importer.hpp>
+#include <ikos/frontend/llvm/import/reachability.hpp>
+#include <ikos/frontend/llvm/import/source_info.hpp>
@@ -117,8 +117,14 @@ public:
 
   /// \brief Generate an AR bundle from a LLVM module
   ///
+  /// Global variables and function declarations are translated first, then
+  /// function bodies are translated on `num_threads` threads (0 means use all
+  /// available cores). The result does not depend on the number of threads.
+  ///
   /// \throws ImportError on errors
-  ar::Bundle* import(llvm::Module&, ImportOptions opts = DefaultOptions);
+  ar::Bundle* import(llvm::Module&,
+                     ImportOptions opts = DefaultOptions,
+                     int num_threads = 1);
 };
 
 IKOS_DECLARE_OPERATORS_FOR_FLAGS(Importer::ImportOptions)
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Source information provider for the AR binary format
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <ikos/ar/format/binary.hpp>
+
+namespace ikos {
+namespace frontend {
+namespace import {
+
+/// \brief Source information provider for AR objects translated from LLVM
+///
+/// This resolves the source information of AR objects using their LLVM
+/// front-end objects, so that a bundle can be written with ar::BinaryWriter
+/// and later analyzed without the llvm::Module.
+class SourceInfoProvider final : public ar::BinaryWriter::SourceInfoProvider {
+private:
+  /// \brief Storage for the file of the last returned source information
+  std::string _file;
+
+  /// \brief Storage for the name of the last returned source information
+  std::string _name;
+
+public:
+  /// \brief Constructor
+  SourceInfoProvider() = default;
+
+  /// \brief No copy constructor
+  SourceInfoProvider(const SourceInfoProvider&) = delete;
+
+  /// \brief No move constructor
+  SourceInfoProvider(SourceInfoProvider&&) = delete;
+
+  /// \brief No copy assignment operator
+  SourceInfoProvider& operator=(const SourceInfoProvider&) = delete;
+
+  /// \brief No move assignment operator
+  SourceInfoProvider& operator=(SourceInfoProvider&&) = delete;
+
+  /// \brief Destructor
+  ~SourceInfoProvider() override;
+
+  /// \brief Return the source information of a function
+  ///
+  /// This is the LLVM name, and the location of the debug information.
+  ar::SourceInfo source_info(ar::Function*) override;
+
+  /// \brief Return the source information of a global variable
+  ///
+  /// This is the debug information name, or the LLVM name.
+  ar::SourceInfo source_info(ar::GlobalVariable*) override;
+
+  /// \brief Return the source information of a local variable
+  ///
+  /// This is the debug information name, or the LLVM name.
+  ar::SourceInfo source_info(ar::LocalVariable*) override;
+
+  /// \brief Return the source information of an internal variable
+  ///
+  /// This is the LLVM name.
+  ar::SourceInfo source_info(ar::InternalVariable*) override;
+
+  /// \brief Return the source information of a statement
+  ///
+  /// This is the location returned by source_location(), which is resolved
+  /// here since it requires the surrounding LLVM instructions.
+  ar::SourceInfo source_info(ar::Statement*) override;
+
+private:
+  /// \brief Return a source information with the given name
+  ar::SourceInfo named(std::string name);
+
+}; // end class SourceInfoProvider
+
+} // end namespace import
+} // end namespace frontend
+} // end namespace ikos
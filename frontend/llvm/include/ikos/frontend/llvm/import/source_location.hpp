@@ -51,6 +51,7 @@
 
 #include <ikos/ar/semantic/statement.hpp>
 #include <ikos/ar/support/assert.hpp>
+#include <ikos/ar/support/source_info.hpp>
 
 namespace ikos {
 namespace frontend {
@@ -60,11 +61,17 @@ namespace import {
 boost::filesystem::path source_path(llvm::DIFile* file);
 
 /// \brief Represents a source code location
+///
+/// A source location either comes from the LLVM debug information, or from
+/// the source information of a bundle loaded from the AR binary format.
 class SourceLocation {
 private:
   /// \brief Debug Information Location
   llvm::DILocation* _loc = nullptr;
 
+  /// \brief Source information, for bundles without LLVM module
+  const ar::SourceInfo* _info = nullptr;
+
 public:
   /// \brief Create a null source location
   SourceLocation() = default;
@@ -74,6 +81,11 @@ public:
     ikos_assert(loc != nullptr && loc->isResolved());
   }
 
+  /// \brief Create a source location from an ar::SourceInfo*
+  explicit SourceLocation(const ar::SourceInfo* info) : _info(info) {
+    ikos_assert(info != nullptr && info->has_location());
+  }
+
   /// \brief Copy constructor
   SourceLocation(const SourceLocation&) noexcept = default;
 
@@ -90,31 +102,42 @@ public:
   ~SourceLocation() = default;
 
   /// \brief Return true if the source location is null
-  bool is_null() const { return this->_loc == nullptr; }
+  bool is_null() const {
+    return this->_loc == nullptr && this->_info == nullptr;
+  }
 
   /// \brief Return true if the source location is not null
-  explicit operator bool() const { return this->_loc != nullptr; }
+  explicit operator bool() const { return !this->is_null(); }
 
-  /// \brief Return the file
+  /// \brief Return the file, or null if the location comes from an
+  /// ar::SourceInfo
   llvm::DIFile* file() const {
-    ikos_assert(this->_loc != nullptr);
-    return this->_loc->getFile();
+    ikos_assert(!this->is_null());
+    return this->_loc != nullptr ? this->_loc->getFile() : nullptr;
   }
 
   /// \brief Return the line
   unsigned line() const {
-    ikos_assert(this->_loc != nullptr);
-    return this->_loc->getLine();
+    ikos_assert(!this->is_null());
+    return this->_loc != nullptr ? this->_loc->getLine() : this->_info->line;
   }
 
   /// \brief Return the column
   unsigned column() const {
-    ikos_assert(this->_loc != nullptr);
-    return this->_loc->getColumn();
+    ikos_assert(!this->is_null());
+    return this->_loc != nullptr ? this->_loc->getColumn()
+                                 : this->_info->column;
   }
 
   /// \brief Return the absolute path to the filename
-  boost::filesystem::path path() const { return source_path(this->file()); }
+  boost::filesystem::path path() const {
+    ikos_assert(!this->is_null());
+    if (this->_loc != nullptr) {
+      return source_path(this->file());
+    } else {
+      return boost::filesystem::path(this->_info->file.to_string());
+    }
+  }
 
 }; // end class SourceLocation
 
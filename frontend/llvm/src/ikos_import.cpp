@@ -53,6 +53,7 @@
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <ikos/ar/format/binary.hpp>
 #include <ikos/ar/format/dot.hpp>
 #include <ikos/ar/format/text.hpp>
 #include <ikos/ar/pass/simplify_cfg.hpp>
@@ -99,6 +100,19 @@ static llvm::cl::opt< bool > NoTypeCheck(
 static llvm::cl::opt< bool > NoSimplifyCFG(
     "no-simplify-cfg", llvm::cl::desc("Do not run the simplify-cfg pass"));
 
+static llvm::cl::list< std::string > EntryPoints(
+    "entry-points",
+    llvm::cl::desc("Only import the functions reachable from these entry "
+                   "points (ex: main)"),
+    llvm::cl::CommaSeparated,
+    llvm::cl::value_desc("function"));
+
+static llvm::cl::opt< int > Jobs(
+    "j",
+    llvm::cl::desc("Number of threads used to translate function bodies "
+                   "(0 means all available cores)"),
+    llvm::cl::init(1));
+
 enum OutputFormatType { None, Text, Dot };
 
 static llvm::cl::opt< OutputFormatType > OutputFormat(
@@ -109,6 +123,11 @@ static llvm::cl::opt< OutputFormatType > OutputFormat(
                      clEnumValN(Dot, "dot", "Dot format")),
     llvm::cl::init(Text));
 
+static llvm::cl::opt< bool > EmitArBin(
+    "emit-ar-bin",
+    llvm::cl::desc("Write the AR in binary format, for ikos-analyzer -input-ar "
+                   "(overrides -format)"));
+
 static llvm::cl::opt< bool > NoShowResultType(
     "no-show-result-type",
     llvm::cl::desc("Do not show the result type of statements"));
@@ -167,13 +186,29 @@ int main(int argc, char** argv) {
     llvm::SMDiagnostic err;
 
     // Load the input module
+    // With entry points, function bodies are only parsed if they are reachable
     std::unique_ptr< llvm::Module > module =
-        llvm::parseIRFile(InputFilename, err, llvm_context);
+        EntryPoints.empty()
+            ? llvm::parseIRFile(InputFilename, err, llvm_context)
+            : llvm::getLazyIRFileModule(InputFilename, err, llvm_context);
     if (!module) {
       err.print(progname.c_str(), llvm::errs());
       return 1;
     }
 
+    // Remove the functions unreachable from the entry points
+    if (!EntryPoints.empty()) {
+      try {
+        llvm_to_ar::prune_unreachable_functions(*module,
+                                                {EntryPoints.begin(),
+                                                 EntryPoints.end()});
+      } catch (llvm_to_ar::ImportError& err) {
+        llvm::errs() << progname << ": " << InputFilename
+                     << ": error: " << err.what() << "\n";
+        return 1;
+      }
+    }
+
     // Immediately run the verifier to catch any problems
     if (!NoVerify && verifyModule(*module, &llvm::errs())) {
       llvm::errs() << progname << ": " << InputFilename
@@ -196,7 +231,7 @@ int main(int argc, char** argv) {
     ar::Bundle* bundle = nullptr;
     try {
       llvm_to_ar::Importer importer(ar_context);
-      bundle = importer.import(*module, make_import_options());
+      bundle = importer.import(*module, make_import_options(), Jobs);
     } catch (llvm_to_ar::ImportError& err) {
       llvm::errs() << progname << ": " << InputFilename
                    << ": error: " << err.what() << "\n";
@@ -217,7 +252,26 @@ int main(int argc, char** argv) {
     }
 
     // Generate output
-    if (OutputFormat == Text) {
+    if (EmitArBin) {
+      llvm_to_ar::SourceInfoProvider provider;
+      ar::BinaryWriter writer(&provider);
+
+      if (OutputFilename.empty() || OutputFilename == "-") {
+        // Default to standard output
+        writer.write(std::cout, bundle);
+      } else {
+        boost::filesystem::ofstream output(OutputFilename.getValue(),
+                                           std::ios::out | std::ios::binary);
+
+        if (!output.is_open()) {
+          llvm::errs() << progname << ": " << OutputFilename << ": "
+                       << strerror(errno) << "\n";
+          return 5;
+        }
+
+        writer.write(output, bundle);
+      }
+    } else if (OutputFormat == Text) {
       ar::TextFormatter formatter(make_format_options());
 
       if (OutputFilename.empty() || OutputFilename == "-") {
@@ -83,6 +83,8 @@ static ar::MachineInt to_machine_int(const llvm::APInt& n,
 ar::Value* ConstantImporter::translate_constant(llvm::Constant* cst,
                                                 ar::Type* type,
                                                 ar::BasicBlock* bb) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
+
   // List of constant expressions to handle
   llvm::SmallVector< ConstantExpression, 4 > exprs;
 
@@ -566,6 +568,8 @@ ar::Value* ConstantImporter::translate_cast_integer_constant(
     llvm::Constant* cst, ar::IntegerType* type) {
   ikos_assert(type != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
+
   auto it = this->_constants.find({cst, type});
 
   if (it != this->_constants.end()) {
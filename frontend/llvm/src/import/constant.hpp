@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Constants.h>
@@ -80,6 +82,9 @@ private:
   // LLVM data layout
   const llvm::DataLayout& _llvm_data_layout;
 
+  // Mutex for the shared state
+  std::recursive_mutex& _mutex;
+
   // Map from LLVM Constant + AR type to AR value
   llvm::DenseMap< std::pair< llvm::Constant*, ar::Type* >, ar::Value* >
       _constants;
@@ -90,7 +95,8 @@ public:
       : _ctx(ctx),
         _context(ctx.ar_context),
         _bundle(ctx.bundle),
-        _llvm_data_layout(ctx.llvm_data_layout) {}
+        _llvm_data_layout(ctx.llvm_data_layout),
+        _mutex(ctx.mutex) {}
 
 public:
   /// \brief Translate a llvm::Constant into an ar::Value
@@ -44,6 +44,7 @@
  ******************************************************************************/
 
 #include <deque>
+#include <mutex>
 
 #include <boost/container/flat_map.hpp>
 
@@ -66,6 +67,30 @@ namespace ikos {
 namespace frontend {
 namespace import {
 
+void FunctionImporter::lower_fneg(llvm::Function* fun) {
+  for (llvm::BasicBlock& bb : *fun) {
+    for (auto it = bb.begin(), et = bb.end(); it != et;) {
+      llvm::Instruction* inst = &*it++;
+      if (inst->getOpcode() != llvm::Instruction::FNeg) {
+        continue;
+      }
+
+      // Replace `fneg %x` by `fmul -1.0, %x`
+      auto* binary_inst =
+          llvm::BinaryOperator::Create(llvm::BinaryOperator::FMul,
+                                       llvm::ConstantFP::get(inst->getOperand(0)
+                                                                 ->getType(),
+                                                             -1.0),
+                                       inst->getOperand(0),
+                                       "",
+                                       inst);
+      binary_inst->setDebugLoc(inst->getDebugLoc());
+      inst->replaceAllUsesWith(binary_inst);
+      inst->eraseFromParent();
+    }
+  }
+}
+
 ar::Code* FunctionImporter::translate_body() {
   // Translate parameters
   this->translate_parameters();
@@ -375,16 +400,6 @@ void FunctionImporter::translate_instruction(
   } else if (llvm::isa< llvm::SwitchInst >(inst)) {
     // The preprocessor should use the -lowerswitch pass
     throw ImportError("llvm switch instructions are not supported");
-  } else if (inst->getOpcode() == llvm::Instruction::FNeg) {
-    auto* binary_inst =
-        llvm::BinaryOperator::Create(llvm::BinaryOperator::FMul,
-                                     llvm::ConstantFP::get(inst->getOperand(0)
-                                                               ->getType(),
-                                                           -1.0),
-                                     inst->getOperand(0));
-    inst->replaceAllUsesWith(binary_inst);
-    binary_inst->setDebugLoc(inst->getDebugLoc());
-    this->translate_binary_operator(bb_translation, binary_inst);
   } else {
     std::ostringstream buf;
     buf << "unsupported llvm instruction: " << inst->getOpcodeName() << " [1]";
@@ -914,8 +929,7 @@ void FunctionImporter::translate_getelementptr(
                   value.getZExtValue() <=
                       std::numeric_limits< unsigned >::max());
       auto uint_value = static_cast< unsigned >(value.getZExtValue());
-      uint64_t offset = this->_llvm_data_layout.getStructLayout(struct_type)
-                            ->getElementOffset(uint_value);
+      uint64_t offset = this->struct_element_offset(struct_type, uint_value);
 
       ar::IntegerConstant* ar_op =
           ar::IntegerConstant::get(this->_context,
@@ -929,8 +943,7 @@ void FunctionImporter::translate_getelementptr(
                          ar_op);
     } else {
       // Shift in a sequential type
-      uint64_t size =
-          this->_llvm_data_layout.getTypeAllocSize(it.getIndexedType());
+      uint64_t size = this->type_alloc_size(it.getIndexedType());
       ar::Type* preferred_type =
           llvm::isa< llvm::Constant >(op)
               ? _ctx.type_imp->translate_type(op->getType(), ar::Signed)
@@ -1545,20 +1558,16 @@ ar::IntegerConstant* FunctionImporter::translate_indexes(
     unsigned idx = *it;
 
     if (auto struct_type = llvm::dyn_cast< llvm::StructType >(indexed_type)) {
-      offset += this->_llvm_data_layout.getStructLayout(struct_type)
-                    ->getElementOffset(idx);
+      offset += this->struct_element_offset(struct_type, idx);
     } else if (auto array_type =
                    llvm::dyn_cast< llvm::ArrayType >(indexed_type)) {
       ar::ZNumber element_size(
-          this->_llvm_data_layout.getTypeAllocSize(array_type->getElementType())
-              .getFixedSize());
+          this->type_alloc_size(array_type->getElementType()));
       offset += element_size * idx;
     } else if (auto vector_type =
                    llvm::dyn_cast< llvm::VectorType >(indexed_type)) {
       ar::ZNumber element_size(
-          this->_llvm_data_layout
-              .getTypeAllocSize(vector_type->getElementType())
-              .getFixedSize());
+          this->type_alloc_size(vector_type->getElementType()));
       offset += element_size * idx;
     } else {
       throw ImportError("unsupported operand to llvm extractvalue");
@@ -1575,6 +1584,17 @@ ar::IntegerConstant* FunctionImporter::translate_indexes(
                                                  size_type->sign()));
 }
 
+uint64_t FunctionImporter::struct_element_offset(llvm::StructType* type,
+                                                 unsigned idx) {
+  std::lock_guard< std::recursive_mutex > lock(_ctx.mutex);
+  return this->_llvm_data_layout.getStructLayout(type)->getElementOffset(idx);
+}
+
+uint64_t FunctionImporter::type_alloc_size(llvm::Type* type) {
+  std::lock_guard< std::recursive_mutex > lock(_ctx.mutex);
+  return this->_llvm_data_layout.getTypeAllocSize(type).getFixedSize();
+}
+
 void FunctionImporter::translate_extractelement(
     BasicBlockTranslation* bb_translation, llvm::ExtractElementInst* inst) {
   // Translate result variable
@@ -1593,9 +1613,7 @@ void FunctionImporter::translate_extractelement(
   }
   auto size_type = ar::IntegerType::size_type(this->_bundle);
   ar::ZNumber element_size(
-      this->_llvm_data_layout
-          .getTypeAllocSize(inst->getVectorOperandType()->getElementType())
-          .getFixedSize());
+      this->type_alloc_size(inst->getVectorOperandType()->getElementType()));
   ar::ZNumber offset_value = index->getZExtValue() * element_size;
   auto offset = ar::IntegerConstant::get(this->_context,
                                          size_type,
@@ -1627,9 +1645,7 @@ void FunctionImporter::translate_insertelement(
   }
   auto size_type = ar::IntegerType::size_type(this->_bundle);
   ar::ZNumber element_size(
-      this->_llvm_data_layout
-          .getTypeAllocSize(inst->getType()->getElementType())
-          .getFixedSize());
+      this->type_alloc_size(inst->getType()->getElementType()));
   ar::ZNumber offset_value = index->getZExtValue() * element_size;
   auto offset = ar::IntegerConstant::get(this->_context,
                                          size_type,
@@ -2486,9 +2502,9 @@ void BasicBlockTranslation::add_comparison(
     this->internals.push_back(bb);
     this->outputs.clear();
 
-    ar::Comparison* cmp_ptr = cmp.get();
+    std::unique_ptr< ar::Comparison > inverse = cmp->inverse();
     this->add_comparison_output_bb(bb, std::move(cmp), var, true);
-    this->add_comparison_output_bb(bb, cmp_ptr->inverse(), var, false);
+    this->add_comparison_output_bb(bb, std::move(inverse), var, false);
   } else {
     std::vector< BasicBlockOutput > prev_outputs;
     std::swap(prev_outputs, this->outputs);
@@ -234,6 +234,13 @@ public:
         _allow_debug_info_mismatch(
             ctx.opts.test(Importer::AllowMismatchDebugInfo)) {}
 
+  /// \brief Replace the llvm fneg instructions of a function by llvm fmul
+  /// instructions
+  ///
+  /// This modifies the LLVM module, hence it must be called before translating
+  /// function bodies in parallel.
+  static void lower_fneg(llvm::Function* fun);
+
   /// \brief Translate the body of the function
   ar::Code* translate_body();
 
@@ -366,6 +373,17 @@ private:
       llvm::ExtractValueInst::idx_iterator begin,
       llvm::ExtractValueInst::idx_iterator end);
 
+  /// \brief Return the offset of a structure element, in bytes
+  ///
+  /// The LLVM data layout computes structure layouts lazily, hence this is
+  /// protected by the import context mutex.
+  uint64_t struct_element_offset(llvm::StructType* type, unsigned idx);
+
+  /// \brief Return the allocation size of a type, in bytes
+  ///
+  /// See struct_element_offset().
+  uint64_t type_alloc_size(llvm::Type* type);
+
   /// \brief Translate a llvm::ExtractElementInst
   void translate_extractelement(BasicBlockTranslation* bb_translation,
                                 llvm::ExtractElementInst* inst);
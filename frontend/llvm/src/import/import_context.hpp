@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
@@ -104,6 +106,12 @@ public:
   /// \brief Helper class to translate global values and functions
   BundleImporter* bundle_imp;
 
+  /// \brief Mutex for the state shared by the translations of function bodies
+  ///
+  /// This protects the caches of the TypeImporter and ConstantImporter, and the
+  /// struct layouts that the LLVM data layout computes lazily.
+  std::recursive_mutex mutex;
+
 public:
   /// \brief Create an ImportContext
   ImportContext(llvm::Module& module_, ar::Bundle* bundle_, ImportOptions opts_)
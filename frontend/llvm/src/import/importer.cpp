@@ -43,9 +43,15 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <exception>
+#include <vector>
+
 #include <llvm/IR/Function.h>
 #include <llvm/IR/GlobalVariable.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Threading.h>
 
 #include <ikos/core/support/assert.hpp>
 
@@ -56,6 +62,7 @@
 #include "bundle.hpp"
 #include "constant.hpp"
 #include "data_layout.hpp"
+#include "function.hpp"
 #include "import_context.hpp"
 #include "library_function.hpp"
 #include "type.hpp"
@@ -72,7 +79,9 @@ bool has_debug_info(llvm::Module& m) {
 
 // Importer
 
-ar::Bundle* Importer::import(llvm::Module& module, ImportOptions opts) {
+ar::Bundle* Importer::import(llvm::Module& module,
+                             ImportOptions opts,
+                             int num_threads) {
   // Create the data layout
   std::unique_ptr< ar::DataLayout > data_layout =
       translate_data_layout(module.getDataLayout(), module.getContext());
@@ -119,10 +128,42 @@ ar::Bundle* Importer::import(llvm::Module& module, ImportOptions opts) {
     }
   }
 
-  // Translate all function bodies
+  // Collect all function definitions
+  std::vector< llvm::Function* > definitions;
   for (llvm::Function& fun : module) {
     if (!fun.isDeclaration()) {
-      bundle_imp.translate_function_body(&fun);
+      FunctionImporter::lower_fneg(&fun);
+      definitions.push_back(&fun);
+    }
+  }
+
+  // Translate all function bodies
+  if (num_threads == 1) {
+    for (llvm::Function* fun : definitions) {
+      bundle_imp.translate_function_body(fun);
+    }
+  } else {
+    // Each task only creates the body of its own function. Shared state is
+    // protected by the import context and the AR context.
+    std::vector< std::exception_ptr > errors(definitions.size());
+    llvm::ThreadPool pool(llvm::hardware_concurrency(
+        static_cast< unsigned >(std::max(num_threads, 0))));
+    for (std::size_t i = 0; i < definitions.size(); i++) {
+      pool.async([&, i] {
+        try {
+          bundle_imp.translate_function_body(definitions[i]);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    pool.wait();
+
+    // Report the error of the first function, for determinism
+    for (const std::exception_ptr& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
     }
   }
 
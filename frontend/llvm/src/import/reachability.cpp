@@ -0,0 +1,198 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Prune the functions unreachable from the entry points
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalIFunc.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/Support/Error.h>
+
+#include <ikos/frontend/llvm/import/exception.hpp>
+#include <ikos/frontend/llvm/import/reachability.hpp>
+
+namespace ikos {
+namespace frontend {
+namespace import {
+
+namespace {
+
+/// \brief Compute the set of reachable functions
+class ReachableFunctions {
+private:
+  // Reachable functions
+  llvm::DenseSet< llvm::Function* > _functions;
+
+  // Visited constants
+  llvm::DenseSet< llvm::Constant* > _constants;
+
+  // Reachable functions whose body has not been scanned yet
+  std::vector< llvm::Function* > _worklist;
+
+public:
+  /// \brief Mark a function as reachable
+  void add(llvm::Function* fun) {
+    if (this->_functions.insert(fun).second) {
+      this->_worklist.push_back(fun);
+    }
+  }
+
+  /// \brief Mark the functions referenced by a constant as reachable
+  void add(llvm::Constant* cst) {
+    std::vector< llvm::Constant* > stack{cst};
+
+    while (!stack.empty()) {
+      llvm::Constant* c = stack.back();
+      stack.pop_back();
+
+      if (llvm::isa< llvm::ConstantData >(c) ||
+          !this->_constants.insert(c).second) {
+        continue;
+      }
+
+      if (auto fun = llvm::dyn_cast< llvm::Function >(c)) {
+        this->add(fun);
+      } else if (auto alias = llvm::dyn_cast< llvm::GlobalAlias >(c)) {
+        stack.push_back(alias->getAliasee());
+      } else if (auto ifunc = llvm::dyn_cast< llvm::GlobalIFunc >(c)) {
+        stack.push_back(ifunc->getResolver());
+      } else if (auto addr = llvm::dyn_cast< llvm::BlockAddress >(c)) {
+        // The operands are the function and a basic block, not a constant
+        this->add(addr->getFunction());
+      } else if (llvm::isa< llvm::GlobalVariable >(c)) {
+        // Initializers of global variables are already roots
+        continue;
+      } else {
+        for (llvm::Value* op : c->operand_values()) {
+          if (auto op_cst = llvm::dyn_cast< llvm::Constant >(op)) {
+            stack.push_back(op_cst);
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Mark the functions referenced by the reachable functions
+  ///
+  /// This materializes the bodies of the reachable functions.
+  void run() {
+    while (!this->_worklist.empty()) {
+      llvm::Function* fun = this->_worklist.back();
+      this->_worklist.pop_back();
+
+      if (llvm::Error err = fun->materialize()) {
+        throw ImportError("could not materialize llvm function " +
+                          fun->getName().str() + ": " +
+                          llvm::toString(std::move(err)));
+      }
+
+      if (fun->hasPersonalityFn()) {
+        this->add(fun->getPersonalityFn());
+      }
+
+      for (llvm::BasicBlock& bb : *fun) {
+        for (llvm::Instruction& inst : bb) {
+          for (llvm::Value* op : inst.operand_values()) {
+            if (auto cst = llvm::dyn_cast< llvm::Constant >(op)) {
+              this->add(cst);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Return true if the given function is reachable
+  bool contains(llvm::Function* fun) const {
+    return this->_functions.count(fun) != 0;
+  }
+
+}; // end class ReachableFunctions
+
+} // end anonymous namespace
+
+std::size_t prune_unreachable_functions(
+    llvm::Module& module, const std::vector< std::string >& entry_points) {
+  ReachableFunctions reachable;
+
+  // Entry points
+  for (const std::string& name : entry_points) {
+    if (llvm::Function* fun = module.getFunction(name)) {
+      reachable.add(fun);
+    }
+  }
+
+  // Functions referenced by global variables
+  for (llvm::GlobalVariable& gv : module.globals()) {
+    if (gv.hasInitializer()) {
+      reachable.add(gv.getInitializer());
+    }
+  }
+
+  reachable.run();
+
+  // Turn unreachable functions into declarations
+  std::size_t num_removed = 0;
+  for (llvm::Function& fun : module) {
+    if (!fun.isDeclaration() && !reachable.contains(&fun)) {
+      fun.deleteBody();
+      fun.setComdat(nullptr);
+      num_removed++;
+    }
+  }
+
+  // Materialize the rest of the module, e.g, metadata
+  if (llvm::Error err = module.materializeAll()) {
+    throw ImportError("could not materialize llvm module: " +
+                      llvm::toString(std::move(err)));
+  }
+
+  return num_removed;
+}
+
+} // end namespace import
+} // end namespace frontend
+} // end namespace ikos
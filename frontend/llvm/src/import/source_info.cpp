@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Source information provider for the AR binary format
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/Transforms/Utils/Local.h>
+
+#include <ikos/frontend/llvm/import/source_info.hpp>
+#include <ikos/frontend/llvm/import/source_location.hpp>
+
+namespace ikos {
+namespace frontend {
+namespace import {
+
+/// \brief Return the debug information name of the given alloca, or empty
+static llvm::StringRef debug_name(llvm::AllocaInst* alloca) {
+  // Check for llvm.dbg.declare and llvm.dbg.addr
+  llvm::TinyPtrVector< llvm::DbgVariableIntrinsic* > dbg_addrs =
+      llvm::FindDbgAddrUses(alloca);
+  auto dbg_addr =
+      std::find_if(dbg_addrs.begin(),
+                   dbg_addrs.end(),
+                   [](llvm::DbgVariableIntrinsic* dbg) {
+                     return dbg->getExpression()->getNumElements() == 0;
+                   });
+
+  if (dbg_addr != dbg_addrs.end()) {
+    return (*dbg_addr)->getVariable()->getName();
+  }
+
+  // Check for llvm.dbg.value
+  llvm::SmallVector< llvm::DbgValueInst*, 1 > dbg_values;
+  llvm::findDbgValues(dbg_values, alloca);
+  auto dbg_value =
+      std::find_if(dbg_values.begin(),
+                   dbg_values.end(),
+                   [](llvm::DbgValueInst* dbg) {
+                     return dbg->getExpression()->getNumElements() == 0;
+                   });
+
+  if (dbg_value != dbg_values.end()) {
+    return (*dbg_value)->getVariable()->getName();
+  }
+
+  return {};
+}
+
+SourceInfoProvider::~SourceInfoProvider() = default;
+
+ar::SourceInfo SourceInfoProvider::named(std::string name) {
+  this->_name = std::move(name);
+
+  ar::SourceInfo info;
+  info.name = this->_name;
+  return info;
+}
+
+ar::SourceInfo SourceInfoProvider::source_info(ar::Function* fun) {
+  auto llvm_fun = fun->frontend< llvm::Function >();
+  ar::SourceInfo info = this->named(llvm_fun->getName().str());
+
+  if (llvm::DISubprogram* dbg = llvm_fun->getSubprogram()) {
+    this->_file = source_path(dbg->getFile()).string();
+    info.file = this->_file;
+    info.line = dbg->getLine();
+  }
+
+  return info;
+}
+
+ar::SourceInfo SourceInfoProvider::source_info(ar::GlobalVariable* gv) {
+  auto llvm_gv = gv->frontend< llvm::GlobalVariable >();
+
+  // Check for debug info
+  llvm::SmallVector< llvm::DIGlobalVariableExpression*, 1 > dbgs;
+  llvm_gv->getDebugInfo(dbgs);
+
+  if (!dbgs.empty()) {
+    llvm::StringRef name = dbgs[0]->getVariable()->getName();
+
+    if (!name.empty()) {
+      return this->named(name.str());
+    }
+  }
+
+  return this->named(llvm_gv->getName().str());
+}
+
+ar::SourceInfo SourceInfoProvider::source_info(ar::LocalVariable* lv) {
+  auto value = lv->frontend< llvm::Value >();
+
+  if (auto alloca = llvm::dyn_cast< llvm::AllocaInst >(value)) {
+    llvm::StringRef name = debug_name(alloca);
+
+    if (!name.empty()) {
+      return this->named(name.str());
+    }
+  }
+
+  return this->named(value->getName().str());
+}
+
+ar::SourceInfo SourceInfoProvider::source_info(ar::InternalVariable* iv) {
+  return this->named(iv->frontend< llvm::Value >()->getName().str());
+}
+
+ar::SourceInfo SourceInfoProvider::source_info(ar::Statement* stmt) {
+  ar::SourceInfo info;
+
+  SourceLocation loc = source_location(stmt);
+  if (loc) {
+    this->_file = loc.path().string();
+    info.file = this->_file;
+    info.line = loc.line();
+    info.column = loc.column();
+  }
+
+  if (ar::isa< ar::Assignment >(stmt) || ar::isa< ar::UnaryOperation >(stmt)) {
+    auto value = stmt->frontend< llvm::Value >();
+
+    if (llvm::isa< llvm::PHINode >(value) ||
+        llvm::isa< llvm::CmpInst >(value)) {
+      info.flags |= ar::SourceInfo::Synthetic;
+    }
+  }
+
+  return info;
+}
+
+} // end namespace import
+} // end namespace frontend
+} // end namespace ikos
@@ -89,6 +89,17 @@ static SourceLocation source_location(llvm::Instruction* inst) {
   return {}; // null location
 }
 
+/// \brief Return the source location of the given source information
+static SourceLocation source_location(const ar::SourceInfo* info) {
+  ikos_assert(info != nullptr);
+
+  if (info->has_location()) {
+    return SourceLocation(info);
+  }
+
+  return {}; // null location
+}
+
 SourceLocation source_location(ar::Statement* stmt) {
   ikos_assert(stmt != nullptr);
 
@@ -96,6 +107,11 @@ SourceLocation source_location(ar::Statement* stmt) {
     return {}; // null location
   }
 
+  if (stmt->frontend_isa< ar::SourceInfo >()) {
+    // Loaded from the AR binary format, the location was resolved on export
+    return source_location(stmt->frontend< ar::SourceInfo >());
+  }
+
   auto value = stmt->frontend< llvm::Value >();
 
   if (auto inst = llvm::dyn_cast< llvm::Instruction >(value)) {
@@ -118,7 +134,13 @@ SourceLocation source_location(ar::Statement* stmt) {
     for (; it != et; ++it) {
       ar::Statement* s = *it;
 
-      if (s->has_frontend()) {
+      if (s->frontend_isa< ar::SourceInfo >()) {
+        SourceLocation loc = source_location(s->frontend< ar::SourceInfo >());
+
+        if (loc) {
+          return loc;
+        }
+      } else if (s->has_frontend()) {
         if (auto inst = llvm::dyn_cast< llvm::Instruction >(
                 s->frontend< llvm::Value >())) {
           SourceLocation loc = source_location(inst);
@@ -150,7 +172,14 @@ SourceLocation source_location(ar::Statement* stmt) {
       if (!bb->empty()) {
         ar::Statement* s = bb->front();
 
-        if (ar::isa< ar::Comparison >(s) && s->has_frontend()) {
+        if (ar::isa< ar::Comparison >(s) &&
+            s->frontend_isa< ar::SourceInfo >()) {
+          SourceLocation loc = source_location(s->frontend< ar::SourceInfo >());
+
+          if (loc) {
+            return loc;
+          }
+        } else if (ar::isa< ar::Comparison >(s) && s->has_frontend()) {
           if (auto inst = llvm::dyn_cast< llvm::Instruction >(
                   s->frontend< llvm::Value >())) {
             SourceLocation loc = source_location(inst);
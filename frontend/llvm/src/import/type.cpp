@@ -1719,17 +1719,20 @@ bool TypeMatcher::match_extern_function_param_type(llvm::Type* llvm_type,
 }
 
 TypeImporter::TypeImporter(ImportContext& ctx)
-    : _type_sign_imp(ctx),
+    : _mutex(ctx.mutex),
+      _type_sign_imp(ctx),
       _type_di_imp(ctx, this->_type_sign_imp),
       _type_match(ctx) {}
 
 ar::Type* TypeImporter::translate_type(llvm::Type* type,
                                        ar::Signedness preferred) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   return this->_type_sign_imp.translate_type(type, preferred);
 }
 
 ar::Type* TypeImporter::translate_type(llvm::Type* type,
                                        llvm::DIType* di_type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   TypeWithDebugInfoImporter imp = this->_type_di_imp.fork();
   ar::Type* ar_type = imp.translate_type(type, di_type);
   this->_type_di_imp.join(imp);
@@ -1738,6 +1741,7 @@ ar::Type* TypeImporter::translate_type(llvm::Type* type,
 
 ar::FunctionType* TypeImporter::translate_function_type(
     llvm::Function* fun, llvm::DISubroutineType* di_type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   TypeWithDebugInfoImporter imp = this->_type_di_imp.fork();
   ar::FunctionType* ar_type = imp.translate_function_di_type(fun, di_type);
   this->_type_di_imp.join(imp);
@@ -1745,11 +1749,13 @@ ar::FunctionType* TypeImporter::translate_function_type(
 }
 
 bool TypeImporter::match_type(llvm::Type* llvm_type, ar::Type* ar_type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   return this->_type_match.match_type(llvm_type, ar_type);
 }
 
 bool TypeImporter::match_extern_function_type(llvm::FunctionType* llvm_type,
                                               ar::FunctionType* ar_type) {
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
   return this->_type_match.match_extern_function_type(llvm_type, ar_type);
 }
 
@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <boost/container/flat_set.hpp>
 
 #include <llvm/ADT/DenseMap.h>
@@ -414,6 +416,9 @@ private:
 /// \brief Helper class to translate types
 class TypeImporter {
 private:
+  // Mutex for the shared state
+  std::recursive_mutex& _mutex;
+
   // Helper class to translate types with a given signedness
   TypeWithSignImporter _type_sign_imp;
 
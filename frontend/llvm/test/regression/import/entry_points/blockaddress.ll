@@ -0,0 +1,29 @@
+; ModuleID = 'blockaddress.ll'
+source_filename = "blockaddress.ll"
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; The reachability analysis must handle the basic block operand of a
+; blockaddress, and leave the import report the unsupported constant.
+
+define i32 @helper() {
+  ret i32 1
+}
+
+define i32 @main() {
+entry:
+  %p = alloca i8*
+  store i8* blockaddress(@main, %target), i8** %p
+  %a = load i8*, i8** %p
+  indirectbr i8* %a, [label %target]
+
+target:
+  %r = call i32 @helper()
+  ret i32 %r
+}
+
+define i32 @unused() {
+  ret i32 2
+}
+
+; CHECK: error: llvm blockaddress is not supported
@@ -0,0 +1,101 @@
+; ModuleID = 'prune.ll'
+source_filename = "prune.ll"
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+; CHECK-LABEL: Bundle
+; CHECK: target-endianness = little-endian
+; CHECK: target-pointer-size = 64 bits
+; CHECK: target-triple = x86_64-pc-linux-gnu
+
+$comdat_fun = comdat any
+
+@llvm.global_ctors = appending global [1 x { i32, void ()*, i8* }] [{ i32, void ()*, i8* } { i32 65535, void ()* @ctor, i8* null }]
+; CHECK: define [1 x {0: si32, 8: void ()*, 16: si8*}]* @ar.global_ctors, init {
+; CHECK: #1 !entry !exit {
+; CHECK:   store @ar.global_ctors, [{0: 65535, 8: @ctor, 16: null}], align 1
+; CHECK: }
+; CHECK: }
+
+@fun_ptr = global void ()* @via_global
+; CHECK: define void ()** @fun_ptr, init {
+; CHECK: #1 !entry !exit {
+; CHECK:   store @fun_ptr, @via_global, align 1
+; CHECK: }
+; CHECK: }
+
+define void @addr_taken() {
+  ret void
+}
+; CHECK: define void @addr_taken() {
+; CHECK: #1 !entry !exit {
+; CHECK:   return
+; CHECK: }
+; CHECK: }
+
+define void @callee(void ()* %f) {
+  call void %f()
+  ret void
+}
+; CHECK: define void @callee(void ()* %f) {
+; CHECK: #1 !entry !exit {
+; CHECK:   call %f()
+; CHECK:   return
+; CHECK: }
+; CHECK: }
+
+define linkonce_odr void @comdat_fun() comdat {
+  ret void
+}
+; CHECK: declare void @comdat_fun()
+
+define void @ctor() {
+  call void @from_ctor()
+  ret void
+}
+; CHECK: define void @ctor() {
+; CHECK: #1 !entry !exit {
+; CHECK:   call @from_ctor()
+; CHECK:   return
+; CHECK: }
+; CHECK: }
+
+define void @dead() {
+  call void @dead_callee()
+  ret void
+}
+; CHECK: declare void @dead()
+
+define void @dead_callee() {
+  ret void
+}
+; CHECK: declare void @dead_callee()
+
+define void @from_ctor() {
+  ret void
+}
+; CHECK: define void @from_ctor() {
+; CHECK: #1 !entry !exit {
+; CHECK:   return
+; CHECK: }
+; CHECK: }
+
+define i32 @main() {
+  call void @callee(void ()* @addr_taken)
+  ret i32 0
+}
+; CHECK: define si32 @main() {
+; CHECK: #1 !entry !exit {
+; CHECK:   call @callee(@addr_taken)
+; CHECK:   return 0
+; CHECK: }
+; CHECK: }
+
+define void @via_global() {
+  ret void
+}
+; CHECK: define void @via_global() {
+; CHECK: #1 !entry !exit {
+; CHECK:   return
+; CHECK: }
+; CHECK: }